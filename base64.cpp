@@ -0,0 +1,405 @@
+// Header files
+#include "base64.h"
+#include "common.h"
+
+// Check if x86-64
+#if defined __x86_64__ || defined _M_X64
+
+	// Header files
+	#include <immintrin.h>
+#endif
+
+using namespace std;
+
+
+// Constants
+
+// Padding character
+const char Base64::PADDING_CHARACTER = '=';
+
+// Invalid value
+const uint8_t Base64::INVALID_VALUE = 0xFF;
+
+// Encoding table
+const char Base64::ENCODING_TABLE[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+// Decoding table
+const uint8_t Base64::DECODING_TABLE[] = {
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x3E, 0xFF, 0xFF, 0xFF, 0x3F,
+	0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A, 0x3B, 0x3C, 0x3D, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E,
+	0x0F, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28,
+	0x29, 0x2A, 0x2B, 0x2C, 0x2D, 0x2E, 0x2F, 0x30, 0x31, 0x32, 0x33, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF
+};
+
+
+// Supporting function implementation
+
+// Get encoded length
+size_t Base64::getEncodedLength(size_t length) {
+
+	// Return number of characters needed to encode the length including padding
+	return (length + 2) / 3 * 4;
+}
+
+// Get decoded length
+size_t Base64::getDecodedLength(const char *input, size_t length) {
+
+	// Check if length isn't a multiple of a quantum
+	if(!length || length % 4) {
+
+		// Return zero
+		return 0;
+	}
+
+	// Return number of bytes encoded by the input without its padding
+	return length / 4 * 3 - (input[length - 1] == PADDING_CHARACTER) - (input[length - 2] == PADDING_CHARACTER);
+}
+
+// Encode
+void Base64::encode(char *output, const uint8_t *input, size_t length) {
+
+	// Initialize index
+	size_t i = 0;
+
+	// Check if x86-64
+	#if defined __x86_64__ || defined _M_X64
+
+		// Check if AVX2 is supported
+		if(Common::isAvx2Supported()) {
+
+			// Encode full blocks with AVX2
+			i = encodeAvx2(output, input, length);
+		}
+
+		// Otherwise check if SSSE3 is supported
+		else if(Common::isSsse3Supported()) {
+
+			// Encode full blocks with SSSE3
+			i = encodeSsse3(output, input, length);
+		}
+	#endif
+
+	// Encode remaining bytes
+	encodeScalar(output + i / 3 * 4, input + i, length - i);
+}
+
+// Decode
+bool Base64::decode(uint8_t *output, const char *input, size_t length) {
+
+	// Check if length isn't a multiple of a quantum
+	if(length % 4) {
+
+		// Return false
+		return false;
+	}
+
+	// Initialize index
+	size_t i = 0;
+
+	// Check if x86-64
+	#if defined __x86_64__ || defined _M_X64
+
+		// Check if AVX2 is supported
+		if(Common::isAvx2Supported()) {
+
+			// Decode full blocks with AVX2
+			i = decodeAvx2(output, input, length);
+		}
+
+		// Otherwise check if SSSE3 is supported
+		else if(Common::isSsse3Supported()) {
+
+			// Decode full blocks with SSSE3
+			i = decodeSsse3(output, input, length);
+		}
+	#endif
+
+	// Return decoding remaining characters
+	return decodeScalar(output + i / 4 * 3, input + i, length - i);
+}
+
+// Is valid
+bool Base64::isValid(const char *input, size_t length) {
+
+	// Check if length isn't a multiple of a quantum
+	if(length % 4) {
+
+		// Return false
+		return false;
+	}
+
+	// Go through all characters before the last quantum
+	for(size_t i = 0; i + 4 < length; ++i) {
+
+		// Check if character isn't valid
+		if(DECODING_TABLE[static_cast<uint8_t>(input[i])] == INVALID_VALUE) {
+
+			// Return false
+			return false;
+		}
+	}
+
+	// Return if the last quantum is valid
+	uint8_t lastQuantum[3];
+	return !length || decodeScalar(lastQuantum, input + length - 4, 4);
+}
+
+// Encode scalar
+void Base64::encodeScalar(char *output, const uint8_t *input, size_t length) {
+
+	// Go through all full groups
+	size_t i = 0;
+	for(; length - i >= 3; i += 3, output += 4) {
+
+		// Encode group
+		output[0] = ENCODING_TABLE[input[i] >> 2];
+		output[1] = ENCODING_TABLE[((input[i] & 0x03) << 4) | (input[i + 1] >> 4)];
+		output[2] = ENCODING_TABLE[((input[i + 1] & 0x0F) << 2) | (input[i + 2] >> 6)];
+		output[3] = ENCODING_TABLE[input[i + 2] & 0x3F];
+	}
+
+	// Check if a partial group remains
+	if(i != length) {
+
+		// Encode partial group with padding
+		output[0] = ENCODING_TABLE[input[i] >> 2];
+		output[1] = ENCODING_TABLE[((input[i] & 0x03) << 4) | ((length - i == 2) ? input[i + 1] >> 4 : 0)];
+		output[2] = (length - i == 2) ? ENCODING_TABLE[(input[i + 1] & 0x0F) << 2] : PADDING_CHARACTER;
+		output[3] = PADDING_CHARACTER;
+	}
+}
+
+// Decode scalar
+bool Base64::decodeScalar(uint8_t *output, const char *input, size_t length) {
+
+	// Go through all quantums
+	for(size_t i = 0; i < length; i += 4) {
+
+		// Get quantum's first two values
+		const uint8_t first = DECODING_TABLE[static_cast<uint8_t>(input[i])];
+		const uint8_t second = DECODING_TABLE[static_cast<uint8_t>(input[i + 1])];
+
+		// Check if values are invalid
+		if(first > 0x3F || second > 0x3F) {
+
+			// Return false
+			return false;
+		}
+
+		// Check if quantum is the last quantum and it's padded
+		if(i + 4 == length && input[i + 3] == PADDING_CHARACTER) {
+
+			// Check if quantum contains one byte
+			if(input[i + 2] == PADDING_CHARACTER) {
+
+				// Check if unused bits aren't zero
+				if(second & 0x0F) {
+
+					// Return false
+					return false;
+				}
+
+				// Decode byte
+				*output = (first << 2) | (second >> 4);
+			}
+
+			// Otherwise
+			else {
+
+				// Check if third value is invalid or its unused bits aren't zero
+				const uint8_t third = DECODING_TABLE[static_cast<uint8_t>(input[i + 2])];
+				if(third > 0x3F || third & 0x03) {
+
+					// Return false
+					return false;
+				}
+
+				// Decode bytes
+				output[0] = (first << 2) | (second >> 4);
+				output[1] = (second << 4) | (third >> 2);
+			}
+
+			// Break
+			break;
+		}
+
+		// Get quantum's last two values
+		const uint8_t third = DECODING_TABLE[static_cast<uint8_t>(input[i + 2])];
+		const uint8_t fourth = DECODING_TABLE[static_cast<uint8_t>(input[i + 3])];
+
+		// Check if values are invalid
+		if(third > 0x3F || fourth > 0x3F) {
+
+			// Return false
+			return false;
+		}
+
+		// Decode bytes
+		output[0] = (first << 2) | (second >> 4);
+		output[1] = (second << 4) | (third >> 2);
+		output[2] = (third << 6) | fourth;
+		output += 3;
+	}
+
+	// Return true
+	return true;
+}
+
+// Check if x86-64
+#if defined __x86_64__ || defined _M_X64
+
+	// Encode SSSE3
+	size_t Base64::encodeSsse3(char *output, const uint8_t *input, size_t length) {
+
+		// Initialize constants
+		const __m128i shuffle = _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1);
+		const __m128i firstMask = _mm_set1_epi32(0x0FC0FC00);
+		const __m128i firstMultiplier = _mm_set1_epi32(0x04000040);
+		const __m128i secondMask = _mm_set1_epi32(0x003F03F0);
+		const __m128i secondMultiplier = _mm_set1_epi32(0x01000010);
+		const __m128i offsets = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+
+		// Go through all blocks that can be loaded
+		size_t i = 0;
+		for(; length - i >= sizeof(__m128i); i += 12, output += sizeof(__m128i)) {
+
+			// Get block with each group of three bytes spread across four lanes
+			const __m128i block = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(&input[i])), shuffle);
+
+			// Get six bit values from the block
+			const __m128i values = _mm_or_si128(_mm_mulhi_epu16(_mm_and_si128(block, firstMask), firstMultiplier), _mm_mullo_epi16(_mm_and_si128(block, secondMask), secondMultiplier));
+
+			// Get index of each value's offset
+			const __m128i indices = _mm_or_si128(_mm_subs_epu8(values, _mm_set1_epi8(51)), _mm_and_si128(_mm_cmpgt_epi8(_mm_set1_epi8(26), values), _mm_set1_epi8(13)));
+
+			// Store values offset to their characters
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(output), _mm_add_epi8(values, _mm_shuffle_epi8(offsets, indices)));
+		}
+
+		// Return number of bytes encoded
+		return i;
+	}
+
+	// Encode AVX2
+	size_t Base64::encodeAvx2(char *output, const uint8_t *input, size_t length) {
+
+		// Initialize constants
+		const __m256i shuffle = _mm256_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1, 10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1);
+		const __m256i firstMask = _mm256_set1_epi32(0x0FC0FC00);
+		const __m256i firstMultiplier = _mm256_set1_epi32(0x04000040);
+		const __m256i secondMask = _mm256_set1_epi32(0x003F03F0);
+		const __m256i secondMultiplier = _mm256_set1_epi32(0x01000010);
+		const __m256i offsets = _mm256_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0, 'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+
+		// Go through all blocks that can be loaded
+		size_t i = 0;
+		for(; length - i >= 12 + sizeof(__m128i); i += 24, output += sizeof(__m256i)) {
+
+			// Get block with each lane containing twelve bytes and each group of three bytes spread across four lanes
+			const __m256i block = _mm256_shuffle_epi8(_mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i *>(&input[i]))), _mm_loadu_si128(reinterpret_cast<const __m128i *>(&input[i + 12])), 1), shuffle);
+
+			// Get six bit values from the block
+			const __m256i values = _mm256_or_si256(_mm256_mulhi_epu16(_mm256_and_si256(block, firstMask), firstMultiplier), _mm256_mullo_epi16(_mm256_and_si256(block, secondMask), secondMultiplier));
+
+			// Get index of each value's offset
+			const __m256i indices = _mm256_or_si256(_mm256_subs_epu8(values, _mm256_set1_epi8(51)), _mm256_and_si256(_mm256_cmpgt_epi8(_mm256_set1_epi8(26), values), _mm256_set1_epi8(13)));
+
+			// Store values offset to their characters
+			_mm256_storeu_si256(reinterpret_cast<__m256i *>(output), _mm256_add_epi8(values, _mm256_shuffle_epi8(offsets, indices)));
+		}
+
+		// Return number of bytes encoded
+		return i;
+	}
+
+	// Decode SSSE3
+	size_t Base64::decodeSsse3(uint8_t *output, const char *input, size_t length) {
+
+		// Initialize constants
+		const __m128i nibbleMask = _mm_set1_epi8(0x0F);
+		const __m128i lowNibbleClasses = _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+		const __m128i highNibbleClasses = _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+		const __m128i offsets = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+		const __m128i slash = _mm_set1_epi8('/');
+		const __m128i firstMultiplier = _mm_set1_epi32(0x01400140);
+		const __m128i secondMultiplier = _mm_set1_epi32(0x00011000);
+		const __m128i shuffle = _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+
+		// Go through all blocks whose output can be stored without overflowing the output
+		size_t i = 0;
+		for(; length - i >= sizeof(__m128i) + 8; i += sizeof(__m128i), output += 12) {
+
+			// Get block
+			const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&input[i]));
+
+			// Check if block contains invalid characters
+			const __m128i highNibbles = _mm_and_si128(_mm_srli_epi32(block, 4), nibbleMask);
+			if(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_and_si128(_mm_shuffle_epi8(lowNibbleClasses, _mm_and_si128(block, nibbleMask)), _mm_shuffle_epi8(highNibbleClasses, highNibbles)), _mm_setzero_si128()))) {
+
+				// Break
+				break;
+			}
+
+			// Get six bit values from the block
+			const __m128i values = _mm_add_epi8(block, _mm_shuffle_epi8(offsets, _mm_add_epi8(_mm_cmpeq_epi8(block, slash), highNibbles)));
+
+			// Store values packed into bytes
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(output), _mm_shuffle_epi8(_mm_madd_epi16(_mm_maddubs_epi16(values, firstMultiplier), secondMultiplier), shuffle));
+		}
+
+		// Return number of characters decoded
+		return i;
+	}
+
+	// Decode AVX2
+	size_t Base64::decodeAvx2(uint8_t *output, const char *input, size_t length) {
+
+		// Initialize constants
+		const __m256i nibbleMask = _mm256_set1_epi8(0x0F);
+		const __m256i lowNibbleClasses = _mm256_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A, 0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+		const __m256i highNibbleClasses = _mm256_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+		const __m256i offsets = _mm256_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0, 0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+		const __m256i slash = _mm256_set1_epi8('/');
+		const __m256i firstMultiplier = _mm256_set1_epi32(0x01400140);
+		const __m256i secondMultiplier = _mm256_set1_epi32(0x00011000);
+		const __m256i shuffle = _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1, 2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+		const __m256i permutation = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 7, 7);
+
+		// Go through all blocks whose output can be stored without overflowing the output
+		size_t i = 0;
+		for(; length - i >= sizeof(__m256i) + sizeof(__m128i); i += sizeof(__m256i), output += 24) {
+
+			// Get block
+			const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(&input[i]));
+
+			// Check if block contains invalid characters
+			const __m256i highNibbles = _mm256_and_si256(_mm256_srli_epi32(block, 4), nibbleMask);
+			if(!_mm256_testz_si256(_mm256_shuffle_epi8(lowNibbleClasses, _mm256_and_si256(block, nibbleMask)), _mm256_shuffle_epi8(highNibbleClasses, highNibbles))) {
+
+				// Break
+				break;
+			}
+
+			// Get six bit values from the block
+			const __m256i values = _mm256_add_epi8(block, _mm256_shuffle_epi8(offsets, _mm256_add_epi8(_mm256_cmpeq_epi8(block, slash), highNibbles)));
+
+			// Store values packed into bytes
+			_mm256_storeu_si256(reinterpret_cast<__m256i *>(output), _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(_mm256_madd_epi16(_mm256_maddubs_epi16(values, firstMultiplier), secondMultiplier), shuffle), permutation));
+		}
+
+		// Return number of characters decoded
+		return i;
+	}
+#endif
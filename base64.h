@@ -0,0 +1,78 @@
+// Header guard
+#ifndef BASE64_H
+#define BASE64_H
+
+
+// Header files
+#include <cstddef>
+#include <cstdint>
+
+using namespace std;
+
+
+// Classes
+
+// Base64 class
+class Base64 final {
+
+	// Public
+	public:
+
+		// Constructor
+		Base64() = delete;
+
+		// Get encoded length
+		static size_t getEncodedLength(size_t length);
+
+		// Get decoded length
+		static size_t getDecodedLength(const char *input, size_t length);
+
+		// Encode
+		static void encode(char *output, const uint8_t *input, size_t length);
+
+		// Decode
+		static bool decode(uint8_t *output, const char *input, size_t length);
+
+		// Is valid
+		static bool isValid(const char *input, size_t length);
+
+	// Private
+	private:
+
+		// Encode scalar
+		static void encodeScalar(char *output, const uint8_t *input, size_t length);
+
+		// Decode scalar
+		static bool decodeScalar(uint8_t *output, const char *input, size_t length);
+
+		// Check if x86-64
+		#if defined __x86_64__ || defined _M_X64
+
+			// Encode SSSE3
+			__attribute__((target("ssse3"))) static size_t encodeSsse3(char *output, const uint8_t *input, size_t length);
+
+			// Encode AVX2
+			__attribute__((target("avx2"))) static size_t encodeAvx2(char *output, const uint8_t *input, size_t length);
+
+			// Decode SSSE3
+			__attribute__((target("ssse3"))) static size_t decodeSsse3(uint8_t *output, const char *input, size_t length);
+
+			// Decode AVX2
+			__attribute__((target("avx2"))) static size_t decodeAvx2(uint8_t *output, const char *input, size_t length);
+		#endif
+
+		// Padding character
+		static const char PADDING_CHARACTER;
+
+		// Invalid value
+		static const uint8_t INVALID_VALUE;
+
+		// Encoding table
+		static const char ENCODING_TABLE[];
+
+		// Decoding table
+		static const uint8_t DECODING_TABLE[];
+};
+
+
+#endif
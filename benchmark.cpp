@@ -0,0 +1,1534 @@
+// Header files
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <getopt.h>
+#include <iostream>
+#include <new>
+#include <random>
+#include <thread>
+#include <tuple>
+#include <unordered_map>
+#include "base64.h"
+#include "common.h"
+#include "json.h"
+#include "messages.h"
+#include "recorder.h"
+#include "unicode.h"
+#include "websocket.h"
+#include "openssl/bio.h"
+#include "openssl/evp.h"
+
+using namespace std;
+
+
+// Constants
+
+// Default minimum duration milliseconds
+static const unsigned long long DEFAULT_MINIMUM_DURATION_MILLISECONDS = 200;
+
+// Maximum minimum duration milliseconds
+static const unsigned long long MAXIMUM_MINIMUM_DURATION_MILLISECONDS = 60 * 1000;
+
+// Unlimited replay speed
+static const unsigned long long UNLIMITED_REPLAY_SPEED = 0;
+
+// Maximum replay speed
+static const unsigned long long MAXIMUM_REPLAY_SPEED = 1000;
+
+// Replay benchmark names
+static const char *REPLAY_BENCHMARK_NAMES[] = {
+
+	// POST request
+	"replay_post_request",
+
+	// Client message
+	"replay_client_message",
+
+	// Server message
+	"replay_server_message"
+};
+
+// Corpus sizes
+static const vector<pair<string, size_t>> CORPUS_SIZES = {
+	{"1KB", 1024},
+	{"64KB", 64 * 1024},
+	{"1MB", 1024 * 1024},
+	{"10MB", 10 * 1024 * 1024}
+};
+
+// Small message sizes
+static const vector<pair<string, size_t>> SMALL_MESSAGE_SIZES = {
+	{"1KB", 1024},
+	{"4KB", 4 * 1024},
+	{"10KB", 10 * 1024}
+};
+
+// Parallel gzip numbers of threads
+static const unsigned int PARALLEL_GZIP_NUMBERS_OF_THREADS[] = {1, 4, 8};
+
+// Parallel gzip minimum corpus length
+static const size_t PARALLEL_GZIP_MINIMUM_CORPUS_LENGTH = 1024 * 1024;
+
+// Body words
+static const vector<string> BODY_WORDS = {"{\"jsonrpc\":\"2.0\",", "\"id\":", "\"method\":", "\"get_version\"", "\"result\":", "\"height\":", "\"hash\":", "\"commitment\":", "\"0a1b2c3d4e5f\"", "\"proof\":", "\"amount\":", "\"status\":", "\"ok\"", "null", "true", "false", "1234567", "[", "]", "},", ", "};
+
+// Mixed script words
+static const vector<string> MIXED_SCRIPT_WORDS = {"hello ", "world ", "Grüße ", "naïve ", "Привет ", "мир ", "Γειά ", "σου ", "שלום ", "مرحبا ", "नमस्ते ", "こんにちは ", "世界 ", "안녕하세요 ", "😀 ", "🚀 ", "𝔘𝔫𝔦𝔠𝔬𝔡𝔢 "};
+
+// Control messages
+static const vector<string> CONTROL_MESSAGES = {
+	"{\"Index\":1,\"Request\":\"Create URL\"}",
+	"{\"Index\":2,\"Request\":\"Change URL\",\"URL\":\"abcdefghijklmnopqrstuvwxyz234567abcdefghijklmnopqrstuvwx\"}",
+	"{\"Index\":3,\"Request\":\"Own URL\",\"URL\":\"abcdefghijklmnopqrstuvwxyz234567abcdefghijklmnopqrstuvwx\"}",
+	"{\"Index\":4,\"Request\":\"Delete URL\"}",
+	"{\"Interaction\":5,\"Status\":\"Succeeded\"}"
+};
+
+// Random seed
+static const mt19937::result_type RANDOM_SEED = 0;
+
+// Frame mask
+static const uint8_t FRAME_MASK[] = {0x37, 0xFA, 0x21, 0x3D};
+
+// Minimum compression length (the gateway's default)
+static const size_t MINIMUM_COMPRESSION_LENGTH = 1000;
+
+// Benchmark connection ID
+static const uint64_t BENCHMARK_CONNECTION_ID = 0;
+
+// Unpooled inflate reserved space size (the same as the stream pool's)
+static const size_t UNPOOLED_INFLATE_RESERVED_SPACE_SIZE = 16 * 1024;
+
+// Benchmark result template
+static const Json::Template<6> BENCHMARK_RESULT_TEMPLATE({
+	{"Benchmark", Json()},
+	{"Corpus", Json()},
+	{"Iterations", Json()},
+	{"Nanoseconds Per Operation", Json()},
+	{"Bytes Per Second", Json()},
+	{"Allocations Per Operation", Json()}
+});
+
+// Interaction request template
+static const Json::Template<5> INTERACTION_REQUEST_TEMPLATE({
+	{"Interaction", Json()},
+	{"URL", Json()},
+	{"API", Json()},
+	{"Type", Json()},
+	{"Data", Json()}
+});
+
+// Interaction response template
+static const Json::Template<3> INTERACTION_RESPONSE_TEMPLATE({
+	{"Interaction", Json()},
+	{"Status", Json()},
+	{"Type", "application/json"},
+	{"Data", Json()}
+});
+
+
+// Global variables
+
+// Number of allocations
+static atomic_uint64_t numberOfAllocations(0);
+
+// Minimum duration
+static chrono::milliseconds minimumDuration(DEFAULT_MINIMUM_DURATION_MILLISECONDS);
+
+// Filter
+static string filter;
+
+
+// Function prototypes
+
+// Display options help
+static void displayOptionsHelp();
+
+// Display invalid option
+static void displayInvalidOption(const char *program, const char *name, const char *value);
+
+// Parse number
+static bool parseNumber(const char *text, unsigned long long minimum, unsigned long long maximum, unsigned long long &number);
+
+// Create text
+static string createText(size_t length, const vector<string> &words, mt19937 &generator);
+
+// Base64 encode BIO
+static bool base64EncodeBio(string &output, const vector<uint8_t> &value);
+
+// Base64 decode BIO
+static bool base64DecodeBio(vector<uint8_t> &output, const string &value);
+
+// Deflate unpooled
+static bool deflateUnpooled(evbuffer *output, const uint8_t *input, size_t length);
+
+// Inflate unpooled
+static bool inflateUnpooled(evbuffer *output, const uint8_t *input, size_t length);
+
+// Create client frame
+static vector<uint8_t> createClientFrame(const string &message, bool compress);
+
+// Parse client frame
+static bool parseClientFrame(string &message, const vector<uint8_t> &frame, Unicode::Utf8Validator &validator);
+
+// Run benchmark
+static bool runBenchmark(const char *name, const string &corpus, size_t bytesPerOperation, const function<bool()> &operation);
+
+// Run replay
+static bool runReplay(const char *path, unsigned long long speed);
+
+// Display result
+static void displayResult(const char *name, const string &corpus, uint64_t iterations, chrono::steady_clock::duration duration, uint64_t bytes, uint64_t allocations);
+
+// Do not optimize
+template<typename Type> static inline void doNotOptimize(const Type &value) {
+
+	// Prevent the compiler from removing the computation of the value
+	asm volatile("" : : "r"(&value) : "memory");
+}
+
+
+// Allocation counting
+
+// New operator
+void *operator new(size_t size) {
+
+	// Increment number of allocations
+	numberOfAllocations.fetch_add(1, memory_order_relaxed);
+
+	// Check if allocating memory was successful
+	void *memory = malloc(size ? size : 1);
+	if(memory) {
+
+		// Return memory
+		return memory;
+	}
+
+	// Throw exception
+	throw bad_alloc();
+}
+
+// Delete operator
+void operator delete(void *memory) noexcept {
+
+	// Free memory
+	free(memory);
+}
+
+// Sized delete operator
+void operator delete(void *memory, size_t size) noexcept {
+
+	// Free memory
+	free(memory);
+}
+
+
+// Main function
+int main(int argc, char *argv[]) {
+
+	// Display message to the standard error so that the results remain machine-readable
+	cerr << TOSTRING(PROGRAM_NAME) << " Benchmark v" << TOSTRING(PROGRAM_VERSION) << endl;
+
+	// Set options
+	const option options[] = {
+
+		// Version
+		{"version", no_argument, nullptr, 'v'},
+
+		// Time
+		{"time", required_argument, nullptr, 't'},
+
+		// Filter
+		{"filter", required_argument, nullptr, 'f'},
+
+		// Replay
+		{"replay", required_argument, nullptr, 'r'},
+
+		// Replay speed
+		{"replay-speed", required_argument, nullptr, 'S'},
+
+		// Help
+		{"help", no_argument, nullptr, 'h'},
+
+		// End
+		{}
+	};
+
+	// Initialize replay file
+	const char *replayFile = nullptr;
+
+	// Initialize replay speed
+	unsigned long long replaySpeed = UNLIMITED_REPLAY_SPEED;
+
+	// Go through all options
+	for(int option = getopt_long(argc, argv, "vt:f:r:S:h", options, nullptr); option != -1; option = getopt_long(argc, argv, "vt:f:r:S:h", options, nullptr)) {
+
+		// Check option
+		switch(option) {
+
+			// Version
+			case 'v':
+
+				// Return success
+				return EXIT_SUCCESS;
+
+			// Time
+			case 't':
+
+				// Check if parsing minimum duration failed
+				unsigned long long minimumDurationMilliseconds;
+				if(!optarg || !parseNumber(optarg, 1, MAXIMUM_MINIMUM_DURATION_MILLISECONDS, minimumDurationMilliseconds)) {
+
+					// Display invalid option
+					displayInvalidOption(argv[0], "time", optarg);
+
+					// Return failure
+					return EXIT_FAILURE;
+				}
+
+				// Set minimum duration
+				minimumDuration = chrono::milliseconds(minimumDurationMilliseconds);
+
+				// Break
+				break;
+
+			// Filter
+			case 'f':
+
+				// Check if option doesn't exist
+				if(!optarg || !*optarg) {
+
+					// Display invalid option
+					displayInvalidOption(argv[0], "filter", optarg);
+
+					// Return failure
+					return EXIT_FAILURE;
+				}
+
+				// Set filter
+				filter = optarg;
+
+				// Break
+				break;
+
+			// Replay
+			case 'r':
+
+				// Check if option doesn't exist
+				if(!optarg || !*optarg) {
+
+					// Display invalid option
+					displayInvalidOption(argv[0], "replay", optarg);
+
+					// Return failure
+					return EXIT_FAILURE;
+				}
+
+				// Set replay file
+				replayFile = optarg;
+
+				// Break
+				break;
+
+			// Replay speed
+			case 'S':
+
+				// Check if replay speed is unlimited
+				if(optarg && !strcmp(optarg, "max")) {
+
+					// Set replay speed
+					replaySpeed = UNLIMITED_REPLAY_SPEED;
+				}
+
+				// Otherwise check if parsing replay speed failed
+				else if(!optarg || !parseNumber(optarg, 1, MAXIMUM_REPLAY_SPEED, replaySpeed)) {
+
+					// Display invalid option
+					displayInvalidOption(argv[0], "replay speed", optarg);
+
+					// Return failure
+					return EXIT_FAILURE;
+				}
+
+				// Break
+				break;
+
+			// Help
+			case 'h':
+
+				// Display message
+				cout << endl << "Usage:" << endl << '\t' << argv[0] << " [options]" << endl << endl;
+
+				// Display options help
+				displayOptionsHelp();
+
+				// Return success
+				return EXIT_SUCCESS;
+
+			// Default
+			default:
+
+				// Display message
+				cout << endl << "Usage:" << endl << '\t' << argv[0] << " [options]" << endl << endl;
+
+				// Display options help
+				displayOptionsHelp();
+
+				// Return failure
+				return EXIT_FAILURE;
+		}
+	}
+
+	// Check if replaying
+	if(replayFile) {
+
+		// Return if running replay was successful
+		return runReplay(replayFile, replaySpeed) ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+
+	// Initialize generator with a fixed seed so that every run uses the same corpora
+	mt19937 generator(RANDOM_SEED);
+
+	// Initialize succeeded
+	bool succeeded = true;
+
+	// Go through all control messages
+	size_t controlMessagesLength = 0;
+	for(const string &controlMessage : CONTROL_MESSAGES) {
+
+		// Update control messages length
+		controlMessagesLength += controlMessage.size();
+	}
+
+	// Run JSON decode control messages benchmark
+	succeeded = runBenchmark("json_decode", "control", controlMessagesLength, [&]() {
+
+		// Go through all control messages
+		for(const string &controlMessage : CONTROL_MESSAGES) {
+
+			// Check if decoding control message failed
+			Json json;
+			if(!json.decode(controlMessage)) {
+
+				// Return false
+				return false;
+			}
+
+			// Do not optimize JSON
+			doNotOptimize(json);
+		}
+
+		// Return true
+		return true;
+
+	}) && succeeded;
+
+	// Run schema decode control messages benchmark
+	succeeded = runBenchmark("schema_decode", "control", controlMessagesLength, [&]() {
+
+		// Go through all control messages
+		for(const string &controlMessage : CONTROL_MESSAGES) {
+
+			// Check if decoding control message with the gateway's client message decoder failed
+			ControlMessage decodedControlMessage;
+			InteractionMessage decodedInteractionMessage;
+			if(!CLIENT_MESSAGE_DECODER.decodeValidUtf8(controlMessage, decodedControlMessage, decodedInteractionMessage)) {
+
+				// Return false
+				return false;
+			}
+
+			// Do not optimize decoded messages
+			doNotOptimize(decodedControlMessage);
+			doNotOptimize(decodedInteractionMessage);
+		}
+
+		// Return true
+		return true;
+
+	}) && succeeded;
+
+	// Run UTF-8 validation control messages benchmark
+	succeeded = runBenchmark("utf8_validate", "control", controlMessagesLength, [&]() {
+
+		// Go through all control messages
+		for(const string &controlMessage : CONTROL_MESSAGES) {
+
+			// Check if control message isn't valid UTF-8
+			if(!Unicode::isValidUtf8(controlMessage)) {
+
+				// Return false
+				return false;
+			}
+		}
+
+		// Return true
+		return true;
+
+	}) && succeeded;
+
+	// Go through all corpus sizes
+	for(const pair<string, size_t> &corpusSize : CORPUS_SIZES) {
+
+		// Get corpus size's name and length
+		const string &sizeName = corpusSize.first;
+		const size_t length = corpusSize.second;
+
+		// Create body and mixed script text
+		const string bodyText = createText(length, BODY_WORDS, generator);
+		const vector<uint8_t> body(bodyText.begin(), bodyText.end());
+		const string mixedScriptText = createText(length, MIXED_SCRIPT_WORDS, generator);
+
+		// Create encoded body
+		const string encodedBody = Json::base64Encode(body);
+
+		// Create interaction request and response messages
+		const string interactionRequest = INTERACTION_REQUEST_TEMPLATE.fill(static_cast<Json::Number>(1), "abcdefghijklmnopqrstuvwxyz234567abcdefghijklmnopqrstuvwx", "/v2/owner", "application/json", encodedBody);
+		const string interactionResponse = INTERACTION_RESPONSE_TEMPLATE.fill(static_cast<Json::Number>(1), static_cast<Json::Number>(200), encodedBody);
+
+		// Get corpus names
+		const string interactionCorpus = "interaction_" + sizeName;
+		const string bodyCorpus = "body_" + sizeName;
+		const string mixedScriptCorpus = "mixed_script_" + sizeName;
+
+		// Run JSON decode interaction benchmark
+		succeeded = runBenchmark("json_decode", interactionCorpus, interactionResponse.size(), [&]() {
+
+			// Check if decoding interaction response failed
+			Json json;
+			if(!json.decode(interactionResponse)) {
+
+				// Return false
+				return false;
+			}
+
+			// Do not optimize JSON
+			doNotOptimize(json);
+
+			// Return true
+			return true;
+
+		}) && succeeded;
+
+		// Run schema decode interaction benchmark
+		succeeded = runBenchmark("schema_decode", interactionCorpus, interactionResponse.size(), [&]() {
+
+			// Check if decoding interaction response with the gateway's client message decoder failed
+			ControlMessage decodedControlMessage;
+			InteractionMessage decodedInteractionMessage;
+			if(!CLIENT_MESSAGE_DECODER.decodeValidUtf8(interactionResponse, decodedControlMessage, decodedInteractionMessage)) {
+
+				// Return false
+				return false;
+			}
+
+			// Do not optimize decoded messages
+			doNotOptimize(decodedControlMessage);
+			doNotOptimize(decodedInteractionMessage);
+
+			// Return true
+			return true;
+
+		}) && succeeded;
+
+		// Check if decoding interaction request failed
+		Json interactionRequestJson;
+		if(!interactionRequestJson.decode(interactionRequest)) {
+
+			// Display message
+			cerr << "Decoding " << interactionCorpus << " failed" << endl;
+
+			// Return failure
+			return EXIT_FAILURE;
+		}
+
+		// Run JSON encode interaction benchmark
+		succeeded = runBenchmark("json_encode", interactionCorpus, interactionRequest.size(), [&]() {
+
+			// Encode interaction request
+			const string encoded = interactionRequestJson.encode();
+
+			// Do not optimize encoded
+			doNotOptimize(encoded);
+
+			// Return true
+			return true;
+
+		}) && succeeded;
+
+		// Run base64 encode benchmark
+		succeeded = runBenchmark("base64_encode", bodyCorpus, body.size(), [&]() {
+
+			// Encode body
+			const string encoded = Json::base64Encode(body);
+
+			// Do not optimize encoded
+			doNotOptimize(encoded);
+
+			// Return true
+			return true;
+
+		}) && succeeded;
+
+		// Run base64 decode benchmark
+		succeeded = runBenchmark("base64_decode", bodyCorpus, encodedBody.size(), [&]() {
+
+			// Decode encoded body
+			const vector<uint8_t> decoded = Json::base64Decode(encodedBody);
+
+			// Do not optimize decoded
+			doNotOptimize(decoded);
+
+			// Return true
+			return true;
+
+		}) && succeeded;
+
+		// Run base64 encode BIO benchmark
+		succeeded = runBenchmark("base64_encode_bio", bodyCorpus, body.size(), [&]() {
+
+			// Check if encoding body with a BIO chain failed
+			string encoded;
+			if(!base64EncodeBio(encoded, body)) {
+
+				// Return false
+				return false;
+			}
+
+			// Do not optimize encoded
+			doNotOptimize(encoded);
+
+			// Return true
+			return true;
+
+		}) && succeeded;
+
+		// Run base64 decode BIO benchmark
+		succeeded = runBenchmark("base64_decode_bio", bodyCorpus, encodedBody.size(), [&]() {
+
+			// Check if decoding encoded body with a BIO chain failed
+			vector<uint8_t> decoded;
+			if(!base64DecodeBio(decoded, encodedBody)) {
+
+				// Return false
+				return false;
+			}
+
+			// Do not optimize decoded
+			doNotOptimize(decoded);
+
+			// Return true
+			return true;
+
+		}) && succeeded;
+
+		// Run UTF-8 validation interaction benchmark
+		succeeded = runBenchmark("utf8_validate", interactionCorpus, interactionRequest.size(), [&]() {
+
+			// Return if interaction request is valid UTF-8
+			return Unicode::isValidUtf8(interactionRequest);
+
+		}) && succeeded;
+
+		// Run UTF-8 validation mixed script benchmark
+		succeeded = runBenchmark("utf8_validate", mixedScriptCorpus, mixedScriptText.size(), [&]() {
+
+			// Return if mixed script text is valid UTF-8
+			return Unicode::isValidUtf8(mixedScriptText);
+
+		}) && succeeded;
+
+		// Go through all UTF-8 conversion texts
+		for(const pair<const string *, const string *> &conversionText : {
+			make_pair(&mixedScriptCorpus, &mixedScriptText),
+			make_pair(&bodyCorpus, &bodyText)
+		}) {
+
+			// Get text
+			const string &text = *conversionText.second;
+
+			// Run UTF-8 to UTF-16 benchmark
+			u16string utf16Text(text.size(), u'\0');
+			succeeded = runBenchmark("utf8_to_utf16", *conversionText.first, text.size(), [&]() {
+
+				// Convert text to UTF-16
+				const size_t utf16Length = Unicode::utf8ToUtf16(utf16Text.data(), text.data(), text.size());
+
+				// Do not optimize UTF-16 text
+				doNotOptimize(utf16Text);
+
+				// Return if text was converted
+				return utf16Length != 0;
+
+			}) && succeeded;
+
+			// Run UTF-8 to UTF-32 benchmark
+			u32string utf32Text(text.size(), U'\0');
+			succeeded = runBenchmark("utf8_to_utf32", *conversionText.first, text.size(), [&]() {
+
+				// Convert text to UTF-32
+				const size_t utf32Length = Unicode::utf8ToUtf32(utf32Text.data(), text.data(), text.size());
+
+				// Do not optimize UTF-32 text
+				doNotOptimize(utf32Text);
+
+				// Return if text was converted
+				return utf32Length != 0;
+
+			}) && succeeded;
+
+			// Run remove invalid UTF-8 benchmark
+			string validText(text.size(), '\0');
+			succeeded = runBenchmark("remove_invalid_utf8", *conversionText.first, text.size(), [&]() {
+
+				// Remove invalid UTF-8 from the text
+				const size_t validLength = Unicode::removeInvalidUtf8(validText.data(), text.data(), text.size());
+
+				// Do not optimize valid text
+				doNotOptimize(validText);
+
+				// Return if nothing was removed from the valid text
+				return validLength == text.size();
+
+			}) && succeeded;
+		}
+
+		// Run gzip benchmark
+		succeeded = runBenchmark("gzip", bodyCorpus, body.size(), [&]() {
+
+			// Check if gzipping body failed
+			vector<uint8_t> compressed;
+			if(!Common::gzip(compressed, body)) {
+
+				// Return false
+				return false;
+			}
+
+			// Do not optimize compressed
+			doNotOptimize(compressed);
+
+			// Return true
+			return true;
+
+		}) && succeeded;
+
+		// Check if body is large enough to be gzipped in parallel
+		if(length >= PARALLEL_GZIP_MINIMUM_CORPUS_LENGTH) {
+
+			// Check if creating compressed body buffer failed
+			unique_ptr<evbuffer, decltype(&evbuffer_free)> compressedBody(evbuffer_new(), evbuffer_free);
+			if(!compressedBody) {
+
+				// Display message
+				cerr << "Creating buffer failed" << endl;
+
+				// Return failure
+				return EXIT_FAILURE;
+			}
+
+			// Go through all parallel gzip numbers of threads
+			for(const unsigned int numberOfThreads : PARALLEL_GZIP_NUMBERS_OF_THREADS) {
+
+				// Run parallel gzip benchmark
+				succeeded = runBenchmark(("parallel_gzip_x" + to_string(numberOfThreads)).c_str(), bodyCorpus, body.size(), [&]() {
+
+					// Check if gzipping body with the number of threads failed
+					if(!Common::parallelGzip(compressedBody.get(), body.data(), body.size(), numberOfThreads)) {
+
+						// Return false
+						return false;
+					}
+
+					// Return if removing the compressed body from its buffer was successful
+					return !evbuffer_drain(compressedBody.get(), evbuffer_get_length(compressedBody.get()));
+
+				}) && succeeded;
+			}
+		}
+
+		// Run deflate benchmark
+		succeeded = runBenchmark("deflate", bodyCorpus, body.size(), [&]() {
+
+			// Check if deflating body failed
+			vector<uint8_t> compressed;
+			if(!Common::deflate(compressed, body)) {
+
+				// Return false
+				return false;
+			}
+
+			// Do not optimize compressed
+			doNotOptimize(compressed);
+
+			// Return true
+			return true;
+
+		}) && succeeded;
+
+		// Check if deflating body failed
+		vector<uint8_t> deflatedBody;
+		if(!Common::deflate(deflatedBody, body)) {
+
+			// Display message
+			cerr << "Deflating " << bodyCorpus << " failed" << endl;
+
+			// Return failure
+			return EXIT_FAILURE;
+		}
+
+		// Run inflate benchmark
+		succeeded = runBenchmark("inflate", bodyCorpus, body.size(), [&]() {
+
+			// Check if inflating deflated body failed
+			vector<uint8_t> decompressed;
+			if(!Common::inflate(decompressed, deflatedBody)) {
+
+				// Return false
+				return false;
+			}
+
+			// Do not optimize decompressed
+			doNotOptimize(decompressed);
+
+			// Return true
+			return true;
+
+		}) && succeeded;
+
+		// Go through all compressions
+		for(const bool compress : {false, true}) {
+
+			// Initialize compression policy like a connection that supports compression
+			WebSocket::CompressionPolicy compressionPolicy(MINIMUM_COMPRESSION_LENGTH);
+
+			// Run WebSocket response benchmark
+			succeeded = runBenchmark(compress ? "websocket_response_deflate" : "websocket_response", interactionCorpus, interactionRequest.size(), [&]() {
+
+				// Try
+				try {
+
+					// Create WebSocket response with the gateway's compression policy
+					const vector<uint8_t> response = WebSocket::createResponse(interactionRequest, WebSocket::Opcode::TEXT, compress ? &compressionPolicy : nullptr, BENCHMARK_CONNECTION_ID);
+
+					// Do not optimize response
+					doNotOptimize(response);
+				}
+
+				// Catch errors
+				catch(...) {
+
+					// Return false
+					return false;
+				}
+
+				// Return true
+				return true;
+
+			}) && succeeded;
+		}
+
+		// Create client frames
+		const vector<uint8_t> interactionFrame = createClientFrame(interactionResponse, false);
+		const vector<uint8_t> mixedScriptFrame = createClientFrame(mixedScriptText, false);
+		const vector<uint8_t> compressedMixedScriptFrame = createClientFrame(mixedScriptText, true);
+
+		// Go through all client frames
+		for(const tuple<const char *, const string *, const vector<uint8_t> *, size_t> &clientFrame : {
+			make_tuple("websocket_frame_parse", &interactionCorpus, &interactionFrame, interactionResponse.size()),
+			make_tuple("websocket_frame_parse", &mixedScriptCorpus, &mixedScriptFrame, mixedScriptText.size()),
+			make_tuple("websocket_frame_parse_deflate", &mixedScriptCorpus, &compressedMixedScriptFrame, mixedScriptText.size())
+		}) {
+
+			// Run WebSocket frame parse benchmark
+			succeeded = runBenchmark(get<0>(clientFrame), *get<1>(clientFrame), get<3>(clientFrame), [&]() {
+
+				// Check if parsing client frame failed
+				string message;
+				Unicode::Utf8Validator validator;
+				if(!parseClientFrame(message, *get<2>(clientFrame), validator)) {
+
+					// Return false
+					return false;
+				}
+
+				// Do not optimize message
+				doNotOptimize(message);
+
+				// Return true
+				return true;
+
+			}) && succeeded;
+		}
+	}
+
+	// Check if creating buffer failed
+	unique_ptr<evbuffer, decltype(&evbuffer_free)> buffer(evbuffer_new(), evbuffer_free);
+	if(!buffer) {
+
+		// Display message
+		cerr << "Creating buffer failed" << endl;
+
+		// Return failure
+		return EXIT_FAILURE;
+	}
+
+	// Go through all small message sizes
+	for(const pair<string, size_t> &smallMessageSize : SMALL_MESSAGE_SIZES) {
+
+		// Create message and get its corpus name
+		const string messageText = createText(smallMessageSize.second, BODY_WORDS, generator);
+		const uint8_t *message = reinterpret_cast<const uint8_t *>(messageText.data());
+		const string messageCorpus = "message_" + smallMessageSize.first;
+
+		// Check if deflating message failed
+		vector<uint8_t> deflatedMessage;
+		if(!Common::deflate(deflatedMessage, vector<uint8_t>(messageText.begin(), messageText.end()))) {
+
+			// Display message
+			cerr << "Deflating " << messageCorpus << " failed" << endl;
+
+			// Return failure
+			return EXIT_FAILURE;
+		}
+
+		// Go through all deflate and inflate benchmarks with and without the stream pool
+		for(const tuple<const char *, bool (*)(evbuffer *, const uint8_t *, size_t), const uint8_t *, size_t> &smallMessageBenchmark : {
+			make_tuple("deflate", +[](evbuffer *output, const uint8_t *input, size_t length) {
+				return Common::deflate(output, input, length);
+			}, message, messageText.size()),
+			make_tuple("deflate_unpooled", deflateUnpooled, message, messageText.size()),
+			make_tuple("inflate", +[](evbuffer *output, const uint8_t *input, size_t length) {
+				return Common::inflate(output, input, length);
+			}, static_cast<const uint8_t *>(deflatedMessage.data()), deflatedMessage.size()),
+			make_tuple("inflate_unpooled", inflateUnpooled, static_cast<const uint8_t *>(deflatedMessage.data()), deflatedMessage.size())
+		}) {
+
+			// Run small message benchmark
+			succeeded = runBenchmark(get<0>(smallMessageBenchmark), messageCorpus, messageText.size(), [&]() {
+
+				// Check if compressing or decompressing input into the buffer failed
+				if(!get<1>(smallMessageBenchmark)(buffer.get(), get<2>(smallMessageBenchmark), get<3>(smallMessageBenchmark))) {
+
+					// Return false
+					return false;
+				}
+
+				// Return if removing the output from the buffer was successful
+				return !evbuffer_drain(buffer.get(), evbuffer_get_length(buffer.get()));
+
+			}) && succeeded;
+		}
+	}
+
+	// Return if all benchmarks succeeded
+	return succeeded ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+
+// Supporting function implementation
+
+// Display options help
+void displayOptionsHelp() {
+
+	// Display message
+	cout << "Options:" << endl;
+	cout << "\t-v, --version\t\tDisplays version information" << endl;
+	cout << "\t-t, --time\t\tSets the minimum milliseconds to run each benchmark for (default: " << DEFAULT_MINIMUM_DURATION_MILLISECONDS << ')' << endl;
+	cout << "\t-f, --filter\t\tOnly runs benchmarks whose benchmark/corpus name contains the filter" << endl;
+	cout << "\t-r, --replay\t\tRuns the POST requests and WebSocket messages recorded by the gateway's --record-file through the codec layer instead" << endl;
+	cout << "\t-S, --replay-speed\tSets the replay speed as a multiple of the recorded timing or max to replay back-to-back for at least the time (default: max)" << endl;
+	cout << "\t-h, --help\t\tDisplays help information" << endl;
+}
+
+// Display invalid option
+void displayInvalidOption(const char *program, const char *name, const char *value) {
+
+	// Display message
+	cout << program << ": invalid " << name << " -- '" << (value ? value : "") << '\'' << endl;
+
+	// Display message
+	cout << endl << "Usage:" << endl << '\t' << program << " [options]" << endl << endl;
+
+	// Display options help
+	displayOptionsHelp();
+}
+
+// Parse number
+bool parseNumber(const char *text, unsigned long long minimum, unsigned long long maximum, unsigned long long &number) {
+
+	// Check if text isn't numeric
+	if(!Common::isNumeric(text)) {
+
+		// Return false
+		return false;
+	}
+
+	// Try
+	try {
+
+		// Get number from text
+		number = stoull(text);
+	}
+
+	// Catch errors
+	catch(...) {
+
+		// Return false
+		return false;
+	}
+
+	// Return if number is in range
+	return number >= minimum && number <= maximum;
+}
+
+// Create text
+string createText(size_t length, const vector<string> &words, mt19937 &generator) {
+
+	// Initialize text
+	string text;
+	text.reserve(length);
+
+	// Go through all words that fit in the text
+	uniform_int_distribution<size_t> distribution(0, words.size() - 1);
+	for(const string *word = &words[distribution(generator)]; text.size() + word->size() <= length; word = &words[distribution(generator)]) {
+
+		// Append word to the text
+		text += *word;
+	}
+
+	// Pad text to the length with spaces so that no character is split
+	text.resize(length, ' ');
+
+	// Return text
+	return text;
+}
+
+// Base64 encode BIO (the OpenSSL BIO chain that the base64 codec replaced)
+bool base64EncodeBio(string &output, const vector<uint8_t> &value) {
+
+	// Check if creating a base64 BIO or a memory BIO failed
+	unique_ptr<BIO, decltype(&BIO_free_all)> base64Bio(BIO_new(BIO_f_base64()), BIO_free_all);
+	BIO *memoryBio = BIO_new(BIO_s_mem());
+	if(!base64Bio || !memoryBio) {
+
+		// Free memory BIO
+		BIO_free(memoryBio);
+
+		// Return false
+		return false;
+	}
+
+	// Set base64 BIO to not append newlines and append the memory BIO to it
+	BIO_set_flags(base64Bio.get(), BIO_FLAGS_BASE64_NO_NL);
+	BIO_push(base64Bio.get(), memoryBio);
+
+	// Check if encoding value or flushing the base64 BIO failed
+	if(BIO_write(base64Bio.get(), value.data(), value.size()) <= 0 || BIO_flush(base64Bio.get()) != 1) {
+
+		// Return false
+		return false;
+	}
+
+	// Check if moving encoded value to the output failed
+	output.resize(Base64::getEncodedLength(value.size()));
+	const int bytesRead = BIO_read(memoryBio, output.data(), output.size());
+	if(bytesRead <= 0) {
+
+		// Return false
+		return false;
+	}
+
+	// Remove unused space from the output
+	output.resize(bytesRead);
+
+	// Return true
+	return true;
+}
+
+// Base64 decode BIO (the OpenSSL BIO chain that the base64 codec replaced)
+bool base64DecodeBio(vector<uint8_t> &output, const string &value) {
+
+	// Check if creating a base64 BIO or a memory BIO with the value failed
+	unique_ptr<BIO, decltype(&BIO_free_all)> base64Bio(BIO_new(BIO_f_base64()), BIO_free_all);
+	BIO *memoryBio = BIO_new_mem_buf(value.data(), value.size());
+	if(!base64Bio || !memoryBio) {
+
+		// Free memory BIO
+		BIO_free(memoryBio);
+
+		// Return false
+		return false;
+	}
+
+	// Set base64 BIO to not expect newlines and append the memory BIO to it
+	BIO_set_flags(base64Bio.get(), BIO_FLAGS_BASE64_NO_NL);
+	BIO_push(base64Bio.get(), memoryBio);
+
+	// Check if decoding value to the output failed
+	output.resize(value.size() / 4 * 3);
+	const int bytesRead = BIO_read(base64Bio.get(), output.data(), output.size());
+	if(bytesRead <= 0) {
+
+		// Return false
+		return false;
+	}
+
+	// Remove unused space from the output
+	output.resize(bytesRead);
+
+	// Return true
+	return true;
+}
+
+// Deflate unpooled (initializes and ends a stream for every message like the gateway did before the stream pool)
+bool deflateUnpooled(evbuffer *output, const uint8_t *input, size_t length) {
+
+	// Check if initializing stream with the stream pool's raw deflate parameters failed
+	z_stream stream = {};
+	if(deflateInit2(&stream, Z_BEST_COMPRESSION, Z_DEFLATED, -MAX_WBITS, MAX_MEM_LEVEL, Z_DEFAULT_STRATEGY) != Z_OK) {
+
+		// Return false
+		return false;
+	}
+
+	// Check if reserving space for the largest possible deflated input in the output failed
+	const uLong bound = deflateBound(&stream, length);
+	evbuffer_iovec space;
+	if(evbuffer_reserve_space(output, bound, &space, 1) != 1 || space.iov_len < bound) {
+
+		// End stream
+		deflateEnd(&stream);
+
+		// Return false
+		return false;
+	}
+
+	// Set stream to deflate input directly into the reserved space
+	stream.avail_in = length;
+	stream.next_in = const_cast<uint8_t *>(input);
+	stream.avail_out = bound;
+	stream.next_out = reinterpret_cast<uint8_t *>(space.iov_base);
+
+	// Check if deflating input failed
+	if(deflate(&stream, Z_FINISH) != Z_STREAM_END) {
+
+		// End stream
+		deflateEnd(&stream);
+
+		// Return false
+		return false;
+	}
+
+	// Get deflated input's length
+	space.iov_len = bound - stream.avail_out;
+
+	// End stream
+	deflateEnd(&stream);
+
+	// Return if committing the deflated input to the output was successful
+	return !evbuffer_commit_space(output, &space, 1);
+}
+
+// Inflate unpooled (initializes and ends a stream for every message like the gateway did before the stream pool)
+bool inflateUnpooled(evbuffer *output, const uint8_t *input, size_t length) {
+
+	// Check if initializing stream with the stream pool's raw inflate parameters failed
+	z_stream stream = {};
+	if(inflateInit2(&stream, -MAX_WBITS) != Z_OK) {
+
+		// Return false
+		return false;
+	}
+
+	// Set stream to inflate input
+	stream.avail_in = length;
+	stream.next_in = const_cast<uint8_t *>(input);
+
+	// Go through all data
+	int result;
+	do {
+
+		// Check if reserving space in the output failed
+		evbuffer_iovec space;
+		if(evbuffer_reserve_space(output, UNPOOLED_INFLATE_RESERVED_SPACE_SIZE, &space, 1) != 1) {
+
+			// End stream
+			inflateEnd(&stream);
+
+			// Return false
+			return false;
+		}
+
+		// Set stream to inflate chunk directly into the reserved space
+		stream.avail_out = space.iov_len;
+		stream.next_out = reinterpret_cast<uint8_t *>(space.iov_base);
+
+		// Check if error occurred while inflating chunk
+		result = inflate(&stream, Z_SYNC_FLUSH);
+		if(result != Z_OK && result != Z_STREAM_END && result != Z_BUF_ERROR) {
+
+			// End stream
+			inflateEnd(&stream);
+
+			// Return false
+			return false;
+		}
+
+		// Check if committing inflated chunk to the output failed
+		space.iov_len -= stream.avail_out;
+		if(evbuffer_commit_space(output, &space, 1)) {
+
+			// End stream
+			inflateEnd(&stream);
+
+			// Return false
+			return false;
+		}
+
+	} while(result != Z_STREAM_END && result != Z_BUF_ERROR && (stream.avail_in || !stream.avail_out));
+
+	// End stream
+	inflateEnd(&stream);
+
+	// Return true
+	return true;
+}
+
+// Create client frame
+vector<uint8_t> createClientFrame(const string &message, bool compress) {
+
+	// Initialize payload
+	vector<uint8_t> payload(message.begin(), message.end());
+
+	// Check if compressing
+	if(compress) {
+
+		// Check if deflating the message failed
+		vector<uint8_t> compressedMessage;
+		if(!Common::deflate(compressedMessage, payload)) {
+
+			// Throw exception
+			throw runtime_error("Deflating the message failed");
+		}
+
+		// Set payload to the compressed message
+		payload = move(compressedMessage);
+	}
+
+	// Append frame's header to the frame
+	vector<uint8_t> frame;
+	WebSocket::appendFrameHeader(frame, WebSocket::Opcode::TEXT, true, compress, payload.size(), FRAME_MASK);
+
+	// Go through all bytes in the payload
+	for(size_t i = 0; i < payload.size(); ++i) {
+
+		// Append masked byte to the frame
+		frame.push_back(payload[i] ^ FRAME_MASK[i % WebSocket::MASK_LENGTH]);
+	}
+
+	// Return frame
+	return frame;
+}
+
+// Parse client frame
+bool parseClientFrame(string &message, const vector<uint8_t> &frame, Unicode::Utf8Validator &validator) {
+
+	// Get frame's opcode, is final frame, and is compressed
+	const uint8_t *data = frame.data();
+	const WebSocket::Opcode opcode = static_cast<WebSocket::Opcode>(data[WebSocket::OPCODE_BYTE_OFFSET] & WebSocket::OPCODE_BYTE_MASK);
+	const bool isFinalFrame = data[WebSocket::FINAL_FRAME_BYTE_OFFSET] & WebSocket::FINAL_FRAME_BYTE_MASK;
+	const bool isCompressed = data[WebSocket::EXTENSION_BYTE_OFFSET] & WebSocket::COMPRESSED_EXTENSION_BYTE_MASK;
+
+	// Check if frame isn't a masked final text frame
+	if(opcode != WebSocket::Opcode::TEXT || !isFinalFrame || !(data[WebSocket::MASK_BYTE_OFFSET] & WebSocket::MASK_BYTE_MASK)) {
+
+		// Return false
+		return false;
+	}
+
+	// Get real length and mask offset
+	uint64_t realLength = data[WebSocket::LENGTH_BYTE_OFFSET] & WebSocket::LENGTH_BYTE_MASK;
+	size_t maskOffset = WebSocket::LENGTH_BYTE_OFFSET + sizeof(uint8_t);
+
+	// Check if real length is expressed by the next sixteen or sixty-three bits
+	if(realLength == WebSocket::SIXTEEN_BITS_LENGTH || realLength == WebSocket::SIXTY_THREE_BITS_LENGTH) {
+
+		// Go through all real length bytes
+		const size_t lengthSize = (realLength == WebSocket::SIXTEEN_BITS_LENGTH) ? sizeof(uint16_t) : sizeof(uint64_t);
+		realLength = 0;
+		for(size_t i = 0; i < lengthSize; ++i) {
+
+			// Include length byte in real length
+			realLength |= static_cast<uint64_t>(data[WebSocket::LENGTH_BYTE_OFFSET + lengthSize - sizeof(uint8_t) * i]) << (Common::BITS_IN_A_BYTE * i);
+		}
+
+		// Update mask offset
+		maskOffset += lengthSize;
+	}
+
+	// Check if frame doesn't contain the mask and data
+	if(frame.size() < maskOffset + WebSocket::MASK_LENGTH + realLength) {
+
+		// Return false
+		return false;
+	}
+
+	// Check if frame is compressed
+	if(isCompressed) {
+
+		// Check if unmasking the data failed
+		string compressedMessage(realLength, '\0');
+		if(!WebSocket::unmask(reinterpret_cast<uint8_t *>(compressedMessage.data()), &data[maskOffset + WebSocket::MASK_LENGTH], realLength, &data[maskOffset], nullptr)) {
+
+			// Return false
+			return false;
+		}
+
+		// Append compressed message tail to the compressed message
+		compressedMessage.append(WebSocket::COMPRESSED_MESSAGE_TAIL.begin(), WebSocket::COMPRESSED_MESSAGE_TAIL.end());
+
+		// Return if inflating and validating the compressed message was successful
+		return Common::inflateUtf8(message, compressedMessage);
+	}
+
+	// Check if unmasking and validating the data failed
+	message.resize(realLength);
+	if(!WebSocket::unmask(reinterpret_cast<uint8_t *>(message.data()), &data[maskOffset + WebSocket::MASK_LENGTH], realLength, &data[maskOffset], &validator)) {
+
+		// Return false
+		return false;
+	}
+
+	// Return if message is complete UTF-8
+	return validator.isComplete();
+}
+
+// Run benchmark
+bool runBenchmark(const char *name, const string &corpus, size_t bytesPerOperation, const function<bool()> &operation) {
+
+	// Check if benchmark doesn't match the filter
+	if(!filter.empty() && (string(name) + '/' + corpus).find(filter) == string::npos) {
+
+		// Return true
+		return true;
+	}
+
+	// Check if warming up failed
+	if(!operation()) {
+
+		// Display message
+		cerr << name << '/' << corpus << " failed" << endl;
+
+		// Return false
+		return false;
+	}
+
+	// Go through all batches until the minimum duration has passed
+	uint64_t iterations = 0;
+	chrono::steady_clock::duration duration(0);
+	const uint64_t startNumberOfAllocations = numberOfAllocations.load(memory_order_relaxed);
+	for(uint64_t batchSize = 1; duration < minimumDuration; batchSize *= 2) {
+
+		// Go through all iterations in the batch
+		const chrono::steady_clock::time_point startTime = chrono::steady_clock::now();
+		for(uint64_t i = 0; i < batchSize; ++i) {
+
+			// Check if running operation failed
+			if(!operation()) {
+
+				// Display message
+				cerr << name << '/' << corpus << " failed" << endl;
+
+				// Return false
+				return false;
+			}
+		}
+
+		// Update duration and iterations
+		duration += chrono::steady_clock::now() - startTime;
+		iterations += batchSize;
+	}
+
+	// Display result
+	displayResult(name, corpus, iterations, duration, bytesPerOperation * iterations, numberOfAllocations.load(memory_order_relaxed) - startNumberOfAllocations);
+
+	// Return true
+	return true;
+}
+
+// Run replay
+bool runReplay(const char *path, unsigned long long speed) {
+
+	// Try
+	unique_ptr<Recorder::Reader> reader;
+	try {
+
+		// Create reader
+		reader = make_unique<Recorder::Reader>(path);
+	}
+
+	// Catch errors
+	catch(const runtime_error &error) {
+
+		// Display message
+		cerr << path << ": " << error.what() << endl;
+
+		// Return false
+		return false;
+	}
+
+	// Go through all records
+	vector<vector<uint8_t>> clientFrames;
+	Recorder::Record record;
+	while(reader->read(record)) {
+
+		// Check if record is a client message
+		if(record.type == Recorder::Type::CLIENT_MESSAGE) {
+
+			// Append client frame for the message to the client frames so that replaying it includes parsing the frame
+			clientFrames.push_back(createClientFrame(string(record.payload), record.compressed));
+		}
+	}
+
+	// Initialize iterations, durations, bytes, and allocations for each record type
+	uint64_t iterations[static_cast<size_t>(Recorder::Type::NUMBER_OF_TYPES)] = {};
+	chrono::steady_clock::duration durations[static_cast<size_t>(Recorder::Type::NUMBER_OF_TYPES)] = {};
+	uint64_t bytes[static_cast<size_t>(Recorder::Type::NUMBER_OF_TYPES)] = {};
+	uint64_t allocations[static_cast<size_t>(Recorder::Type::NUMBER_OF_TYPES)] = {};
+
+	// Initialize compression policies for each connection (the recorded messages were already large enough to compress)
+	unordered_map<uint64_t, WebSocket::CompressionPolicy> compressionPolicies;
+
+	// Go through all passes until the minimum duration has passed when replaying at unlimited speed or once otherwise
+	const chrono::steady_clock::time_point startTime = chrono::steady_clock::now();
+	do {
+
+		// Go through all records
+		reader->rewind();
+		const chrono::steady_clock::time_point passStartTime = chrono::steady_clock::now();
+		for(size_t clientFrameIndex = 0; reader->read(record);) {
+
+			// Check if replaying in real time
+			if(speed != UNLIMITED_REPLAY_SPEED) {
+
+				// Wait until the record is due
+				this_thread::sleep_until(passStartTime + chrono::duration_cast<chrono::steady_clock::duration>(record.time / speed));
+			}
+
+			// Check record's type
+			bool succeeded = true;
+			const chrono::steady_clock::time_point operationStartTime = chrono::steady_clock::now();
+			const uint64_t startNumberOfAllocations = numberOfAllocations.load(memory_order_relaxed);
+			switch(record.type) {
+
+				// POST request
+				case Recorder::Type::POST_REQUEST:
+
+					// Encode body into an interaction request like the gateway
+					{
+						const string request = INTERACTION_REQUEST_TEMPLATE.fill(static_cast<Json::Number>(1), "abcdefghijklmnopqrstuvwxyz234567abcdefghijklmnopqrstuvwx", Recorder::getPostRequestField(record, Recorder::PostRequestField::URI), Recorder::getPostRequestField(record, Recorder::PostRequestField::CONTENT_TYPE), Json::base64Encode(vector<uint8_t>(record.payload.begin(), record.payload.end())));
+
+						// Do not optimize request
+						doNotOptimize(request);
+					}
+
+					// Break
+					break;
+
+				// Client message
+				case Recorder::Type::CLIENT_MESSAGE:
+
+					// Parse client frame and decode its message like the gateway
+					{
+						string message;
+						Unicode::Utf8Validator validator;
+						ControlMessage controlMessage;
+						InteractionMessage interactionMessage;
+						succeeded = parseClientFrame(message, clientFrames[clientFrameIndex++], validator) && CLIENT_MESSAGE_DECODER.decodeValidUtf8(message, controlMessage, interactionMessage);
+
+						// Do not optimize decoded messages
+						doNotOptimize(controlMessage);
+						doNotOptimize(interactionMessage);
+					}
+
+					// Break
+					break;
+
+				// Server message
+				case Recorder::Type::SERVER_MESSAGE:
+
+					// Create WebSocket response for the message with its connection's compression policy like the gateway
+					try {
+						const vector<uint8_t> response = WebSocket::createResponse(string(record.payload), WebSocket::Opcode::TEXT, record.compressed ? &compressionPolicies.try_emplace(record.connectionId, 0).first->second : nullptr, record.connectionId);
+
+						// Do not optimize response
+						doNotOptimize(response);
+					}
+
+					// Catch errors
+					catch(...) {
+
+						// Set succeeded to false
+						succeeded = false;
+					}
+
+					// Break
+					break;
+
+				// Default
+				default:
+
+					// Break
+					break;
+			}
+
+			// Check if replaying record failed
+			if(!succeeded) {
+
+				// Display message
+				cerr << REPLAY_BENCHMARK_NAMES[static_cast<size_t>(record.type)] << '/' << path << " failed" << endl;
+
+				// Return false
+				return false;
+			}
+
+			// Update record type's iterations, duration, bytes, and allocations
+			const size_t type = static_cast<size_t>(record.type);
+			++iterations[type];
+			durations[type] += chrono::steady_clock::now() - operationStartTime;
+			bytes[type] += record.payload.size();
+			allocations[type] += numberOfAllocations.load(memory_order_relaxed) - startNumberOfAllocations;
+		}
+
+	} while(speed == UNLIMITED_REPLAY_SPEED && chrono::steady_clock::now() - startTime < minimumDuration);
+
+	// Go through all record types
+	for(size_t i = 0; i < static_cast<size_t>(Recorder::Type::NUMBER_OF_TYPES); ++i) {
+
+		// Check if record type was replayed and matches the filter
+		if(iterations[i] && (filter.empty() || (string(REPLAY_BENCHMARK_NAMES[i]) + '/' + path).find(filter) != string::npos)) {
+
+			// Display result
+			displayResult(REPLAY_BENCHMARK_NAMES[i], path, iterations[i], durations[i], bytes[i], allocations[i]);
+		}
+	}
+
+	// Return true
+	return true;
+}
+
+// Display result
+void displayResult(const char *name, const string &corpus, uint64_t iterations, chrono::steady_clock::duration duration, uint64_t bytes, uint64_t allocations) {
+
+	// Get results
+	const Json::Number nanosecondsPerOperation = static_cast<Json::Number>(chrono::duration_cast<chrono::nanoseconds>(duration).count()) / iterations;
+	const Json::Number bytesPerSecond = static_cast<Json::Number>(bytes) * chrono::nanoseconds(chrono::seconds(1)).count() / max(static_cast<Json::Number>(chrono::duration_cast<chrono::nanoseconds>(duration).count()), static_cast<Json::Number>(1));
+	const Json::Number allocationsPerOperation = static_cast<Json::Number>(allocations) / iterations;
+
+	// Display result
+	cout << BENCHMARK_RESULT_TEMPLATE.fill(name, corpus, static_cast<Json::Number>(iterations), round(nanosecondsPerOperation), round(bytesPerSecond), allocationsPerOperation) << endl;
+}
@@ -0,0 +1,180 @@
+// Header files
+#include <memory>
+#include <stdexcept>
+#include "cache.h"
+#include "openssl/sha.h"
+
+using namespace std;
+
+
+// Supporting function implementation
+
+// Constructor
+Cache::Cache(size_t maximumSize) :
+
+	// Set maximum size
+	maximumSize(maximumSize),
+
+	// Set size
+	size(0),
+
+	// Set hits
+	hits(0),
+
+	// Set misses
+	misses(0)
+{
+}
+
+// Destructor
+Cache::~Cache() {
+
+	// Go through all entries
+	for(list<pair<string, evbuffer *>>::const_iterator i = entries.cbegin(); i != entries.cend(); ++i) {
+
+		// Free entry's buffer
+		evbuffer_free(i->second);
+	}
+}
+
+// Get key
+string Cache::getKey(const string_view &data, const char *encoding) {
+
+	// Check if getting SHA256 hash of data failed
+	uint8_t hash[SHA256_DIGEST_LENGTH];
+	if(!SHA256(reinterpret_cast<const unsigned char *>(data.data()), data.length(), hash)) {
+
+		// Throw exception
+		throw runtime_error("Failed to hash data");
+	}
+
+	// Return hash followed by the encoding
+	return string(reinterpret_cast<const char *>(hash), sizeof(hash)) + encoding;
+}
+
+// Reference
+bool Cache::reference(evbuffer *output, const string &key) {
+
+	// Check if key isn't cached
+	const unordered_map<string, list<pair<string, evbuffer *>>::iterator>::const_iterator entry = index.find(key);
+	if(entry == index.cend()) {
+
+		// Increment misses
+		++misses;
+
+		// Return false
+		return false;
+	}
+
+	// Check if appending a reference to the entry's buffer to the output failed
+	if(evbuffer_add_buffer_reference(output, entry->second->second)) {
+
+		// Increment misses
+		++misses;
+
+		// Return false
+		return false;
+	}
+
+	// Move entry to the front of the entries
+	entries.splice(entries.begin(), entries, entry->second);
+
+	// Increment hits
+	++hits;
+
+	// Return true
+	return true;
+}
+
+// Add
+bool Cache::add(const string &key, evbuffer *buffer) {
+
+	// Check if buffer is too large to cache or key is already cached
+	const size_t length = evbuffer_get_length(buffer);
+	if(length > maximumSize || index.count(key)) {
+
+		// Return true
+		return true;
+	}
+
+	// Check if creating entry's buffer failed
+	unique_ptr<evbuffer, decltype(&evbuffer_free)> entryBuffer(evbuffer_new(), evbuffer_free);
+	if(!entryBuffer) {
+
+		// Return false
+		return false;
+	}
+
+	// Check if moving buffer's data to the entry's buffer failed
+	if(evbuffer_add_buffer(entryBuffer.get(), buffer)) {
+
+		// Return false
+		return false;
+	}
+
+	// Check if appending a reference to the entry's buffer to the buffer failed
+	if(evbuffer_add_buffer_reference(buffer, entryBuffer.get())) {
+
+		// Return if moving entry's buffer's data back to the buffer was successful
+		return !evbuffer_add_buffer(buffer, entryBuffer.get());
+	}
+
+	// Loop while adding the entry would exceed the maximum size
+	while(size + length > maximumSize) {
+
+		// Remove least recently used entry from the index
+		index.erase(entries.back().first);
+
+		// Update size
+		size -= evbuffer_get_length(entries.back().second);
+
+		// Free least recently used entry's buffer
+		evbuffer_free(entries.back().second);
+
+		// Remove least recently used entry
+		entries.pop_back();
+	}
+
+	// Add entry to the front of the entries
+	entries.emplace_front(key, entryBuffer.get());
+
+	// Release entry's buffer
+	entryBuffer.release();
+
+	// Add entry to the index
+	index.emplace(key, entries.begin());
+
+	// Update size
+	size += length;
+
+	// Return true
+	return true;
+}
+
+// Get hits
+uint64_t Cache::getHits() const {
+
+	// Return hits
+	return hits;
+}
+
+// Get misses
+uint64_t Cache::getMisses() const {
+
+	// Return misses
+	return misses;
+}
+
+// Get size
+size_t Cache::getSize() const {
+
+	// Return size
+	return size;
+}
+
+// Get maximum size
+size_t Cache::getMaximumSize() const {
+
+	// Return maximum size
+	return maximumSize;
+}
@@ -0,0 +1,81 @@
+// Header guard
+#ifndef CACHE_H
+#define CACHE_H
+
+
+// Header files
+#include <cstdint>
+#include <list>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include "event2/buffer.h"
+
+using namespace std;
+
+
+// Classes
+
+// Cache class
+class Cache final {
+
+	// Public
+	public:
+
+		// Constructor
+		explicit Cache(size_t maximumSize);
+
+		// Copy constructor
+		Cache(const Cache &other) = delete;
+
+		// Destructor
+		~Cache();
+
+		// Copy assignment operator
+		Cache &operator=(const Cache &other) = delete;
+
+		// Get key
+		static string getKey(const string_view &data, const char *encoding);
+
+		// Reference
+		bool reference(evbuffer *output, const string &key);
+
+		// Add
+		bool add(const string &key, evbuffer *buffer);
+
+		// Get hits
+		uint64_t getHits() const;
+
+		// Get misses
+		uint64_t getMisses() const;
+
+		// Get size
+		size_t getSize() const;
+
+		// Get maximum size
+		size_t getMaximumSize() const;
+
+	// Private
+	private:
+
+		// Maximum size
+		size_t maximumSize;
+
+		// Size
+		size_t size;
+
+		// Hits
+		uint64_t hits;
+
+		// Misses
+		uint64_t misses;
+
+		// Entries
+		list<pair<string, evbuffer *>> entries;
+
+		// Index
+		unordered_map<string, list<pair<string, evbuffer *>>::iterator> index;
+};
+
+
+#endif
@@ -1,7 +1,11 @@
 // Header files
 #include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <memory>
 #include <stdexcept>
+#include <thread>
+#include "base64.h"
 #include "common.h"
 #include "openssl/sha.h"
 #include "zlib.h"
@@ -47,6 +51,12 @@ const uint8_t Common::DEFLATE_BFINAL_FLAG = 0x00;
 // Chunk size
 const size_t Common::CHUNK_SIZE = 1 * BYTES_IN_A_KILOBYTE;
 
+// Base64 block size
+const size_t Common::BASE64_BLOCK_SIZE = 16 * BYTES_IN_A_KILOBYTE;
+
+// Reserved space size
+const size_t Common::RESERVED_SPACE_SIZE = 16 * BYTES_IN_A_KILOBYTE;
+
 // Window bits
 const int Common::WINDOWS_BITS = MAX_WBITS;
 
@@ -59,6 +69,36 @@ const int Common::GZIP_FLAG = 0x10;
 // Maximum decompress size
 const size_t Common::MAXIMUM_DECOMPRESS_SIZE = 10 * KILOBYTE_IN_A_MEGABYTE * BYTES_IN_A_KILOBYTE;
 
+// Maximum pooled streams
+const size_t Common::MAXIMUM_POOLED_STREAMS = 8;
+
+// Parallel gzip threshold
+const size_t Common::PARALLEL_GZIP_THRESHOLD = 1 * KILOBYTE_IN_A_MEGABYTE * BYTES_IN_A_KILOBYTE;
+
+// Parallel gzip block size
+const size_t Common::PARALLEL_GZIP_BLOCK_SIZE = 128 * BYTES_IN_A_KILOBYTE;
+
+// Parallel gzip dictionary size
+const size_t Common::PARALLEL_GZIP_DICTIONARY_SIZE = 32 * BYTES_IN_A_KILOBYTE;
+
+// Maximum parallel gzip threads
+const unsigned int Common::MAXIMUM_PARALLEL_GZIP_THREADS = MAXIMUM_POOLED_STREAMS;
+
+// Gzip header (ID1, ID2, CM deflate, no flags, no modification time, XFL maximum compression, OS unknown)
+const uint8_t Common::GZIP_HEADER[] = {0x1F, 0x8B, Z_DEFLATED, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0xFF};
+
+
+// Global variables
+
+// Deflate streams
+map<pair<int, int>, vector<z_stream *>> Common::deflateStreams;
+
+// Inflate streams
+map<int, vector<z_stream *>> Common::inflateStreams;
+
+// Streams lock
+mutex Common::streamsLock;
+
 
 // Supporting function implementation
 
@@ -148,8 +188,23 @@ bool Common::isNumeric(const string &text) {
 // Gzip
 bool Common::gzip(vector<uint8_t> &output, const vector<uint8_t> &input) {
 
-	// Return compressing input
-	return compress(output, input, WINDOWS_BITS | GZIP_FLAG);
+	// Check if creating buffer failed
+	unique_ptr<evbuffer, decltype(&evbuffer_free)> buffer(evbuffer_new(), evbuffer_free);
+	if(!buffer) {
+	
+		// Return false
+		return false;
+	}
+	
+	// Check if gzipping input into the buffer failed
+	if(!gzip(buffer.get(), input.data(), input.size())) {
+	
+		// Return false
+		return false;
+	}
+	
+	// Return appending buffer to the output
+	return appendBuffer(output, buffer.get());
 }
 
 // Inflate
@@ -166,132 +221,908 @@ bool Common::deflate(vector<uint8_t> &output, const vector<uint8_t> &input) {
 	return compress(output, input, WINDOWS_BITS * DEFLATE_SCALAR);
 }
 
-// Compress
-bool Common::compress(vector<uint8_t> &output, const vector<uint8_t> &input, int windowBits) {
+// Gzip
+bool Common::gzip(evbuffer *output, const uint8_t *input, size_t length) {
 
-	// Check if initializing stream failed
-	z_stream stream;
-	stream.zalloc = Z_NULL;
-	stream.zfree = Z_NULL;
-	stream.opaque = Z_NULL;
-	stream.avail_in = input.size();
-	stream.next_in = const_cast<uint8_t *>(input.data());
+	// Check if input is large enough to gzip in parallel
+	const unsigned int numberOfThreads = getNumberOfGzipThreads(length);
+	if(numberOfThreads > 1) {
 	
-	if(deflateInit2(&stream, Z_BEST_COMPRESSION, Z_DEFLATED, windowBits, MAX_MEM_LEVEL, Z_DEFAULT_STRATEGY) != Z_OK) {
+		// Return gzipping input in parallel
+		return parallelGzip(output, input, length, numberOfThreads);
+	}
+
+	// Return compressing input
+	return compress(output, input, length, WINDOWS_BITS | GZIP_FLAG, Z_BEST_COMPRESSION);
+}
+
+// Inflate
+bool Common::inflate(evbuffer *output, const uint8_t *input, size_t length) {
+
+	// Return decompressing input
+	return decompress(output, input, length, WINDOWS_BITS * DEFLATE_SCALAR);
+}
+
+// Deflate
+bool Common::deflate(evbuffer *output, const uint8_t *input, size_t length, int level) {
+
+	// Return compressing input
+	return compress(output, input, length, WINDOWS_BITS * DEFLATE_SCALAR, level);
+}
+
+// Inflate UTF-8
+bool Common::inflateUtf8(string &output, const string_view &input) {
+
+	// Check if borrowing stream failed
+	z_stream *stream = borrowInflateStream(WINDOWS_BITS * DEFLATE_SCALAR);
+	if(!stream) {
 	
 		// Return false
 		return false;
 	}
 	
+	// Set stream to inflate input
+	stream->avail_in = input.length();
+	stream->next_in = reinterpret_cast<uint8_t *>(const_cast<char *>(input.data()));
+	
 	// Go through all data
+	Unicode::Utf8Validator validator;
 	int result;
 	do {
 	
 		// Go through data in the current chunk
 		do {
 		
-			// Set stream to deflate chunk
-			uint8_t chunk[CHUNK_SIZE];
+			// Set stream to inflate chunk directly into the end of the output
+			const string::size_type outputLength = output.length();
+			output.resize(outputLength + CHUNK_SIZE);
 			
-			stream.avail_out = sizeof(chunk);
-			stream.next_out = chunk;
+			stream->avail_out = CHUNK_SIZE;
+			stream->next_out = reinterpret_cast<uint8_t *>(&output[outputLength]);
 			
-			// Check if error occurred while deflating chunk
-			result = ::deflate(&stream, Z_FINISH);
+			// Check if error occurred while inflating chunk
+			result = ::inflate(stream, Z_SYNC_FLUSH);
 			
 			if(result != Z_OK && result != Z_STREAM_END && result != Z_BUF_ERROR) {
 			
-				// End stream
-				deflateEnd(&stream);
-			
+				// Return stream
+				returnInflateStream(stream, WINDOWS_BITS * DEFLATE_SCALAR);
+				
 				// Return false
 				return false;
 			}
 			
-			// Append deflated chunk to output
-			output.insert(output.end(), chunk, chunk + sizeof(chunk) - stream.avail_out);
-		
-		} while(!stream.avail_out);
+			// Remove unused part of the chunk from the output
+			output.resize(outputLength + CHUNK_SIZE - stream->avail_out);
+			
+			// Check if inflated chunk isn't valid UTF-8 or output size is too large
+			if(!validator.update(&output[outputLength], output.length() - outputLength) || output.length() > MAXIMUM_DECOMPRESS_SIZE) {
+			
+				// Return stream
+				returnInflateStream(stream, WINDOWS_BITS * DEFLATE_SCALAR);
+				
+				// Return false
+				return false;
+			}
 		
-	} while(result != Z_STREAM_END && result != Z_BUF_ERROR && stream.avail_in);
+		} while(!stream->avail_out);
+	
+	} while(result != Z_STREAM_END && result != Z_BUF_ERROR && stream->avail_in);
+	
+	// Return stream
+	returnInflateStream(stream, WINDOWS_BITS * DEFLATE_SCALAR);
+	
+	// Return if output doesn't end in the middle of a character
+	return validator.isComplete();
+}
+
+// Parallel gzip
+bool Common::parallelGzip(evbuffer *output, const uint8_t *input, size_t length, unsigned int numberOfThreads) {
+
+	// Return gzipping input in parallel
+	return parallelGzip(output, length, numberOfThreads, [input](size_t start, size_t length, vector<uint8_t> &buffer) {
+	
+		// Return input at the start
+		return input + start;
+	});
+}
+
+// Base64 decode
+bool Common::base64Decode(evbuffer *output, const string_view &input) {
+
+	// Check if input is empty
+	if(input.empty()) {
+	
+		// Return true
+		return true;
+	}
+	
+	// Check if input's length is invalid
+	const size_t decodedLength = Base64::getDecodedLength(input.data(), input.length());
+	if(!decodedLength) {
+	
+		// Return false
+		return false;
+	}
+	
+	// Check if reserving space for the decoded input in the output failed
+	evbuffer_iovec space;
+	if(evbuffer_reserve_space(output, decodedLength, &space, 1) != 1 || space.iov_len < decodedLength) {
+	
+		// Return false
+		return false;
+	}
 	
-	// Check if ending stream failed
-	if(deflateEnd(&stream) != Z_OK) {
+	// Check if decoding input directly into the reserved space failed
+	if(!Base64::decode(reinterpret_cast<uint8_t *>(space.iov_base), input.data(), input.length())) {
 	
 		// Return false
 		return false;
 	}
 	
+	// Return if committing the decoded input to the output was successful
+	space.iov_len = decodedLength;
+	return !evbuffer_commit_space(output, &space, 1);
+}
+
+// Base64 decode and gzip
+bool Common::base64DecodeAndGzip(evbuffer *output, const string_view &input) {
+
+	// Check if input's length is invalid
+	if(input.length() % 4) {
+	
+		// Return false
+		return false;
+	}
+
+	// Check if decoded input is large enough to gzip in parallel
+	const size_t decodedLength = Base64::getDecodedLength(input.data(), input.length());
+	const unsigned int numberOfThreads = getNumberOfGzipThreads(decodedLength);
+	if(numberOfThreads > 1) {
+	
+		// Return gzipping decoded input in parallel with each worker only decoding its own blocks and their dictionaries
+		return parallelGzip(output, decodedLength, numberOfThreads, [&input](size_t start, size_t length, vector<uint8_t> &buffer) -> const uint8_t * {
+		
+			// Get the encoded groups that contain the decoded range
+			const string_view::size_type firstGroup = start / 3;
+			const string_view::size_type endGroup = (start + length + 2) / 3;
+			const string_view encodedRange = input.substr(firstGroup * 4, (endGroup - firstGroup) * 4);
+			
+			// Check if encoded range isn't at the end of the input and it contains padding
+			if(firstGroup * 4 + encodedRange.length() != input.length() && encodedRange.back() == '=') {
+			
+				// Return null
+				return nullptr;
+			}
+			
+			// Try
+			try {
+			
+				// Resize buffer to fit the decoded range
+				buffer.resize(Base64::getDecodedLength(encodedRange.data(), encodedRange.length()));
+			}
+			
+			// Catch errors
+			catch(...) {
+			
+				// Return null
+				return nullptr;
+			}
+			
+			// Check if decoding encoded range failed
+			if(!Base64::decode(buffer.data(), encodedRange.data(), encodedRange.length())) {
+			
+				// Return null
+				return nullptr;
+			}
+			
+			// Return decoded range's start in the buffer
+			return buffer.data() + start % 3;
+		});
+	}
+
+	// Check if borrowing stream failed
+	z_stream *stream = borrowDeflateStream(WINDOWS_BITS | GZIP_FLAG, Z_BEST_COMPRESSION);
+	if(!stream) {
+	
+		// Return false
+		return false;
+	}
+	
+	// Get length of the encoded blocks that fit in a decoded block
+	uint8_t block[BASE64_BLOCK_SIZE];
+	const string_view::size_type encodedBlockLength = sizeof(block) / 3 * 4;
+	
+	// Go through all blocks of the input
+	for(string_view::size_type i = 0;; i += encodedBlockLength) {
+	
+		// Get encoded block
+		const string_view encodedBlock = input.substr(i, encodedBlockLength);
+		
+		// Check if block is the last block
+		const bool lastBlock = i + encodedBlock.length() == input.length();
+		
+		// Check if block isn't the last block and it contains padding or decoding block failed
+		const size_t decodedBlockLength = encodedBlock.empty() ? 0 : Base64::getDecodedLength(encodedBlock.data(), encodedBlock.length());
+		if((!lastBlock && encodedBlock.back() == '=') || !Base64::decode(block, encodedBlock.data(), encodedBlock.length())) {
+		
+			// Return stream
+			returnDeflateStream(stream, WINDOWS_BITS | GZIP_FLAG, Z_BEST_COMPRESSION);
+			
+			// Return false
+			return false;
+		}
+		
+		// Set stream to deflate block
+		stream->avail_in = decodedBlockLength;
+		stream->next_in = block;
+		
+		// Go through all of the block's deflated data
+		int result;
+		do {
+		
+			// Check if reserving space in the output failed
+			evbuffer_iovec space;
+			if(evbuffer_reserve_space(output, RESERVED_SPACE_SIZE, &space, 1) != 1) {
+			
+				// Return stream
+				returnDeflateStream(stream, WINDOWS_BITS | GZIP_FLAG, Z_BEST_COMPRESSION);
+				
+				// Return false
+				return false;
+			}
+			
+			// Set stream to deflate into the reserved space
+			stream->avail_out = space.iov_len;
+			stream->next_out = reinterpret_cast<uint8_t *>(space.iov_base);
+			
+			// Check if error occurred while deflating block
+			result = ::deflate(stream, lastBlock ? Z_FINISH : Z_NO_FLUSH);
+			
+			if(result != Z_OK && result != Z_STREAM_END && result != Z_BUF_ERROR) {
+			
+				// Return stream
+				returnDeflateStream(stream, WINDOWS_BITS | GZIP_FLAG, Z_BEST_COMPRESSION);
+				
+				// Return false
+				return false;
+			}
+			
+			// Check if committing deflated data to the output failed
+			space.iov_len -= stream->avail_out;
+			if(evbuffer_commit_space(output, &space, 1)) {
+			
+				// Return stream
+				returnDeflateStream(stream, WINDOWS_BITS | GZIP_FLAG, Z_BEST_COMPRESSION);
+				
+				// Return false
+				return false;
+			}
+		
+		} while(!stream->avail_out || (lastBlock && result != Z_STREAM_END));
+		
+		// Check if block is the last block
+		if(lastBlock) {
+		
+			// Break
+			break;
+		}
+	}
+	
+	// Return stream
+	returnDeflateStream(stream, WINDOWS_BITS | GZIP_FLAG, Z_BEST_COMPRESSION);
+	
 	// Return true
 	return true;
 }
 
+// Borrow deflate stream
+z_stream *Common::borrowDeflateStream(int windowBits, int level) {
+
+	// Lock streams
+	unique_lock<mutex> lock(streamsLock);
+	
+	// Check if a pooled stream with the same parameters exists
+	vector<z_stream *> &streams = deflateStreams[{windowBits, level}];
+	if(!streams.empty()) {
+	
+		// Remove stream from the pool
+		z_stream *stream = streams.back();
+		streams.pop_back();
+		
+		// Return stream
+		return stream;
+	}
+	
+	// Unlock streams
+	lock.unlock();
+	
+	// Check if creating stream failed
+	z_stream *stream = new(nothrow) z_stream;
+	if(!stream) {
+	
+		// Return null
+		return nullptr;
+	}
+	
+	// Check if initializing stream failed
+	stream->zalloc = Z_NULL;
+	stream->zfree = Z_NULL;
+	stream->opaque = Z_NULL;
+	stream->avail_in = 0;
+	stream->next_in = Z_NULL;
+	
+	if(deflateInit2(stream, level, Z_DEFLATED, windowBits, MAX_MEM_LEVEL, Z_DEFAULT_STRATEGY) != Z_OK) {
+	
+		// Delete stream
+		delete stream;
+		
+		// Return null
+		return nullptr;
+	}
+	
+	// Return stream
+	return stream;
+}
+
+// Return deflate stream
+void Common::returnDeflateStream(z_stream *stream, int windowBits, int level) {
+
+	// Check if resetting stream was successful
+	if(deflateReset(stream) == Z_OK) {
+	
+		// Lock streams
+		lock_guard<mutex> lock(streamsLock);
+		
+		// Check if pool isn't full
+		vector<z_stream *> &streams = deflateStreams[{windowBits, level}];
+		if(streams.size() < MAXIMUM_POOLED_STREAMS) {
+		
+			// Add stream to the pool
+			streams.push_back(stream);
+			
+			// Return
+			return;
+		}
+	}
+	
+	// End stream
+	deflateEnd(stream);
+	
+	// Delete stream
+	delete stream;
+}
+
+// Borrow inflate stream
+z_stream *Common::borrowInflateStream(int windowBits) {
+
+	// Lock streams
+	unique_lock<mutex> lock(streamsLock);
+	
+	// Check if a pooled stream with the same parameters exists
+	vector<z_stream *> &streams = inflateStreams[windowBits];
+	if(!streams.empty()) {
+	
+		// Remove stream from the pool
+		z_stream *stream = streams.back();
+		streams.pop_back();
+		
+		// Return stream
+		return stream;
+	}
+	
+	// Unlock streams
+	lock.unlock();
+	
+	// Check if creating stream failed
+	z_stream *stream = new(nothrow) z_stream;
+	if(!stream) {
+	
+		// Return null
+		return nullptr;
+	}
+	
+	// Check if initializing stream failed
+	stream->zalloc = Z_NULL;
+	stream->zfree = Z_NULL;
+	stream->opaque = Z_NULL;
+	stream->avail_in = 0;
+	stream->next_in = Z_NULL;
+	
+	if(inflateInit2(stream, windowBits) != Z_OK) {
+	
+		// Delete stream
+		delete stream;
+		
+		// Return null
+		return nullptr;
+	}
+	
+	// Return stream
+	return stream;
+}
+
+// Return inflate stream
+void Common::returnInflateStream(z_stream *stream, int windowBits) {
+
+	// Check if resetting stream was successful
+	if(inflateReset(stream) == Z_OK) {
+	
+		// Lock streams
+		lock_guard<mutex> lock(streamsLock);
+		
+		// Check if pool isn't full
+		vector<z_stream *> &streams = inflateStreams[windowBits];
+		if(streams.size() < MAXIMUM_POOLED_STREAMS) {
+		
+			// Add stream to the pool
+			streams.push_back(stream);
+			
+			// Return
+			return;
+		}
+	}
+	
+	// End stream
+	inflateEnd(stream);
+	
+	// Delete stream
+	delete stream;
+}
+
+// Is SSSE3 supported
+bool Common::isSsse3Supported() {
+
+	// Check if x86-64
+	#if defined __x86_64__ || defined _M_X64
+	
+		// Initialize SSSE3 supported
+		static const bool ssse3Supported = []() -> bool {
+		
+			// Initialize CPU features
+			__builtin_cpu_init();
+			
+			// Return if the CPU supports SSSE3
+			return __builtin_cpu_supports("ssse3");
+		}();
+		
+		// Return SSSE3 supported
+		return ssse3Supported;
+	
+	// Otherwise
+	#else
+	
+		// Return false
+		return false;
+	#endif
+}
+
+// Is AVX2 supported
+bool Common::isAvx2Supported() {
+
+	// Check if x86-64
+	#if defined __x86_64__ || defined _M_X64
+	
+		// Initialize AVX2 supported
+		static const bool avx2Supported = []() -> bool {
+		
+			// Initialize CPU features
+			__builtin_cpu_init();
+			
+			// Return if the CPU supports AVX2
+			return __builtin_cpu_supports("avx2");
+		}();
+		
+		// Return AVX2 supported
+		return avx2Supported;
+	
+	// Otherwise
+	#else
+	
+		// Return false
+		return false;
+	#endif
+}
+
+// Compress
+bool Common::compress(vector<uint8_t> &output, const vector<uint8_t> &input, int windowBits) {
+
+	// Check if creating buffer failed
+	unique_ptr<evbuffer, decltype(&evbuffer_free)> buffer(evbuffer_new(), evbuffer_free);
+	if(!buffer) {
+	
+		// Return false
+		return false;
+	}
+	
+	// Check if compressing input into the buffer failed
+	if(!compress(buffer.get(), input.data(), input.size(), windowBits, Z_BEST_COMPRESSION)) {
+	
+		// Return false
+		return false;
+	}
+	
+	// Return appending buffer to the output
+	return appendBuffer(output, buffer.get());
+}
+
 // Decompress
 bool Common::decompress(vector<uint8_t> &output, const vector<uint8_t> &input, int windowBits) {
 
-	// Check if initializing stream failed
-	z_stream stream;
-	stream.zalloc = Z_NULL;
-	stream.zfree = Z_NULL;
-	stream.opaque = Z_NULL;
-	stream.avail_in = input.size();
-	stream.next_in = const_cast<uint8_t *>(input.data());
+	// Check if creating buffer failed
+	unique_ptr<evbuffer, decltype(&evbuffer_free)> buffer(evbuffer_new(), evbuffer_free);
+	if(!buffer) {
+	
+		// Return false
+		return false;
+	}
+	
+	// Check if decompressing input into the buffer failed
+	if(!decompress(buffer.get(), input.data(), input.size(), windowBits)) {
+	
+		// Return false
+		return false;
+	}
+	
+	// Return appending buffer to the output
+	return appendBuffer(output, buffer.get());
+}
+
+// Compress
+bool Common::compress(evbuffer *output, const uint8_t *input, size_t length, int windowBits, int level) {
+
+	// Check if borrowing stream failed
+	z_stream *stream = borrowDeflateStream(windowBits, level);
+	if(!stream) {
+	
+		// Return false
+		return false;
+	}
+	
+	// Check if reserving space for the largest possible deflated input in the output failed
+	const uLong bound = deflateBound(stream, length);
+	evbuffer_iovec space;
+	if(evbuffer_reserve_space(output, bound, &space, 1) != 1 || space.iov_len < bound) {
+	
+		// Return stream
+		returnDeflateStream(stream, windowBits, level);
+	
+		// Return false
+		return false;
+	}
+	
+	// Set stream to deflate input directly into the reserved space
+	stream->avail_in = length;
+	stream->next_in = const_cast<uint8_t *>(input);
+	stream->avail_out = bound;
+	stream->next_out = reinterpret_cast<uint8_t *>(space.iov_base);
+	
+	// Check if deflating input failed
+	if(::deflate(stream, Z_FINISH) != Z_STREAM_END) {
 	
-	if(inflateInit2(&stream, windowBits) != Z_OK) {
+		// Return stream
+		returnDeflateStream(stream, windowBits, level);
 	
 		// Return false
 		return false;
 	}
 	
+	// Get deflated input's length
+	space.iov_len = bound - stream->avail_out;
+	
+	// Return stream
+	returnDeflateStream(stream, windowBits, level);
+	
+	// Return if committing the deflated input to the output was successful
+	return !evbuffer_commit_space(output, &space, 1);
+}
+
+// Decompress
+bool Common::decompress(evbuffer *output, const uint8_t *input, size_t length, int windowBits) {
+
+	// Check if borrowing stream failed
+	z_stream *stream = borrowInflateStream(windowBits);
+	if(!stream) {
+	
+		// Return false
+		return false;
+	}
+	
+	// Set stream to inflate input
+	stream->avail_in = length;
+	stream->next_in = const_cast<uint8_t *>(input);
+	
 	// Go through all data
+	size_t outputLength = 0;
 	int result;
 	do {
 	
 		// Go through data in the current chunk
 		do {
 		
-			// Set stream to inflate chunk
-			uint8_t chunk[CHUNK_SIZE];
+			// Check if reserving space in the output failed
+			evbuffer_iovec space;
+			if(evbuffer_reserve_space(output, RESERVED_SPACE_SIZE, &space, 1) != 1) {
+			
+				// Return stream
+				returnInflateStream(stream, windowBits);
+				
+				// Return false
+				return false;
+			}
 			
-			stream.avail_out = sizeof(chunk);
-			stream.next_out = chunk;
+			// Set stream to inflate chunk directly into the reserved space
+			stream->avail_out = space.iov_len;
+			stream->next_out = reinterpret_cast<uint8_t *>(space.iov_base);
 			
 			// Check if error occurred while inflating chunk
-			result = ::inflate(&stream, Z_SYNC_FLUSH);
+			result = ::inflate(stream, Z_SYNC_FLUSH);
 			
 			if(result != Z_OK && result != Z_STREAM_END && result != Z_BUF_ERROR) {
 			
-				// End stream
-				inflateEnd(&stream);
+				// Return stream
+				returnInflateStream(stream, windowBits);
 				
 				// Return false
 				return false;
 			}
 			
-			// Append inflated chunk to output
-			output.insert(output.end(), chunk, chunk + sizeof(chunk) - stream.avail_out);
+			// Check if committing inflated chunk to the output failed or output size is too large
+			space.iov_len -= stream->avail_out;
+			outputLength += space.iov_len;
+			if(evbuffer_commit_space(output, &space, 1) || outputLength > MAXIMUM_DECOMPRESS_SIZE) {
 			
-			// Check if output size is too large
-			if(output.size() > MAXIMUM_DECOMPRESS_SIZE) {
-			
-				// End stream
-				inflateEnd(&stream);
+				// Return stream
+				returnInflateStream(stream, windowBits);
 				
 				// Return false
 				return false;
 			}
 		
-		} while(!stream.avail_out);
+		} while(!stream->avail_out);
+	
+	} while(result != Z_STREAM_END && result != Z_BUF_ERROR && stream->avail_in);
+	
+	// Return stream
+	returnInflateStream(stream, windowBits);
+	
+	// Return true
+	return true;
+}
+
+// Append buffer
+bool Common::appendBuffer(vector<uint8_t> &output, evbuffer *input) {
+
+	// Append space for the buffer to the output
+	const size_t inputLength = evbuffer_get_length(input);
+	const vector<uint8_t>::size_type outputLength = output.size();
+	output.resize(outputLength + inputLength);
 	
-	} while(result != Z_STREAM_END && result != Z_BUF_ERROR && stream.avail_in);
+	// Return if removing the buffer into the output was successful
+	return evbuffer_remove(input, output.data() + outputLength, inputLength) == static_cast<int>(inputLength);
+}
+
+// Get number of gzip threads
+unsigned int Common::getNumberOfGzipThreads(size_t length) {
+
+	// Check if length is too small to gzip in parallel
+	if(length < PARALLEL_GZIP_THRESHOLD) {
+	
+		// Return one
+		return 1;
+	}
+	
+	// Return number of hardware threads limited to the maximum
+	return max(min(thread::hardware_concurrency(), MAXIMUM_PARALLEL_GZIP_THREADS), 1U);
+}
+
+// Deflate block
+bool Common::deflateBlock(evbuffer *output, const uint8_t *input, size_t length, size_t dictionaryLength, bool lastBlock) {
+
+	// Check if borrowing stream failed
+	z_stream *stream = borrowDeflateStream(WINDOWS_BITS * DEFLATE_SCALAR, Z_BEST_COMPRESSION);
+	if(!stream) {
+	
+		// Return false
+		return false;
+	}
 	
-	// Check if ending stream failed
-	if(inflateEnd(&stream) != Z_OK) {
+	// Check if setting dictionary failed
+	if(dictionaryLength && deflateSetDictionary(stream, input - dictionaryLength, dictionaryLength) != Z_OK) {
 	
+		// Return stream
+		returnDeflateStream(stream, WINDOWS_BITS * DEFLATE_SCALAR, Z_BEST_COMPRESSION);
+		
 		// Return false
 		return false;
 	}
 	
+	// Set stream to deflate input
+	stream->avail_in = length;
+	stream->next_in = const_cast<uint8_t *>(input);
+	
+	// Go through all of the block's deflated data
+	const uLong bound = deflateBound(stream, length);
+	int result;
+	do {
+	
+		// Check if reserving space in the output failed
+		evbuffer_iovec space;
+		if(evbuffer_reserve_space(output, bound, &space, 1) != 1) {
+		
+			// Return stream
+			returnDeflateStream(stream, WINDOWS_BITS * DEFLATE_SCALAR, Z_BEST_COMPRESSION);
+			
+			// Return false
+			return false;
+		}
+		
+		// Set stream to deflate into the reserved space
+		stream->avail_out = space.iov_len;
+		stream->next_out = reinterpret_cast<uint8_t *>(space.iov_base);
+		
+		// Check if error occurred while deflating block
+		result = ::deflate(stream, lastBlock ? Z_FINISH : Z_SYNC_FLUSH);
+		
+		if(result != Z_OK && result != Z_STREAM_END && result != Z_BUF_ERROR) {
+		
+			// Return stream
+			returnDeflateStream(stream, WINDOWS_BITS * DEFLATE_SCALAR, Z_BEST_COMPRESSION);
+			
+			// Return false
+			return false;
+		}
+		
+		// Check if committing deflated data to the output failed
+		space.iov_len -= stream->avail_out;
+		if(evbuffer_commit_space(output, &space, 1)) {
+		
+			// Return stream
+			returnDeflateStream(stream, WINDOWS_BITS * DEFLATE_SCALAR, Z_BEST_COMPRESSION);
+			
+			// Return false
+			return false;
+		}
+	
+	} while(!stream->avail_out || (lastBlock && result != Z_STREAM_END));
+	
+	// Return stream
+	returnDeflateStream(stream, WINDOWS_BITS * DEFLATE_SCALAR, Z_BEST_COMPRESSION);
+	
 	// Return true
 	return true;
 }
+
+// Parallel gzip
+bool Common::parallelGzip(evbuffer *output, size_t length, unsigned int numberOfThreads, const function<const uint8_t *(size_t start, size_t length, vector<uint8_t> &buffer)> &getInput) {
+
+	// Get number of blocks
+	const size_t numberOfBlocks = max((length + PARALLEL_GZIP_BLOCK_SIZE - 1) / PARALLEL_GZIP_BLOCK_SIZE, static_cast<size_t>(1));
+	
+	// Go through all blocks
+	vector<unique_ptr<evbuffer, decltype(&evbuffer_free)>> deflatedBlocks;
+	deflatedBlocks.reserve(numberOfBlocks);
+	for(size_t i = 0; i < numberOfBlocks; ++i) {
+	
+		// Check if creating block's buffer failed
+		deflatedBlocks.emplace_back(evbuffer_new(), evbuffer_free);
+		if(!deflatedBlocks.back()) {
+		
+			// Return false
+			return false;
+		}
+	}
+	
+	// Initialize blocks' checksums
+	vector<uLong> blockChecksums(numberOfBlocks);
+	
+	// Initialize next block and error
+	atomic_size_t nextBlock(0);
+	atomic_bool error(false);
+	
+	// Create worker
+	const auto worker = [&]() {
+	
+		// Go through all unclaimed blocks while no errors occurred
+		vector<uint8_t> buffer;
+		for(size_t i = nextBlock++; i < numberOfBlocks && !error.load(); i = nextBlock++) {
+		
+			// Get block and its dictionary's length
+			const size_t blockStart = i * PARALLEL_GZIP_BLOCK_SIZE;
+			const size_t blockLength = min(length - blockStart, PARALLEL_GZIP_BLOCK_SIZE);
+			const size_t dictionaryLength = min(blockStart, PARALLEL_GZIP_DICTIONARY_SIZE);
+			
+			// Check if getting the block with the previous block's tail before it failed
+			const uint8_t *dictionary = getInput(blockStart - dictionaryLength, dictionaryLength + blockLength, buffer);
+			if(!dictionary) {
+			
+				// Set error
+				error.store(true);
+				
+				// Break
+				break;
+			}
+			
+			// Get block's checksum
+			const uint8_t *block = dictionary + dictionaryLength;
+			blockChecksums[i] = crc32(crc32(0, Z_NULL, 0), block, blockLength);
+			
+			// Check if deflating block with the previous block's tail as a dictionary failed
+			if(!deflateBlock(deflatedBlocks[i].get(), block, blockLength, dictionaryLength, i == numberOfBlocks - 1)) {
+			
+				// Set error
+				error.store(true);
+			}
+		}
+	};
+	
+	// Go through all additional threads
+	vector<thread> threads;
+	for(unsigned int i = 1; i < numberOfThreads && i < numberOfBlocks; ++i) {
+	
+		// Try
+		try {
+		
+			// Start thread
+			threads.emplace_back(worker);
+		}
+		
+		// Catch errors
+		catch(...) {
+		
+			// Break
+			break;
+		}
+	}
+	
+	// Deflate blocks on this thread as well
+	worker();
+	
+	// Go through all threads
+	for(thread &workerThread : threads) {
+	
+		// Join thread
+		workerThread.join();
+	}
+	
+	// Check if an error occurred
+	if(error.load()) {
+	
+		// Return false
+		return false;
+	}
+	
+	// Check if adding header to the output failed
+	if(evbuffer_add(output, GZIP_HEADER, sizeof(GZIP_HEADER))) {
+	
+		// Return false
+		return false;
+	}
+	
+	// Go through all blocks
+	uLong checksum = crc32(0, Z_NULL, 0);
+	for(size_t i = 0; i < numberOfBlocks; ++i) {
+	
+		// Combine block's checksum with the checksum
+		checksum = crc32_combine(checksum, blockChecksums[i], min(length - i * PARALLEL_GZIP_BLOCK_SIZE, PARALLEL_GZIP_BLOCK_SIZE));
+		
+		// Check if moving block's deflated data to the output failed
+		if(evbuffer_add_buffer(output, deflatedBlocks[i].get())) {
+		
+			// Return false
+			return false;
+		}
+	}
+	
+	// Go through all bytes in the checksum and input size
+	uint8_t trailer[sizeof(uint32_t) + sizeof(uint32_t)];
+	for(size_t i = 0; i < sizeof(uint32_t); ++i) {
+	
+		// Set trailer's bytes in little endian order
+		trailer[i] = checksum >> (BITS_IN_A_BYTE * i);
+		trailer[sizeof(uint32_t) + i] = length >> (BITS_IN_A_BYTE * i);
+	}
+	
+	// Return if adding trailer to the output was successful
+	return !evbuffer_add(output, trailer, sizeof(trailer));
+}
@@ -5,8 +5,15 @@
 
 // Header files
 #include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
 #include <string>
+#include <string_view>
 #include <vector>
+#include "event2/buffer.h"
+#include "unicode.h"
+#include "zlib.h"
 
 using namespace std;
 
@@ -53,6 +60,45 @@ class Common final {
 		// Deflate
 		static bool deflate(vector<uint8_t> &output, const vector<uint8_t> &input);
 		
+		// Gzip
+		static bool gzip(evbuffer *output, const uint8_t *input, size_t length);
+		
+		// Inflate
+		static bool inflate(evbuffer *output, const uint8_t *input, size_t length);
+		
+		// Deflate
+		static bool deflate(evbuffer *output, const uint8_t *input, size_t length, int level = Z_BEST_COMPRESSION);
+		
+		// Inflate UTF-8
+		static bool inflateUtf8(string &output, const string_view &input);
+		
+		// Parallel gzip
+		static bool parallelGzip(evbuffer *output, const uint8_t *input, size_t length, unsigned int numberOfThreads);
+		
+		// Base64 decode
+		static bool base64Decode(evbuffer *output, const string_view &input);
+		
+		// Base64 decode and gzip
+		static bool base64DecodeAndGzip(evbuffer *output, const string_view &input);
+		
+		// Borrow deflate stream
+		static z_stream *borrowDeflateStream(int windowBits, int level);
+		
+		// Return deflate stream
+		static void returnDeflateStream(z_stream *stream, int windowBits, int level);
+		
+		// Borrow inflate stream
+		static z_stream *borrowInflateStream(int windowBits);
+		
+		// Return inflate stream
+		static void returnInflateStream(z_stream *stream, int windowBits);
+		
+		// Is SSSE3 supported
+		static bool isSsse3Supported();
+		
+		// Is AVX2 supported
+		static bool isAvx2Supported();
+		
 		// Microseconds in a millisecond
 		static const int MICROSECONDS_IN_A_MILLISECOND;
 		
@@ -94,9 +140,33 @@ class Common final {
 		
 		// Decompress
 		static bool decompress(vector<uint8_t> &output, const vector<uint8_t> &input, int windowBits);
+		
+		// Compress
+		static bool compress(evbuffer *output, const uint8_t *input, size_t length, int windowBits, int level);
+		
+		// Decompress
+		static bool decompress(evbuffer *output, const uint8_t *input, size_t length, int windowBits);
+		
+		// Append buffer
+		static bool appendBuffer(vector<uint8_t> &output, evbuffer *input);
+		
+		// Get number of gzip threads
+		static unsigned int getNumberOfGzipThreads(size_t length);
+		
+		// Deflate block
+		static bool deflateBlock(evbuffer *output, const uint8_t *input, size_t length, size_t dictionaryLength, bool lastBlock);
+		
+		// Parallel gzip (gets each worker's input from start to start plus length, which it can place in the worker's buffer, and returns null if that failed)
+		static bool parallelGzip(evbuffer *output, size_t length, unsigned int numberOfThreads, const function<const uint8_t *(size_t start, size_t length, vector<uint8_t> &buffer)> &getInput);
 	
 		// Chunk size
 		static const size_t CHUNK_SIZE;
+		
+		// Base64 block size
+		static const size_t BASE64_BLOCK_SIZE;
+		
+		// Reserved space size
+		static const size_t RESERVED_SPACE_SIZE;
 
 		// Window bits
 		static const int WINDOWS_BITS;
@@ -109,6 +179,33 @@ class Common final {
 		
 		// Maximum decompress size
 		static const size_t MAXIMUM_DECOMPRESS_SIZE;
+		
+		// Maximum pooled streams
+		static const size_t MAXIMUM_POOLED_STREAMS;
+		
+		// Parallel gzip threshold
+		static const size_t PARALLEL_GZIP_THRESHOLD;
+		
+		// Parallel gzip block size
+		static const size_t PARALLEL_GZIP_BLOCK_SIZE;
+		
+		// Parallel gzip dictionary size
+		static const size_t PARALLEL_GZIP_DICTIONARY_SIZE;
+		
+		// Maximum parallel gzip threads
+		static const unsigned int MAXIMUM_PARALLEL_GZIP_THREADS;
+		
+		// Gzip header
+		static const uint8_t GZIP_HEADER[];
+		
+		// Deflate streams
+		static map<pair<int, int>, vector<z_stream *>> deflateStreams;
+		
+		// Inflate streams
+		static map<int, vector<z_stream *>> inflateStreams;
+		
+		// Streams lock
+		static mutex streamsLock;
 };
 
 
@@ -0,0 +1,438 @@
+// Header files
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include "common.h"
+#include "controller.h"
+
+// Extern C
+extern "C" {
+
+	// Header files
+	#include "feature/api/tor_api.h"
+}
+
+// Check if Windows
+#ifdef _WIN32
+
+	// Header files
+	#include <winsock2.h>
+
+// Otherwise
+#else
+
+	// Header files
+	#include <sys/socket.h>
+#endif
+
+using namespace std;
+
+
+// Constants
+
+// Mock controller default service ID
+static const char *MOCK_CONTROLLER_DEFAULT_SERVICE_ID = "mock";
+
+// Mock controller buffer size
+static const size_t MOCK_CONTROLLER_BUFFER_SIZE = 4096;
+
+// Mock controller split delay
+static const chrono::milliseconds MOCK_CONTROLLER_SPLIT_DELAY(1);
+
+// Check if Windows
+#ifdef _WIN32
+
+	// Mock controller socket family
+	static const int MOCK_CONTROLLER_SOCKET_FAMILY = AF_INET;
+
+	// Mock controller shutdown both
+	static const int MOCK_CONTROLLER_SHUTDOWN_BOTH = SD_BOTH;
+
+	// Mock controller send flags
+	static const int MOCK_CONTROLLER_SEND_FLAGS = 0;
+
+// Otherwise
+#else
+
+	// Mock controller socket family
+	static const int MOCK_CONTROLLER_SOCKET_FAMILY = AF_UNIX;
+
+	// Mock controller shutdown both
+	static const int MOCK_CONTROLLER_SHUTDOWN_BOTH = SHUT_RDWR;
+
+	// Check if sending can report a closed peer as an error instead of a broken pipe signal
+	#ifdef MSG_NOSIGNAL
+
+		// Mock controller send flags
+		static const int MOCK_CONTROLLER_SEND_FLAGS = MSG_NOSIGNAL;
+
+	// Otherwise
+	#else
+
+		// Mock controller send flags
+		static const int MOCK_CONTROLLER_SEND_FLAGS = 0;
+	#endif
+#endif
+
+
+// Supporting function implementation
+
+// Embedded Tor controller constructor
+EmbeddedTorController::EmbeddedTorController() :
+
+	// Set configuration
+	configuration(tor_main_configuration_new(), tor_main_configuration_free),
+
+	// Set control socket
+	controlSocket(EVUTIL_INVALID_SOCKET)
+{
+
+	// Check if creating configuration failed
+	if(!configuration) {
+
+		// Throw exception
+		throw runtime_error("Creating Tor configuration failed");
+	}
+
+	// Check if getting control socket failed
+	const tor_control_socket_t torControlSocket = tor_main_configuration_setup_control_socket(configuration.get());
+	if(torControlSocket == INVALID_TOR_CONTROL_SOCKET) {
+
+		// Throw exception
+		throw runtime_error("Getting Tor control socket failed");
+	}
+
+	// Set control socket
+	controlSocket = torControlSocket;
+}
+
+// Embedded Tor controller get control socket
+evutil_socket_t EmbeddedTorController::getControlSocket() const {
+
+	// Return control socket
+	return controlSocket;
+}
+
+// Embedded Tor controller configure
+bool EmbeddedTorController::configure(int argc, char *argv[]) {
+
+	// Return if configuring configuration with the arguments was successful
+	return !tor_main_configuration_set_command_line(configuration.get(), argc, argv);
+}
+
+// Embedded Tor controller run
+bool EmbeddedTorController::run() {
+
+	// Return if running Tor was successful
+	return tor_run_main(configuration.get()) == EXIT_SUCCESS;
+}
+
+// Embedded Tor controller stop
+void EmbeddedTorController::stop() {
+
+	// Tor stops itself when it receives a signal
+}
+
+// Mock controller constructor
+MockController::MockController(const string &settings) :
+
+	// Set sockets
+	sockets{EVUTIL_INVALID_SOCKET, EVUTIL_INVALID_SOCKET},
+
+	// Set delay milliseconds
+	delayMilliseconds(0),
+
+	// Set remaining polls
+	remainingPolls(0),
+
+	// Set split length
+	splitLength(0),
+
+	// Set service ID
+	serviceId(MOCK_CONTROLLER_DEFAULT_SERVICE_ID),
+
+	// Set stopped
+	stopped(false)
+{
+
+	// Go through all settings
+	for(string::size_type startOfSetting = 0, endOfSetting = settings.find(',', startOfSetting); startOfSetting < settings.length(); startOfSetting = (endOfSetting != string::npos) ? endOfSetting + sizeof(',') : string::npos, endOfSetting = settings.find(',', startOfSetting)) {
+
+		// Get setting
+		const string setting = Common::trim(settings.substr(startOfSetting, (endOfSetting != string::npos) ? endOfSetting - startOfSetting : string::npos));
+
+		// Check if setting isn't a key value pair
+		const string::size_type separator = setting.find('=');
+		if(separator == string::npos) {
+
+			// Throw exception
+			throw runtime_error("Invalid mock Tor setting -- '" + setting + '\'');
+		}
+
+		// Get key and value
+		const string key = Common::toLowerCase(Common::trim(setting.substr(0, separator)));
+		const string value = Common::trim(setting.substr(separator + sizeof('=')));
+
+		// Check if key is the failing command
+		if(key == "fail") {
+
+			// Check if value isn't a command
+			if(value != "authenticate" && value != "getinfo" && value != "add_onion") {
+
+				// Throw exception
+				throw runtime_error("Invalid mock Tor setting -- '" + setting + '\'');
+			}
+
+			// Set failing command
+			failingCommand = value;
+		}
+
+		// Otherwise check if key is the service ID
+		else if(key == "id") {
+
+			// Check if value isn't alphanumeric
+			if(value.empty() || !Common::isAlphanumeric(value)) {
+
+				// Throw exception
+				throw runtime_error("Invalid mock Tor setting -- '" + setting + '\'');
+			}
+
+			// Set service ID
+			serviceId = Common::toLowerCase(value);
+		}
+
+		// Otherwise
+		else {
+
+			// Check if value isn't numeric
+			if(!Common::isNumeric(value)) {
+
+				// Throw exception
+				throw runtime_error("Invalid mock Tor setting -- '" + setting + '\'');
+			}
+
+			// Initialize error occurred
+			bool errorOccurred = false;
+
+			// Try
+			unsigned long long number;
+			try {
+
+				// Get number from value
+				number = stoull(value);
+			}
+
+			// Catch errors
+			catch(...) {
+
+				// Set error occurred
+				errorOccurred = true;
+			}
+
+			// Check if an error occurred
+			if(errorOccurred) {
+
+				// Throw exception
+				throw runtime_error("Invalid mock Tor setting -- '" + setting + '\'');
+			}
+
+			// Check if key is the delay
+			if(key == "delay") {
+
+				// Set delay milliseconds
+				delayMilliseconds = number;
+			}
+
+			// Otherwise check if key is the polls
+			else if(key == "polls") {
+
+				// Set remaining polls
+				remainingPolls = number;
+			}
+
+			// Otherwise check if key is the split
+			else if(key == "split") {
+
+				// Set split length
+				splitLength = number;
+			}
+
+			// Otherwise
+			else {
+
+				// Throw exception
+				throw runtime_error("Invalid mock Tor setting -- '" + setting + '\'');
+			}
+		}
+
+		// Check if at the last setting
+		if(endOfSetting == string::npos) {
+
+			// Break
+			break;
+		}
+	}
+
+	// Check if creating sockets failed
+	if(evutil_socketpair(MOCK_CONTROLLER_SOCKET_FAMILY, SOCK_STREAM, 0, sockets)) {
+
+		// Throw exception
+		throw runtime_error("Creating mock Tor control socket failed");
+	}
+}
+
+// Mock controller destructor
+MockController::~MockController() {
+
+	// Close sockets
+	evutil_closesocket(sockets[0]);
+	evutil_closesocket(sockets[1]);
+}
+
+// Mock controller get control socket
+evutil_socket_t MockController::getControlSocket() const {
+
+	// Return control socket
+	return sockets[0];
+}
+
+// Mock controller configure
+bool MockController::configure(int argc, char *argv[]) {
+
+	// Return true
+	return true;
+}
+
+// Mock controller run
+bool MockController::run() {
+
+	// Loop until stopped
+	string received;
+	while(!stopped.load()) {
+
+		// Check if receiving data failed
+		char buffer[MOCK_CONTROLLER_BUFFER_SIZE];
+		const int length = recv(sockets[1], buffer, sizeof(buffer), 0);
+		if(length <= 0) {
+
+			// Return if stopped or the control socket was closed
+			return stopped.load() || !length;
+		}
+
+		// Append data to received
+		received.append(buffer, length);
+
+		// Go through all received commands
+		for(string::size_type endOfCommand = received.find('\n'); endOfCommand != string::npos; endOfCommand = received.find('\n')) {
+
+			// Get command
+			const string command = Common::trim(received.substr(0, endOfCommand));
+
+			// Remove command from received
+			received.erase(0, endOfCommand + sizeof('\n'));
+
+			// Wait for the delay
+			this_thread::sleep_for(chrono::milliseconds(delayMilliseconds));
+
+			// Check if sending command's reply failed
+			if(!sendReply(getReply(command))) {
+
+				// Return if stopped
+				return stopped.load();
+			}
+		}
+	}
+
+	// Return true
+	return true;
+}
+
+// Mock controller stop
+void MockController::stop() {
+
+	// Set stopped
+	stopped.store(true);
+
+	// Shutdown socket
+	shutdown(sockets[1], MOCK_CONTROLLER_SHUTDOWN_BOTH);
+}
+
+// Mock controller get reply
+string MockController::getReply(const string &command) {
+
+	// Get command's name
+	const string name = Common::toLowerCase(command.substr(0, command.find(' ')));
+
+	// Check if command is failing
+	if(name == failingCommand) {
+
+		// Return failure
+		return "551 Mock failure\r\n";
+	}
+
+	// Check if command is authenticate
+	if(name == "authenticate") {
+
+		// Return success
+		return "250 OK\r\n";
+	}
+
+	// Check if command is get info
+	if(name == "getinfo") {
+
+		// Check if polls remain
+		if(remainingPolls) {
+
+			// Decrement remaining polls
+			--remainingPolls;
+
+			// Return not connected
+			return "250-status/circuit-established=0\r\n250 OK\r\n";
+		}
+
+		// Return connected
+		return "250-status/circuit-established=1\r\n250 OK\r\n";
+	}
+
+	// Check if command is add Onion Service
+	if(name == "add_onion") {
+
+		// Return service ID
+		return "250-ServiceID=" + serviceId + "\r\n250 OK\r\n";
+	}
+
+	// Return unrecognized command
+	return "510 Unrecognized command\r\n";
+}
+
+// Mock controller send reply
+bool MockController::sendReply(const string &reply) const {
+
+	// Go through all parts of the reply
+	for(string::size_type i = 0; i < reply.length();) {
+
+		// Get part's length
+		const size_t partLength = splitLength ? min(splitLength, reply.length() - i) : reply.length() - i;
+
+		// Check if sending part failed
+		const int length = send(sockets[1], &reply[i], partLength, MOCK_CONTROLLER_SEND_FLAGS);
+		if(length <= 0) {
+
+			// Return false
+			return false;
+		}
+
+		// Update offset to next part
+		i += length;
+
+		// Check if splitting reply and more parts remain
+		if(splitLength && i < reply.length()) {
+
+			// Wait for the split delay so the part is received separately
+			this_thread::sleep_for(MOCK_CONTROLLER_SPLIT_DELAY);
+		}
+	}
+
+	// Return true
+	return true;
+}
@@ -0,0 +1,139 @@
+// Header guard
+#ifndef CONTROLLER_H
+#define CONTROLLER_H
+
+
+// Header files
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include "event2/util.h"
+
+using namespace std;
+
+
+// Structures
+
+// Tor main configuration structure
+struct tor_main_configuration_t;
+
+
+// Classes
+
+// Controller class
+class Controller {
+
+	// Public
+	public:
+
+		// Destructor
+		virtual ~Controller() = default;
+
+		// Get control socket
+		virtual evutil_socket_t getControlSocket() const = 0;
+
+		// Configure
+		virtual bool configure(int argc, char *argv[]) = 0;
+
+		// Run
+		virtual bool run() = 0;
+
+		// Stop
+		virtual void stop() = 0;
+};
+
+// Embedded Tor controller class
+class EmbeddedTorController final : public Controller {
+
+	// Public
+	public:
+
+		// Constructor
+		EmbeddedTorController();
+
+		// Get control socket
+		evutil_socket_t getControlSocket() const override;
+
+		// Configure
+		bool configure(int argc, char *argv[]) override;
+
+		// Run
+		bool run() override;
+
+		// Stop
+		void stop() override;
+
+	// Private
+	private:
+
+		// Configuration
+		unique_ptr<tor_main_configuration_t, void (*)(tor_main_configuration_t *)> configuration;
+
+		// Control socket
+		evutil_socket_t controlSocket;
+};
+
+// Mock controller class
+class MockController final : public Controller {
+
+	// Public
+	public:
+
+		// Constructor
+		explicit MockController(const string &settings);
+
+		// Copy constructor
+		MockController(const MockController &other) = delete;
+
+		// Destructor
+		~MockController();
+
+		// Copy assignment operator
+		MockController &operator=(const MockController &other) = delete;
+
+		// Get control socket
+		evutil_socket_t getControlSocket() const override;
+
+		// Configure
+		bool configure(int argc, char *argv[]) override;
+
+		// Run
+		bool run() override;
+
+		// Stop
+		void stop() override;
+
+	// Private
+	private:
+
+		// Get reply
+		string getReply(const string &command);
+
+		// Send reply
+		bool sendReply(const string &reply) const;
+
+		// Sockets
+		evutil_socket_t sockets[2];
+
+		// Delay milliseconds
+		uint64_t delayMilliseconds;
+
+		// Remaining polls
+		uint64_t remainingPolls;
+
+		// Split length
+		size_t splitLength;
+
+		// Failing command
+		string failingCommand;
+
+		// Service ID
+		string serviceId;
+
+		// Stopped
+		atomic_bool stopped;
+};
+
+
+#endif
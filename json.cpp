@@ -1,16 +1,48 @@
 // Header files
+#include <charconv>
 #include <cmath>
+#include <cstring>
 #include <iomanip>
+#include <sstream>
 #ifdef JSON_BASE64
-	#include <openssl/ssl.h>
+	#include "base64.h"
 #endif
-#include <sstream>
+#include "common.h"
 #include "json.h"
 #include "unicode.h"
 
+// Check if x86-64
+#if defined __x86_64__ || defined _M_X64
+
+	// Header files
+	#include <immintrin.h>
+#endif
+
 using namespace std;
 
 
+// Constants
+
+// Hexadecimal characters
+const char Json::HEXADECIMAL_CHARACTERS[] = "0123456789ABCDEF";
+
+
+// Function prototypes
+
+// Get unescaped length
+static size_t getUnescapedLength(const char *value, size_t length);
+
+// Check if x86-64
+#if defined __x86_64__ || defined _M_X64
+
+	// Get unescaped length SSE2
+	static size_t getUnescapedLengthSse2(const char *value, size_t length);
+	
+	// Get unescaped length AVX2
+	__attribute__((target("avx2"))) static size_t getUnescapedLengthAvx2(const char *value, size_t length);
+#endif
+
+
 // Supporting function implementation
 Json::Json() {
 
@@ -1182,8 +1214,8 @@ void Json::setStringValue(const String &value) {
 	// Clear
 	clear();
 	
-	// Check if escaped value isn't a valid UTF-8 string
-	if(!Unicode::isValidUtf8(escape(value)))
+	// Check if value isn't a valid string
+	if(!isValidString(value))
 	
 		// Throw exception
 		throw runtime_error("Invalid string");
@@ -1195,6 +1227,24 @@ void Json::setStringValue(const String &value) {
 	stringValue = value;
 }
 
+void Json::setStringValue(String &&value) {
+
+	// Clear
+	clear();
+	
+	// Check if value isn't a valid string
+	if(!isValidString(value))
+	
+		// Throw exception
+		throw runtime_error("Invalid string");
+
+	// Set type
+	setType(Type::STRING);
+	
+	// Set string value
+	stringValue = move(value);
+}
+
 void Json::setNumberValue(Number value) {
 
 	// Clear
@@ -1233,8 +1283,8 @@ void Json::setObjectValue(const Object &value) {
 	// Go through all key value pairs
 	for(const Object::value_type &object : value)
 	
-		// Check if escaped key value isn't a valid UTF-8 string
-		if(!Unicode::isValidUtf8(escape(object.first)))
+		// Check if key isn't a valid string
+		if(!isValidString(object.first))
 		
 			// Throw exception
 			throw runtime_error("Invalid object");
@@ -1272,20 +1322,29 @@ string Json::encode() const {
 	// Initialize return value
 	string returnValue;
 	
+	// Encode into return value
+	encode(returnValue);
+	
+	// Return return value
+	return returnValue;
+}
+
+void Json::encode(string &output) const {
+
 	// Check type
 	switch(type) {
 	
 		// String
 		case Type::STRING:
 		
-			// Append string starting character to return value
-			returnValue += '"';
+			// Append string starting character to output
+			output += '"';
 			
-			// Append string value to return value
-			returnValue += escape(stringValue);
+			// Append escaped string value to output
+			escape(output, stringValue);
 			
-			// Append string ending character to return value
-			returnValue += '"';
+			// Append string ending character to output
+			output += '"';
 			
 			// Break
 			break;
@@ -1293,13 +1352,8 @@ string Json::encode() const {
 		// Number
 		case Type::NUMBER:
 
-			{
-				// Append number value without trailing zeros and decimal points to return value
-				string formattedNumberValue = to_string(numberValue);
-				formattedNumberValue.erase(formattedNumberValue.find_last_not_of('0') + 1);
-				formattedNumberValue.erase(formattedNumberValue.find_last_not_of('.') + 1);
-				returnValue += formattedNumberValue;
-			}
+			// Append encoded number value to output
+			encodeNumber(output, numberValue);
 			
 			// Break
 			break;
@@ -1307,36 +1361,36 @@ string Json::encode() const {
 		// Object
 		case Type::OBJECT:
 		
-			// Append object starting character to return value
-			returnValue += '{';
+			// Append object starting character to output
+			output += '{';
 			
 			// Go through all pairs in the object value
 			for(Object::const_iterator i = objectValue.cbegin(); i != objectValue.cend(); ++i) {
 			
-				// Append string starting character to return value
-				returnValue += '"';
+				// Append string starting character to output
+				output += '"';
 				
-				// Append pair's key to return value
-				returnValue += escape(i->first);
+				// Append pair's escaped key to output
+				escape(output, i->first);
 				
-				// Append string ending character to return value
-				returnValue += '"';
+				// Append string ending character to output
+				output += '"';
 				
-				// Append key value separator to return value
-				returnValue += ':';
+				// Append key value separator to output
+				output += ':';
 				
-				// Append pair's encoded value to return value
-				returnValue += i->second->encode();
+				// Append pair's encoded value to output
+				i->second->encode(output);
 				
 				// Check if not at the last value
 				if(next(i) != objectValue.cend())
 				
-					// Append value separator to return value
-					returnValue += ',';
+					// Append value separator to output
+					output += ',';
 			}
 			
-			// Append object ending character to return value
-			returnValue += '}';
+			// Append object ending character to output
+			output += '}';
 			
 			// Break
 			break;
@@ -1344,24 +1398,24 @@ string Json::encode() const {
 		// Array
 		case Type::ARRAY:
 		
-			// Append array starting character to return value
-			returnValue += '[';
+			// Append array starting character to output
+			output += '[';
 			
 			// Go through all JSON values in the array value
 			for(Array::const_iterator i = arrayValue.cbegin(); i != arrayValue.cend(); ++i) {
 				
-				// Append encoded value to return value
-				returnValue += i->encode();
+				// Append encoded value to output
+				i->encode(output);
 				
 				// Check if not at the last value
 				if(next(i) != arrayValue.cend())
 				
-					// Append value separator to return value
-					returnValue += ',';
+					// Append value separator to output
+					output += ',';
 			}
 			
-			// Append array ending character to return value
-			returnValue += ']';
+			// Append array ending character to output
+			output += ']';
 			
 			// Break
 			break;
@@ -1369,8 +1423,8 @@ string Json::encode() const {
 		// Boolean
 		case Type::BOOLEAN:
 		
-			// Append boolean value to return value
-			returnValue += booleanValue ? "true" : "false";
+			// Append boolean value to output
+			output += booleanValue ? "true" : "false";
 			
 			// Break
 			break;
@@ -1378,8 +1432,8 @@ string Json::encode() const {
 		// NULL
 		case Type::NULL_VALUE:
 		
-			// Append NULL value to return value
-			returnValue += "null";
+			// Append NULL value to output
+			output += "null";
 			
 			// Break
 			break;
@@ -1391,8 +1445,29 @@ string Json::encode() const {
 			break;
 	}
 	
-	// Return return value
-	return returnValue;
+}
+
+void Json::encodeNumber(string &output, Number value) {
+
+	// Check if value is an integer that fits in an integer type and isn't negative zero
+	Number integerComponent;
+	if(modf(value, &integerComponent) == 0 && value > static_cast<Number>(INTMAX_MIN) && value < static_cast<Number>(INTMAX_MAX) && (value != 0 || !signbit(value))) {
+	
+		// Append integer to output
+		char buffer[sizeof("-9223372036854775808")];
+		const to_chars_result result = to_chars(buffer, buffer + sizeof(buffer), static_cast<intmax_t>(value));
+		output.append(buffer, result.ptr - buffer);
+	}
+	
+	// Otherwise
+	else {
+	
+		// Append number value without trailing zeros and decimal points to output
+		string formattedNumberValue = to_string(value);
+		formattedNumberValue.erase(formattedNumberValue.find_last_not_of('0') + 1);
+		formattedNumberValue.erase(formattedNumberValue.find_last_not_of('.') + 1);
+		output += formattedNumberValue;
+	}
 }
 
 bool Json::decode(const string &value, intmax_t maxDepth) {
@@ -1461,67 +1536,15 @@ bool Json::empty() const {
 			// Throw exception
 			throw runtime_error("Failed to encode value");
 		
-		// Initialize output
-		int outputSize = ((value.size() + ((value.size() % 3) ? (3 - value.size() % 3) : 0)) / 3) * 4;
-		uint8_t output[outputSize];
-
-		// Check if creating a base64 BIO failed
-		BIO *base64Bio = BIO_new(BIO_f_base64());
-		if(!base64Bio)
-		
-			// Throw exception
-			throw runtime_error("Failed to encode value");
-		
-		// Check if creating a memory BIO failed
-		BIO *memoryBio = BIO_new(BIO_s_mem());
-		if(!memoryBio) {
-		
-			// Free memory
-			BIO_free(base64Bio);
-		
-			// Throw exception
-			throw runtime_error("Failed to encode value");
-		}
-		
-		// Set flag
-		BIO_set_flags(base64Bio, BIO_FLAGS_BASE64_NO_NL);
-		
-		// Append the memory BIO to the base64 BIOS
-		BIO_push(base64Bio, memoryBio);
-		
-		// Check if encoding value failed, flushing the buffer failed, or moving value to output failed
-		int bytesRead;
-		if(BIO_write(base64Bio, value.data(), value.size()) <= 0 || BIO_flush(base64Bio) != 1 || (bytesRead = BIO_read(memoryBio, output, outputSize)) <= 0) {
-		
-			// Free memory
-			BIO_free(memoryBio);
-			BIO_free(base64Bio);
-		
-			// Throw exception
-			throw runtime_error("Failed to encode value");
-		}
-		
-		// Check if freeing memory failed
-		if(!BIO_free(memoryBio)) {
-		
-			// Free memory
-			BIO_free(base64Bio);
-			
-			// Throw exception
-			throw runtime_error("Failed to encode value");
-		}
-		
-		// Check if freeing memory failed
-		if(!BIO_free(base64Bio))
-			
-			// Throw exception
-			throw runtime_error("Failed to encode value");
+		// Encode value
+		string output(Base64::getEncodedLength(value.size()), '\0');
+		Base64::encode(output.data(), value.data(), value.size());
 		
 		// Return output
-		return {output, output + bytesRead};
+		return output;
 	}
 
-	vector<uint8_t> Json::base64Decode(const string &value) {
+	vector<uint8_t> Json::base64Decode(const string_view &value) {
 
 		// Check if value is empty
 		if(value.empty())
@@ -1529,73 +1552,15 @@ bool Json::empty() const {
 			// Throw exception
 			throw runtime_error("Failed to decode value");
 		
-		// Go through all characters in value
-		for(char character : value)
-		
-			// Check if character isn't valid base64
-			if(!isalnum(character) && character != '+' && character != '/' && character != '=')
-				
-				// Throw exception
-				throw runtime_error("Failed to decode value");
-		
-		// Initialize output
-		int outputSize = value.size() / 4 * 3 - ((value.back() == '=') ? ((value.size() >= 2 && value[value.size() - 2] == '=') ? 2 : 1) : 0);
-		uint8_t output[outputSize];
-
-		// Check if creating a base64 BIO failed
-		BIO *base64Bio = BIO_new(BIO_f_base64());
-		if(!base64Bio)
-		
-			// Throw exception
-			throw runtime_error("Failed to decode value");
-		
-		// Check if creating a memory BIO failed
-		BIO *memoryBio = BIO_new(BIO_s_mem());
-		if(!memoryBio) {
-		
-			// Free memory
-			BIO_free(base64Bio);
-		
-			// Throw exception
-			throw runtime_error("Failed to decode value");
-		}
+		// Check if decoding value failed
+		vector<uint8_t> output(Base64::getDecodedLength(value.data(), value.length()));
+		if(!Base64::decode(output.data(), value.data(), value.length()))
 		
-		// Set flag
-		BIO_set_flags(base64Bio, BIO_FLAGS_BASE64_NO_NL);
-		
-		// Append the memory BIO to the base64 BIOS
-		BIO_push(base64Bio, memoryBio);
-		
-		// Check if decoding value failed, flushing the buffer failed, or moving value to output failed
-		int bytesRead;
-		if(BIO_write(memoryBio, value.data(), value.size()) <= 0 || BIO_flush(base64Bio) != 1 || (bytesRead = BIO_read(base64Bio, output, outputSize)) <= 0) {
-		
-			// Free memory
-			BIO_free(memoryBio);
-			BIO_free(base64Bio);
-		
-			// Throw exception
-			throw runtime_error("Failed to decode value");
-		}
-		
-		// Check if freeing memory failed
-		if(!BIO_free(memoryBio)) {
-		
-			// Free memory
-			BIO_free(base64Bio);
-			
-			// Throw exception
-			throw runtime_error("Failed to decode value");
-		}
-		
-		// Check if freeing memory failed
-		if(!BIO_free(base64Bio))
-			
 			// Throw exception
 			throw runtime_error("Failed to decode value");
 		
 		// Return output
-		return {output, output + bytesRead};
+		return output;
 	}
 #endif
 
@@ -1681,22 +1646,34 @@ string Json::removeWhitespace(const string &value) {
 	return returnValue;
 }
 
-string Json::escape(const string &value) {
+void Json::escape(string &output, const string_view &value) {
 
-	// Initialize variables
-	string returnValue;
-	
 	// Go through all characters
-	for(char character : value)
+	for(string_view::size_type i = 0;; ++i) {
 	
+		// Get length of the characters that don't need to be escaped
+		const size_t unescapedLength = getUnescapedLength(value.data() + i, value.length() - i);
+		
+		// Append characters that don't need to be escaped to output
+		output.append(value.data() + i, unescapedLength);
+		
+		// Update index to the character that needs to be escaped
+		i += unescapedLength;
+		
+		// Check if at the end of the value
+		if(i == value.length())
+		
+			// Break
+			break;
+		
 		// Check character
-		switch(character) {
+		switch(value[i]) {
 		
 			// Double quote
 			case '"':
 			
-				// Append escaped character to return value
-				returnValue += "\\\"";
+				// Append escaped character to output
+				output += "\\\"";
 				
 				// Break
 				break;
@@ -1704,17 +1681,8 @@ string Json::escape(const string &value) {
 			// Backslash
 			case '\\':
 			
-				// Append escaped character to return value
-				returnValue += "\\\\";
-				
-				// Break
-				break;
-			
-			// Forward slash
-			case '/':
-			
-				// Append escaped character to return value
-				returnValue += "\\/";
+				// Append escaped character to output
+				output += "\\\\";
 				
 				// Break
 				break;
@@ -1722,8 +1690,8 @@ string Json::escape(const string &value) {
 			// Backspace
 			case '\b':
 			
-				// Append escaped character to return value
-				returnValue += "\\b";
+				// Append escaped character to output
+				output += "\\b";
 				
 				// Break
 				break;
@@ -1731,8 +1699,8 @@ string Json::escape(const string &value) {
 			// Form feed
 			case '\f':
 			
-				// Append escaped character to return value
-				returnValue += "\\f";
+				// Append escaped character to output
+				output += "\\f";
 				
 				// Break
 				break;
@@ -1740,8 +1708,8 @@ string Json::escape(const string &value) {
 			// Newline
 			case '\n':
 			
-				// Append escaped character to return value
-				returnValue += "\\n";
+				// Append escaped character to output
+				output += "\\n";
 				
 				// Break
 				break;
@@ -1749,8 +1717,8 @@ string Json::escape(const string &value) {
 			// Carriage return
 			case '\r':
 			
-				// Append escaped character to return value
-				returnValue += "\\r";
+				// Append escaped character to output
+				output += "\\r";
 				
 				// Break
 				break;
@@ -1758,251 +1726,312 @@ string Json::escape(const string &value) {
 			// Tab
 			case '\t':
 			
-				// Append escaped character to return value
-				returnValue += "\\t";
+				// Append escaped character to output
+				output += "\\t";
 				
 				// Break
 				break;
 			
 			// Other control characters
-			case '\0':
-			case '\x1':
-			case '\x2':
-			case '\x3':
-			case '\x4':
-			case '\x5':
-			case '\x6':
-			case '\x7':
-			case '\xB':
-			case '\xE':
-			case '\xF':
-			case '\x10':
-			case '\x11':
-			case '\x12':
-			case '\x13':
-			case '\x14':
-			case '\x15':
-			case '\x16':
-			case '\x17':
-			case '\x18':
-			case '\x19':
-			case '\x1A':
-			case '\x1B':
-			case '\x1C':
-			case '\x1D':
-			case '\x1E':
-			case '\x1F':
-			
-				{
-			
-					// Append escaped character to return value
-					stringstream escapedCharacter;
-					escapedCharacter << hex << uppercase << setfill('0') << setw(4) << static_cast<uint16_t>(character);
-					returnValue += "\\u" + escapedCharacter.str();
-				}
-				
-				// Break
-				break;
-			
-			// Default
 			default:
 			
-				// Append escaped character to return value
-				returnValue += character;
+				// Append escaped character to output
+				output += "\\u00";
+				output += HEXADECIMAL_CHARACTERS[static_cast<uint8_t>(value[i]) >> 4];
+				output += HEXADECIMAL_CHARACTERS[static_cast<uint8_t>(value[i]) & 0x0F];
 				
 				// Break
 				break;
 		}
-	
-	// Return return value
-	return returnValue;
+	}
 }
 
-string Json::unescape(const string &value) {
+string_view Json::unescape(const string_view &value, string &buffer) {
 
-	// Initialize variables
-	string returnValue;
-	char lastCharacter = '\0';
-	bool ignoreEscapeSequence = false;
+	// Check if value doesn't contain any escape sequences
+	if(!memchr(value.data(), '\\', value.length()))
+	
+		// Return value
+		return value;
+
+	// Clear buffer
+	buffer.clear();
+	buffer.reserve(value.length());
 	
 	// Go through all characters
-	for(string::size_type i = 0; i < value.length(); ++i) {
+	for(string_view::size_type i = 0; i < value.length(); ++i) {
 	
-		// Set character
-		const char &character = value[i];
+		// Get next escape sequence
+		const char *escapeSequence = reinterpret_cast<const char *>(memchr(value.data() + i, '\\', value.length() - i));
 		
-		// Check if last character is a backslash
-		if(!ignoreEscapeSequence && lastCharacter == '\\') {
+		// Get index of the escape sequence or the end of the value if there isn't one
+		const string_view::size_type escapeSequenceIndex = escapeSequence ? escapeSequence - value.data() : value.length();
+		
+		// Append characters before the escape sequence to buffer
+		buffer.append(value.data() + i, escapeSequenceIndex - i);
+		
+		// Check if there's no escape sequence or it's at the end of the value
+		if(escapeSequenceIndex + sizeof('\\') >= value.length())
 		
-			// Check character
-			switch(character) {
+			// Break
+			break;
+		
+		// Update index to the escaped character
+		i = escapeSequenceIndex + sizeof('\\');
+		
+		// Check escaped character
+		switch(value[i]) {
+		
+			// Double quote, backslash, or forward slash
+			case '"':
+			case '\\':
+			case '/':
 			
-				// Double quote, backslash, or forward slash
-				case '"':
-				case '\\':
-				case '/':
-				
-					// Append unescaped character to return value
-					returnValue += character;
-					
-					// Break
-					break;
+				// Append unescaped character to buffer
+				buffer += value[i];
 				
-				// Backspace
-				case 'b':
-				
-					// Append unescaped character to return value
-					returnValue += '\b';
-					
-					// Break
-					break;
-				
-				// Form feed
-				case 'f':
-				
-					// Append unescaped character to return value
-					returnValue += '\f';
-					
-					// Break
-					break;
+				// Break
+				break;
+			
+			// Backspace
+			case 'b':
+			
+				// Append unescaped character to buffer
+				buffer += '\b';
 				
-				// Newline
-				case 'n':
+				// Break
+				break;
+			
+			// Form feed
+			case 'f':
+			
+				// Append unescaped character to buffer
+				buffer += '\f';
 				
-					// Append unescaped character to return value
-					returnValue += '\n';
-					
-					// Break
-					break;
+				// Break
+				break;
+			
+			// Newline
+			case 'n':
+			
+				// Append unescaped character to buffer
+				buffer += '\n';
 				
-				// Carriage return
-				case 'r':
+				// Break
+				break;
+			
+			// Carriage return
+			case 'r':
+			
+				// Append unescaped character to buffer
+				buffer += '\r';
 				
-					// Append unescaped character to return value
-					returnValue += '\r';
-					
-					// Break
-					break;
+				// Break
+				break;
+			
+			// Tab
+			case 't':
+			
+				// Append unescaped character to buffer
+				buffer += '\t';
 				
-				// Tab
-				case 't':
+				// Break
+				break;
+			
+			// Escaped character
+			case 'u':
+			
+				{
 				
-					// Append unescaped character to return value
-					returnValue += '\t';
+					// Increment index
+					++i;
 					
-					// Break
-					break;
-				
-				// Escaped character
-				case 'u':
-				
-					{
+					// Initialie UTF-16 string
+					u16string utf16String;
 					
-						// Increment index
-						++i;
+					// Go through both potential surrogate pair values
+					for(uint8_t j = 0; j < 2; ++j) {
 						
-						// Initialie UTF-16 string
-						u16string utf16String;
+						// Check if the escape character has an invalid length
+						if(value.length() - i < sizeof("FFFF") - 1)
 						
-						// Go through both potential surrogate pair values
-						for(uint8_t j = 0; j < 2; ++j) {
-							
-							// Check if the escape character has an invalid length
-							if(value.length() - i < sizeof("FFFF") - 1)
+							// Throw exception
+							throw runtime_error("Invalid escaped character");
+						
+						// Go through all characters in the escape character
+						char16_t utf16Character = 0;
+						for(string_view::size_type k = i; k < i + sizeof("FFFF") - 1; ++k) {
+						
+							// Check if character isn't a hexadecimal character
+							if(!isxdigit(value[k]))
 							
 								// Throw exception
 								throw runtime_error("Invalid escaped character");
 							
-							// Go through all characters in the value
-							for(string::size_type k = i; k < i + sizeof("FFFF") - 1; ++k)
-							
-								// Check if character isn't a hexadecimal character
-								if(!isxdigit(value[k]))
-								
-									// Throw exception
-									throw runtime_error("Invalid escaped character");
-							
-							// Get UTF-16 code point
-							char16_t utf16Character = stoi(value.substr(i, sizeof("FFFF") - 1), nullptr, 16);
-							
+							// Include character in the UTF-16 code point
+							utf16Character = (utf16Character << 4) | (isdigit(value[k]) ? value[k] - '0' : tolower(value[k]) - 'a' + 10);
+						}
+						
+						// Check if UTF-16 code point is a single unpaired surrogate
+						if(j == 0 && utf16Character >= Unicode::UTF16_LOW_SURROGATE_RANGE_BEGIN && utf16Character <= Unicode::UTF16_LOW_SURROGATE_RANGE_END)
+						
+							// Throw exception
+							throw runtime_error("Invalid escaped character");
+						
+						// Check if previous UTF-16 code point is a single unpaired surrogate
+						if(j == 1 && (utf16Character < Unicode::UTF16_LOW_SURROGATE_RANGE_BEGIN || utf16Character > Unicode::UTF16_LOW_SURROGATE_RANGE_END))
+						
+							// Throw exception
+							throw runtime_error("Invalid escaped character");
+						
+						// Append code point to UTF-16 string
+						utf16String += utf16Character;
+						
+						// Increment index
+						i += sizeof("FFFF") - 1;
+						
+						// Check if code point is part of a surrogate pair
+						if(j == 0 && utf16Character >= Unicode::UTF16_HIGH_SURROGATE_RANGE_BEGIN && utf16Character <= Unicode::UTF16_HIGH_SURROGATE_RANGE_END && value.length() - i >= sizeof("\\u") - 1 && value[i] == '\\' && value[i + 1] == 'u')
+						
+							// Increment index
+							i += sizeof("\\u") - 1;
+						
+						// Otherwise
+						else {
+						
 							// Check if UTF-16 code point is a single unpaired surrogate
-							if(j == 0 && utf16Character >= Unicode::UTF16_LOW_SURROGATE_RANGE_BEGIN && utf16Character <= Unicode::UTF16_LOW_SURROGATE_RANGE_END)
+							if(j == 0 && utf16Character >= Unicode::UTF16_HIGH_SURROGATE_RANGE_BEGIN && utf16Character <= Unicode::UTF16_HIGH_SURROGATE_RANGE_END)
 							
 								// Throw exception
 								throw runtime_error("Invalid escaped character");
-							
-							// Check if previous UTF-16 code point is a single unpaired surrogate
-							if(j == 1 && (utf16Character < Unicode::UTF16_LOW_SURROGATE_RANGE_BEGIN || utf16Character > Unicode::UTF16_LOW_SURROGATE_RANGE_END))
-							
-								// Throw exception
-								throw runtime_error("Invalid escaped character");
-							
-							// Append code point to UTF-16 string
-							utf16String += utf16Character;
-							
-							// Increment index
-							i += sizeof("FFFF") - 1;
-							
-							// Check if code point is part of a surrogate pair
-							if(j == 0 && utf16Character >= Unicode::UTF16_HIGH_SURROGATE_RANGE_BEGIN && utf16Character <= Unicode::UTF16_HIGH_SURROGATE_RANGE_END && value.length() - i >= sizeof("\\u") - 1 && value[i] == '\\' && value[i + 1] == 'u')
-							
-								// Increment index
-								i += sizeof("\\u") - 1;
-							
-							// Otherwise
-							else {
-							
-								// Check if UTF-16 code point is a single unpaired surrogate
-								if(j == 0 && utf16Character >= Unicode::UTF16_HIGH_SURROGATE_RANGE_BEGIN && utf16Character <= Unicode::UTF16_HIGH_SURROGATE_RANGE_END)
-								
-									// Throw exception
-									throw runtime_error("Invalid escaped character");
-							
-								// Break
-								break;
-							}
-						}
 						
-						// Decrement index
-						--i;
-						
-						// Append code point to return value
-						returnValue += Unicode::utf16ToUtf8(utf16String);
+							// Break
+							break;
+						}
 					}
 					
-					// Break
-					break;
-			}
+					// Decrement index
+					--i;
+					
+					// Append code point to buffer
+					buffer += Unicode::utf16ToUtf8(utf16String);
+				}
+				
+				// Break
+				break;
 		}
+	}
+	
+	// Return buffer
+	return buffer;
+}
+
+vector<string> Json::createTemplateSegments(const vector<pair<string, Json>> &members) {
+
+	// Initialize segments
+	vector<string> segments(1);
+	
+	// Append object starting character to the segment
+	segments.back() += '{';
+	
+	// Go through all members
+	for(vector<pair<string, Json>>::const_iterator i = members.cbegin(); i != members.cend(); ++i) {
+	
+		// Check if not at the first member
+		if(i != members.cbegin())
 		
-		// Otherwise Check if character isn't a backslash
-		else if(character != '\\')
+			// Append value separator to the segment
+			segments.back() += ',';
 		
-			// Append character to return value
-			returnValue += character;
+		// Append member's escaped key and key value separator to the segment
+		segments.back() += '"';
+		escape(segments.back(), i->first);
+		segments.back() += "\":";
 		
-		// Check if last character is a backslash
-		if(!ignoreEscapeSequence && lastCharacter == '\\') {
+		// Check if member's value is a slot
+		if(i->second.getType() == Type::NONE)
 		
-			// Check if character is an escaped backslash
-			if(character == '\\')
-			
-				// Set to ignore escape sequence caused by this backslash
-				ignoreEscapeSequence = true;
-		}
+			// Start next segment
+			segments.emplace_back();
 		
-		// Otherwise check if ignoring escape sequence
-		else if(ignoreEscapeSequence)
-			
-			// Clear ignore escape sequence
-			ignoreEscapeSequence = false;
+		// Otherwise
+		else
 		
-		// Set last character
-		lastCharacter = value[i];
+			// Append member's encoded value to the segment
+			i->second.encode(segments.back());
 	}
 	
-	// Return return value
-	return returnValue;
+	// Append object ending character to the segment
+	segments.back() += '}';
+	
+	// Return segments
+	return segments;
+}
+
+size_t Json::getTemplateValueLength(const char *value) {
+
+	// Return value's length
+	return strlen(value);
+}
+
+size_t Json::getTemplateValueLength(const string_view &value) {
+
+	// Return value's length including its quotes
+	return value.length() + sizeof("\"\"") - 1;
+}
+
+size_t Json::getTemplateValueLength(Number value) {
+
+	// Return maximum length of an integer
+	return sizeof("-9223372036854775808") - 1;
+}
+
+size_t Json::getTemplateValueLength(Boolean value) {
+
+	// Return value's length
+	return value ? sizeof("true") - 1 : sizeof("false") - 1;
+}
+
+void Json::appendTemplateValue(string &output, const char *value) {
+
+	// Append value to output
+	appendTemplateValue(output, string_view(value));
+}
+
+void Json::appendTemplateValue(string &output, const string_view &value) {
+
+	// Append value's escaped string to output
+	output += '"';
+	escape(output, value);
+	output += '"';
+}
+
+void Json::appendTemplateValue(string &output, Number value) {
+
+	// Append encoded number to output
+	encodeNumber(output, value);
+}
+
+void Json::appendTemplateValue(string &output, Boolean value) {
+
+	// Append value to output
+	output += value ? "true" : "false";
+}
+
+bool Json::isValidString(const string &value) {
+
+	// Check if value doesn't contain any characters that need to be escaped
+	if(getUnescapedLength(value.data(), value.length()) == value.length())
+	
+		// Return if value is a valid UTF-8 string
+		return Unicode::isValidUtf8(value);
+	
+	// Escape value
+	string escapedValue;
+	escape(escapedValue, value);
+	
+	// Return if escaped value is a valid UTF-8 string
+	return Unicode::isValidUtf8(escapedValue);
 }
 
 bool Json::parseValue(const string &value, intmax_t currentDepth, intmax_t maxDepth) {
@@ -2025,6 +2054,7 @@ bool Json::parseValue(const string &value, intmax_t currentDepth, intmax_t maxDe
 		bool ignoreEscapeSequence = false;
 		intmax_t arrayDepth = 0, objectDepth = 0;
 		string key;
+		string unescapedKey;
 		
 		// Go through all characters
 		for(string::size_type i = 1, j = i; i < value.length(); ++i) {
@@ -2135,7 +2165,7 @@ bool Json::parseValue(const string &value, intmax_t currentDepth, intmax_t maxDe
 						
 						// Try setting key
 						try {
-							key = unescape(value.substr(j + sizeof('"'), i - j - sizeof('"') * 2));
+							key = unescape(string_view(value).substr(j + sizeof('"'), i - j - sizeof('"') * 2), unescapedKey);
 						}
 						
 						// Check if an exception occurred
@@ -2432,7 +2462,20 @@ bool Json::parseValue(const string &value, intmax_t currentDepth, intmax_t maxDe
 		
 		// Try setting string value
 		try {
-			setStringValue(unescape(value.substr(sizeof('"'), value.length() - 1 - sizeof('"'))));
+			string unescapedValue;
+			const string_view stringValue = unescape(string_view(value).substr(sizeof('"'), value.length() - 1 - sizeof('"')), unescapedValue);
+			
+			// Check if string value was unescaped into the unescaped value
+			if(stringValue.data() == unescapedValue.data())
+			
+				// Set string value to the unescaped value without copying it
+				setStringValue(move(unescapedValue));
+			
+			// Otherwise
+			else
+			
+				// Set string value to the value
+				setStringValue(String(stringValue));
 		}
 		
 		// Check if an exception occurred
@@ -2506,3 +2549,92 @@ bool Json::parseValue(const string &value, intmax_t currentDepth, intmax_t maxDe
 	// Return true;
 	return true;
 }
+
+// Get unescaped length
+size_t getUnescapedLength(const char *value, size_t length) {
+
+	// Initialize index
+	size_t i = 0;
+
+	// Check if x86-64
+	#if defined __x86_64__ || defined _M_X64
+	
+		// Skip vectorized spans that don't contain any characters that need to be escaped
+		i = Common::isAvx2Supported() ? getUnescapedLengthAvx2(value, length) : getUnescapedLengthSse2(value, length);
+	#endif
+	
+	// Go through all remaining characters
+	for(; i < length; ++i) {
+	
+		// Check if character needs to be escaped
+		if(value[i] == '"' || value[i] == '\\' || static_cast<uint8_t>(value[i]) < ' ')
+		
+			// Return index
+			return i;
+	}
+	
+	// Return length
+	return length;
+}
+
+// Check if x86-64
+#if defined __x86_64__ || defined _M_X64
+
+	// Get unescaped length SSE2
+	size_t getUnescapedLengthSse2(const char *value, size_t length) {
+	
+		// Initialize comparison values
+		const __m128i doubleQuote = _mm_set1_epi8('"');
+		const __m128i backslash = _mm_set1_epi8('\\');
+		const __m128i lastControlCharacter = _mm_set1_epi8(' ' - 1);
+		
+		// Go through all full blocks
+		size_t i = 0;
+		for(; length - i >= sizeof(__m128i); i += sizeof(__m128i)) {
+		
+			// Get block
+			const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&value[i]));
+			
+			// Get characters in the block that need to be escaped
+			const int matches = _mm_movemask_epi8(_mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(block, doubleQuote), _mm_cmpeq_epi8(block, backslash)), _mm_cmpeq_epi8(_mm_max_epu8(block, lastControlCharacter), lastControlCharacter)));
+			
+			// Check if block contains a character that needs to be escaped
+			if(matches)
+			
+				// Return index of the character
+				return i + __builtin_ctz(matches);
+		}
+		
+		// Return index of the remaining characters
+		return i;
+	}
+	
+	// Get unescaped length AVX2
+	size_t getUnescapedLengthAvx2(const char *value, size_t length) {
+	
+		// Initialize comparison values
+		const __m256i doubleQuote = _mm256_set1_epi8('"');
+		const __m256i backslash = _mm256_set1_epi8('\\');
+		const __m256i lastControlCharacter = _mm256_set1_epi8(' ' - 1);
+		
+		// Go through all full blocks
+		size_t i = 0;
+		for(; length - i >= sizeof(__m256i); i += sizeof(__m256i)) {
+		
+			// Get block
+			const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(&value[i]));
+			
+			// Get characters in the block that need to be escaped
+			const uint32_t matches = _mm256_movemask_epi8(_mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(block, doubleQuote), _mm256_cmpeq_epi8(block, backslash)), _mm256_cmpeq_epi8(_mm256_max_epu8(block, lastControlCharacter), lastControlCharacter)));
+			
+			// Check if block contains a character that needs to be escaped
+			if(matches)
+			
+				// Return index of the character
+				return i + __builtin_ctz(matches);
+		}
+		
+		// Return index of the remaining characters
+		return i;
+	}
+#endif
@@ -5,6 +5,10 @@
 
 // Header files
 #include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
 #include <unordered_map>
 #include <vector>
 
@@ -40,6 +44,73 @@ class Json final {
 		typedef vector<Json> Array;
 		typedef bool Boolean;
 		typedef void * Null;
+		
+		// Template class
+		template<size_t numberOfSlots> class Template final {
+		
+			// Public
+			public:
+			
+				// Constructor
+				Template(const vector<pair<string, Json>> &members) :
+				
+					// Set segments
+					segments(createTemplateSegments(members)),
+					
+					// Set length
+					length(0)
+				{
+				
+					// Check if the number of slots isn't the template's number of slots
+					if(segments.size() - 1 != numberOfSlots)
+					
+						// Throw exception
+						throw runtime_error("Invalid number of slots");
+					
+					// Go through all segments
+					for(const string &segment : segments)
+					
+						// Include segment's length in the length
+						length += segment.length();
+				}
+				
+				// Fill
+				template<typename... Values> string fill(const Values &... values) const {
+				
+					// Check if the number of values isn't the number of slots
+					static_assert(sizeof...(Values) == numberOfSlots, "Invalid number of values");
+					
+					// Fill result
+					string result;
+					fill(result, values...);
+					
+					// Return result
+					return result;
+				}
+				
+				// Fill (appends to the output)
+				template<typename... Values, typename = enable_if_t<sizeof...(Values) == numberOfSlots>> void fill(string &output, const Values &... values) const {
+				
+					// Reserve enough space in the output for the segments and values
+					output.reserve(output.length() + (length + ... + getTemplateValueLength(values)));
+					
+					// Append first segment to the output
+					typename vector<string>::const_iterator segment = segments.cbegin();
+					output += *segment;
+					
+					// Append each value followed by its next segment to the output
+					((appendTemplateValue(output, values), output += *++segment), ...);
+				}
+			
+			// Private
+			private:
+			
+				// Segments
+				vector<string> segments;
+				
+				// Length
+				size_t length;
+		};
 	
 		// Constructor
 		Json();
@@ -176,6 +247,7 @@ class Json final {
 		
 		// Set value
 		void setStringValue(const String &value);
+		void setStringValue(String &&value);
 		void setNumberValue(Number value);
 		void setObjectValue(const Object &value);
 		void setArrayValue(const Array &value);
@@ -194,6 +266,9 @@ class Json final {
 		// Empty
 		bool empty() const;
 		
+		// Unescape (returns the value if it doesn't contain escape sequences otherwise unescapes it into the buffer and returns the buffer)
+		static string_view unescape(const string_view &value, string &buffer);
+		
 		// Check if using JSON base64
 		#ifdef JSON_BASE64
 		
@@ -201,7 +276,7 @@ class Json final {
 			static string base64Encode(const vector<uint8_t> &value);
 
 			// Base64 decode
-			static vector<uint8_t> base64Decode(const string &value);
+			static vector<uint8_t> base64Decode(const string_view &value);
 		#endif
 	
 	// Private
@@ -213,11 +288,32 @@ class Json final {
 		// Remove whitespace
 		static string removeWhitespace(const string &value);
 		
+		// Encode
+		void encode(string &output) const;
+		
+		// Encode number
+		static void encodeNumber(string &output, Number value);
+		
 		// Escape
-		static string escape(const string &value);
+		static void escape(string &output, const string_view &value);
+		
+		// Create template segments
+		static vector<string> createTemplateSegments(const vector<pair<string, Json>> &members);
+		
+		// Get template value length
+		static size_t getTemplateValueLength(const char *value);
+		static size_t getTemplateValueLength(const string_view &value);
+		static size_t getTemplateValueLength(Number value);
+		static size_t getTemplateValueLength(Boolean value);
 		
-		// Unescape
-		static string unescape(const string &value);
+		// Append template value
+		static void appendTemplateValue(string &output, const char *value);
+		static void appendTemplateValue(string &output, const string_view &value);
+		static void appendTemplateValue(string &output, Number value);
+		static void appendTemplateValue(string &output, Boolean value);
+		
+		// Is valid string
+		static bool isValidString(const string &value);
 		
 		// Parse value
 		bool parseValue(const string &value, intmax_t currentDepth, intmax_t maxDepth);
@@ -225,6 +321,9 @@ class Json final {
 		// Compare
 		bool compare(const Json *value) const;
 		
+		// Hexadecimal characters
+		static const char HEXADECIMAL_CHARACTERS[];
+		
 		// Type
 		Type type;
 		
@@ -0,0 +1,2594 @@
+// Header files
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <getopt.h>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <signal.h>
+#include <sstream>
+#include <unordered_map>
+#include <unistd.h>
+#include "event2/buffer.h"
+#include "base64.h"
+#include "common.h"
+#include "event2/bufferevent_ssl.h"
+#include "event2/event.h"
+#include "event2/http.h"
+#include "json.h"
+#include "recorder.h"
+#include "websocket.h"
+#include "openssl/ssl.h"
+
+using namespace std;
+
+
+// Constants
+
+// Default address
+static const char *DEFAULT_ADDRESS = "localhost";
+
+// Default port
+static const uint16_t DEFAULT_PORT = 9061;
+
+// Default Tor port
+static const uint16_t DEFAULT_TOR_PORT = 9062;
+
+// Default number of connections
+static const unsigned long long DEFAULT_NUMBER_OF_CONNECTIONS = 16;
+
+// Default deflate percent
+static const unsigned long long DEFAULT_DEFLATE_PERCENT = 50;
+
+// Default number of requests
+static const unsigned long long DEFAULT_NUMBER_OF_REQUESTS = 10000;
+
+// Default concurrency
+static const unsigned long long DEFAULT_CONCURRENCY = 64;
+
+// Default gzip percent
+static const unsigned long long DEFAULT_GZIP_PERCENT = 50;
+
+// Default request sizes
+static const char *DEFAULT_REQUEST_SIZES = "256:60,4096:30,65536:10";
+
+// Default reply sizes
+static const char *DEFAULT_REPLY_SIZES = "1024";
+
+// Default think time milliseconds
+static const unsigned long long DEFAULT_THINK_TIME_MILLISECONDS = 0;
+
+// Default replay speed
+static const unsigned long long DEFAULT_REPLAY_SPEED = 1;
+
+// Maximum replay speed
+static const unsigned long long MAXIMUM_REPLAY_SPEED = 1000;
+
+// Unlimited replay speed
+static const unsigned long long UNLIMITED_REPLAY_SPEED = 0;
+
+// Maximum body size
+static const unsigned long long MAXIMUM_BODY_SIZE = 10 * 1024 * 1024;
+
+// Maximum headers size
+static const size_t MAXIMUM_HEADERS_SIZE = 8 * 1024;
+
+// Maximum WebSocket message size
+static const uint64_t MAXIMUM_WEBSOCKET_MESSAGE_SIZE = 20 * 1024 * 1024;
+
+// Minimum compression length
+static const size_t MINIMUM_COMPRESSION_LENGTH = 1000;
+
+// WebSocket key length
+static const size_t WEBSOCKET_KEY_LENGTH = 16;
+
+// HTTP headers end
+static const char HTTP_HEADERS_END[] = "\r\n\r\n";
+
+// HTTP switching protocols status line
+static const char HTTP_SWITCHING_PROTOCOLS_STATUS_LINE[] = "HTTP/1.1 101";
+
+// Body characters
+static const char BODY_CHARACTERS[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789 ";
+
+// Percent scale
+static const unsigned long long PERCENT_SCALE = 100;
+
+// Create URL request template
+static const Json::Template<1> CREATE_URL_REQUEST_TEMPLATE({
+	{"Index", Json()},
+	{"Request", "Create URL"}
+});
+
+// Interaction reply template
+static const Json::Template<3> INTERACTION_REPLY_TEMPLATE({
+	{"Interaction", Json()},
+	{"Status", Json()},
+	{"Type", "text/plain"},
+	{"Data", Json()}
+});
+
+// Replayed interaction reply template
+static const Json::Template<4> REPLAYED_INTERACTION_REPLY_TEMPLATE({
+	{"Interaction", Json()},
+	{"Status", Json()},
+	{"Type", Json()},
+	{"Data", Json()}
+});
+
+
+// Classes
+
+// Size distribution class
+class SizeDistribution final {
+
+	// Public
+	public:
+
+		// Constructor
+		explicit SizeDistribution(const string &specification);
+
+		// Get random index
+		size_t getRandomIndex(mt19937 &generator);
+
+		// Get size
+		size_t getSize(size_t index) const;
+
+		// Get number of sizes
+		size_t getNumberOfSizes() const;
+
+		// Get maximum size
+		size_t getMaximumSize() const;
+
+	// Private
+	private:
+
+		// Sizes
+		vector<size_t> sizes;
+
+		// Distribution
+		discrete_distribution<size_t> distribution;
+};
+
+// Replay class
+class Replay final {
+
+	// Public
+	public:
+
+		// Request structure
+		struct Request {
+
+			// Time
+			chrono::nanoseconds time;
+
+			// Responder index
+			size_t responderIndex;
+
+			// API
+			string api;
+
+			// Content type
+			string contentType;
+
+			// Accept encoding
+			string acceptEncoding;
+
+			// Body
+			string_view body;
+		};
+
+		// Reply structure
+		struct Reply {
+
+			// Status
+			Json::Number status;
+
+			// Type
+			string type;
+
+			// Data
+			string data;
+		};
+
+		// Constructor
+		explicit Replay(const char *path);
+
+		// Copy constructor
+		Replay(const Replay &other) = delete;
+
+		// Copy assignment operator
+		Replay &operator=(const Replay &other) = delete;
+
+		// Get requests
+		const vector<Request> &getRequests() const;
+
+		// Get number of responders
+		size_t getNumberOfResponders() const;
+
+		// Get responder uses compression
+		bool getResponderUsesCompression(size_t index) const;
+
+		// Get next reply
+		const Reply *getNextReply(size_t responderIndex);
+
+		// Unrouted responder index
+		static const size_t UNROUTED_RESPONDER_INDEX;
+
+	// Private
+	private:
+
+		// Get responder index
+		size_t getResponderIndex(uint64_t connectionId);
+
+		// Reader
+		Recorder::Reader reader;
+
+		// Requests
+		vector<Request> requests;
+
+		// Responder indices
+		unordered_map<uint64_t, size_t> responderIndices;
+
+		// Responders use compression
+		vector<bool> respondersUseCompression;
+
+		// Responders replies
+		vector<vector<Reply>> respondersReplies;
+
+		// Responders next reply
+		vector<size_t> respondersNextReply;
+};
+
+// Load generator class
+class LoadGenerator;
+
+// Responder class
+class Responder final {
+
+	// Public
+	public:
+
+		// Constructor
+		Responder(LoadGenerator *loadGenerator, size_t index, bool requestsCompression);
+
+		// Copy constructor
+		Responder(const Responder &other) = delete;
+
+		// Copy assignment operator
+		Responder &operator=(const Responder &other) = delete;
+
+		// Connect
+		bool connect();
+
+		// Get URL host
+		const string &getUrlHost() const;
+
+		// Get URL path
+		const string &getUrlPath() const;
+
+		// Get uses compression
+		bool getUsesCompression() const;
+
+	// Private
+	private:
+
+		// Read callback
+		static void readCallback(bufferevent *connection, void *argument);
+
+		// Event callback
+		static void eventCallback(bufferevent *connection, short events, void *argument);
+
+		// Reply callback
+		static void replyCallback(evutil_socket_t socket, short events, void *argument);
+
+		// Finish handshake
+		bool finishHandshake(evbuffer *input);
+
+		// Read frames
+		bool readFrames(evbuffer *input);
+
+		// Handle message
+		bool handleMessage(const string &message);
+
+		// Reply
+		bool reply(Json::Number interactionIndex);
+
+		// Send message
+		bool sendMessage(const string &message, WebSocket::Opcode opcode);
+
+		// Load generator
+		LoadGenerator *loadGenerator;
+
+		// Index
+		size_t index;
+
+		// Connection
+		unique_ptr<bufferevent, decltype(&bufferevent_free)> connection;
+
+		// Requests compression
+		bool requestsCompression;
+
+		// Uses compression
+		bool usesCompression;
+
+		// Key
+		string key;
+
+		// Handshake finished
+		bool handshakeFinished;
+
+		// Partial message
+		string partialMessage;
+
+		// Message compressed
+		bool messageCompressed;
+
+		// Message started
+		bool messageStarted;
+
+		// URL host
+		string urlHost;
+
+		// URL path
+		string urlPath;
+};
+
+// Load generator class
+class LoadGenerator final {
+
+	// Public
+	public:
+
+		// Constructor
+		LoadGenerator(event_base *eventBase, SSL_CTX *tlsContext, const string &address, uint16_t port, const string &torAddress, uint16_t torPort, size_t numberOfConnections, unsigned int deflatePercent, uint64_t numberOfRequests, size_t concurrency, unsigned int gzipPercent, const SizeDistribution &requestSizes, const SizeDistribution &replySizes, uint64_t thinkTimeMilliseconds, pid_t gatewayProcessId, Replay *replay, unsigned long long replaySpeed);
+
+		// Start
+		bool start();
+
+		// Stop
+		void stop();
+
+		// Fail
+		void fail(const string &reason);
+
+		// Get succeeded
+		bool getSucceeded() const;
+
+		// Get event base
+		event_base *getEventBase() const;
+
+		// Get TLS context
+		SSL_CTX *getTlsContext() const;
+
+		// Get address
+		const string &getAddress() const;
+
+		// Get port
+		uint16_t getPort() const;
+
+		// Get think time milliseconds
+		uint64_t getThinkTimeMilliseconds() const;
+
+		// Get generator
+		mt19937 &getGenerator();
+
+		// Get replay
+		Replay *getReplay() const;
+
+		// Get random reply
+		pair<size_t, const string *> getRandomReply();
+
+		// Responder ready
+		void responderReady();
+
+		// Interaction replied
+		void interactionReplied(size_t length);
+
+	// Private
+	private:
+
+		// Request callback
+		static void requestCallback(evhttp_request *request, void *argument);
+
+		// Replay callback
+		static void replayCallback(evutil_socket_t socket, short events, void *argument);
+
+		// Send request
+		bool sendRequest(size_t slot);
+
+		// Release due requests
+		bool releaseDueRequests();
+
+		// Report
+		void report() const;
+
+		// Event base
+		event_base *eventBase;
+
+		// TLS context
+		SSL_CTX *tlsContext;
+
+		// Address
+		string address;
+
+		// Port
+		uint16_t port;
+
+		// Tor address
+		string torAddress;
+
+		// Tor port
+		uint16_t torPort;
+
+		// Number of requests
+		uint64_t numberOfRequests;
+
+		// Gzip percent
+		unsigned int gzipPercent;
+
+		// Request sizes
+		SizeDistribution requestSizes;
+
+		// Reply sizes
+		SizeDistribution replySizes;
+
+		// Think time milliseconds
+		uint64_t thinkTimeMilliseconds;
+
+		// Gateway process ID
+		pid_t gatewayProcessId;
+
+		// Generator
+		mt19937 generator;
+
+		// Body
+		string body;
+
+		// Encoded replies
+		vector<string> encodedReplies;
+
+		// Responders
+		vector<unique_ptr<Responder>> responders;
+
+		// Number of ready responders
+		size_t numberOfReadyResponders;
+
+		// Connections
+		vector<unique_ptr<evhttp_connection, decltype(&evhttp_connection_free)>> connections;
+
+		// Number of sent requests
+		uint64_t numberOfSentRequests;
+
+		// Number of due requests
+		uint64_t numberOfDueRequests;
+
+		// Free slots
+		vector<size_t> freeSlots;
+
+		// Replay
+		Replay *replay;
+
+		// Replay speed
+		unsigned long long replaySpeed;
+
+		// Replay event
+		unique_ptr<event, decltype(&event_free)> replayEvent;
+
+		// Number of completed requests
+		uint64_t numberOfCompletedRequests;
+
+		// Number of failed requests
+		uint64_t numberOfFailedRequests;
+
+		// Number of replied interactions
+		uint64_t numberOfRepliedInteractions;
+
+		// Request bytes
+		uint64_t requestBytes;
+
+		// Response bytes
+		uint64_t responseBytes;
+
+		// Reply bytes
+		uint64_t replyBytes;
+
+		// Latencies
+		vector<uint64_t> latencies;
+
+		// Start time
+		chrono::steady_clock::time_point startTime;
+
+		// Gateway start CPU time
+		double gatewayStartCpuTime;
+
+		// Running
+		bool running;
+
+		// Succeeded
+		bool succeeded;
+};
+
+
+// Function prototypes
+
+// Display options help
+static void displayOptionsHelp();
+
+// Display invalid option
+static void displayInvalidOption(const char *program, const char *name, const char *value);
+
+// Parse number
+static bool parseNumber(const char *text, unsigned long long minimum, unsigned long long maximum, unsigned long long &number);
+
+// Get process CPU time
+static double getProcessCpuTime(pid_t processId);
+
+
+// Main function
+int main(int argc, char *argv[]) {
+
+	// Display message
+	cout << TOSTRING(PROGRAM_NAME) << " Load Generator v" << TOSTRING(PROGRAM_VERSION) << endl;
+
+	// Initialize address
+	string address = DEFAULT_ADDRESS;
+
+	// Initialize port
+	uint16_t port = DEFAULT_PORT;
+
+	// Initialize using TLS
+	bool usingTls = false;
+
+	// Initialize Tor address
+	string torAddress = DEFAULT_ADDRESS;
+
+	// Initialize Tor port
+	uint16_t torPort = DEFAULT_TOR_PORT;
+
+	// Initialize number of connections
+	unsigned long long numberOfConnections = DEFAULT_NUMBER_OF_CONNECTIONS;
+
+	// Initialize deflate percent
+	unsigned long long deflatePercent = DEFAULT_DEFLATE_PERCENT;
+
+	// Initialize number of requests
+	unsigned long long numberOfRequests = DEFAULT_NUMBER_OF_REQUESTS;
+
+	// Initialize concurrency
+	unsigned long long concurrency = DEFAULT_CONCURRENCY;
+
+	// Initialize gzip percent
+	unsigned long long gzipPercent = DEFAULT_GZIP_PERCENT;
+
+	// Initialize request sizes
+	string requestSizes = DEFAULT_REQUEST_SIZES;
+
+	// Initialize reply sizes
+	string replySizes = DEFAULT_REPLY_SIZES;
+
+	// Initialize think time milliseconds
+	unsigned long long thinkTimeMilliseconds = DEFAULT_THINK_TIME_MILLISECONDS;
+
+	// Initialize gateway process ID
+	unsigned long long gatewayProcessId = 0;
+
+	// Initialize replay file
+	const char *replayFile = nullptr;
+
+	// Initialize replay speed
+	unsigned long long replaySpeed = DEFAULT_REPLAY_SPEED;
+
+	// Set options
+	const option options[] = {
+
+		// Version
+		{"version", no_argument, nullptr, 'v'},
+
+		// Address
+		{"address", required_argument, nullptr, 'a'},
+
+		// Port
+		{"port", required_argument, nullptr, 'p'},
+
+		// TLS
+		{"tls", no_argument, nullptr, 'T'},
+
+		// Tor address
+		{"tor-address", required_argument, nullptr, 'A'},
+
+		// Tor port
+		{"tor-port", required_argument, nullptr, 'P'},
+
+		// Connections
+		{"connections", required_argument, nullptr, 'c'},
+
+		// Deflate percent
+		{"deflate-percent", required_argument, nullptr, 'd'},
+
+		// Requests
+		{"requests", required_argument, nullptr, 'n'},
+
+		// Concurrency
+		{"concurrency", required_argument, nullptr, 'C'},
+
+		// Gzip percent
+		{"gzip-percent", required_argument, nullptr, 'g'},
+
+		// Request sizes
+		{"request-sizes", required_argument, nullptr, 's'},
+
+		// Reply sizes
+		{"reply-sizes", required_argument, nullptr, 'b'},
+
+		// Think time
+		{"think-time", required_argument, nullptr, 'w'},
+
+		// Gateway PID
+		{"gateway-pid", required_argument, nullptr, 'G'},
+
+		// Replay
+		{"replay", required_argument, nullptr, 'r'},
+
+		// Replay speed
+		{"replay-speed", required_argument, nullptr, 'S'},
+
+		// Help
+		{"help", no_argument, nullptr, 'h'},
+
+		// End
+		{}
+	};
+
+	// Go through all options
+	for(int option = getopt_long(argc, argv, "va:p:TA:P:c:d:n:C:g:s:b:w:G:r:S:h", options, nullptr); option != -1; option = getopt_long(argc, argv, "va:p:TA:P:c:d:n:C:g:s:b:w:G:r:S:h", options, nullptr)) {
+
+		// Check option
+		switch(option) {
+
+			// Version
+			case 'v':
+
+				// Return success
+				return EXIT_SUCCESS;
+
+			// Address or Tor address
+			case 'a':
+			case 'A':
+
+				// Check if option doesn't exist
+				if(!optarg || !*optarg) {
+
+					// Display invalid option
+					displayInvalidOption(argv[0], (option == 'a') ? "address" : "Tor address", optarg);
+
+					// Return failure
+					return EXIT_FAILURE;
+				}
+
+				// Set address or Tor address
+				((option == 'a') ? address : torAddress) = optarg;
+
+				// Break
+				break;
+
+			// Port or Tor port
+			case 'p':
+			case 'P':
+
+				// Check if parsing port failed
+				unsigned long long portNumber;
+				if(!optarg || !parseNumber(optarg, 1, UINT16_MAX, portNumber)) {
+
+					// Display invalid option
+					displayInvalidOption(argv[0], (option == 'p') ? "port" : "Tor port", optarg);
+
+					// Return failure
+					return EXIT_FAILURE;
+				}
+
+				// Set port or Tor port
+				((option == 'p') ? port : torPort) = portNumber;
+
+				// Break
+				break;
+
+			// TLS
+			case 'T':
+
+				// Set using TLS
+				usingTls = true;
+
+				// Break
+				break;
+
+			// Connections
+			case 'c':
+
+				// Check if parsing number of connections failed
+				if(!optarg || !parseNumber(optarg, 1, UINT16_MAX, numberOfConnections)) {
+
+					// Display invalid option
+					displayInvalidOption(argv[0], "connections", optarg);
+
+					// Return failure
+					return EXIT_FAILURE;
+				}
+
+				// Break
+				break;
+
+			// Deflate percent
+			case 'd':
+
+				// Check if parsing deflate percent failed
+				if(!optarg || !parseNumber(optarg, 0, PERCENT_SCALE, deflatePercent)) {
+
+					// Display invalid option
+					displayInvalidOption(argv[0], "deflate percent", optarg);
+
+					// Return failure
+					return EXIT_FAILURE;
+				}
+
+				// Break
+				break;
+
+			// Requests
+			case 'n':
+
+				// Check if parsing number of requests failed
+				if(!optarg || !parseNumber(optarg, 1, UINT32_MAX, numberOfRequests)) {
+
+					// Display invalid option
+					displayInvalidOption(argv[0], "requests", optarg);
+
+					// Return failure
+					return EXIT_FAILURE;
+				}
+
+				// Break
+				break;
+
+			// Concurrency
+			case 'C':
+
+				// Check if parsing concurrency failed
+				if(!optarg || !parseNumber(optarg, 1, UINT16_MAX, concurrency)) {
+
+					// Display invalid option
+					displayInvalidOption(argv[0], "concurrency", optarg);
+
+					// Return failure
+					return EXIT_FAILURE;
+				}
+
+				// Break
+				break;
+
+			// Gzip percent
+			case 'g':
+
+				// Check if parsing gzip percent failed
+				if(!optarg || !parseNumber(optarg, 0, PERCENT_SCALE, gzipPercent)) {
+
+					// Display invalid option
+					displayInvalidOption(argv[0], "gzip percent", optarg);
+
+					// Return failure
+					return EXIT_FAILURE;
+				}
+
+				// Break
+				break;
+
+			// Request sizes or reply sizes
+			case 's':
+			case 'b':
+
+				// Check if option doesn't exist
+				if(!optarg) {
+
+					// Display invalid option
+					displayInvalidOption(argv[0], (option == 's') ? "request sizes" : "reply sizes", optarg);
+
+					// Return failure
+					return EXIT_FAILURE;
+				}
+
+				// Set request sizes or reply sizes
+				((option == 's') ? requestSizes : replySizes) = optarg;
+
+				// Break
+				break;
+
+			// Think time
+			case 'w':
+
+				// Check if parsing think time failed
+				if(!optarg || !parseNumber(optarg, 0, UINT32_MAX, thinkTimeMilliseconds)) {
+
+					// Display invalid option
+					displayInvalidOption(argv[0], "think time", optarg);
+
+					// Return failure
+					return EXIT_FAILURE;
+				}
+
+				// Break
+				break;
+
+			// Gateway PID
+			case 'G':
+
+				// Check if parsing gateway process ID failed
+				if(!optarg || !parseNumber(optarg, 1, INT32_MAX, gatewayProcessId)) {
+
+					// Display invalid option
+					displayInvalidOption(argv[0], "gateway PID", optarg);
+
+					// Return failure
+					return EXIT_FAILURE;
+				}
+
+				// Break
+				break;
+
+			// Replay
+			case 'r':
+
+				// Check if option doesn't exist
+				if(!optarg || !*optarg) {
+
+					// Display invalid option
+					displayInvalidOption(argv[0], "replay", optarg);
+
+					// Return failure
+					return EXIT_FAILURE;
+				}
+
+				// Set replay file
+				replayFile = optarg;
+
+				// Break
+				break;
+
+			// Replay speed
+			case 'S':
+
+				// Check if replay speed is unlimited
+				if(optarg && !strcmp(optarg, "max")) {
+
+					// Set replay speed
+					replaySpeed = UNLIMITED_REPLAY_SPEED;
+				}
+
+				// Otherwise check if parsing replay speed failed
+				else if(!optarg || !parseNumber(optarg, 1, MAXIMUM_REPLAY_SPEED, replaySpeed)) {
+
+					// Display invalid option
+					displayInvalidOption(argv[0], "replay speed", optarg);
+
+					// Return failure
+					return EXIT_FAILURE;
+				}
+
+				// Break
+				break;
+
+			// Help
+			case 'h':
+
+				// Display message
+				cout << endl << "Usage:" << endl << '\t' << argv[0] << " [options]" << endl << endl;
+
+				// Display options help
+				displayOptionsHelp();
+
+				// Return success
+				return EXIT_SUCCESS;
+
+			// Default
+			default:
+
+				// Display message
+				cout << endl << "Usage:" << endl << '\t' << argv[0] << " [options]" << endl << endl;
+
+				// Display options help
+				displayOptionsHelp();
+
+				// Return failure
+				return EXIT_FAILURE;
+		}
+	}
+
+	// Try
+	unique_ptr<SizeDistribution> requestSizeDistribution;
+	unique_ptr<SizeDistribution> replySizeDistribution;
+	unique_ptr<Replay> replay;
+	try {
+
+		// Create request size distribution
+		requestSizeDistribution = make_unique<SizeDistribution>(requestSizes);
+
+		// Create reply size distribution
+		replySizeDistribution = make_unique<SizeDistribution>(replySizes);
+
+		// Check if replaying
+		if(replayFile) {
+
+			// Create replay
+			replay = make_unique<Replay>(replayFile);
+		}
+	}
+
+	// Catch errors
+	catch(const runtime_error &error) {
+
+		// Display message
+		cout << argv[0] << ": " << error.what() << endl;
+
+		// Return failure
+		return EXIT_FAILURE;
+	}
+
+	// Check if ignoring broken pipe signals failed
+	if(signal(SIGPIPE, SIG_IGN) == SIG_ERR) {
+
+		// Display message
+		cout << "Ignoring broken pipe signals failed" << endl;
+
+		// Return failure
+		return EXIT_FAILURE;
+	}
+
+	// Check if creating event base failed
+	unique_ptr<event_base, decltype(&event_base_free)> eventBase(event_base_new(), event_base_free);
+	if(!eventBase) {
+
+		// Display message
+		cout << "Creating event base failed" << endl;
+
+		// Return failure
+		return EXIT_FAILURE;
+	}
+
+	// Initialize TLS context
+	unique_ptr<SSL_CTX, decltype(&SSL_CTX_free)> tlsContext(nullptr, SSL_CTX_free);
+
+	// Check if using TLS
+	if(usingTls) {
+
+		// Check if creating TLS context failed
+		tlsContext.reset(SSL_CTX_new(TLS_client_method()));
+		if(!tlsContext) {
+
+			// Display message
+			cout << "Creating TLS context failed" << endl;
+
+			// Return failure
+			return EXIT_FAILURE;
+		}
+	}
+
+	// Create load generator
+	LoadGenerator loadGenerator(eventBase.get(), tlsContext.get(), address, port, torAddress, torPort, numberOfConnections, deflatePercent, numberOfRequests, concurrency, gzipPercent, *requestSizeDistribution, *replySizeDistribution, thinkTimeMilliseconds, gatewayProcessId, replay.get(), replaySpeed);
+
+	// Check if creating interrupt signal event failed
+	unique_ptr<event, decltype(&event_free)> interruptSignalEvent(evsignal_new(eventBase.get(), SIGINT, ([](evutil_socket_t signal, short events, void *argument) {
+
+		// Stop load generator
+		reinterpret_cast<LoadGenerator *>(argument)->stop();
+
+	}), &loadGenerator), event_free);
+	if(!interruptSignalEvent || evsignal_add(interruptSignalEvent.get(), nullptr)) {
+
+		// Display message
+		cout << "Creating interrupt signal event failed" << endl;
+
+		// Return failure
+		return EXIT_FAILURE;
+	}
+
+	// Check if starting load generator failed
+	if(!loadGenerator.start()) {
+
+		// Return failure
+		return EXIT_FAILURE;
+	}
+
+	// Check if running event dispatch loop failed
+	if(event_base_dispatch(eventBase.get()) == -1) {
+
+		// Display message
+		cout << "Running event dispatch loop failed" << endl;
+
+		// Return failure
+		return EXIT_FAILURE;
+	}
+
+	// Return if load generator succeeded
+	return loadGenerator.getSucceeded() ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+
+// Supporting function implementation
+
+// Display options help
+void displayOptionsHelp() {
+
+	// Display message
+	cout << "Options:" << endl;
+	cout << "\t-v, --version\t\tDisplays version information" << endl;
+	cout << "\t-a, --address\t\tSets the gateway's WebSocket address (default: " << DEFAULT_ADDRESS << ')' << endl;
+	cout << "\t-p, --port\t\tSets the gateway's WebSocket port (default: " << DEFAULT_PORT << ')' << endl;
+	cout << "\t-T, --tls\t\tConnects to the gateway's WebSocket port with TLS" << endl;
+	cout << "\t-A, --tor-address\tSets the address of the gateway's Tor-side server (default: " << DEFAULT_ADDRESS << ')' << endl;
+	cout << "\t-P, --tor-port\t\tSets the port of the gateway's Tor-side server (default: " << DEFAULT_TOR_PORT << ')' << endl;
+	cout << "\t-c, --connections\tSets the number of WebSocket responder connections (default: " << DEFAULT_NUMBER_OF_CONNECTIONS << ')' << endl;
+	cout << "\t-d, --deflate-percent\tSets the percent of responder connections that offer permessage-deflate (default: " << DEFAULT_DEFLATE_PERCENT << ')' << endl;
+	cout << "\t-n, --requests\t\tSets the number of POST requests to send (default: " << DEFAULT_NUMBER_OF_REQUESTS << ')' << endl;
+	cout << "\t-C, --concurrency\tSets the number of concurrent POST requests (default: " << DEFAULT_CONCURRENCY << ')' << endl;
+	cout << "\t-g, --gzip-percent\tSets the percent of POST requests that accept gzip (default: " << DEFAULT_GZIP_PERCENT << ')' << endl;
+	cout << "\t-s, --request-sizes\tSets the POST body size distribution as size:weight pairs (default: " << DEFAULT_REQUEST_SIZES << ')' << endl;
+	cout << "\t-b, --reply-sizes\tSets the interaction reply body size distribution as size:weight pairs (default: " << DEFAULT_REPLY_SIZES << ')' << endl;
+	cout << "\t-w, --think-time\tSets the milliseconds responders wait before replying (default: " << DEFAULT_THINK_TIME_MILLISECONDS << ')' << endl;
+	cout << "\t-G, --gateway-pid\tSets the gateway's process ID to report its CPU usage" << endl;
+	cout << "\t-r, --replay\t\tReplays the POST requests, interaction replies, and compression usage recorded by the gateway's --record-file instead of generating them" << endl;
+	cout << "\t-S, --replay-speed\tSets the replay speed as a multiple of the recorded timing or max to send as fast as the concurrency allows (default: " << DEFAULT_REPLAY_SPEED << ')' << endl;
+	cout << "\t-h, --help\t\tDisplays help information" << endl;
+}
+
+// Display invalid option
+void displayInvalidOption(const char *program, const char *name, const char *value) {
+
+	// Display message
+	cout << program << ": invalid " << name << " -- '" << (value ? value : "") << '\'' << endl;
+
+	// Display message
+	cout << endl << "Usage:" << endl << '\t' << program << " [options]" << endl << endl;
+
+	// Display options help
+	displayOptionsHelp();
+}
+
+// Parse number
+bool parseNumber(const char *text, unsigned long long minimum, unsigned long long maximum, unsigned long long &number) {
+
+	// Check if text isn't numeric
+	if(!Common::isNumeric(text)) {
+
+		// Return false
+		return false;
+	}
+
+	// Try
+	try {
+
+		// Get number from text
+		number = stoull(text);
+	}
+
+	// Catch errors
+	catch(...) {
+
+		// Return false
+		return false;
+	}
+
+	// Return if number is in range
+	return number >= minimum && number <= maximum;
+}
+
+// Get process CPU time
+double getProcessCpuTime(pid_t processId) {
+
+	// Check if Linux
+	#ifdef __linux__
+
+		// Check if opening process's status failed
+		ifstream file("/proc/" + to_string(processId) + "/stat");
+		string status;
+		if(!file || !getline(file, status)) {
+
+			// Return not a number
+			return NAN;
+		}
+
+		// Check if status doesn't contain the end of the process's name
+		const string::size_type endOfName = status.rfind(')');
+		if(endOfName == string::npos) {
+
+			// Return not a number
+			return NAN;
+		}
+
+		// Skip the process's state and the fields before its user and system time
+		istringstream fields(status.substr(endOfName + sizeof(')')));
+		string field;
+		for(int i = 0; i < 11 && fields >> field; ++i);
+
+		// Check if getting the process's user and system time failed
+		unsigned long long userTime;
+		unsigned long long systemTime;
+		if(!(fields >> userTime >> systemTime)) {
+
+			// Return not a number
+			return NAN;
+		}
+
+		// Return process's CPU time in seconds
+		return static_cast<double>(userTime + systemTime) / sysconf(_SC_CLK_TCK);
+
+	// Otherwise
+	#else
+
+		// Return not a number
+		return NAN;
+	#endif
+}
+
+// Size distribution constructor
+SizeDistribution::SizeDistribution(const string &specification) {
+
+	// Initialize weights
+	vector<double> weights;
+
+	// Go through all entries in the specification
+	for(string::size_type startOfEntry = 0, endOfEntry = specification.find(',', startOfEntry);; startOfEntry = endOfEntry + sizeof(','), endOfEntry = specification.find(',', startOfEntry)) {
+
+		// Get entry
+		const string entry = Common::trim(specification.substr(startOfEntry, (endOfEntry != string::npos) ? endOfEntry - startOfEntry : string::npos));
+
+		// Get entry's size and weight
+		const string::size_type separator = entry.find(':');
+		const string size = Common::trim(entry.substr(0, separator));
+		const string weight = (separator != string::npos) ? Common::trim(entry.substr(separator + sizeof(':'))) : "1";
+
+		// Check if parsing size or weight failed
+		unsigned long long sizeNumber;
+		unsigned long long weightNumber;
+		if(!parseNumber(size.c_str(), 0, MAXIMUM_BODY_SIZE, sizeNumber) || !parseNumber(weight.c_str(), 1, UINT32_MAX, weightNumber)) {
+
+			// Throw exception
+			throw runtime_error("invalid size distribution -- '" + specification + '\'');
+		}
+
+		// Append size and weight
+		sizes.push_back(sizeNumber);
+		weights.push_back(weightNumber);
+
+		// Check if at the last entry
+		if(endOfEntry == string::npos) {
+
+			// Break
+			break;
+		}
+	}
+
+	// Set distribution
+	distribution = discrete_distribution<size_t>(weights.begin(), weights.end());
+}
+
+// Size distribution get random index
+size_t SizeDistribution::getRandomIndex(mt19937 &generator) {
+
+	// Return random index
+	return distribution(generator);
+}
+
+// Size distribution get size
+size_t SizeDistribution::getSize(size_t index) const {
+
+	// Return size
+	return sizes[index];
+}
+
+// Size distribution get number of sizes
+size_t SizeDistribution::getNumberOfSizes() const {
+
+	// Return number of sizes
+	return sizes.size();
+}
+
+// Size distribution get maximum size
+size_t SizeDistribution::getMaximumSize() const {
+
+	// Return maximum size
+	return *max_element(sizes.begin(), sizes.end());
+}
+
+// Replay unrouted responder index
+const size_t Replay::UNROUTED_RESPONDER_INDEX = SIZE_MAX;
+
+// Replay constructor
+Replay::Replay(const char *path) :
+
+	// Set reader
+	reader(path)
+{
+
+	// Go through all records
+	unordered_map<string, size_t> urlResponderIndices;
+	Recorder::Record record;
+	while(reader.read(record)) {
+
+		// Check if record is a client message
+		if(record.type == Recorder::Type::CLIENT_MESSAGE) {
+
+			// Get record's responder index
+			const size_t responderIndex = getResponderIndex(record.connectionId);
+
+			// Update if responder uses compression
+			respondersUseCompression[responderIndex] = respondersUseCompression[responderIndex] || record.compressed;
+
+			// Check if message is an interaction reply
+			Json json;
+			if(record.payload.find("\"Data\"") != string_view::npos && json.decode(string(record.payload)) && json.getType() == Json::Type::OBJECT) {
+
+				// Get message's members
+				const Json::Object &members = json.getObjectValue();
+
+				// Check if message has an interaction, status, type, and data
+				if(members.count("Interaction") && members.count("Status") && members.at("Status")->getType() == Json::Type::NUMBER && members.count("Type") && members.at("Type")->getType() == Json::Type::STRING && members.count("Data") && members.at("Data")->getType() == Json::Type::STRING) {
+
+					// Append reply to the responder's replies
+					respondersReplies[responderIndex].push_back({members.at("Status")->getNumberValue(), members.at("Type")->getStringValue(), members.at("Data")->getStringValue()});
+				}
+			}
+		}
+
+		// Otherwise check if record is a server message
+		else if(record.type == Recorder::Type::SERVER_MESSAGE) {
+
+			// Get record's responder index
+			const size_t responderIndex = getResponderIndex(record.connectionId);
+
+			// Update if responder uses compression
+			respondersUseCompression[responderIndex] = respondersUseCompression[responderIndex] || record.compressed;
+
+			// Check if message is a URL response
+			Json json;
+			if(record.payload.find("\"Response\"") != string_view::npos && json.decode(string(record.payload)) && json.getType() == Json::Type::OBJECT && json.getObjectValue().count("Response") && json.getObjectValue().at("Response")->getType() == Json::Type::STRING) {
+
+				// Check if URL has a path
+				const string &url = json.getObjectValue().at("Response")->getStringValue();
+				const string::size_type startOfHost = url.find("://");
+				const string::size_type startOfPath = (startOfHost != string::npos) ? url.find('/', startOfHost + sizeof("://") - sizeof('\0')) : string::npos;
+				if(startOfPath != string::npos) {
+
+					// Set URL's responder index
+					urlResponderIndices[Common::toLowerCase(url.substr(startOfPath))] = responderIndex;
+				}
+			}
+		}
+	}
+
+	// Check if no connections were recorded
+	if(respondersUseCompression.empty()) {
+
+		// Add a responder that doesn't use compression
+		getResponderIndex(0);
+	}
+
+	// Go through all records
+	reader.rewind();
+	while(reader.read(record)) {
+
+		// Check if record is a POST request
+		if(record.type == Recorder::Type::POST_REQUEST) {
+
+			// Get request's path
+			const string uri(Recorder::getPostRequestField(record, Recorder::PostRequestField::URI));
+			unique_ptr<evhttp_uri, decltype(&evhttp_uri_free)> parsedUri(evhttp_uri_parse(uri.c_str()), evhttp_uri_free);
+			const string path = (parsedUri && evhttp_uri_get_path(parsedUri.get())) ? evhttp_uri_get_path(parsedUri.get()) : "/";
+			const string query = (parsedUri && evhttp_uri_get_query(parsedUri.get())) ? string("?") + evhttp_uri_get_query(parsedUri.get()) : "";
+
+			// Initialize request
+			Request request = {
+
+				// Time
+				.time = record.time,
+
+				// Responder index
+				.responderIndex = UNROUTED_RESPONDER_INDEX,
+
+				// API
+				.api = path + query,
+
+				// Content type
+				.contentType = string(Recorder::getPostRequestField(record, Recorder::PostRequestField::CONTENT_TYPE)),
+
+				// Accept encoding
+				.acceptEncoding = string(Recorder::getPostRequestField(record, Recorder::PostRequestField::ACCEPT_ENCODING)),
+
+				// Body
+				.body = record.payload
+			};
+
+			// Check if path contains a URL delimiter
+			const string::size_type urlDelimiter = path.find('/', sizeof('/'));
+			if(path[0] == '/' && urlDelimiter != string::npos) {
+
+				// Set request's responder index to the URL's responder or spread unknown URLs across the responders
+				const unordered_map<string, size_t>::const_iterator urlResponderIndex = urlResponderIndices.find(Common::toLowerCase(path.substr(0, urlDelimiter)));
+				request.responderIndex = (urlResponderIndex != urlResponderIndices.cend()) ? urlResponderIndex->second : requests.size() % respondersUseCompression.size();
+
+				// Set request's API to the path after the URL
+				request.api = path.substr(urlDelimiter) + query;
+			}
+
+			// Append request to the requests
+			requests.push_back(move(request));
+		}
+	}
+
+	// Check if no requests were recorded
+	if(requests.empty()) {
+
+		// Throw exception
+		throw runtime_error("recording doesn't contain any POST requests -- '" + string(path) + '\'');
+	}
+
+	// Set responders next reply
+	respondersNextReply.assign(respondersReplies.size(), 0);
+}
+
+// Replay get requests
+const vector<Replay::Request> &Replay::getRequests() const {
+
+	// Return requests
+	return requests;
+}
+
+// Replay get number of responders
+size_t Replay::getNumberOfResponders() const {
+
+	// Return number of responders
+	return respondersUseCompression.size();
+}
+
+// Replay get responder uses compression
+bool Replay::getResponderUsesCompression(size_t index) const {
+
+	// Return if responder uses compression
+	return respondersUseCompression[index];
+}
+
+// Replay get next reply
+const Replay::Reply *Replay::getNextReply(size_t responderIndex) {
+
+	// Check if responder doesn't have replies
+	const vector<Reply> &replies = respondersReplies[responderIndex];
+	if(replies.empty()) {
+
+		// Return null
+		return nullptr;
+	}
+
+	// Get responder's next reply and cycle through its replies
+	const Reply *reply = &replies[respondersNextReply[responderIndex]];
+	respondersNextReply[responderIndex] = (respondersNextReply[responderIndex] + 1) % replies.size();
+
+	// Return reply
+	return reply;
+}
+
+// Replay get responder index
+size_t Replay::getResponderIndex(uint64_t connectionId) {
+
+	// Check if connection doesn't have a responder
+	const unordered_map<uint64_t, size_t>::const_iterator responderIndex = responderIndices.find(connectionId);
+	if(responderIndex == responderIndices.cend()) {
+
+		// Add responder for the connection
+		responderIndices.emplace(connectionId, respondersUseCompression.size());
+		respondersUseCompression.push_back(false);
+		respondersReplies.emplace_back();
+
+		// Return new responder's index
+		return respondersUseCompression.size() - 1;
+	}
+
+	// Return responder's index
+	return responderIndex->second;
+}
+
+// Responder constructor
+Responder::Responder(LoadGenerator *loadGenerator, size_t index, bool requestsCompression) :
+
+	// Set load generator
+	loadGenerator(loadGenerator),
+
+	// Set index
+	index(index),
+
+	// Set connection
+	connection(nullptr, bufferevent_free),
+
+	// Set requests compression
+	requestsCompression(requestsCompression),
+
+	// Set uses compression
+	usesCompression(false),
+
+	// Set handshake finished
+	handshakeFinished(false),
+
+	// Set message compressed
+	messageCompressed(false),
+
+	// Set message started
+	messageStarted(false)
+{
+}
+
+// Responder connect
+bool Responder::connect() {
+
+	// Check if using TLS
+	if(loadGenerator->getTlsContext()) {
+
+		// Check if creating TLS connection failed
+		unique_ptr<SSL, decltype(&SSL_free)> tlsConnection(SSL_new(loadGenerator->getTlsContext()), SSL_free);
+		if(!tlsConnection || !SSL_set_tlsext_host_name(tlsConnection.get(), loadGenerator->getAddress().c_str())) {
+
+			// Return false
+			return false;
+		}
+
+		// Check if creating connection failed
+		connection.reset(bufferevent_openssl_socket_new(loadGenerator->getEventBase(), -1, tlsConnection.get(), BUFFEREVENT_SSL_CONNECTING, BEV_OPT_CLOSE_ON_FREE | BEV_OPT_DEFER_CALLBACKS));
+		if(!connection) {
+
+			// Return false
+			return false;
+		}
+
+		// Release TLS connection
+		tlsConnection.release();
+	}
+
+	// Otherwise
+	else {
+
+		// Check if creating connection failed
+		connection.reset(bufferevent_socket_new(loadGenerator->getEventBase(), -1, BEV_OPT_CLOSE_ON_FREE | BEV_OPT_DEFER_CALLBACKS));
+		if(!connection) {
+
+			// Return false
+			return false;
+		}
+	}
+
+	// Set connection callbacks
+	bufferevent_setcb(connection.get(), readCallback, nullptr, eventCallback, this);
+
+	// Return if enabling reading and connecting to the gateway was successful
+	return !bufferevent_enable(connection.get(), EV_READ) && !bufferevent_socket_connect_hostname(connection.get(), nullptr, AF_UNSPEC, loadGenerator->getAddress().c_str(), loadGenerator->getPort());
+}
+
+// Responder get URL host
+const string &Responder::getUrlHost() const {
+
+	// Return URL host
+	return urlHost;
+}
+
+// Responder get URL path
+const string &Responder::getUrlPath() const {
+
+	// Return URL path
+	return urlPath;
+}
+
+// Responder get uses compression
+bool Responder::getUsesCompression() const {
+
+	// Return uses compression
+	return usesCompression;
+}
+
+// Responder read callback
+void Responder::readCallback(bufferevent *connection, void *argument) {
+
+	// Get responder from argument
+	Responder *responder = reinterpret_cast<Responder *>(argument);
+
+	// Get input
+	evbuffer *input = bufferevent_get_input(connection);
+
+	// Check if handshake isn't finished
+	if(!responder->handshakeFinished) {
+
+		// Check if finishing handshake failed
+		if(!responder->finishHandshake(input)) {
+
+			// Fail load generator
+			responder->loadGenerator->fail("Responder " + to_string(responder->index) + " WebSocket handshake failed");
+
+			// Return
+			return;
+		}
+
+		// Check if handshake still isn't finished
+		if(!responder->handshakeFinished) {
+
+			// Return
+			return;
+		}
+	}
+
+	// Check if reading frames failed
+	if(!responder->readFrames(input)) {
+
+		// Fail load generator
+		responder->loadGenerator->fail("Responder " + to_string(responder->index) + " received an invalid WebSocket message");
+	}
+}
+
+// Responder event callback
+void Responder::eventCallback(bufferevent *connection, short events, void *argument) {
+
+	// Get responder from argument
+	Responder *responder = reinterpret_cast<Responder *>(argument);
+
+	// Check if connected
+	if(events & BEV_EVENT_CONNECTED) {
+
+		// Create key
+		uint8_t randomKey[WEBSOCKET_KEY_LENGTH];
+		for(uint8_t &byte : randomKey) {
+
+			// Set byte to a random value
+			byte = responder->loadGenerator->getGenerator()();
+		}
+		responder->key.assign(Base64::getEncodedLength(sizeof(randomKey)), '\0');
+		Base64::encode(responder->key.data(), randomKey, sizeof(randomKey));
+
+		// Create handshake request
+		const string request = "GET / HTTP/1.1\r\nHost: " + responder->loadGenerator->getAddress() + ':' + to_string(responder->loadGenerator->getPort()) + "\r\nConnection: Upgrade\r\nUpgrade: websocket\r\nSec-WebSocket-Version: 13\r\nSec-WebSocket-Key: " + responder->key + "\r\n" + (responder->requestsCompression ? "Sec-WebSocket-Extensions: permessage-deflate\r\n" : "") + "\r\n";
+
+		// Check if sending handshake request failed
+		if(bufferevent_write(connection, request.data(), request.length())) {
+
+			// Fail load generator
+			responder->loadGenerator->fail("Responder " + to_string(responder->index) + " sending WebSocket handshake failed");
+		}
+	}
+
+	// Otherwise check if an error occurred or the connection closed
+	else if(events & (BEV_EVENT_ERROR | BEV_EVENT_EOF)) {
+
+		// Fail load generator
+		responder->loadGenerator->fail("Responder " + to_string(responder->index) + " connection closed");
+	}
+}
+
+// Responder reply callback
+void Responder::replyCallback(evutil_socket_t socket, short events, void *argument) {
+
+	// Get reply callback argument from argument
+	unique_ptr<pair<Responder *, Json::Number>> replyCallbackArgument(reinterpret_cast<pair<Responder *, Json::Number> *>(argument));
+
+	// Check if replying failed
+	Responder *responder = replyCallbackArgument->first;
+	if(!responder->reply(replyCallbackArgument->second)) {
+
+		// Fail load generator
+		responder->loadGenerator->fail("Responder " + to_string(responder->index) + " replying to interaction failed");
+	}
+}
+
+// Responder finish handshake
+bool Responder::finishHandshake(evbuffer *input) {
+
+	// Check if the response's headers aren't complete
+	const evbuffer_ptr endOfHeaders = evbuffer_search(input, HTTP_HEADERS_END, sizeof(HTTP_HEADERS_END) - sizeof('\0'), nullptr);
+	if(endOfHeaders.pos == -1) {
+
+		// Return if the headers aren't too large
+		return evbuffer_get_length(input) <= MAXIMUM_HEADERS_SIZE;
+	}
+
+	// Get headers
+	string headers(endOfHeaders.pos, '\0');
+	if(evbuffer_remove(input, headers.data(), headers.length()) != static_cast<int>(headers.length()) || evbuffer_drain(input, sizeof(HTTP_HEADERS_END) - sizeof('\0'))) {
+
+		// Return false
+		return false;
+	}
+
+	// Check if response isn't switching protocols
+	if(headers.compare(0, sizeof(HTTP_SWITCHING_PROTOCOLS_STATUS_LINE) - sizeof('\0'), HTTP_SWITCHING_PROTOCOLS_STATUS_LINE)) {
+
+		// Return false
+		return false;
+	}
+
+	// Go through all header lines after the status line
+	bool acceptKeyValid = false;
+	for(string::size_type startOfLine = headers.find("\r\n"); startOfLine != string::npos;) {
+
+		// Get line
+		startOfLine += sizeof("\r\n") - sizeof('\0');
+		const string::size_type endOfLine = headers.find("\r\n", startOfLine);
+		const string line = headers.substr(startOfLine, (endOfLine != string::npos) ? endOfLine - startOfLine : string::npos);
+		startOfLine = endOfLine;
+
+		// Check if line is a header
+		const string::size_type separator = line.find(':');
+		if(separator != string::npos) {
+
+			// Get header's name and value
+			const string name = Common::toLowerCase(Common::trim(line.substr(0, separator)));
+			const string value = Common::trim(line.substr(separator + sizeof(':')));
+
+			// Check if header is the accept key
+			if(name == "sec-websocket-accept") {
+
+				// Set accept key valid
+				acceptKeyValid = value == WebSocket::getAcceptKey(key);
+			}
+
+			// Otherwise check if header is the extensions
+			else if(name == "sec-websocket-extensions") {
+
+				// Set uses compression
+				usesCompression = requestsCompression && value.find("permessage-deflate") != string::npos;
+			}
+		}
+	}
+
+	// Check if accept key is invalid
+	if(!acceptKeyValid) {
+
+		// Return false
+		return false;
+	}
+
+	// Set handshake finished
+	handshakeFinished = true;
+
+	// Return if requesting a URL was successful
+	return sendMessage(CREATE_URL_REQUEST_TEMPLATE.fill(static_cast<Json::Number>(index)), WebSocket::Opcode::TEXT);
+}
+
+// Responder read frames
+bool Responder::readFrames(evbuffer *input) {
+
+	// Loop while input contains a frame's header
+	for(size_t length = evbuffer_get_length(input); length > WebSocket::LENGTH_BYTE_OFFSET; length = evbuffer_get_length(input)) {
+
+		// Get frame's first bytes
+		const uint8_t *data = evbuffer_pullup(input, min(length, WebSocket::LENGTH_BYTE_OFFSET + sizeof(uint8_t) + sizeof(uint64_t)));
+		if(!data) {
+
+			// Return false
+			return false;
+		}
+
+		// Check if frame is masked
+		if(data[WebSocket::MASK_BYTE_OFFSET] & WebSocket::MASK_BYTE_MASK) {
+
+			// Return false
+			return false;
+		}
+
+		// Get frame's length
+		uint64_t frameLength = data[WebSocket::LENGTH_BYTE_OFFSET] & WebSocket::LENGTH_BYTE_MASK;
+		size_t headerLength = WebSocket::LENGTH_BYTE_OFFSET + sizeof(uint8_t);
+		const size_t extendedLengthSize = (frameLength == WebSocket::SIXTY_THREE_BITS_LENGTH) ? sizeof(uint64_t) : ((frameLength == WebSocket::SIXTEEN_BITS_LENGTH) ? sizeof(uint16_t) : 0);
+		if(extendedLengthSize) {
+
+			// Check if input doesn't contain the extended length
+			if(length < headerLength + extendedLengthSize) {
+
+				// Return true
+				return true;
+			}
+
+			// Go through all extended length bytes
+			frameLength = 0;
+			for(size_t i = 0; i < extendedLengthSize; ++i) {
+
+				// Append extended length byte to the frame's length
+				frameLength = (frameLength << Common::BITS_IN_A_BYTE) | data[headerLength + i];
+			}
+
+			// Update header length
+			headerLength += extendedLengthSize;
+		}
+
+		// Check if frame is too large
+		if(frameLength > MAXIMUM_WEBSOCKET_MESSAGE_SIZE - partialMessage.size()) {
+
+			// Return false
+			return false;
+		}
+
+		// Check if input doesn't contain the frame
+		if(length < headerLength + frameLength) {
+
+			// Return true
+			return true;
+		}
+
+		// Get frame's opcode, is final frame, and is compressed
+		const WebSocket::Opcode opcode = static_cast<WebSocket::Opcode>(data[WebSocket::OPCODE_BYTE_OFFSET] & WebSocket::OPCODE_BYTE_MASK);
+		const bool isFinalFrame = data[WebSocket::FINAL_FRAME_BYTE_OFFSET] & WebSocket::FINAL_FRAME_BYTE_MASK;
+		const bool isCompressed = data[WebSocket::EXTENSION_BYTE_OFFSET] & WebSocket::COMPRESSED_EXTENSION_BYTE_MASK;
+
+		// Check if removing frame's header failed
+		if(evbuffer_drain(input, headerLength)) {
+
+			// Return false
+			return false;
+		}
+
+		// Get frame's payload
+		string payload(frameLength, '\0');
+		if(evbuffer_remove(input, payload.data(), frameLength) != static_cast<int>(frameLength)) {
+
+			// Return false
+			return false;
+		}
+
+		// Check opcode
+		switch(opcode) {
+
+			// Text
+			case WebSocket::Opcode::TEXT:
+
+				// Check if a message was already started
+				if(messageStarted) {
+
+					// Return false
+					return false;
+				}
+
+				// Start message
+				messageStarted = true;
+				messageCompressed = isCompressed;
+				partialMessage = move(payload);
+
+				// Break
+				break;
+
+			// Continuation
+			case WebSocket::Opcode::CONTINUATION:
+
+				// Check if a message wasn't started
+				if(!messageStarted) {
+
+					// Return false
+					return false;
+				}
+
+				// Append payload to the message
+				partialMessage += payload;
+
+				// Break
+				break;
+
+			// Ping
+			case WebSocket::Opcode::PING:
+
+				// Check if sending pong failed
+				if(!sendMessage(payload, WebSocket::Opcode::PONG)) {
+
+					// Return false
+					return false;
+				}
+
+				// Continue
+				continue;
+
+			// Pong
+			case WebSocket::Opcode::PONG:
+
+				// Continue
+				continue;
+
+			// Default
+			default:
+
+				// Return false
+				return false;
+		}
+
+		// Check if message is complete
+		if(isFinalFrame) {
+
+			// Check if message is compressed
+			string decompressedMessage;
+			if(messageCompressed) {
+
+				// Check if decompressing message failed
+				partialMessage.append(WebSocket::COMPRESSED_MESSAGE_TAIL.begin(), WebSocket::COMPRESSED_MESSAGE_TAIL.end());
+				if(!Common::inflateUtf8(decompressedMessage, partialMessage)) {
+
+					// Return false
+					return false;
+				}
+			}
+
+			// End message
+			messageStarted = false;
+
+			// Check if handling message failed
+			if(!handleMessage(messageCompressed ? decompressedMessage : partialMessage)) {
+
+				// Return false
+				return false;
+			}
+
+			// Clear message
+			partialMessage.clear();
+		}
+	}
+
+	// Return true
+	return true;
+}
+
+// Responder handle message
+bool Responder::handleMessage(const string &message) {
+
+	// Check if decoding message failed
+	Json json;
+	if(!json.decode(message) || json.getType() != Json::Type::OBJECT) {
+
+		// Return false
+		return false;
+	}
+
+	// Get message's members
+	const Json::Object &members = json.getObjectValue();
+
+	// Check if message is an interaction
+	if(members.count("Interaction") && members.at("Interaction")->getType() == Json::Type::NUMBER) {
+
+		// Check if message is an interaction request
+		if(members.count("Data")) {
+
+			// Get interaction index
+			const Json::Number interactionIndex = members.at("Interaction")->getNumberValue();
+
+			// Check if not thinking before replying
+			if(!loadGenerator->getThinkTimeMilliseconds()) {
+
+				// Return if replying was successful
+				return reply(interactionIndex);
+			}
+
+			// Set think time
+			const timeval thinkTime = {
+
+				// Seconds
+				.tv_sec = static_cast<decltype(timeval::tv_sec)>(loadGenerator->getThinkTimeMilliseconds() / Common::MILLISECONDS_IN_A_SECOND),
+
+				// Microseconds
+				.tv_usec = static_cast<decltype(timeval::tv_usec)>(loadGenerator->getThinkTimeMilliseconds() % Common::MILLISECONDS_IN_A_SECOND * Common::MICROSECONDS_IN_A_MILLISECOND)
+			};
+
+			// Check if scheduling reply failed
+			unique_ptr<pair<Responder *, Json::Number>> replyCallbackArgument = make_unique<pair<Responder *, Json::Number>>(this, interactionIndex);
+			if(event_base_once(loadGenerator->getEventBase(), -1, EV_TIMEOUT, replyCallback, replyCallbackArgument.get(), &thinkTime)) {
+
+				// Return false
+				return false;
+			}
+
+			// Release reply callback argument
+			replyCallbackArgument.release();
+		}
+
+		// Return true
+		return true;
+	}
+
+	// Check if message is a URL response
+	if(members.count("Index") && members.count("Response") && members.at("Response")->getType() == Json::Type::STRING) {
+
+		// Check if URL doesn't have a host and path
+		const string &url = members.at("Response")->getStringValue();
+		const string::size_type startOfHost = url.find("://");
+		const string::size_type startOfPath = (startOfHost != string::npos) ? url.find('/', startOfHost + sizeof("://") - sizeof('\0')) : string::npos;
+		if(startOfPath == string::npos) {
+
+			// Return false
+			return false;
+		}
+
+		// Set URL host and path
+		urlHost = url.substr(startOfHost + sizeof("://") - sizeof('\0'), startOfPath - (startOfHost + sizeof("://") - sizeof('\0')));
+		urlPath = url.substr(startOfPath);
+
+		// Notify load generator that the responder is ready
+		loadGenerator->responderReady();
+
+		// Return true
+		return true;
+	}
+
+	// Return if message isn't an error
+	return !members.count("Error");
+}
+
+// Responder reply
+bool Responder::reply(Json::Number interactionIndex) {
+
+	// Check if replaying and the recorded connection replied to interactions
+	const Replay::Reply *replayedReply = loadGenerator->getReplay() ? loadGenerator->getReplay()->getNextReply(index) : nullptr;
+	if(replayedReply) {
+
+		// Check if sending replayed reply failed
+		if(!sendMessage(REPLAYED_INTERACTION_REPLY_TEMPLATE.fill(interactionIndex, replayedReply->status, string_view(replayedReply->type), string_view(replayedReply->data)), WebSocket::Opcode::TEXT)) {
+
+			// Return false
+			return false;
+		}
+
+		// Notify load generator that an interaction was replied to
+		loadGenerator->interactionReplied(Base64::getDecodedLength(replayedReply->data.data(), replayedReply->data.size()));
+
+		// Return true
+		return true;
+	}
+
+	// Get random reply
+	const pair<size_t, const string *> reply = loadGenerator->getRandomReply();
+
+	// Check if sending reply failed
+	if(!sendMessage(INTERACTION_REPLY_TEMPLATE.fill(interactionIndex, static_cast<Json::Number>(HTTP_OK), string_view(*reply.second)), WebSocket::Opcode::TEXT)) {
+
+		// Return false
+		return false;
+	}
+
+	// Notify load generator that an interaction was replied to
+	loadGenerator->interactionReplied(reply.first);
+
+	// Return true
+	return true;
+}
+
+// Responder send message
+bool Responder::sendMessage(const string &message, WebSocket::Opcode opcode) {
+
+	// Initialize payload
+	const uint8_t *payload = reinterpret_cast<const uint8_t *>(message.data());
+	size_t payloadLength = message.size();
+
+	// Check if compressing the message
+	unique_ptr<evbuffer, decltype(&evbuffer_free)> compressedMessage(nullptr, evbuffer_free);
+	bool compress = false;
+	if(usesCompression && opcode == WebSocket::Opcode::TEXT && payloadLength >= MINIMUM_COMPRESSION_LENGTH) {
+
+		// Check if creating and deflating compressed message failed
+		compressedMessage.reset(evbuffer_new());
+		if(!compressedMessage || !Common::deflate(compressedMessage.get(), payload, payloadLength) || evbuffer_add(compressedMessage.get(), &Common::DEFLATE_BFINAL_FLAG, sizeof(Common::DEFLATE_BFINAL_FLAG))) {
+
+			// Return false
+			return false;
+		}
+
+		// Check if compressed message is smaller than the message
+		const size_t compressedMessageLength = evbuffer_get_length(compressedMessage.get());
+		if(compressedMessageLength < payloadLength) {
+
+			// Check if making compressed message contiguous failed
+			payload = evbuffer_pullup(compressedMessage.get(), compressedMessageLength);
+			if(!payload) {
+
+				// Return false
+				return false;
+			}
+
+			// Set payload length and compress
+			payloadLength = compressedMessageLength;
+			compress = true;
+		}
+	}
+
+	// Create mask
+	uint8_t mask[WebSocket::MASK_LENGTH];
+	for(uint8_t &byte : mask) {
+
+		// Set byte to a random value
+		byte = loadGenerator->getGenerator()();
+	}
+
+	// Create frame with the payload masked since masking and unmasking are the same operation
+	vector<uint8_t> frame;
+	frame.reserve(payloadLength + sizeof(uint8_t) + sizeof(uint8_t) + sizeof(uint64_t) + sizeof(mask));
+	WebSocket::appendFrameHeader(frame, opcode, true, compress, payloadLength, mask);
+	const size_t headerLength = frame.size();
+	frame.resize(headerLength + payloadLength);
+	WebSocket::unmask(&frame[headerLength], payload, payloadLength, mask, nullptr);
+
+	// Return if sending frame was successful
+	return !bufferevent_write(connection.get(), frame.data(), frame.size());
+}
+
+// Load generator constructor
+LoadGenerator::LoadGenerator(event_base *eventBase, SSL_CTX *tlsContext, const string &address, uint16_t port, const string &torAddress, uint16_t torPort, size_t numberOfConnections, unsigned int deflatePercent, uint64_t numberOfRequests, size_t concurrency, unsigned int gzipPercent, const SizeDistribution &requestSizes, const SizeDistribution &replySizes, uint64_t thinkTimeMilliseconds, pid_t gatewayProcessId, Replay *replay, unsigned long long replaySpeed) :
+
+	// Set event base
+	eventBase(eventBase),
+
+	// Set TLS context
+	tlsContext(tlsContext),
+
+	// Set address
+	address(address),
+
+	// Set port
+	port(port),
+
+	// Set Tor address
+	torAddress(torAddress),
+
+	// Set Tor port
+	torPort(torPort),
+
+	// Set number of requests to the number of replayed requests if replaying
+	numberOfRequests(replay ? replay->getRequests().size() : numberOfRequests),
+
+	// Set gzip percent
+	gzipPercent(gzipPercent),
+
+	// Set request sizes
+	requestSizes(requestSizes),
+
+	// Set reply sizes
+	replySizes(replySizes),
+
+	// Set think time milliseconds
+	thinkTimeMilliseconds(thinkTimeMilliseconds),
+
+	// Set gateway process ID
+	gatewayProcessId(gatewayProcessId),
+
+	// Set generator
+	generator(random_device()()),
+
+	// Set number of ready responders
+	numberOfReadyResponders(0),
+
+	// Set number of sent requests
+	numberOfSentRequests(0),
+
+	// Set number of due requests to none if replaying in real time
+	numberOfDueRequests((replay && replaySpeed != UNLIMITED_REPLAY_SPEED) ? 0 : this->numberOfRequests),
+
+	// Set replay
+	replay(replay),
+
+	// Set replay speed
+	replaySpeed(replaySpeed),
+
+	// Set replay event
+	replayEvent(nullptr, event_free),
+
+	// Set number of completed requests
+	numberOfCompletedRequests(0),
+
+	// Set number of failed requests
+	numberOfFailedRequests(0),
+
+	// Set number of replied interactions
+	numberOfRepliedInteractions(0),
+
+	// Set request bytes
+	requestBytes(0),
+
+	// Set response bytes
+	responseBytes(0),
+
+	// Set reply bytes
+	replyBytes(0),
+
+	// Set gateway start CPU time
+	gatewayStartCpuTime(NAN),
+
+	// Set running
+	running(false),
+
+	// Set succeeded
+	succeeded(false)
+{
+
+	// Fill body with random characters so it compresses like text
+	uniform_int_distribution<size_t> distribution(0, sizeof(BODY_CHARACTERS) - sizeof('\0') - 1);
+	body.resize(max(requestSizes.getMaximumSize(), replySizes.getMaximumSize()));
+	for(char &character : body) {
+
+		// Set character to a random body character
+		character = BODY_CHARACTERS[distribution(generator)];
+	}
+
+	// Go through all reply sizes
+	for(size_t i = 0; i < replySizes.getNumberOfSizes(); ++i) {
+
+		// Append encoded reply to the encoded replies
+		string encodedReply(Base64::getEncodedLength(replySizes.getSize(i)), '\0');
+		Base64::encode(encodedReply.data(), reinterpret_cast<const uint8_t *>(body.data()), replySizes.getSize(i));
+		encodedReplies.push_back(move(encodedReply));
+	}
+
+	// Check if replaying
+	if(replay) {
+
+		// Go through all replayed responders
+		for(size_t i = 0; i < replay->getNumberOfResponders(); ++i) {
+
+			// Create responder that requests compression if the recorded connection used it
+			responders.push_back(make_unique<Responder>(this, i, replay->getResponderUsesCompression(i)));
+		}
+	}
+
+	// Otherwise
+	else {
+
+		// Go through all connections
+		for(size_t i = 0; i < numberOfConnections; ++i) {
+
+			// Create responder that requests compression for the deflate percent of connections
+			responders.push_back(make_unique<Responder>(this, i, i * PERCENT_SCALE < deflatePercent * numberOfConnections));
+		}
+	}
+
+	// Go through all concurrent requests
+	for(size_t i = 0; i < concurrency; ++i) {
+
+		// Append no connection
+		connections.emplace_back(nullptr, evhttp_connection_free);
+	}
+
+	// Reserve space for the latencies
+	latencies.reserve(this->numberOfRequests);
+}
+
+// Load generator start
+bool LoadGenerator::start() {
+
+	// Display message
+	cout << "Connecting " << responders.size() << " responders to " << (tlsContext ? "wss" : "ws") << "://" << address << ':' << port << endl;
+
+	// Go through all responders
+	for(unique_ptr<Responder> &responder : responders) {
+
+		// Check if connecting responder failed
+		if(!responder->connect()) {
+
+			// Display message
+			cout << "Connecting responder failed" << endl;
+
+			// Return false
+			return false;
+		}
+	}
+
+	// Return true
+	return true;
+}
+
+// Load generator stop
+void LoadGenerator::stop() {
+
+	// Check if running
+	if(running) {
+
+		// Display message
+		cout << "Interrupted" << endl;
+
+		// Report results so far
+		report();
+	}
+
+	// Break out of event dispatch loop
+	event_base_loopbreak(eventBase);
+}
+
+// Load generator fail
+void LoadGenerator::fail(const string &reason) {
+
+	// Display message
+	cout << reason << endl;
+
+	// Stop
+	stop();
+}
+
+// Load generator get succeeded
+bool LoadGenerator::getSucceeded() const {
+
+	// Return succeeded
+	return succeeded;
+}
+
+// Load generator get event base
+event_base *LoadGenerator::getEventBase() const {
+
+	// Return event base
+	return eventBase;
+}
+
+// Load generator get TLS context
+SSL_CTX *LoadGenerator::getTlsContext() const {
+
+	// Return TLS context
+	return tlsContext;
+}
+
+// Load generator get address
+const string &LoadGenerator::getAddress() const {
+
+	// Return address
+	return address;
+}
+
+// Load generator get port
+uint16_t LoadGenerator::getPort() const {
+
+	// Return port
+	return port;
+}
+
+// Load generator get think time milliseconds
+uint64_t LoadGenerator::getThinkTimeMilliseconds() const {
+
+	// Return think time milliseconds
+	return thinkTimeMilliseconds;
+}
+
+// Load generator get generator
+mt19937 &LoadGenerator::getGenerator() {
+
+	// Return generator
+	return generator;
+}
+
+// Load generator get replay
+Replay *LoadGenerator::getReplay() const {
+
+	// Return replay
+	return replay;
+}
+
+// Load generator get random reply
+pair<size_t, const string *> LoadGenerator::getRandomReply() {
+
+	// Get random reply size's index
+	const size_t index = replySizes.getRandomIndex(generator);
+
+	// Return reply's size and encoded reply
+	return make_pair(replySizes.getSize(index), &encodedReplies[index]);
+}
+
+// Load generator responder ready
+void LoadGenerator::responderReady() {
+
+	// Check if not all responders are ready
+	if(++numberOfReadyResponders != responders.size()) {
+
+		// Return
+		return;
+	}
+
+	// Check if replaying
+	if(replay) {
+
+		// Display message
+		cout << "Created " << responders.size() << " URLs, replaying " << numberOfRequests << " requests to http://" << torAddress << ':' << torPort << " with a concurrency of " << connections.size() << " at " << ((replaySpeed == UNLIMITED_REPLAY_SPEED) ? "maximum" : to_string(replaySpeed) + "x") << " speed" << endl;
+	}
+
+	// Otherwise
+	else {
+
+		// Display message
+		cout << "Created " << responders.size() << " URLs, sending " << numberOfRequests << " requests to http://" << torAddress << ':' << torPort << " with a concurrency of " << connections.size() << endl;
+	}
+
+	// Set running
+	running = true;
+
+	// Set start time
+	startTime = chrono::steady_clock::now();
+
+	// Set gateway start CPU time
+	gatewayStartCpuTime = gatewayProcessId ? getProcessCpuTime(gatewayProcessId) : NAN;
+
+	// Go through all connections
+	for(size_t i = 0; i < connections.size(); ++i) {
+
+		// Check if creating connection failed
+		connections[i].reset(evhttp_connection_base_new(eventBase, nullptr, torAddress.c_str(), torPort));
+		if(!connections[i]) {
+
+			// Fail
+			fail("Creating Tor-side connection failed");
+
+			// Return
+			return;
+		}
+
+		// Check if sending request failed
+		if(!sendRequest(i)) {
+
+			// Fail
+			fail("Sending request failed");
+
+			// Return
+			return;
+		}
+	}
+
+	// Check if replaying in real time
+	if(replay && replaySpeed != UNLIMITED_REPLAY_SPEED) {
+
+		// Check if creating replay event failed
+		replayEvent.reset(evtimer_new(eventBase, replayCallback, this));
+		if(!replayEvent) {
+
+			// Fail
+			fail("Creating replay event failed");
+
+			// Return
+			return;
+		}
+
+		// Check if releasing due requests failed
+		if(!releaseDueRequests()) {
+
+			// Fail
+			fail("Sending request failed");
+		}
+	}
+}
+
+// Load generator interaction replied
+void LoadGenerator::interactionReplied(size_t length) {
+
+	// Increment number of replied interactions
+	++numberOfRepliedInteractions;
+
+	// Add length to the reply bytes
+	replyBytes += length;
+}
+
+// Load generator request callback
+void LoadGenerator::requestCallback(evhttp_request *request, void *argument) {
+
+	// Get request callback argument from argument
+	unique_ptr<tuple<LoadGenerator *, size_t, chrono::steady_clock::time_point>> requestCallbackArgument(reinterpret_cast<tuple<LoadGenerator *, size_t, chrono::steady_clock::time_point> *>(argument));
+
+	// Get load generator from request callback argument
+	LoadGenerator *loadGenerator = get<0>(*requestCallbackArgument);
+
+	// Check if not running
+	if(!loadGenerator->running) {
+
+		// Return
+		return;
+	}
+
+	// Record request's latency
+	loadGenerator->latencies.push_back(chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - get<2>(*requestCallbackArgument)).count());
+
+	// Check if request succeeded
+	if(request && evhttp_request_get_response_code(request) == HTTP_OK) {
+
+		// Add response's length to the response bytes
+		loadGenerator->responseBytes += evbuffer_get_length(evhttp_request_get_input_buffer(request));
+	}
+
+	// Otherwise
+	else {
+
+		// Increment number of failed requests
+		++loadGenerator->numberOfFailedRequests;
+	}
+
+	// Check if all requests completed
+	if(++loadGenerator->numberOfCompletedRequests == loadGenerator->numberOfRequests) {
+
+		// Set succeeded
+		loadGenerator->succeeded = !loadGenerator->numberOfFailedRequests;
+
+		// Report
+		loadGenerator->report();
+
+		// Clear running
+		loadGenerator->running = false;
+
+		// Break out of event dispatch loop
+		event_base_loopbreak(loadGenerator->eventBase);
+	}
+
+	// Otherwise check if sending next request failed
+	else if(!loadGenerator->sendRequest(get<1>(*requestCallbackArgument))) {
+
+		// Fail
+		loadGenerator->fail("Sending request failed");
+	}
+}
+
+// Load generator replay callback
+void LoadGenerator::replayCallback(evutil_socket_t socket, short events, void *argument) {
+
+	// Get load generator from argument
+	LoadGenerator *loadGenerator = reinterpret_cast<LoadGenerator *>(argument);
+
+	// Check if running and releasing due requests failed
+	if(loadGenerator->running && !loadGenerator->releaseDueRequests()) {
+
+		// Fail
+		loadGenerator->fail("Sending request failed");
+	}
+}
+
+// Load generator send request
+bool LoadGenerator::sendRequest(size_t slot) {
+
+	// Check if all due requests were sent
+	if(numberOfSentRequests == numberOfDueRequests) {
+
+		// Add slot to the free slots
+		freeSlots.push_back(slot);
+
+		// Return true
+		return true;
+	}
+
+	// Check if replaying
+	const Replay::Request *replayedRequest = replay ? &replay->getRequests()[numberOfSentRequests] : nullptr;
+
+	// Get responder whose URL the request is for
+	const Responder &responder = *responders[(replayedRequest && replayedRequest->responderIndex != Replay::UNROUTED_RESPONDER_INDEX) ? replayedRequest->responderIndex : numberOfSentRequests % responders.size()];
+	++numberOfSentRequests;
+
+	// Check if creating request failed
+	unique_ptr<tuple<LoadGenerator *, size_t, chrono::steady_clock::time_point>> requestCallbackArgument = make_unique<tuple<LoadGenerator *, size_t, chrono::steady_clock::time_point>>(this, slot, chrono::steady_clock::now());
+	evhttp_request *request = evhttp_request_new(requestCallback, requestCallbackArgument.get());
+	if(!request) {
+
+		// Return false
+		return false;
+	}
+
+	// Get request's body, content type, accept encoding, and path from the replayed request or randomly
+	const size_t size = replayedRequest ? replayedRequest->body.size() : requestSizes.getSize(requestSizes.getRandomIndex(generator));
+	const char *data = replayedRequest ? replayedRequest->body.data() : body.data();
+	const string contentType = replayedRequest ? replayedRequest->contentType : "text/plain";
+	const string acceptEncoding = replayedRequest ? replayedRequest->acceptEncoding : ((uniform_int_distribution<unsigned int>(0, PERCENT_SCALE - 1)(generator) < gzipPercent) ? "gzip" : "identity");
+	const string path = (replayedRequest && replayedRequest->responderIndex == Replay::UNROUTED_RESPONDER_INDEX) ? replayedRequest->api : responder.getUrlPath() + (replayedRequest ? replayedRequest->api : "/loadgen");
+
+	// Check if setting request's headers and body failed
+	evkeyvalq *headers = evhttp_request_get_output_headers(request);
+	if(evhttp_add_header(headers, "Host", responder.getUrlHost().c_str()) || (!contentType.empty() && evhttp_add_header(headers, "Content-Type", contentType.c_str())) || evhttp_add_header(headers, "Connection", "close") || (!acceptEncoding.empty() && evhttp_add_header(headers, "Accept-Encoding", acceptEncoding.c_str())) || evbuffer_add(evhttp_request_get_output_buffer(request), data, size)) {
+
+		// Free request
+		evhttp_request_free(request);
+
+		// Return false
+		return false;
+	}
+
+	// Check if making request failed
+	if(evhttp_make_request(connections[slot].get(), request, EVHTTP_REQ_POST, path.c_str())) {
+
+		// Return false
+		return false;
+	}
+
+	// Release request callback argument
+	requestCallbackArgument.release();
+
+	// Add size to the request bytes
+	requestBytes += size;
+
+	// Return true
+	return true;
+}
+
+// Load generator release due requests
+bool LoadGenerator::releaseDueRequests() {
+
+	// Get replayed time that has passed
+	const vector<Replay::Request> &requests = replay->getRequests();
+	const chrono::nanoseconds replayedTime = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - startTime) * replaySpeed;
+
+	// Go through all requests that are due
+	while(numberOfDueRequests < numberOfRequests && requests[numberOfDueRequests].time - requests.front().time <= replayedTime) {
+
+		// Increment number of due requests
+		++numberOfDueRequests;
+	}
+
+	// Go through all free slots while due requests haven't been sent
+	while(!freeSlots.empty() && numberOfSentRequests < numberOfDueRequests) {
+
+		// Get free slot
+		const size_t slot = freeSlots.back();
+		freeSlots.pop_back();
+
+		// Check if sending request failed
+		if(!sendRequest(slot)) {
+
+			// Return false
+			return false;
+		}
+	}
+
+	// Check if requests that aren't due remain
+	if(numberOfDueRequests < numberOfRequests) {
+
+		// Get delay until the next request is due
+		const chrono::microseconds delay = chrono::duration_cast<chrono::microseconds>((requests[numberOfDueRequests].time - requests.front().time - replayedTime) / replaySpeed);
+
+		// Set replay time
+		const timeval replayTime = {
+
+			// Seconds
+			.tv_sec = static_cast<decltype(timeval::tv_sec)>(delay.count() / Common::MICROSECONDS_IN_A_MILLISECOND / Common::MILLISECONDS_IN_A_SECOND),
+
+			// Microseconds
+			.tv_usec = static_cast<decltype(timeval::tv_usec)>(delay.count() % (Common::MICROSECONDS_IN_A_MILLISECOND * Common::MILLISECONDS_IN_A_SECOND))
+		};
+
+		// Return if scheduling replay event was successful
+		return !evtimer_add(replayEvent.get(), &replayTime);
+	}
+
+	// Return true
+	return true;
+}
+
+// Load generator report
+void LoadGenerator::report() const {
+
+	// Get duration in seconds
+	const double duration = chrono::duration<double>(chrono::steady_clock::now() - startTime).count();
+
+	// Get sorted latencies
+	vector<uint64_t> sortedLatencies = latencies;
+	sort(sortedLatencies.begin(), sortedLatencies.end());
+
+	// Get percentile
+	const auto getPercentile = [&sortedLatencies](double percentile) -> uint64_t {
+
+		// Return latency at the percentile or zero if there are no latencies
+		return sortedLatencies.empty() ? 0 : sortedLatencies[min(sortedLatencies.size() - 1, static_cast<size_t>(ceil(percentile * sortedLatencies.size())) - 1)];
+	};
+
+	// Display results
+	cout << "Requests:\t" << numberOfCompletedRequests << " completed, " << numberOfFailedRequests << " failed, " << numberOfRepliedInteractions << " interactions replied to" << endl;
+	cout << "Duration:\t" << duration << " s" << endl;
+	cout << "Throughput:\t" << numberOfCompletedRequests / duration << " requests/s, " << requestBytes / duration / 1024 / 1024 << " MiB/s sent, " << responseBytes / duration / 1024 / 1024 << " MiB/s received, " << replyBytes / duration / 1024 / 1024 << " MiB/s replied" << endl;
+	cout << "Latency:\tp50 " << getPercentile(0.5) << " us, p99 " << getPercentile(0.99) << " us, p999 " << getPercentile(0.999) << " us, max " << (sortedLatencies.empty() ? 0 : sortedLatencies.back()) << " us" << endl;
+
+	// Check if gateway process ID exists
+	if(gatewayProcessId) {
+
+		// Check if getting gateway's CPU time failed
+		const double gatewayCpuTime = getProcessCpuTime(gatewayProcessId) - gatewayStartCpuTime;
+		if(isnan(gatewayCpuTime)) {
+
+			// Display message
+			cout << "Gateway CPU:\tunavailable" << endl;
+		}
+
+		// Otherwise
+		else {
+
+			// Display gateway's CPU usage
+			cout << "Gateway CPU:\t" << gatewayCpuTime << " s, " << gatewayCpuTime / duration * PERCENT_SCALE << "% of one core" << endl;
+		}
+	}
+}
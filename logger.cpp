@@ -0,0 +1,430 @@
+// Header files
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+#include "json.h"
+#include "logger.h"
+#include "metrics.h"
+
+using namespace std;
+
+
+// Constants
+
+// No connection
+const uint64_t Logger::NO_CONNECTION = 0;
+
+// Level names
+const char *Logger::LEVEL_NAMES[] = {
+
+	// Debug
+	"debug",
+
+	// Info
+	"info",
+
+	// Warning
+	"warning",
+
+	// Failure
+	"error"
+};
+
+// Format names
+const char *Logger::FORMAT_NAMES[] = {
+
+	// Text
+	"text",
+
+	// JSON
+	"json"
+};
+
+// Flush interval
+const chrono::milliseconds Logger::FLUSH_INTERVAL(10);
+
+// Record template
+static const Json::Template<5> RECORD_TEMPLATE({
+	{"Time", Json()},
+	{"Level", Json()},
+	{"Connection", Json()},
+	{"Message", Json()},
+	{"Detail", Json()}
+});
+
+
+// Global variables
+
+// Level
+atomic<Logger::Level> Logger::level(Logger::Level::INFO);
+
+// Format
+Logger::Format Logger::format = Logger::Format::TEXT;
+
+// Started
+atomic_bool Logger::started(false);
+
+// Running
+atomic_bool Logger::running(false);
+
+// Writer
+thread Logger::writer;
+
+// Rings lock
+mutex Logger::ringsLock;
+
+// Rings
+vector<unique_ptr<Logger::Ring>> Logger::rings;
+
+// Thread ring
+thread_local Logger::Ring *Logger::threadRing = nullptr;
+
+
+// Supporting function implementation
+
+// Get level
+bool Logger::getLevel(const char *name, Level &level) {
+
+	// Go through all levels
+	for(size_t i = 0; i < static_cast<size_t>(Level::NUMBER_OF_LEVELS); ++i) {
+
+		// Check if level's name is the name
+		if(!strcmp(LEVEL_NAMES[i], name)) {
+
+			// Set level
+			level = static_cast<Level>(i);
+
+			// Return true
+			return true;
+		}
+	}
+
+	// Return false
+	return false;
+}
+
+// Get format
+bool Logger::getFormat(const char *name, Format &format) {
+
+	// Go through all formats
+	for(size_t i = 0; i < sizeof(FORMAT_NAMES) / sizeof(FORMAT_NAMES[0]); ++i) {
+
+		// Check if format's name is the name
+		if(!strcmp(FORMAT_NAMES[i], name)) {
+
+			// Set format
+			format = static_cast<Format>(i);
+
+			// Return true
+			return true;
+		}
+	}
+
+	// Return false
+	return false;
+}
+
+// Start
+bool Logger::start(Level level, Format format) {
+
+	// Set level and format
+	Logger::level.store(level, memory_order_relaxed);
+	Logger::format = format;
+
+	// Set running
+	running.store(true);
+
+	// Try
+	try {
+
+		// Create writer
+		writer = thread(run);
+	}
+
+	// Catch errors
+	catch(...) {
+
+		// Clear running
+		running.store(false);
+
+		// Return false
+		return false;
+	}
+
+	// Set started so that records are logged to the rings
+	started.store(true);
+
+	// Check if registering stop to run when the program exits failed
+	if(atexit(stop) || at_quick_exit(stop)) {
+
+		// Stop
+		stop();
+
+		// Return false
+		return false;
+	}
+
+	// Return true
+	return true;
+}
+
+// Stop
+void Logger::stop() {
+
+	// Check if started
+	if(started.exchange(false)) {
+
+		// Clear running
+		running.store(false);
+
+		// Wait for the writer to write the remaining records
+		writer.join();
+	}
+}
+
+// Is enabled
+bool Logger::isEnabled(Level level) {
+
+	// Return if level is at least the logged level
+	return level >= Logger::level.load(memory_order_relaxed);
+}
+
+// Log
+void Logger::log(Level level, const string_view &message, uint64_t connectionId, const string_view &detail) {
+
+	// Check if level isn't enabled
+	if(!isEnabled(level)) {
+
+		// Return
+		return;
+	}
+
+	// Create record
+	Record record;
+	createRecord(record, level, message, connectionId, detail);
+
+	// Check if started
+	if(started.load()) {
+
+		// Check if the thread's ring is full
+		if(!getRing().push(record)) {
+
+			// Update log records dropped metric
+			Metrics::logRecordsDropped.increment();
+		}
+	}
+
+	// Otherwise
+	else {
+
+		// Write record to the standard output since there's no writer
+		string output;
+		writeRecord(output, record);
+		cout.write(output.data(), output.size());
+		cout.flush();
+	}
+}
+
+// Ring constructor
+Logger::Ring::Ring() :
+
+	// Set head
+	head(0),
+
+	// Set tail
+	tail(0)
+{
+}
+
+// Ring push
+bool Logger::Ring::push(const Record &record) {
+
+	// Check if ring is full
+	const size_t currentHead = head.load(memory_order_relaxed);
+	if(currentHead - tail.load(memory_order_acquire) == RING_CAPACITY) {
+
+		// Return false
+		return false;
+	}
+
+	// Copy record into the ring and publish it to the writer
+	records[currentHead % RING_CAPACITY] = record;
+	head.store(currentHead + 1, memory_order_release);
+
+	// Return true
+	return true;
+}
+
+// Ring pop
+bool Logger::Ring::pop(Record &record) {
+
+	// Check if ring is empty
+	const size_t currentTail = tail.load(memory_order_relaxed);
+	if(currentTail == head.load(memory_order_acquire)) {
+
+		// Return false
+		return false;
+	}
+
+	// Copy record out of the ring and release its slot to the producer
+	record = records[currentTail % RING_CAPACITY];
+	tail.store(currentTail + 1, memory_order_release);
+
+	// Return true
+	return true;
+}
+
+// Get ring
+Logger::Ring &Logger::getRing() {
+
+	// Check if thread doesn't have a ring
+	if(!threadRing) {
+
+		// Add ring to the rings, which outlive the thread so that the writer can still drain them
+		lock_guard<mutex> guard(ringsLock);
+		rings.push_back(make_unique<Ring>());
+
+		// Set thread ring
+		threadRing = rings.back().get();
+	}
+
+	// Return thread ring
+	return *threadRing;
+}
+
+// Run
+void Logger::run() {
+
+	// Loop until stopped and all rings have been drained
+	uint64_t numberOfReportedDroppedRecords = 0;
+	string output;
+	for(bool stopping = false;;) {
+
+		// Get if stopping before draining so that records logged before stopping are written
+		stopping = !running.load();
+
+		// Go through all rings
+		{
+			Record record;
+			lock_guard<mutex> guard(ringsLock);
+			for(const unique_ptr<Ring> &ring : rings) {
+
+				// Go through all records in the ring
+				while(ring->pop(record)) {
+
+					// Write record to the output
+					writeRecord(output, record);
+				}
+			}
+		}
+
+		// Check if records were dropped since the last report
+		const uint64_t numberOfDroppedRecords = Metrics::logRecordsDropped.get();
+		if(numberOfDroppedRecords != numberOfReportedDroppedRecords) {
+
+			// Write number of records dropped since the last report to the output
+			Record record;
+			createRecord(record, Level::WARNING, "Dropped log records because a ring was full", NO_CONNECTION, to_string(numberOfDroppedRecords - numberOfReportedDroppedRecords));
+			writeRecord(output, record);
+
+			// Set number of reported dropped records
+			numberOfReportedDroppedRecords = numberOfDroppedRecords;
+		}
+
+		// Check if output exists
+		if(!output.empty()) {
+
+			// Write output to the standard output
+			cout.write(output.data(), output.size());
+			cout.flush();
+
+			// Clear output
+			output.clear();
+		}
+
+		// Check if stopping
+		if(stopping) {
+
+			// Break
+			break;
+		}
+
+		// Wait for more records
+		this_thread::sleep_for(FLUSH_INTERVAL);
+	}
+}
+
+// Create record
+void Logger::createRecord(Record &record, Level level, const string_view &message, uint64_t connectionId, const string_view &detail) {
+
+	// Set record's time, connection ID, and level
+	record.time = chrono::system_clock::now();
+	record.connectionId = connectionId;
+	record.level = level;
+
+	// Set record's text to the message followed by the detail truncated to fit
+	record.messageLength = min(message.size(), TEXT_SIZE);
+	record.textLength = record.messageLength + min(detail.size(), TEXT_SIZE - record.messageLength);
+	memcpy(record.text, message.data(), record.messageLength);
+	memcpy(&record.text[record.messageLength], detail.data(), record.textLength - record.messageLength);
+}
+
+// Write record
+void Logger::writeRecord(string &output, const Record &record) {
+
+	// Get record's time as UTC with milliseconds
+	const time_t seconds = chrono::system_clock::to_time_t(record.time);
+	char time[sizeof("YYYY-MM-DDTHH:MM:SS.mmmZ")];
+	const size_t length = strftime(time, sizeof(time), "%Y-%m-%dT%H:%M:%S", gmtime(&seconds));
+	snprintf(&time[length], sizeof(time) - length, ".%03dZ", static_cast<int>(chrono::duration_cast<chrono::milliseconds>(record.time.time_since_epoch()).count() % chrono::milliseconds(chrono::seconds(1)).count()));
+
+	// Get record's message and detail
+	const string_view message(record.text, record.messageLength);
+	const string_view detail(&record.text[record.messageLength], record.textLength - record.messageLength);
+
+	// Check format
+	switch(format) {
+
+		// Text
+		case Format::TEXT:
+
+			// Append time and level to the output
+			output += string(time) + ' ' + LEVEL_NAMES[static_cast<size_t>(record.level)] + ' ';
+
+			// Check if record has a connection
+			if(record.connectionId != NO_CONNECTION) {
+
+				// Append connection ID to the output
+				output += "[connection " + to_string(record.connectionId) + "] ";
+			}
+
+			// Append message to the output
+			output += message;
+
+			// Check if record has a detail
+			if(!detail.empty()) {
+
+				// Append detail to the output
+				output += " -- ";
+				output += detail;
+			}
+
+			// Append newline to the output
+			output += '\n';
+
+			// Break
+			break;
+
+		// JSON
+		case Format::JSON:
+
+			// Append record as a JSON line to the output
+			RECORD_TEMPLATE.fill(output, time, LEVEL_NAMES[static_cast<size_t>(record.level)], static_cast<Json::Number>(record.connectionId), message, detail);
+			output += '\n';
+
+			// Break
+			break;
+	}
+}
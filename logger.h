@@ -0,0 +1,187 @@
+// Header guard
+#ifndef LOGGER_H
+#define LOGGER_H
+
+
+// Header files
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+
+// Classes
+
+// Logger class
+class Logger final {
+
+	// Public
+	public:
+
+		// Constructor
+		Logger() = delete;
+
+		// Level
+		enum class Level {
+
+			// Debug
+			DEBUG,
+
+			// Info
+			INFO,
+
+			// Warning
+			WARNING,
+
+			// Failure (not named error since Windows headers define that as a macro)
+			FAILURE,
+
+			// Number of levels
+			NUMBER_OF_LEVELS
+		};
+
+		// Format
+		enum class Format {
+
+			// Text
+			TEXT,
+
+			// JSON
+			JSON
+		};
+
+		// No connection
+		static const uint64_t NO_CONNECTION;
+
+		// Get level
+		static bool getLevel(const char *name, Level &level);
+
+		// Get format
+		static bool getFormat(const char *name, Format &format);
+
+		// Start
+		static bool start(Level level, Format format);
+
+		// Stop
+		static void stop();
+
+		// Is enabled
+		static bool isEnabled(Level level);
+
+		// Log
+		static void log(Level level, const string_view &message, uint64_t connectionId = NO_CONNECTION, const string_view &detail = string_view());
+
+	// Private
+	private:
+
+		// Text size
+		static const size_t TEXT_SIZE = 192;
+
+		// Ring capacity
+		static const size_t RING_CAPACITY = 1024;
+
+		// Record structure
+		struct Record {
+
+			// Time
+			chrono::system_clock::time_point time;
+
+			// Connection ID
+			uint64_t connectionId;
+
+			// Level
+			Level level;
+
+			// Message length
+			uint8_t messageLength;
+
+			// Text length
+			uint8_t textLength;
+
+			// Text (message followed by detail)
+			char text[TEXT_SIZE];
+		};
+
+		// Ring class
+		class Ring final {
+
+			// Public
+			public:
+
+				// Constructor
+				Ring();
+
+				// Push
+				bool push(const Record &record);
+
+				// Pop
+				bool pop(Record &record);
+
+			// Private
+			private:
+
+				// Records
+				Record records[RING_CAPACITY];
+
+				// Head
+				atomic_size_t head;
+
+				// Tail
+				atomic_size_t tail;
+		};
+
+		// Get ring
+		static Ring &getRing();
+
+		// Run
+		static void run();
+
+		// Create record
+		static void createRecord(Record &record, Level level, const string_view &message, uint64_t connectionId, const string_view &detail);
+
+		// Write record
+		static void writeRecord(string &output, const Record &record);
+
+		// Level names
+		static const char *LEVEL_NAMES[];
+
+		// Format names
+		static const char *FORMAT_NAMES[];
+
+		// Flush interval
+		static const chrono::milliseconds FLUSH_INTERVAL;
+
+		// Level
+		static atomic<Level> level;
+
+		// Format
+		static Format format;
+
+		// Started
+		static atomic_bool started;
+
+		// Running
+		static atomic_bool running;
+
+		// Writer
+		static thread writer;
+
+		// Rings lock
+		static mutex ringsLock;
+
+		// Rings
+		static vector<unique_ptr<Ring>> rings;
+
+		// Thread ring
+		static thread_local Ring *threadRing;
+};
+
+
+#endif
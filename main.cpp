@@ -10,7 +10,9 @@
 #endif
 
 // Header files
+#include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <climits>
 #include <cmath>
 #include <cstring>
@@ -24,23 +26,30 @@
 #include <thread>
 #include <unordered_set>
 #include "event2/buffer.h"
+#include "base64.h"
+#include "cache.h"
 #include "common.h"
+#include "controller.h"
 #include "event2/bufferevent_ssl.h"
 #include "event2/event.h"
 #include "event2/event_struct.h"
 #include "event2/http.h"
 #include "event2/thread.h"
 #include "json.h"
+#include "logger.h"
+#include "memory.h"
+#include "messages.h"
+#include "metrics.h"
+#include "monitor.h"
+#include "probes.h"
+#include "profiler.h"
+#include "recorder.h"
+#include "schema.h"
+#include "trace.h"
+#include "unicode.h"
+#include "websocket.h"
 #include "openssl/ssl.h"
 
-// Extern C
-extern "C" {
-
-	// Header files
-	#include "feature/api/tor_api.h"
-	#include "feature/api/tor_api_internal.h"
-}
-
 // Check if Windows
 #ifdef _WIN32
 
@@ -75,12 +84,15 @@ static const char *DEFAULT_LISTEN_ADDRESS = "localhost";
 // Default listen port
 static const uint16_t DEFAULT_LISTEN_PORT = 9061;
 
+// Default direct port
+static const uint16_t DEFAULT_DIRECT_PORT = 9062;
+
+// Default metrics port
+static const uint16_t DEFAULT_METRICS_PORT = 9063;
+
 // Minimum TLS version
 static const int MINIMUM_TLS_VERSION = TLS1_VERSION;
 
-// WebSocket magic key value
-static const char *WEBSOCKET_MAGIC_KEY_VALUE = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
-
 // HTTP port
 static const uint16_t HTTP_PORT = 80;
 
@@ -93,53 +105,14 @@ static const int HTTP_SWITCHING_PROTOCOL = 101;
 // Check Tor connected interval microseconds
 static const decltype(timeval::tv_usec) CHECK_TOR_CONNECTED_INTERVAL_MICROSECONDS = 100 * Common::MICROSECONDS_IN_A_MILLISECOND;
 
-// WebSocket opcode byte offset
-static const size_t WEBSOCKET_OPCODE_BYTE_OFFSET = 0;
-
-// WebSocket opcode byte mask
-static const uint8_t WEBSOCKET_OPCODE_BYTE_MASK = 0x0F;
-
-// WebSocket final frame byte offset
-static const size_t WEBSOCKET_FINAL_FRAME_BYTE_OFFSET = WEBSOCKET_OPCODE_BYTE_OFFSET;
-
-// WebSocket final frame byte mask
-static const uint8_t WEBSOCKET_FINAL_FRAME_BYTE_MASK = 0x80;
-
-// WebSocket extension byte offset
-static const size_t WEBSOCKET_EXTENSION_BYTE_OFFSET = 0;
-
-// WebSocket extension byte mask
-static const uint8_t WEBSOCKET_EXTENSION_BYTE_MASK = 0x70;
-
-// WebSocket compressed extension byte mask
-static const uint8_t WEBSOCKET_COMPRESSED_EXTENSION_BYTE_MASK = 0x40;
-
-// WebSocket mask byte offset
-static const size_t WEBSOCKET_MASK_BYTE_OFFSET = 1;
-
-// WebSocket mask byte mask
-static const uint8_t WEBSOCKET_MASK_BYTE_MASK = 0x80;
-
-// WebSocket length byte offset
-static const size_t WEBSOCKET_LENGTH_BYTE_OFFSET = 1;
+// Tor reply code length
+static const size_t TOR_REPLY_CODE_LENGTH = sizeof("250") - sizeof('\0');
 
-// WebSocket length byte mask
-static const uint8_t WEBSOCKET_LENGTH_BYTE_MASK = 0x7F;
+// Tor temporary error reply code
+static const char TOR_TEMPORARY_ERROR_REPLY_CODE = '4';
 
-// WebSocket sixteen bits length
-static const uint8_t WEBSOCKET_SIXTEEN_BITS_LENGTH = 0x7E;
-
-// WebSocket sixty-three bits length
-static const uint8_t WEBSOCKET_SIXTY_THREE_BITS_LENGTH = 0x7F;
-
-// WebSocket mask length
-static const size_t WEBSOCKET_MASK_LENGTH = 4;
-
-// WebSocket compressed message tail
-static const vector<uint8_t> WEBSOCKET_COMPRESSED_MESSAGE_TAIL = {0x00, 0x00, 0xFF, 0xFF};
-
-// Maximum safe integer
-static const uint64_t MAXIMUM_SAFE_INTEGER = pow(2, 53) - 1;
+// Tor permanent error reply code
+static const char TOR_PERMANENT_ERROR_REPLY_CODE = '5';
 
 // Cookie separator
 static const char COOKIE_SEPARATOR = ';';
@@ -165,8 +138,11 @@ static const int SESSION_ID_COOKIE_MAXIMUM_AGE_SECONDS = 4 * Common::WEEKS_IN_A_
 // Ping interval seconds
 static const decltype(timeval::tv_sec) PING_INTERVAL_SECONDS = 10;
 
-// URL doesn't exist
-static const vector<uint8_t> URL_DOESNT_EXIST = {};
+// Lag probe interval milliseconds
+static const int LAG_PROBE_INTERVAL_MILLISECONDS = 10;
+
+// Default slow callback threshold milliseconds
+static const unsigned long long DEFAULT_SLOW_CALLBACK_THRESHOLD_MILLISECONDS = 50;
 
 // URL minimum length
 static const size_t URL_MINIMUM_LENGTH = 4;
@@ -195,20 +171,73 @@ static const evutil_socket_t NO_SOCKET = -1;
 // Minimum compress length
 static const size_t MINIMUM_COMPRESSION_LENGTH = 1000;
 
-// WebSocket Opcode
-enum class WebSocketOpcode {
+// Default cache size
+static const size_t DEFAULT_CACHE_SIZE = 64 * Common::KILOBYTE_IN_A_MEGABYTE * Common::BYTES_IN_A_KILOBYTE;
+
+// Default trace sample interval
+static const uint64_t DEFAULT_TRACE_SAMPLE_INTERVAL = 100;
+
+// Error response template
+static const Json::Template<1> ERROR_RESPONSE_TEMPLATE({
+	{"Error", Json()}
+});
+
+// Index response template
+static const Json::Template<2> INDEX_RESPONSE_TEMPLATE({
+	{"Index", Json()},
+	{"Response", Json()}
+});
 
-	// Continuation
-	CONTINUATION = 0x00,
+// Index error response template
+static const Json::Template<2> INDEX_ERROR_RESPONSE_TEMPLATE({
+	{"Index", Json()},
+	{"Error", Json()}
+});
+
+// Interaction error response template
+static const Json::Template<2> INTERACTION_ERROR_RESPONSE_TEMPLATE({
+	{"Interaction", Json()},
+	{"Error", Json()}
+});
+
+// Interaction succeeded response template
+static const Json::Template<1> INTERACTION_SUCCEEDED_RESPONSE_TEMPLATE({
+	{"Interaction", Json()},
+	{"Status", "Succeeded"}
+});
+
+// Interaction failed response template
+static const Json::Template<1> INTERACTION_FAILED_RESPONSE_TEMPLATE({
+	{"Interaction", Json()},
+	{"Status", "Failed"}
+});
+
+// Interaction request template
+static const Json::Template<5> INTERACTION_REQUEST_TEMPLATE({
+	{"Interaction", Json()},
+	{"URL", Json()},
+	{"API", Json()},
+	{"Type", Json()},
+	{"Data", Json()}
+});
+
+// Control request
+enum class ControlRequest {
+
+	// Create URL
+	CREATE_URL,
 	
-	// Text
-	TEXT = 0x01,
+	// Change URL
+	CHANGE_URL,
 	
-	// Ping
-	PING = 0x09,
+	// Delete URL
+	DELETE_URL,
 	
-	// Pong
-	PONG = 0x0A
+	// Own URL
+	OWN_URL,
+	
+	// Unknown
+	UNKNOWN
 };
 
 
@@ -221,16 +250,22 @@ class Client final {
 	public:
 	
 		// Constructor
-		Client(const string &sessionId, bool supportsCompression) :
+		Client(const string &sessionId, bool supportsCompression, size_t minimumCompressionLength) :
 		
 			// Set session ID
 			sessionId(sessionId),
+			
+			// Set ID
+			id(Recorder::getNewConnectionId()),
 		
 			// Set interaction index
 			interactionIndex(0),
 			
 			// Set supports compression
-			supportsCompression(supportsCompression)
+			supportsCompression(supportsCompression),
+			
+			// Set compression policy
+			compressionPolicy(minimumCompressionLength)
 		{
 		}
 		
@@ -241,6 +276,13 @@ class Client final {
 			return sessionId;
 		}
 		
+		// Get ID
+		uint64_t getId() const {
+		
+			// Return ID
+			return id;
+		}
+		
 		// Get next interaction index
 		Json::Number getNextInteractionIndex() {
 		
@@ -274,7 +316,7 @@ class Client final {
 		}
 		
 		// Add interaction
-		bool addInteraction(Json::Number interactionIndex, evhttp_request *request) {
+		bool addInteraction(Json::Number interactionIndex, evhttp_request *request, const Trace &trace) {
 		
 			// Check if interaction index is already being used
 			if(interactions.count(interactionIndex)) {
@@ -284,7 +326,7 @@ class Client final {
 			}
 			
 			// Add interaction to list
-			interactions.emplace(interactionIndex, request);
+			interactions.emplace(interactionIndex, make_pair(request, trace));
 			
 			// Return true
 			return true;
@@ -305,10 +347,10 @@ class Client final {
 		void cancelAllInteractions() {
 		
 			// Go through all interactions
-			for(unordered_map<Json::Number, evhttp_request *>::const_iterator i = interactions.cbegin(); i != interactions.cend(); ++i) {
+			for(unordered_map<Json::Number, pair<evhttp_request *, Trace>>::const_iterator i = interactions.cbegin(); i != interactions.cend(); ++i) {
 			
 				// Get interaction's request
-				evhttp_request *request = i->second;
+				evhttp_request *request = i->second.first;
 				
 				// Remove request's buffer callbacks
 				bufferevent_setcb(evhttp_connection_get_bufferevent(evhttp_request_get_connection(request)), nullptr, nullptr, nullptr, nullptr);
@@ -328,19 +370,91 @@ class Client final {
 			if(interactions.count(interactionIndex)) {
 			
 				// Return interaction's request
-				return interactions.at(interactionIndex);
+				return interactions.at(interactionIndex).first;
+			}
+			
+			// Return null
+			return nullptr;
+		}
+		
+		// Get interaction trace
+		const Trace *getInteractionTrace(Json::Number interactionIndex) const {
+		
+			// Check if interaction exists
+			if(interactions.count(interactionIndex)) {
+			
+				// Return interaction's trace
+				return &interactions.at(interactionIndex).second;
 			}
 			
 			// Return null
 			return nullptr;
 		}
 		
+		// Mark interactions flushed
+		void markInteractionsFlushed() {
+		
+			// Go through all interactions
+			for(unordered_map<Json::Number, pair<evhttp_request *, Trace>>::iterator i = interactions.begin(); i != interactions.end(); ++i) {
+			
+				// Check if interaction's trace hasn't been flushed
+				Trace &trace = i->second.second;
+				if(!trace.isMarked(Trace::Stage::FLUSHED)) {
+				
+					// Mark interaction's trace flushed
+					trace.mark(Trace::Stage::FLUSHED);
+				}
+			}
+		}
+		
+		// Get number of interactions
+		size_t getNumberOfInteractions() const {
+		
+			// Return number of interactions
+			return interactions.size();
+		}
+		
 		// Get supports compression
 		bool getSupportsCompression() const {
 		
 			// Return supports compression
 			return supportsCompression;
 		}
+		
+		// Get compression policy
+		WebSocket::CompressionPolicy *getCompressionPolicy() {
+		
+			// Return compression policy if compression is supported
+			return supportsCompression ? &compressionPolicy : nullptr;
+		}
+		
+		// Get compression policy
+		const WebSocket::CompressionPolicy *getCompressionPolicy() const {
+		
+			// Return compression policy if compression is supported
+			return supportsCompression ? &compressionPolicy : nullptr;
+		}
+		
+		// Get message validator
+		Unicode::Utf8Validator &getMessageValidator() {
+		
+			// Return message validator
+			return messageValidator;
+		}
+		
+		// Get memory account
+		Memory::Account &getMemoryAccount() {
+		
+			// Return memory account
+			return memoryAccount;
+		}
+		
+		// Get memory account
+		const Memory::Account &getMemoryAccount() const {
+		
+			// Return memory account
+			return memoryAccount;
+		}
 	
 	// Private
 	private:
@@ -348,14 +462,26 @@ class Client final {
 		// Session ID
 		string sessionId;
 		
+		// ID
+		uint64_t id;
+		
 		// Interaction index
 		Json::Number interactionIndex;
 		
 		// Interactions
-		unordered_map<Json::Number, evhttp_request *> interactions;
+		unordered_map<Json::Number, pair<evhttp_request *, Trace>> interactions;
 		
 		// Supports Compression
 		bool supportsCompression;
+		
+		// Compression policy
+		WebSocket::CompressionPolicy compressionPolicy;
+		
+		// Message validator
+		Unicode::Utf8Validator messageValidator;
+		
+		// Memory account
+		Memory::Account memoryAccount;
 };
 
 // Check if Windows
@@ -398,13 +524,24 @@ class Client final {
 #endif
 
 
+// Schemas
+
+// Control requests
+static constexpr Schema::PerfectHash<static_cast<size_t>(ControlRequest::UNKNOWN)> CONTROL_REQUESTS({
+	"Create URL",
+	"Change URL",
+	"Delete URL",
+	"Own URL"
+});
+
+
 // Function prototypes
 
 // Display options help
 static void displayOptionsHelp();
 
 // Create WebSocket response
-static const vector<uint8_t> createWebSocketResponse(const string &message, WebSocketOpcode opcode, bool supportsCompression);
+static const vector<uint8_t> createWebSocketResponse(const string &message, WebSocket::Opcode opcode, Client &client);
 
 // Get cookies
 static const unordered_map<string, string> getCookies(const string &cookieHttpHeader);
@@ -415,6 +552,12 @@ static const string getRandomSessionId();
 // Get random URL
 static const string getRandomUrl(const string &onionServiceAddress);
 
+// Start server
+static bool startServer(evhttp *httpServer, const string &listenAddress, uint16_t listenPort, bool usingTlsServer);
+
+// Decode interaction data
+static bool decodeInteractionData(evbuffer *output, const string_view &data, bool compress, Cache *cache, const string &cacheKey);
+
 
 // Main function
 int main(int argc, char *argv[]) {
@@ -434,6 +577,57 @@ int main(int argc, char *argv[]) {
 	// Initialize key
 	const char *key = nullptr;
 	
+	// Initialize minimum compression length
+	size_t minimumCompressionLength = MINIMUM_COMPRESSION_LENGTH;
+	
+	// Initialize cache size
+	size_t cacheSize = DEFAULT_CACHE_SIZE;
+	
+	// Initialize trace file
+	const char *traceFile = nullptr;
+	
+	// Initialize trace sample interval
+	uint64_t traceSampleInterval = DEFAULT_TRACE_SAMPLE_INTERVAL;
+	
+	// Initialize record file
+	const char *recordFile = nullptr;
+	
+	// Initialize no Tor
+	bool noTor = false;
+	
+	// Initialize direct address
+	string directAddress = DEFAULT_LISTEN_ADDRESS;
+	
+	// Initialize direct port
+	uint16_t directPort = DEFAULT_DIRECT_PORT;
+	
+	// Initialize direct hostname
+	string directHostname;
+	
+	// Initialize metrics address
+	string metricsAddress = DEFAULT_LISTEN_ADDRESS;
+	
+	// Initialize metrics port
+	uint16_t metricsPort = DEFAULT_METRICS_PORT;
+	
+	// Initialize mock Tor
+	bool mockTor = false;
+	
+	// Initialize mock Tor settings
+	string mockTorSettings;
+	
+	// Initialize slow callback threshold milliseconds
+	unsigned long long slowCallbackThresholdMilliseconds = DEFAULT_SLOW_CALLBACK_THRESHOLD_MILLISECONDS;
+	
+	// Initialize memory budget
+	size_t memoryBudget = Memory::UNLIMITED_BUDGET;
+	
+	// Initialize log level
+	Logger::Level logLevel = Logger::Level::INFO;
+	
+	// Initialize log format
+	Logger::Format logFormat = Logger::Format::TEXT;
+	
 	// Set options
 	const option options[] = {
 	
@@ -452,6 +646,54 @@ int main(int argc, char *argv[]) {
 		// Key
 		{"key", required_argument, nullptr, 'k'},
 		
+		// Compression threshold
+		{"compression-threshold", required_argument, nullptr, 't'},
+		
+		// Cache size
+		{"cache-size", required_argument, nullptr, 's'},
+		
+		// Trace file
+		{"trace-file", required_argument, nullptr, 'r'},
+		
+		// Trace sample interval
+		{"trace-sample-interval", required_argument, nullptr, 'R'},
+		
+		// Record file
+		{"record-file", required_argument, nullptr, 'f'},
+		
+		// No Tor
+		{"no-tor", no_argument, nullptr, 'n'},
+		
+		// Direct address
+		{"direct-address", required_argument, nullptr, 'A'},
+		
+		// Direct port
+		{"direct-port", required_argument, nullptr, 'P'},
+		
+		// Direct hostname
+		{"direct-hostname", required_argument, nullptr, 'H'},
+		
+		// Metrics address
+		{"metrics-address", required_argument, nullptr, 'M'},
+		
+		// Metrics port
+		{"metrics-port", required_argument, nullptr, 'O'},
+		
+		// Mock Tor
+		{"mock-tor", optional_argument, nullptr, 'm'},
+		
+		// Slow callback threshold
+		{"slow-callback-threshold", required_argument, nullptr, 'W'},
+		
+		// Memory budget
+		{"memory-budget", required_argument, nullptr, 'B'},
+		
+		// Log level
+		{"log-level", required_argument, nullptr, 'l'},
+		
+		// Log format
+		{"log-format", required_argument, nullptr, 'L'},
+		
 		// Help
 		{"help", no_argument, nullptr, 'h'},
 		
@@ -460,7 +702,7 @@ int main(int argc, char *argv[]) {
 	};
 	
 	// Go through all options
-	for(int option = getopt_long(argc, argv, "va:p:c:k:h", options, nullptr); option != -1; option = getopt_long(argc, argv, "va:p:c:k:h", options, nullptr)) {
+	for(int option = getopt_long(argc, argv, "va:p:c:k:t:s:r:R:f:nA:P:H:M:O:m::W:B:l:L:h", options, nullptr); option != -1; option = getopt_long(argc, argv, "va:p:c:k:t:s:r:R:f:nA:P:H:M:O:m::W:B:l:L:h", options, nullptr)) {
 	
 		// Check option
 		switch(option) {
@@ -610,11 +852,632 @@ int main(int argc, char *argv[]) {
 				// Display message
 				cout << endl << "Usage:" << endl << '\t' << argv[0] << " [options]" << endl << endl;
 				
-				// Display options help
-				displayOptionsHelp();
+				// Display options help
+				displayOptionsHelp();
+				
+				// Return failure
+				return EXIT_FAILURE;
+				
+				// Break
+				break;
+			
+			// Compression threshold
+			case 't':
+			
+				// Check if option exists
+				if(optarg) {
+				
+					// Get compression threshold
+					const string compressionThreshold = optarg;
+					
+					// Check if compression threshold is numeric
+					if(Common::isNumeric(compressionThreshold)) {
+					
+						// Initialize error occurred
+						bool errorOccurred = false;
+					
+						// Try
+						unsigned long long compressionThresholdNumber;
+						try {
+						
+							// Get compression threshold number from compression threshold
+							compressionThresholdNumber = stoull(compressionThreshold);
+						}
+						
+						// Catch errors
+						catch(...) {
+						
+							// Set error occurred
+							errorOccurred = true;
+						}
+						
+						// Check if an error didn't occur
+						if(!errorOccurred && compressionThresholdNumber <= SIZE_MAX) {
+						
+							// Set minimum compression length
+							minimumCompressionLength = compressionThresholdNumber;
+					
+							// Break
+							break;
+						}
+					}
+				}
+				
+				// Display message
+				cout << argv[0] << ": invalid compression threshold -- '" << (optarg ? optarg : "") << '\'' << endl;
+				
+				// Display message
+				cout << endl << "Usage:" << endl << '\t' << argv[0] << " [options]" << endl << endl;
+				
+				// Display options help
+				displayOptionsHelp();
+				
+				// Return failure
+				return EXIT_FAILURE;
+				
+				// Break
+				break;
+			
+			// Cache size
+			case 's':
+			
+				// Check if option exists
+				if(optarg) {
+				
+					// Get cache size
+					const string cacheSizeMegabytes = optarg;
+					
+					// Check if cache size is numeric
+					if(Common::isNumeric(cacheSizeMegabytes)) {
+					
+						// Initialize error occurred
+						bool errorOccurred = false;
+					
+						// Try
+						unsigned long long cacheSizeMegabytesNumber;
+						try {
+						
+							// Get cache size megabytes number from cache size
+							cacheSizeMegabytesNumber = stoull(cacheSizeMegabytes);
+						}
+						
+						// Catch errors
+						catch(...) {
+						
+							// Set error occurred
+							errorOccurred = true;
+						}
+						
+						// Check if an error didn't occur
+						if(!errorOccurred && cacheSizeMegabytesNumber <= SIZE_MAX / Common::KILOBYTE_IN_A_MEGABYTE / Common::BYTES_IN_A_KILOBYTE) {
+						
+							// Set cache size
+							cacheSize = cacheSizeMegabytesNumber * Common::KILOBYTE_IN_A_MEGABYTE * Common::BYTES_IN_A_KILOBYTE;
+					
+							// Break
+							break;
+						}
+					}
+				}
+				
+				// Display message
+				cout << argv[0] << ": invalid cache size -- '" << (optarg ? optarg : "") << '\'' << endl;
+				
+				// Display message
+				cout << endl << "Usage:" << endl << '\t' << argv[0] << " [options]" << endl << endl;
+				
+				// Display options help
+				displayOptionsHelp();
+				
+				// Return failure
+				return EXIT_FAILURE;
+				
+				// Break
+				break;
+			
+			// Trace file
+			case 'r':
+			
+				// Check if option exists
+				if(optarg) {
+				
+					// Set trace file
+					traceFile = optarg;
+				}
+				
+				// Otherwise
+				else {
+				
+					// Display message
+					cout << argv[0] << ": invalid trace file -- ''" << endl;
+					
+					// Display message
+					cout << endl << "Usage:" << endl << '\t' << argv[0] << " [options]" << endl << endl;
+					
+					// Display options help
+					displayOptionsHelp();
+					
+					// Return failure
+					return EXIT_FAILURE;
+				}
+				
+				// Break
+				break;
+			
+			// Trace sample interval
+			case 'R':
+			
+				// Check if option exists
+				if(optarg) {
+				
+					// Get trace sample interval
+					const string sampleInterval = optarg;
+					
+					// Check if trace sample interval is numeric
+					if(Common::isNumeric(sampleInterval)) {
+					
+						// Initialize error occurred
+						bool errorOccurred = false;
+					
+						// Try
+						unsigned long long sampleIntervalNumber;
+						try {
+						
+							// Get sample interval number from sample interval
+							sampleIntervalNumber = stoull(sampleInterval);
+						}
+						
+						// Catch errors
+						catch(...) {
+						
+							// Set error occurred
+							errorOccurred = true;
+						}
+						
+						// Check if an error didn't occur and sample interval number is valid
+						if(!errorOccurred && sampleIntervalNumber) {
+						
+							// Set trace sample interval
+							traceSampleInterval = sampleIntervalNumber;
+					
+							// Break
+							break;
+						}
+					}
+				}
+				
+				// Display message
+				cout << argv[0] << ": invalid trace sample interval -- '" << (optarg ? optarg : "") << '\'' << endl;
+				
+				// Display message
+				cout << endl << "Usage:" << endl << '\t' << argv[0] << " [options]" << endl << endl;
+				
+				// Display options help
+				displayOptionsHelp();
+				
+				// Return failure
+				return EXIT_FAILURE;
+				
+				// Break
+				break;
+			
+			// Record file
+			case 'f':
+			
+				// Check if option exists
+				if(optarg) {
+				
+					// Set record file
+					recordFile = optarg;
+				}
+				
+				// Otherwise
+				else {
+				
+					// Display message
+					cout << argv[0] << ": invalid record file -- ''" << endl;
+					
+					// Display message
+					cout << endl << "Usage:" << endl << '\t' << argv[0] << " [options]" << endl << endl;
+					
+					// Display options help
+					displayOptionsHelp();
+					
+					// Return failure
+					return EXIT_FAILURE;
+				}
+				
+				// Break
+				break;
+			
+			// No Tor
+			case 'n':
+			
+				// Set no Tor
+				noTor = true;
+				
+				// Break
+				break;
+			
+			// Direct address
+			case 'A':
+			
+				// Check if option exists
+				if(optarg) {
+				
+					// Set direct address
+					directAddress = optarg;
+				}
+				
+				// Otherwise
+				else {
+				
+					// Display message
+					cout << argv[0] << ": invalid direct address -- ''" << endl;
+					
+					// Display message
+					cout << endl << "Usage:" << endl << '\t' << argv[0] << " [options]" << endl << endl;
+					
+					// Display options help
+					displayOptionsHelp();
+					
+					// Return failure
+					return EXIT_FAILURE;
+				}
+				
+				// Break
+				break;
+			
+			// Direct port
+			case 'P':
+			
+				// Check if option exists
+				if(optarg) {
+				
+					// Get port
+					string port = optarg;
+					
+					// Check if port is numeric
+					if(Common::isNumeric(port)) {
+					
+						// Initialize error occurred
+						bool errorOccurred = false;
+					
+						// Try
+						int portNumber;
+						try {
+						
+							// Get port number from port
+							portNumber = stoi(port);
+						}
+						
+						// Catch errors
+						catch(...) {
+						
+							// Set error occurred
+							errorOccurred = true;
+						}
+						
+						// Check if an error didn't occur
+						if(!errorOccurred) {
+						
+							// Check if port number is valid
+							if(portNumber >= 1 && portNumber <= UINT16_MAX) {
+							
+								// Set direct port
+								directPort = portNumber;
+						
+								// Break
+								break;
+							}
+						}
+					}
+				}
+				
+				// Display message
+				cout << argv[0] << ": invalid direct port -- '" << (optarg ? optarg : "") << '\'' << endl;
+				
+				// Display message
+				cout << endl << "Usage:" << endl << '\t' << argv[0] << " [options]" << endl << endl;
+				
+				// Display options help
+				displayOptionsHelp();
+				
+				// Return failure
+				return EXIT_FAILURE;
+				
+				// Break
+				break;
+			
+			// Direct hostname
+			case 'H':
+			
+				// Check if option exists
+				if(optarg && strlen(optarg)) {
+				
+					// Set direct hostname
+					directHostname = Common::toLowerCase(optarg);
+				}
+				
+				// Otherwise
+				else {
+				
+					// Display message
+					cout << argv[0] << ": invalid direct hostname -- ''" << endl;
+					
+					// Display message
+					cout << endl << "Usage:" << endl << '\t' << argv[0] << " [options]" << endl << endl;
+					
+					// Display options help
+					displayOptionsHelp();
+					
+					// Return failure
+					return EXIT_FAILURE;
+				}
+				
+				// Break
+				break;
+			
+			// Metrics address
+			case 'M':
+			
+				// Check if option exists
+				if(optarg) {
+				
+					// Set metrics address
+					metricsAddress = optarg;
+				}
+				
+				// Otherwise
+				else {
+				
+					// Display message
+					cout << argv[0] << ": invalid metrics address -- ''" << endl;
+					
+					// Display message
+					cout << endl << "Usage:" << endl << '\t' << argv[0] << " [options]" << endl << endl;
+					
+					// Display options help
+					displayOptionsHelp();
+					
+					// Return failure
+					return EXIT_FAILURE;
+				}
+				
+				// Break
+				break;
+			
+			// Metrics port
+			case 'O':
+			
+				// Check if option exists
+				if(optarg) {
+				
+					// Get port
+					string port = optarg;
+					
+					// Check if port is numeric
+					if(Common::isNumeric(port)) {
+					
+						// Initialize error occurred
+						bool errorOccurred = false;
+					
+						// Try
+						int portNumber;
+						try {
+						
+							// Get port number from port
+							portNumber = stoi(port);
+						}
+						
+						// Catch errors
+						catch(...) {
+						
+							// Set error occurred
+							errorOccurred = true;
+						}
+						
+						// Check if an error didn't occur
+						if(!errorOccurred) {
+						
+							// Check if port number is valid
+							if(portNumber >= 1 && portNumber <= UINT16_MAX) {
+							
+								// Set metrics port
+								metricsPort = portNumber;
+						
+								// Break
+								break;
+							}
+						}
+					}
+				}
+				
+				// Display message
+				cout << argv[0] << ": invalid metrics port -- '" << (optarg ? optarg : "") << '\'' << endl;
+				
+				// Display message
+				cout << endl << "Usage:" << endl << '\t' << argv[0] << " [options]" << endl << endl;
+				
+				// Display options help
+				displayOptionsHelp();
+				
+				// Return failure
+				return EXIT_FAILURE;
+				
+				// Break
+				break;
+			
+			// Mock Tor
+			case 'm':
+			
+				// Set mock Tor
+				mockTor = true;
+				
+				// Check if option exists
+				if(optarg) {
+				
+					// Set mock Tor settings
+					mockTorSettings = optarg;
+				}
+				
+				// Break
+				break;
+			
+			// Slow callback threshold
+			case 'W':
+			
+				// Check if option exists
+				if(optarg) {
+				
+					// Get slow callback threshold
+					const string slowCallbackThreshold = optarg;
+					
+					// Check if slow callback threshold is numeric
+					if(Common::isNumeric(slowCallbackThreshold)) {
+					
+						// Initialize error occurred
+						bool errorOccurred = false;
+					
+						// Try
+						unsigned long long slowCallbackThresholdNumber;
+						try {
+						
+							// Get slow callback threshold number from slow callback threshold
+							slowCallbackThresholdNumber = stoull(slowCallbackThreshold);
+						}
+						
+						// Catch errors
+						catch(...) {
+						
+							// Set error occurred
+							errorOccurred = true;
+						}
+						
+						// Check if an error didn't occur and slow callback threshold number is valid
+						if(!errorOccurred && slowCallbackThresholdNumber && slowCallbackThresholdNumber <= static_cast<unsigned long long>(Common::MILLISECONDS_IN_A_SECOND) * Common::SECONDS_IN_A_MINUTE) {
+						
+							// Set slow callback threshold milliseconds
+							slowCallbackThresholdMilliseconds = slowCallbackThresholdNumber;
+					
+							// Break
+							break;
+						}
+					}
+				}
+				
+				// Display message
+				cout << argv[0] << ": invalid slow callback threshold -- '" << (optarg ? optarg : "") << '\'' << endl;
+				
+				// Display message
+				cout << endl << "Usage:" << endl << '\t' << argv[0] << " [options]" << endl << endl;
+				
+				// Display options help
+				displayOptionsHelp();
+				
+				// Return failure
+				return EXIT_FAILURE;
+				
+				// Break
+				break;
+			
+			// Memory budget
+			case 'B':
+			
+				// Check if option exists
+				if(optarg) {
+				
+					// Get memory budget
+					const string memoryBudgetMegabytes = optarg;
+					
+					// Check if memory budget is numeric
+					if(Common::isNumeric(memoryBudgetMegabytes)) {
+					
+						// Initialize error occurred
+						bool errorOccurred = false;
+					
+						// Try
+						unsigned long long memoryBudgetMegabytesNumber;
+						try {
+						
+							// Get memory budget megabytes number from memory budget
+							memoryBudgetMegabytesNumber = stoull(memoryBudgetMegabytes);
+						}
+						
+						// Catch errors
+						catch(...) {
+						
+							// Set error occurred
+							errorOccurred = true;
+						}
+						
+						// Check if an error didn't occur
+						if(!errorOccurred && memoryBudgetMegabytesNumber <= SIZE_MAX / Common::KILOBYTE_IN_A_MEGABYTE / Common::BYTES_IN_A_KILOBYTE) {
+						
+							// Set memory budget
+							memoryBudget = memoryBudgetMegabytesNumber * Common::KILOBYTE_IN_A_MEGABYTE * Common::BYTES_IN_A_KILOBYTE;
+					
+							// Break
+							break;
+						}
+					}
+				}
+				
+				// Display message
+				cout << argv[0] << ": invalid memory budget -- '" << (optarg ? optarg : "") << '\'' << endl;
+				
+				// Display message
+				cout << endl << "Usage:" << endl << '\t' << argv[0] << " [options]" << endl << endl;
+				
+				// Display options help
+				displayOptionsHelp();
+				
+				// Return failure
+				return EXIT_FAILURE;
+				
+				// Break
+				break;
+			
+			// Log level
+			case 'l':
+			
+				// Check if option doesn't exist or getting log level from it failed
+				if(!optarg || !Logger::getLevel(optarg, logLevel)) {
+				
+					// Display message
+					cout << argv[0] << ": invalid log level -- '" << (optarg ? optarg : "") << '\'' << endl;
+					
+					// Display message
+					cout << endl << "Usage:" << endl << '\t' << argv[0] << " [options]" << endl << endl;
+					
+					// Display options help
+					displayOptionsHelp();
+					
+					// Return failure
+					return EXIT_FAILURE;
+				}
+				
+				// Break
+				break;
+			
+			// Log format
+			case 'L':
+			
+				// Check if option doesn't exist or getting log format from it failed
+				if(!optarg || !Logger::getFormat(optarg, logFormat)) {
 				
-				// Return failure
-				return EXIT_FAILURE;
+					// Display message
+					cout << argv[0] << ": invalid log format -- '" << (optarg ? optarg : "") << '\'' << endl;
+					
+					// Display message
+					cout << endl << "Usage:" << endl << '\t' << argv[0] << " [options]" << endl << endl;
+					
+					// Display options help
+					displayOptionsHelp();
+					
+					// Return failure
+					return EXIT_FAILURE;
+				}
 				
 				// Break
 				break;
@@ -646,6 +1509,26 @@ int main(int argc, char *argv[]) {
 	
 	// Set using TLS server to if a certificate and key are provided
 	const bool usingTlsServer = certificate && key;
+	
+	// Check if a trace file is provided and opening it failed
+	if(traceFile && !Trace::openFile(traceFile, traceSampleInterval)) {
+	
+		// Display message
+		cout << "Opening trace file failed" << endl;
+		
+		// Return failure
+		return EXIT_FAILURE;
+	}
+	
+	// Check if a record file is provided and opening it failed
+	if(recordFile && !Recorder::openFile(recordFile)) {
+	
+		// Display message
+		cout << "Opening record file failed" << endl;
+		
+		// Return failure
+		return EXIT_FAILURE;
+	}
 
 	// Check if not Windows
 	#ifndef _WIN32
@@ -662,14 +1545,24 @@ int main(int argc, char *argv[]) {
 		}
 	#endif
 	
+	// Check if starting logger failed
+	if(!Logger::start(logLevel, logFormat)) {
+	
+		// Display message
+		cout << "Starting logger failed" << endl;
+	
+		// Return failure
+		return EXIT_FAILURE;
+	}
+	
 	// Check if Windows
 	#ifdef _WIN32
 	
 		// Check if enabling thread support failed
 		if(evthread_use_windows_threads()) {
 		
-			// Display message
-			cout << "Enabling thread support failed" << endl;
+			// Log message
+			Logger::log(Logger::Level::FAILURE, "Enabling thread support failed");
 		
 			// Return failure
 			return EXIT_FAILURE;
@@ -681,8 +1574,8 @@ int main(int argc, char *argv[]) {
 		// Check if enabling thread support failed
 		if(evthread_use_pthreads()) {
 		
-			// Display message
-			cout << "Enabling thread support failed" << endl;
+			// Log message
+			Logger::log(Logger::Level::FAILURE, "Enabling thread support failed");
 		
 			// Return failure
 			return EXIT_FAILURE;
@@ -705,8 +1598,8 @@ int main(int argc, char *argv[]) {
 		// Catch errors
 		catch(const runtime_error &error) {
 		
-			// Display message
-			cout << error.what() << endl;
+			// Log message
+			Logger::log(Logger::Level::FAILURE, error.what());
 		
 			// Return failure
 			return EXIT_FAILURE;
@@ -717,8 +1610,8 @@ int main(int argc, char *argv[]) {
 	const SSL_METHOD *tlsMethod = TLS_server_method();
 	if(!tlsMethod) {
 	
-		// Display message
-		cout << "Creating TLS method failed" << endl;
+		// Log message
+		Logger::log(Logger::Level::FAILURE, "Creating TLS method failed");
 	
 		// Return failure
 		return EXIT_FAILURE;
@@ -728,8 +1621,8 @@ int main(int argc, char *argv[]) {
 	unique_ptr<SSL_CTX, decltype(&SSL_CTX_free)> tlsContext(SSL_CTX_new(tlsMethod), SSL_CTX_free);
 	if(!tlsContext) {
 	
-		// Display message
-		cout << "Creating TLS context failed" << endl;
+		// Log message
+		Logger::log(Logger::Level::FAILURE, "Creating TLS context failed");
 	
 		// Return failure
 		return EXIT_FAILURE;
@@ -738,8 +1631,8 @@ int main(int argc, char *argv[]) {
 	// Check if setting TLS context's minimum TLS version failed
 	if(!SSL_CTX_set_min_proto_version(tlsContext.get(), MINIMUM_TLS_VERSION)) {
 	
-		// Display message
-		cout << "Setting TLS context's minimum protocol version failed" << endl;
+		// Log message
+		Logger::log(Logger::Level::FAILURE, "Setting TLS context's minimum protocol version failed");
 	
 		// Return failure
 		return EXIT_FAILURE;
@@ -751,8 +1644,8 @@ int main(int argc, char *argv[]) {
 		// Check if setting the TLS context's certificate and key failed
 		if(SSL_CTX_use_certificate_chain_file(tlsContext.get(), certificate) != 1 || SSL_CTX_use_PrivateKey_file(tlsContext.get(), key, SSL_FILETYPE_PEM) != 1 || SSL_CTX_check_private_key(tlsContext.get()) != 1) {
 		
-			// Display message
-			cout << "Setting the TLS context's certificate and key failed" << endl;
+			// Log message
+			Logger::log(Logger::Level::FAILURE, "Setting the TLS context's certificate and key failed");
 		
 			// Return failure
 			return EXIT_FAILURE;
@@ -763,8 +1656,8 @@ int main(int argc, char *argv[]) {
 	shared_ptr<event_base> eventBase(event_base_new(), event_base_free);
 	if(!eventBase) {
 	
-		// Display message
-		cout << "Creating event base failed" << endl;
+		// Log message
+		Logger::log(Logger::Level::FAILURE, "Creating event base failed");
 	
 		// Return failure
 		return EXIT_FAILURE;
@@ -774,8 +1667,8 @@ int main(int argc, char *argv[]) {
 	unique_ptr<evhttp, decltype(&evhttp_free)> httpServer(evhttp_new(eventBase.get()), evhttp_free);
 	if(!httpServer) {
 	
-		// Display message
-		cout << "Creating HTTP server failed" << endl;
+		// Log message
+		Logger::log(Logger::Level::FAILURE, "Creating HTTP server failed");
 	
 		// Return failure
 		return EXIT_FAILURE;
@@ -882,6 +1775,10 @@ int main(int argc, char *argv[]) {
 		// Get clients from argument
 		unordered_map<evhttp_connection *, Client> *clients = reinterpret_cast<unordered_map<evhttp_connection *, Client> *>(argument);
 		
+		// Start callback's monitor with the number of clients as its payload size
+		Monitor monitor(Monitor::Callback::PING);
+		monitor.setPayloadSize(clients->size());
+		
 		// Go through all clients
 		for(unordered_map<evhttp_connection *, Client>::const_iterator i = clients->cbegin(); i != clients->cend();) {
 		
@@ -901,6 +1798,12 @@ int main(int argc, char *argv[]) {
 				// Cancel all client's interactions
 				clients->at(connection).cancelAllInteractions();
 				
+				// Probe client disconnected
+				PROBE(client_disconnected, clients->at(connection).getId(), "buffer_unavailable");
+				
+				// Log client disconnected
+				Logger::log(Logger::Level::WARNING, "Client disconnected", clients->at(connection).getId(), "buffer_unavailable");
+				
 				// Remove connection from list of clients
 				clients->erase(connection);
 			}
@@ -908,8 +1811,11 @@ int main(int argc, char *argv[]) {
 			// Otherwise
 			else {
 		
-				// Get ping message
-				const vector<uint8_t> pingMessage = createWebSocketResponse("", WebSocketOpcode::PING, clients->at(connection).getSupportsCompression());
+				// Get ping message containing its send time
+				const vector<uint8_t> pingMessage = createWebSocketResponse(to_string(chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now().time_since_epoch()).count()), WebSocket::Opcode::PING, clients->at(connection));
+				
+				// Probe ping sent
+				PROBE(ping_sent, clients->at(connection).getId());
 				
 				// Check if sending ping message to client failed
 				if(bufferevent_write(connectionsBuffer, pingMessage.data(), pingMessage.size())) {
@@ -931,6 +1837,12 @@ int main(int argc, char *argv[]) {
 					// Cancel all client's interactions
 					clients->at(connection).cancelAllInteractions();
 					
+					// Probe client disconnected
+					PROBE(client_disconnected, clients->at(connection).getId(), "write_failed");
+					
+					// Log client disconnected
+					Logger::log(Logger::Level::WARNING, "Client disconnected", clients->at(connection).getId(), "write_failed");
+					
 					// Remove connection from list of clients
 					clients->erase(connection);
 				}
@@ -939,8 +1851,8 @@ int main(int argc, char *argv[]) {
 	
 	}), &clients)) {
 	
-		// Display message
-		cout << "Setting ping callback failed" << endl;
+		// Log message
+		Logger::log(Logger::Level::FAILURE, "Setting ping callback failed");
 	
 		// Return failure
 		return EXIT_FAILURE;
@@ -956,8 +1868,71 @@ int main(int argc, char *argv[]) {
 	// Check if adding ping event to the dispatched events failed
 	if(evtimer_add(&pingEvent, &pingTimer)) {
 	
-		// Display message
-		cout << "Adding ping event to the dispatched events failed" << endl;
+		// Log message
+		Logger::log(Logger::Level::FAILURE, "Adding ping event to the dispatched events failed");
+	
+		// Return failure
+		return EXIT_FAILURE;
+	}
+	
+	// Set slow callback threshold
+	Monitor::setSlowThreshold(chrono::milliseconds(slowCallbackThresholdMilliseconds));
+	
+	// Set memory budget
+	Memory::setBudget(memoryBudget);
+	
+	// Initialize lag probe due time
+	chrono::steady_clock::time_point lagProbeDueTime;
+	
+	// Initialize lag probe event
+	event lagProbeEvent;
+	
+	// Check if setting lag probe callback failed
+	if(event_assign(&lagProbeEvent, eventBase.get(), NO_SOCKET, EV_PERSIST, ([](evutil_socket_t signal, short events, void *argument) {
+	
+		// Get lag probe due time from argument
+		chrono::steady_clock::time_point *lagProbeDueTime = reinterpret_cast<chrono::steady_clock::time_point *>(argument);
+		
+		// Get current time
+		const chrono::steady_clock::time_point currentTime = chrono::steady_clock::now();
+		
+		// Record how late the lag probe fired after it was due
+		Monitor::recordLag(currentTime - *lagProbeDueTime);
+		
+		// Set lag probe due time to when it should fire next relative to when it was due since that's how persistent timers are rescheduled
+		*lagProbeDueTime += chrono::milliseconds(LAG_PROBE_INTERVAL_MILLISECONDS);
+		
+		// Check if lag probe due time is in the past
+		if(*lagProbeDueTime < currentTime) {
+		
+			// Set lag probe due time relative to the current time since that's how persistent timers that fell behind are rescheduled
+			*lagProbeDueTime = currentTime + chrono::milliseconds(LAG_PROBE_INTERVAL_MILLISECONDS);
+		}
+	
+	}), &lagProbeDueTime)) {
+	
+		// Log message
+		Logger::log(Logger::Level::FAILURE, "Setting lag probe callback failed");
+	
+		// Return failure
+		return EXIT_FAILURE;
+	}
+	
+	// Set lag probe timer
+	const timeval lagProbeTimer = {
+	
+		// Microseconds
+		.tv_usec = LAG_PROBE_INTERVAL_MILLISECONDS * Common::MICROSECONDS_IN_A_MILLISECOND
+	};
+	
+	// Set lag probe due time to when it should fire first
+	lagProbeDueTime = chrono::steady_clock::now() + chrono::milliseconds(LAG_PROBE_INTERVAL_MILLISECONDS);
+	
+	// Check if adding lag probe event to the dispatched events failed
+	if(evtimer_add(&lagProbeEvent, &lagProbeTimer)) {
+	
+		// Log message
+		Logger::log(Logger::Level::FAILURE, "Adding lag probe event to the dispatched events failed");
 	
 		// Return failure
 		return EXIT_FAILURE;
@@ -966,14 +1941,17 @@ int main(int argc, char *argv[]) {
 	// Initialize URLs
 	unordered_map<string, unordered_set<string>> urls;
 	
+	// Initialize cache
+	Cache cache(cacheSize);
+	
 	// Initialize HTTP server request callback argument
-	tuple<const string *, unordered_map<evhttp_connection *, Client> *, unordered_map<string, unordered_set<string>> *> httpServerRequestCallbackArgument(&onionServiceAddress, &clients, &urls);
+	tuple<const string *, unordered_map<evhttp_connection *, Client> *, unordered_map<string, unordered_set<string>> *, const size_t *, Cache *> httpServerRequestCallbackArgument(&onionServiceAddress, &clients, &urls, &minimumCompressionLength, &cache);
 	
 	// Set HTTP server WebSocket request callback
 	evhttp_set_cb(httpServer.get(), "/", ([](evhttp_request *request, void *argument) {
 	
 		// Get HTTP server request callback argument from argument
-		tuple<const string *, unordered_map<evhttp_connection *, Client> *, unordered_map<string, unordered_set<string>> *> *httpServerRequestCallbackArgument = reinterpret_cast<tuple<const string *, unordered_map<evhttp_connection *, Client> *, unordered_map<string, unordered_set<string>> *> *>(argument);
+		tuple<const string *, unordered_map<evhttp_connection *, Client> *, unordered_map<string, unordered_set<string>> *, const size_t *, Cache *> *httpServerRequestCallbackArgument = reinterpret_cast<tuple<const string *, unordered_map<evhttp_connection *, Client> *, unordered_map<string, unordered_set<string>> *, const size_t *, Cache *> *>(argument);
 		
 		// Get Onion Service address from HTTP server request callback argument
 		const string *onionServiceAddress = get<0>(*httpServerRequestCallbackArgument);
@@ -984,6 +1962,12 @@ int main(int argc, char *argv[]) {
 		// Get URLs from HTTP server request callback argument
 		unordered_map<string, unordered_set<string>> *urls = get<2>(*httpServerRequestCallbackArgument);
 		
+		// Get minimum compression length from HTTP server request callback argument
+		const size_t *minimumCompressionLength = get<3>(*httpServerRequestCallbackArgument);
+		
+		// Get cache from HTTP server request callback argument
+		Cache *cache = get<4>(*httpServerRequestCallbackArgument);
+		
 		// Check if setting request's cache control header or CORS header failed
 		if(evhttp_add_header(evhttp_request_get_output_headers(request), "Cache-Control", "no-store, no-transform") || evhttp_add_header(evhttp_request_get_output_headers(request), "Access-Control-Allow-Origin", "*")) {
 		
@@ -1037,6 +2021,22 @@ int main(int argc, char *argv[]) {
 			// Check if all required HTTP headers exists for a WebSocket connection
 			if(httpHeaders.count("connection") && Common::toLowerCase(httpHeaders.at("connection")).find("upgrade") != string::npos && httpHeaders.count("upgrade") && Common::toLowerCase(httpHeaders.at("upgrade")) == "websocket" && httpHeaders.count("sec-websocket-key")) {
 			
+				// Check if memory is over budget
+				if(Memory::isOverBudget()) {
+				
+					// Update memory budget rejections metric
+					Metrics::memoryBudgetRejections.increment();
+					
+					// Log rejection
+					Logger::log(Logger::Level::WARNING, "Rejected WebSocket upgrade since memory is over budget", Logger::NO_CONNECTION, to_string(Memory::getTotal()));
+				
+					// Reply with service unavailable error to request
+					evhttp_send_reply(request, HTTP_SERVUNAVAIL, nullptr, nullptr);
+					
+					// Return
+					return;
+				}
+				
 				// Initialize cookies
 				unordered_map<string, string> cookies;
 				
@@ -1098,14 +2098,12 @@ int main(int argc, char *argv[]) {
 					sessionId = getRandomSessionId();
 				}
 				
-				// Set response key to request key appended the WebSocket magic key value to it
-				string responseKey = httpHeaders.at("sec-websocket-key") + WEBSOCKET_MAGIC_KEY_VALUE;
-				
 				// Try
+				string responseKey;
 				try {
 				
-					// Finish creating response key
-					responseKey = Json::base64Encode(Common::sha1Hash(vector<uint8_t>(responseKey.begin(), responseKey.end())));
+					// Set response key to the request key's accept key
+					responseKey = WebSocket::getAcceptKey(httpHeaders.at("sec-websocket-key"));
 				}
 				
 				// Catch errors
@@ -1197,7 +2195,7 @@ int main(int argc, char *argv[]) {
 							else {
 						
 								// Check if creating connection's buffer callbacks argument failed
-								unique_ptr<tuple<evhttp_connection *, string *, const string *, unordered_map<evhttp_connection *, Client> *, unordered_map<string, unordered_set<string>> *, bool *>> connectionsBufferCallbacksArgument = make_unique<tuple<evhttp_connection *, string *, const string *, unordered_map<evhttp_connection *, Client> *, unordered_map<string, unordered_set<string>> *, bool *>>(connection, message.get(), onionServiceAddress, clients, urls, messageCompressed.get());
+								unique_ptr<tuple<evhttp_connection *, string *, const string *, unordered_map<evhttp_connection *, Client> *, unordered_map<string, unordered_set<string>> *, bool *, Cache *>> connectionsBufferCallbacksArgument = make_unique<tuple<evhttp_connection *, string *, const string *, unordered_map<evhttp_connection *, Client> *, unordered_map<string, unordered_set<string>> *, bool *, Cache *>>(connection, message.get(), onionServiceAddress, clients, urls, messageCompressed.get(), cache);
 								if(!connectionsBufferCallbacksArgument) {
 								
 									// Reply with internal server error to request
@@ -1211,20 +2209,39 @@ int main(int argc, char *argv[]) {
 									evhttp_send_reply(request, HTTP_SWITCHING_PROTOCOL, nullptr, nullptr);
 									
 									// Add connection to list of clients
-									clients->emplace(connection, Client(sessionId, supportsCompression));
+									clients->emplace(connection, Client(sessionId, supportsCompression, *minimumCompressionLength));
+									
+									// Check if watching the connection's buffer with the client's memory account failed
+									if(!clients->at(connection).getMemoryAccount().watch(evhttp_connection_get_bufferevent(connection))) {
+									
+										// Log failure
+										Logger::log(Logger::Level::WARNING, "Watching client's buffer memory failed", clients->at(connection).getId());
+									}
+									
+									// Probe handshake accepted
+									PROBE(handshake_accepted, clients->at(connection).getId(), supportsCompression);
+									
+									// Log client connected
+									Logger::log(Logger::Level::DEBUG, "Client connected", clients->at(connection).getId());
 									
 									// Check if URLs doesn't exist for the session ID
 									if(!urls->count(sessionId)) {
 									
 										// Add session ID to URLs list
 										urls->emplace(sessionId, unordered_set<string>());
+										
+										// Account for the session ID's memory
+										Memory::add(Memory::Category::URLS, sizeof(sessionId) + sessionId.length());
 									}
 									
 									// Set connection's buffer callbacks
 									bufferevent_setcb(evhttp_connection_get_bufferevent(connection), ([](bufferevent *connectionsBuffer, void *argument) {
 									
+										// Start callback's monitor
+										Monitor monitor(Monitor::Callback::WEBSOCKET_READ);
+										
 										// Get connection's buffer callbacks argument from argument
-										unique_ptr<tuple<evhttp_connection *, string *, const string *, unordered_map<evhttp_connection *, Client> *, unordered_map<string, unordered_set<string>> *, bool *>> connectionsBufferCallbacksArgument(reinterpret_cast<tuple<evhttp_connection *, string *, const string *, unordered_map<evhttp_connection *, Client> *, unordered_map<string, unordered_set<string>> *, bool *> *>(argument));
+										unique_ptr<tuple<evhttp_connection *, string *, const string *, unordered_map<evhttp_connection *, Client> *, unordered_map<string, unordered_set<string>> *, bool *, Cache *>> connectionsBufferCallbacksArgument(reinterpret_cast<tuple<evhttp_connection *, string *, const string *, unordered_map<evhttp_connection *, Client> *, unordered_map<string, unordered_set<string>> *, bool *, Cache *> *>(argument));
 										
 										// Get connection from connection's buffer callbacks argument
 										evhttp_connection *connection = get<0>(*connectionsBufferCallbacksArgument);
@@ -1243,6 +2260,9 @@ int main(int argc, char *argv[]) {
 										
 										// Get message compressed from connection's buffer callbacks argument
 										unique_ptr<bool> messageCompressed(get<5>(*connectionsBufferCallbacksArgument));
+										
+										// Get cache from connection's buffer callbacks argument
+										Cache *cache = get<6>(*connectionsBufferCallbacksArgument);
 									
 										// Check if getting input from the connection's buffer failed
 										evbuffer *input = bufferevent_get_input(connectionsBuffer);
@@ -1260,6 +2280,12 @@ int main(int argc, char *argv[]) {
 												// Cancel all client's interactions
 												clients->at(connection).cancelAllInteractions();
 												
+												// Probe client disconnected
+												PROBE(client_disconnected, clients->at(connection).getId(), "buffer_unavailable");
+												
+												// Log client disconnected
+												Logger::log(Logger::Level::WARNING, "Client disconnected", clients->at(connection).getId(), "buffer_unavailable");
+												
 												// Remove connection from list of clients
 												clients->erase(connection);
 											}
@@ -1271,6 +2297,9 @@ int main(int argc, char *argv[]) {
 											// Get input's length
 											size_t length = evbuffer_get_length(input);
 											
+											// Set callback's monitor's payload size to the input's length
+											monitor.setPayloadSize(length);
+											
 											// Check if connection doesn't exist
 											if(!clients->count(connection)) {
 											
@@ -1299,6 +2328,12 @@ int main(int argc, char *argv[]) {
 													// Cancel all client's interactions
 													clients->at(connection).cancelAllInteractions();
 													
+													// Probe client disconnected
+													PROBE(client_disconnected, clients->at(connection).getId(), "message_too_large");
+													
+													// Log client disconnected
+													Logger::log(Logger::Level::WARNING, "Client disconnected", clients->at(connection).getId(), "message_too_large");
+													
 													// Remove connection from list of clients
 													clients->erase(connection);
 												}
@@ -1322,6 +2357,12 @@ int main(int argc, char *argv[]) {
 														// Cancel all client's interactions
 														clients->at(connection).cancelAllInteractions();
 														
+														// Probe client disconnected
+														PROBE(client_disconnected, clients->at(connection).getId(), "read_failed");
+														
+														// Log client disconnected
+														Logger::log(Logger::Level::WARNING, "Client disconnected", clients->at(connection).getId(), "read_failed");
+														
 														// Remove connection from list of clients
 														clients->erase(connection);
 													}
@@ -1333,19 +2374,19 @@ int main(int argc, char *argv[]) {
 														while(true) {
 														
 															// Check if frame contains an opcode
-															if(length > WEBSOCKET_OPCODE_BYTE_OFFSET) {
+															if(length > WebSocket::OPCODE_BYTE_OFFSET) {
 															
 																// Get opcode
-																WebSocketOpcode opcode = static_cast<WebSocketOpcode>(data[WEBSOCKET_OPCODE_BYTE_OFFSET] & WEBSOCKET_OPCODE_BYTE_MASK);
+																WebSocket::Opcode opcode = static_cast<WebSocket::Opcode>(data[WebSocket::OPCODE_BYTE_OFFSET] & WebSocket::OPCODE_BYTE_MASK);
 																
 																// Get is final frame
-																const bool isFinalFrame = data[WEBSOCKET_FINAL_FRAME_BYTE_OFFSET] & WEBSOCKET_FINAL_FRAME_BYTE_MASK;
+																const bool isFinalFrame = data[WebSocket::FINAL_FRAME_BYTE_OFFSET] & WebSocket::FINAL_FRAME_BYTE_MASK;
 																
 																// Check opcode
 																switch(opcode) {
 																
 																	// Continuation
-																	case WebSocketOpcode::CONTINUATION:
+																	case WebSocket::Opcode::CONTINUATION:
 																	
 																		// Check if no there is no frame to continue
 																		if(message->empty()) {
@@ -1362,6 +2403,12 @@ int main(int argc, char *argv[]) {
 																			// Cancel all client's interactions
 																			clients->at(connection).cancelAllInteractions();
 																			
+																			// Probe client disconnected
+																			PROBE(client_disconnected, clients->at(connection).getId(), "protocol_error");
+																			
+																			// Log client disconnected
+																			Logger::log(Logger::Level::WARNING, "Client disconnected", clients->at(connection).getId(), "protocol_error");
+																			
 																			// Remove connection from list of clients
 																			clients->erase(connection);
 																			
@@ -1373,8 +2420,8 @@ int main(int argc, char *argv[]) {
 																		break;
 																	
 																	// Ping or pong
-																	case WebSocketOpcode::PING:
-																	case WebSocketOpcode::PONG:
+																	case WebSocket::Opcode::PING:
+																	case WebSocket::Opcode::PONG:
 																	
 																		// Check if frame isn't the final frame
 																		if(!isFinalFrame) {
@@ -1391,6 +2438,12 @@ int main(int argc, char *argv[]) {
 																			// Cancel all client's interactions
 																			clients->at(connection).cancelAllInteractions();
 																			
+																			// Probe client disconnected
+																			PROBE(client_disconnected, clients->at(connection).getId(), "protocol_error");
+																			
+																			// Log client disconnected
+																			Logger::log(Logger::Level::WARNING, "Client disconnected", clients->at(connection).getId(), "protocol_error");
+																			
 																			// Remove connection from list of clients
 																			clients->erase(connection);
 																			
@@ -1402,7 +2455,7 @@ int main(int argc, char *argv[]) {
 																		break;
 																	
 																	// Text
-																	case WebSocketOpcode::TEXT:
+																	case WebSocket::Opcode::TEXT:
 																	
 																		// Break
 																		break;
@@ -1422,6 +2475,12 @@ int main(int argc, char *argv[]) {
 																		// Cancel all client's interactions
 																		clients->at(connection).cancelAllInteractions();
 																		
+																		// Probe client disconnected
+																		PROBE(client_disconnected, clients->at(connection).getId(), "unsupported_opcode");
+																		
+																		// Log client disconnected
+																		Logger::log(Logger::Level::WARNING, "Client disconnected", clients->at(connection).getId(), "unsupported_opcode");
+																		
 																		// Remove connection from list of clients
 																		clients->erase(connection);
 																		
@@ -1430,16 +2489,16 @@ int main(int argc, char *argv[]) {
 																}
 																
 																// Get extension
-																const uint8_t extension = data[WEBSOCKET_EXTENSION_BYTE_OFFSET] & WEBSOCKET_EXTENSION_BYTE_MASK;
+																const uint8_t extension = data[WebSocket::EXTENSION_BYTE_OFFSET] & WebSocket::EXTENSION_BYTE_MASK;
 																
 																// Check if has extension
 																if(extension) {
 																
 																	// Check if opcode is text and this is the first frame in the message
-																	if(opcode == WebSocketOpcode::TEXT && message->empty()) {
+																	if(opcode == WebSocket::Opcode::TEXT && message->empty()) {
 																	
 																		// Check if client doesn't support compression or has an unsupported extension
-																		if(!clients->at(connection).getSupportsCompression() || extension & ~WEBSOCKET_COMPRESSED_EXTENSION_BYTE_MASK) {
+																		if(!clients->at(connection).getSupportsCompression() || extension & ~WebSocket::COMPRESSED_EXTENSION_BYTE_MASK) {
 																		
 																			// Remove data from input
 																			evbuffer_drain(input, length);
@@ -1453,6 +2512,12 @@ int main(int argc, char *argv[]) {
 																			// Cancel all client's interactions
 																			clients->at(connection).cancelAllInteractions();
 																			
+																			// Probe client disconnected
+																			PROBE(client_disconnected, clients->at(connection).getId(), "protocol_error");
+																			
+																			// Log client disconnected
+																			Logger::log(Logger::Level::WARNING, "Client disconnected", clients->at(connection).getId(), "protocol_error");
+																			
 																			// Remove connection from list of clients
 																			clients->erase(connection);
 																			
@@ -1483,6 +2548,12 @@ int main(int argc, char *argv[]) {
 																		// Cancel all client's interactions
 																		clients->at(connection).cancelAllInteractions();
 																		
+																		// Probe client disconnected
+																		PROBE(client_disconnected, clients->at(connection).getId(), "protocol_error");
+																		
+																		// Log client disconnected
+																		Logger::log(Logger::Level::WARNING, "Client disconnected", clients->at(connection).getId(), "protocol_error");
+																		
 																		// Remove connection from list of clients
 																		clients->erase(connection);
 																		
@@ -1492,10 +2563,10 @@ int main(int argc, char *argv[]) {
 																}
 																
 																// Check if frame contains a length
-																if(length > WEBSOCKET_LENGTH_BYTE_OFFSET) {
+																if(length > WebSocket::LENGTH_BYTE_OFFSET) {
 																
 																	// Get has mask
-																	const bool hasMask = data[WEBSOCKET_MASK_BYTE_OFFSET] & WEBSOCKET_MASK_BYTE_MASK;
+																	const bool hasMask = data[WebSocket::MASK_BYTE_OFFSET] & WebSocket::MASK_BYTE_MASK;
 																	
 																	// Check if doesn't have a mask
 																	if(!hasMask) {
@@ -1512,6 +2583,12 @@ int main(int argc, char *argv[]) {
 																		// Cancel all client's interactions
 																		clients->at(connection).cancelAllInteractions();
 																		
+																		// Probe client disconnected
+																		PROBE(client_disconnected, clients->at(connection).getId(), "protocol_error");
+																		
+																		// Log client disconnected
+																		Logger::log(Logger::Level::WARNING, "Client disconnected", clients->at(connection).getId(), "protocol_error");
+																		
 																		// Remove connection from list of clients
 																		clients->erase(connection);
 																		
@@ -1520,16 +2597,16 @@ int main(int argc, char *argv[]) {
 																	}
 																	
 																	// Get real length
-																	uint64_t realLength = data[WEBSOCKET_LENGTH_BYTE_OFFSET] & WEBSOCKET_LENGTH_BYTE_MASK;
+																	uint64_t realLength = data[WebSocket::LENGTH_BYTE_OFFSET] & WebSocket::LENGTH_BYTE_MASK;
 																	
 																	// Initialize mask offset
 																	size_t maskOffset;
 																	
 																	// Check if real length is expressed by next sixteen bits
-																	if(realLength == WEBSOCKET_SIXTEEN_BITS_LENGTH) {
+																	if(realLength == WebSocket::SIXTEEN_BITS_LENGTH) {
 																	
 																		// Check of opcode is a ping or pong
-																		if(opcode == WebSocketOpcode::PING || opcode == WebSocketOpcode::PONG) {
+																		if(opcode == WebSocket::Opcode::PING || opcode == WebSocket::Opcode::PONG) {
 																		
 																			// Remove data from input
 																			evbuffer_drain(input, length);
@@ -1543,6 +2620,12 @@ int main(int argc, char *argv[]) {
 																			// Cancel all client's interactions
 																			clients->at(connection).cancelAllInteractions();
 																			
+																			// Probe client disconnected
+																			PROBE(client_disconnected, clients->at(connection).getId(), "protocol_error");
+																			
+																			// Log client disconnected
+																			Logger::log(Logger::Level::WARNING, "Client disconnected", clients->at(connection).getId(), "protocol_error");
+																			
 																			// Remove connection from list of clients
 																			clients->erase(connection);
 																			
@@ -1551,18 +2634,18 @@ int main(int argc, char *argv[]) {
 																		}
 																	
 																		// Check if frame contains real length
-																		if(length > WEBSOCKET_LENGTH_BYTE_OFFSET + sizeof(uint16_t)) {
+																		if(length > WebSocket::LENGTH_BYTE_OFFSET + sizeof(uint16_t)) {
 																		
 																			// Go through all real length bytes
 																			realLength = 0;
 																			for(size_t i = 0; i < sizeof(uint16_t); ++i) {
 																			
 																				// Include length byte in real length
-																				realLength |= static_cast<uint64_t>(data[WEBSOCKET_LENGTH_BYTE_OFFSET + sizeof(uint16_t) - sizeof(uint8_t) * i]) << (Common::BITS_IN_A_BYTE * i);
+																				realLength |= static_cast<uint64_t>(data[WebSocket::LENGTH_BYTE_OFFSET + sizeof(uint16_t) - sizeof(uint8_t) * i]) << (Common::BITS_IN_A_BYTE * i);
 																			}
 																			
 																			// Set mask offsets
-																			maskOffset = WEBSOCKET_LENGTH_BYTE_OFFSET + sizeof(uint16_t) + sizeof(uint8_t);
+																			maskOffset = WebSocket::LENGTH_BYTE_OFFSET + sizeof(uint16_t) + sizeof(uint8_t);
 																		}
 																		
 																		// Otherwise
@@ -1574,10 +2657,10 @@ int main(int argc, char *argv[]) {
 																	}
 																	
 																	// Otherwise check if real length is expressed by next sixty-three bits
-																	else if(realLength == WEBSOCKET_SIXTY_THREE_BITS_LENGTH) {
+																	else if(realLength == WebSocket::SIXTY_THREE_BITS_LENGTH) {
 																	
 																		// Check of opcode is a ping or pong
-																		if(opcode == WebSocketOpcode::PING || opcode == WebSocketOpcode::PONG) {
+																		if(opcode == WebSocket::Opcode::PING || opcode == WebSocket::Opcode::PONG) {
 																		
 																			// Remove data from input
 																			evbuffer_drain(input, length);
@@ -1591,6 +2674,12 @@ int main(int argc, char *argv[]) {
 																			// Cancel all client's interactions
 																			clients->at(connection).cancelAllInteractions();
 																			
+																			// Probe client disconnected
+																			PROBE(client_disconnected, clients->at(connection).getId(), "protocol_error");
+																			
+																			// Log client disconnected
+																			Logger::log(Logger::Level::WARNING, "Client disconnected", clients->at(connection).getId(), "protocol_error");
+																			
 																			// Remove connection from list of clients
 																			clients->erase(connection);
 																			
@@ -1599,14 +2688,14 @@ int main(int argc, char *argv[]) {
 																		}
 																	
 																		// Check if frame contains real length
-																		if(length > WEBSOCKET_LENGTH_BYTE_OFFSET + sizeof(uint64_t)) {
+																		if(length > WebSocket::LENGTH_BYTE_OFFSET + sizeof(uint64_t)) {
 																		
 																			// Go through all real length bytes
 																			realLength = 0;
 																			for(size_t i = 0; i < sizeof(uint64_t); ++i) {
 																			
 																				// Include length byte in real length
-																				realLength |= static_cast<uint64_t>(data[WEBSOCKET_LENGTH_BYTE_OFFSET + sizeof(uint64_t) - sizeof(uint8_t) * i]) << (Common::BITS_IN_A_BYTE * i);
+																				realLength |= static_cast<uint64_t>(data[WebSocket::LENGTH_BYTE_OFFSET + sizeof(uint64_t) - sizeof(uint8_t) * i]) << (Common::BITS_IN_A_BYTE * i);
 																			}
 																			
 																			// Check if real length is invalid
@@ -1624,6 +2713,12 @@ int main(int argc, char *argv[]) {
 																				// Cancel all client's interactions
 																				clients->at(connection).cancelAllInteractions();
 																				
+																				// Probe client disconnected
+																				PROBE(client_disconnected, clients->at(connection).getId(), "protocol_error");
+																				
+																				// Log client disconnected
+																				Logger::log(Logger::Level::WARNING, "Client disconnected", clients->at(connection).getId(), "protocol_error");
+																				
 																				// Remove connection from list of clients
 																				clients->erase(connection);
 																				
@@ -1632,7 +2727,7 @@ int main(int argc, char *argv[]) {
 																			}
 																			
 																			// Set mask offsets
-																			maskOffset = WEBSOCKET_LENGTH_BYTE_OFFSET + sizeof(uint64_t) + sizeof(uint8_t);
+																			maskOffset = WebSocket::LENGTH_BYTE_OFFSET + sizeof(uint64_t) + sizeof(uint8_t);
 																		}
 																		
 																		// Otherwise
@@ -1647,7 +2742,7 @@ int main(int argc, char *argv[]) {
 																	else {
 																	
 																		// Set mask offsets
-																		maskOffset = WEBSOCKET_LENGTH_BYTE_OFFSET + sizeof(uint8_t);
+																		maskOffset = WebSocket::LENGTH_BYTE_OFFSET + sizeof(uint8_t);
 																	}
 																	
 																	// Check if real length is invalid
@@ -1665,6 +2760,12 @@ int main(int argc, char *argv[]) {
 																		// Cancel all client's interactions
 																		clients->at(connection).cancelAllInteractions();
 																		
+																		// Probe client disconnected
+																		PROBE(client_disconnected, clients->at(connection).getId(), "protocol_error");
+																		
+																		// Log client disconnected
+																		Logger::log(Logger::Level::WARNING, "Client disconnected", clients->at(connection).getId(), "protocol_error");
+																		
 																		// Remove connection from list of clients
 																		clients->erase(connection);
 																		
@@ -1673,39 +2774,73 @@ int main(int argc, char *argv[]) {
 																	}
 																	
 																	// Check if frame contains the mask and data
-																	if(length >= maskOffset + WEBSOCKET_MASK_LENGTH + realLength) {
+																	if(length >= maskOffset + WebSocket::MASK_LENGTH + realLength) {
 																	
-																		// Go through all bytes of data
-																		for(uint64_t i = 0; i < realLength; ++i) {
+																		// Check if message is too large
+																		if(realLength > MAXIMUM_WEBSOCKET_MESSAGE_SIZE - message->size()) {
+
+																			// Remove data from input
+																			evbuffer_drain(input, length);
+																			
+																			// Remove connection's buffer callbacks
+																			bufferevent_setcb(connectionsBuffer, nullptr, nullptr, nullptr, nullptr);
+																			
+																			// Close connection
+																			evhttp_connection_free(connection);
+																			
+																			// Cancel all client's interactions
+																			clients->at(connection).cancelAllInteractions();
+																			
+																			// Probe client disconnected
+																			PROBE(client_disconnected, clients->at(connection).getId(), "message_too_large");
+																			
+																			// Log client disconnected
+																			Logger::log(Logger::Level::WARNING, "Client disconnected", clients->at(connection).getId(), "message_too_large");
+																			
+																			// Remove connection from list of clients
+																			clients->erase(connection);
+																			
+																			// Return
+																			return;
+																		}
 																		
-																			// Append unmasked byte to the message
-																			message->push_back(data[maskOffset + WEBSOCKET_MASK_LENGTH + i] ^ data[maskOffset + i % WEBSOCKET_MASK_LENGTH]);
+																		// Append space for the data to the message
+																		const size_t messageLength = message->size();
+																		message->resize(messageLength + realLength);
+																		
+																		// Account for the message's memory
+																		clients->at(connection).getMemoryAccount().set(Memory::Category::MESSAGES, message->capacity());
+																		
+																		// Check if unmasking the data into the message failed
+																		if(!WebSocket::unmask(reinterpret_cast<uint8_t *>(&(*message)[messageLength]), &data[maskOffset + WebSocket::MASK_LENGTH], realLength, &data[maskOffset], (opcode != WebSocket::Opcode::PING && opcode != WebSocket::Opcode::PONG && !*messageCompressed) ? &clients->at(connection).getMessageValidator() : nullptr)) {
+
+																			// Remove data from input
+																			evbuffer_drain(input, length);
 																			
-																			// Check if message is too large
-																			if(message->size() > MAXIMUM_WEBSOCKET_MESSAGE_SIZE) {
+																			// Remove connection's buffer callbacks
+																			bufferevent_setcb(connectionsBuffer, nullptr, nullptr, nullptr, nullptr);
 																			
-																				// Remove data from input
-																				evbuffer_drain(input, length);
-																				
-																				// Remove connection's buffer callbacks
-																				bufferevent_setcb(connectionsBuffer, nullptr, nullptr, nullptr, nullptr);
-																				
-																				// Close connection
-																				evhttp_connection_free(connection);
-																				
-																				// Cancel all client's interactions
-																				clients->at(connection).cancelAllInteractions();
-																				
-																				// Remove connection from list of clients
-																				clients->erase(connection);
-																				
-																				// Return
-																				return;
-																			}
+																			// Close connection
+																			evhttp_connection_free(connection);
+																			
+																			// Cancel all client's interactions
+																			clients->at(connection).cancelAllInteractions();
+																			
+																			// Probe client disconnected
+																			PROBE(client_disconnected, clients->at(connection).getId(), "invalid_message");
+																			
+																			// Log client disconnected
+																			Logger::log(Logger::Level::WARNING, "Client disconnected", clients->at(connection).getId(), "invalid_message");
+																			
+																			// Remove connection from list of clients
+																			clients->erase(connection);
+																			
+																			// Return
+																			return;
 																		}
 																		
 																		// Check if removing frame from input failed
-																		if(evbuffer_drain(input, maskOffset + WEBSOCKET_MASK_LENGTH + realLength)) {
+																		if(evbuffer_drain(input, maskOffset + WebSocket::MASK_LENGTH + realLength)) {
 																		
 																			// Remove data from input
 																			evbuffer_drain(input, length);
@@ -1719,6 +2854,12 @@ int main(int argc, char *argv[]) {
 																			// Cancel all client's interactions
 																			clients->at(connection).cancelAllInteractions();
 																			
+																			// Probe client disconnected
+																			PROBE(client_disconnected, clients->at(connection).getId(), "read_failed");
+																			
+																			// Log client disconnected
+																			Logger::log(Logger::Level::WARNING, "Client disconnected", clients->at(connection).getId(), "read_failed");
+																			
 																			// Remove connection from list of clients
 																			clients->erase(connection);
 																			
@@ -1726,31 +2867,41 @@ int main(int argc, char *argv[]) {
 																			return;
 																		}
 																		
+																		// Update WebSocket frames parsed and bytes received metrics
+																		Metrics::webSocketFramesParsed.increment();
+																		Metrics::webSocketBytesReceived.increment(maskOffset + WebSocket::MASK_LENGTH + realLength);
+																		
+																		// Probe frame parsed
+																		PROBE(frame_parsed, clients->at(connection).getId(), static_cast<uint8_t>(opcode), realLength, *messageCompressed);
+																		
 																		// Remove frame's length from length
-																		length -= maskOffset + WEBSOCKET_MASK_LENGTH + realLength;
+																		length -= maskOffset + WebSocket::MASK_LENGTH + realLength;
 																		
 																		// Remove frame from data
-																		memmove(data, &data[maskOffset + WEBSOCKET_MASK_LENGTH + realLength], length);
+																		memmove(data, &data[maskOffset + WebSocket::MASK_LENGTH + realLength], length);
 																		
 																		// Check is the final frame
 																		if(isFinalFrame) {
 																		
+																			// Profile the message's allocations
+																			PROFILE_ALLOCATIONS(WEBSOCKET_MESSAGE);
+																		
 																			// Check opcode
 																			switch(opcode) {
 																			
 																				// Text
-																				case WebSocketOpcode::TEXT:
+																				case WebSocket::Opcode::TEXT:
 																					
 																					{
 																						// Check if message is compressed
 																						if(*messageCompressed) {
 																						
 																							// Append compressed message tail to end of the message
-																							message->insert(message->end(), WEBSOCKET_COMPRESSED_MESSAGE_TAIL.begin(), WEBSOCKET_COMPRESSED_MESSAGE_TAIL.end());
+																							message->insert(message->end(), WebSocket::COMPRESSED_MESSAGE_TAIL.begin(), WebSocket::COMPRESSED_MESSAGE_TAIL.end());
 																							
-																							// Check if inflating the message failed
-																							vector<uint8_t> decompressedMessage;
-																							if(!Common::inflate(decompressedMessage, vector<uint8_t>(message->begin(), message->end()))) {
+																							// Check if inflating the message failed or it isn't valid UTF-8
+																							string decompressedMessage;
+																							if(!Common::inflateUtf8(decompressedMessage, *message)) {
 																							
 																								// Remove data from input
 																								evbuffer_drain(input, length);
@@ -1764,6 +2915,12 @@ int main(int argc, char *argv[]) {
 																								// Cancel all client's interactions
 																								clients->at(connection).cancelAllInteractions();
 																								
+																								// Probe client disconnected
+																								PROBE(client_disconnected, clients->at(connection).getId(), "invalid_message");
+																								
+																								// Log client disconnected
+																								Logger::log(Logger::Level::WARNING, "Client disconnected", clients->at(connection).getId(), "invalid_message");
+																								
 																								// Remove connection from list of clients
 																								clients->erase(connection);
 																								
@@ -1772,34 +2929,78 @@ int main(int argc, char *argv[]) {
 																							}
 																							
 																							// Set message to the decompressed message
-																							*message = string(decompressedMessage.begin(), decompressedMessage.end());
+																							message->swap(decompressedMessage);
+																							
+																							// Account for the message's memory
+																							clients->at(connection).getMemoryAccount().set(Memory::Category::MESSAGES, message->capacity());
+																						}
+																						
+																						// Otherwise check if message ends with an incomplete UTF-8 character
+																						else if(!clients->at(connection).getMessageValidator().isComplete()) {
+																						
+																							// Remove data from input
+																							evbuffer_drain(input, length);
+																							
+																							// Remove connection's buffer callbacks
+																							bufferevent_setcb(connectionsBuffer, nullptr, nullptr, nullptr, nullptr);
+																							
+																							// Close connection
+																							evhttp_connection_free(connection);
+																							
+																							// Cancel all client's interactions
+																							clients->at(connection).cancelAllInteractions();
+																							
+																							// Probe client disconnected
+																							PROBE(client_disconnected, clients->at(connection).getId(), "invalid_message");
+																							
+																							// Log client disconnected
+																							Logger::log(Logger::Level::WARNING, "Client disconnected", clients->at(connection).getId(), "invalid_message");
+																							
+																							// Remove connection from list of clients
+																							clients->erase(connection);
+																							
+																							// Return
+																							return;
 																						}
 																						
+																						// Record message received from the client
+																						Recorder::recordClientMessage(clients->at(connection).getId(), *messageCompressed, *message);
+																						
 																						// Initialize response
 																						string response;
 																						
+																						// Decode message as JSON
+																						ControlMessage controlMessage;
+																						InteractionMessage interactionMessage;
+																						const chrono::steady_clock::time_point decodeStartTime = chrono::steady_clock::now();
+																						const bool messageIsJson = CLIENT_MESSAGE_DECODER.decodeValidUtf8(*message, controlMessage, interactionMessage);
+																						
+																						// Update JSON decode duration metric
+																						Metrics::jsonDecodeDuration.recordDuration(chrono::steady_clock::now() - decodeStartTime);
+																						
+																						// Probe message decoded
+																						PROBE(message_decoded, clients->at(connection).getId(), message->size(), messageIsJson);
+																						
 																						// Check if message is JSON
-																						Json jsonMessage;
-																						if(jsonMessage.decode(*message) && jsonMessage.getType() == Json::Type::OBJECT) {
+																						if(messageIsJson) {
 																						
 																							// Check if message contains an index
-																							if(jsonMessage.getObjectValue().count("Index")) {
+																							if(controlMessage.index.state != Schema::State::MISSING) {
 																							
 																								// Check if index is valid
-																								Json::Number integerComponent;
-																								if(jsonMessage.getObjectValue().at("Index")->getType() == Json::Type::NUMBER && jsonMessage.getObjectValue().at("Index")->getNumberValue() >= 0 && jsonMessage.getObjectValue().at("Index")->getNumberValue() <= MAXIMUM_SAFE_INTEGER && modf(jsonMessage.getObjectValue().at("Index")->getNumberValue(), &integerComponent) == 0) {
+																								if(controlMessage.index.state == Schema::State::VALID) {
 																							
 																									// Get index
-																									const Json::Number &index = jsonMessage.getObjectValue().at("Index")->getNumberValue();
+																									const Json::Number &index = controlMessage.index.value;
 																									
 																									// Check if message contains a valid request
-																									if(jsonMessage.getObjectValue().count("Request") && jsonMessage.getObjectValue().at("Request")->getType() == Json::Type::STRING) {
+																									if(controlMessage.request.state == Schema::State::VALID) {
 																							
-																										// Get JSON request
-																										const Json::String &jsonRequest = jsonMessage.getObjectValue().at("Request")->getStringValue();
+																										// Get control request
+																										const ControlRequest controlRequest = static_cast<ControlRequest>(CONTROL_REQUESTS.find(controlMessage.request.getValue()));
 																										
 																										// Check if the message request is to create a URL
-																										if(jsonRequest == "Create URL") {
+																										if(controlRequest == ControlRequest::CREATE_URL) {
 																										
 																											// Initialize URL
 																											string url;
@@ -1844,31 +3045,28 @@ int main(int argc, char *argv[]) {
 																											// Add URL to list of session's URLs
 																											sessionsUrls.emplace(url);
 																											
-																											// Set response
-																											response = Json(Json::Object{
-																												{"Index", make_unique<Json>(index)},
-																												{"Response", make_unique<Json>(url)}
-																											}).encode();
+																											// Account for the URL's memory
+																											Memory::add(Memory::Category::URLS, sizeof(url) + url.length());
+																											
+																											// Fill response
+																											INDEX_RESPONSE_TEMPLATE.fill(response, index, url);
 																										}
 																										
 																										// Otherwise check if message request is to change a URL
-																										else if(jsonRequest == "Change URL") {
+																										else if(controlRequest == ControlRequest::CHANGE_URL) {
 																										
 																											// Check if URL isn't provided or is invalid
-																											if(!jsonMessage.getObjectValue().count("URL") || jsonMessage.getObjectValue().at("URL")->getType() != Json::Type::STRING) {
+																											if(controlMessage.url.state != Schema::State::VALID) {
 																											
-																												// Set response
-																												response = Json(Json::Object{
-																													{"Index", make_unique<Json>(index)},
-																													{"Error", make_unique<Json>(jsonMessage.getObjectValue().count("URL") ? "Invalid URL parameter" : "Missing URL parameter")}
-																												}).encode();
+																												// Fill response
+																												INDEX_ERROR_RESPONSE_TEMPLATE.fill(response, index, (controlMessage.url.state == Schema::State::INVALID) ? "Invalid URL parameter" : "Missing URL parameter");
 																											}
 																											
 																											// Otherwise
 																											else {
 																											
 																												// Get old URL
-																												const Json::String oldUrl = Common::toLowerCase(jsonMessage.getObjectValue().at("URL")->getStringValue());
+																												const Json::String oldUrl = Common::toLowerCase(string(controlMessage.url.getValue()));
 																												
 																												// Get session's URLs
 																												unordered_set<string> &sessionsUrls = urls->at(clients->at(connection).getSessionId());
@@ -1919,43 +3117,38 @@ int main(int argc, char *argv[]) {
 																													// Add URL to list of session's URLs
 																													sessionsUrls.emplace(url);
 																													
-																													// Set response
-																													response = Json(Json::Object{
-																														{"Index", make_unique<Json>(index)},
-																														{"Response", make_unique<Json>(url)}
-																													}).encode();
+																													// Account for the URL's memory replacing the old URL's memory
+																													Memory::subtract(Memory::Category::URLS, sizeof(oldUrl) + oldUrl.length());
+																													Memory::add(Memory::Category::URLS, sizeof(url) + url.length());
+																													
+																													// Fill response
+																													INDEX_RESPONSE_TEMPLATE.fill(response, index, url);
 																												}
 																												
 																												// Otherwis
 																												else {
 																												
-																													// Set response
-																													response = Json(Json::Object{
-																														{"Index", make_unique<Json>(index)},
-																														{"Error", make_unique<Json>("URL doesn't exist or it isn't owned by your session ID")}
-																													}).encode();
+																													// Fill response
+																													INDEX_ERROR_RESPONSE_TEMPLATE.fill(response, index, "URL doesn't exist or it isn't owned by your session ID");
 																												}
 																											}
 																										}
 																										
 																										// Otherwise check if the message request is to delete a URL
-																										else if(jsonRequest == "Delete URL") {
+																										else if(controlRequest == ControlRequest::DELETE_URL) {
 																										
 																											// Check if URL isn't provided or is invalid
-																											if(!jsonMessage.getObjectValue().count("URL") || jsonMessage.getObjectValue().at("URL")->getType() != Json::Type::STRING) {
+																											if(controlMessage.url.state != Schema::State::VALID) {
 																											
-																												// Set response
-																												response = Json(Json::Object{
-																													{"Index", make_unique<Json>(index)},
-																													{"Error", make_unique<Json>(jsonMessage.getObjectValue().count("URL") ? "Invalid URL parameter" : "Missing URL parameter")}
-																												}).encode();
+																												// Fill response
+																												INDEX_ERROR_RESPONSE_TEMPLATE.fill(response, index, (controlMessage.url.state == Schema::State::INVALID) ? "Invalid URL parameter" : "Missing URL parameter");
 																											}
 																											
 																											// Otherwise
 																											else {
 																											
 																												// Get URL
-																												const Json::String url = Common::toLowerCase(jsonMessage.getObjectValue().at("URL")->getStringValue());
+																												const Json::String url = Common::toLowerCase(string(controlMessage.url.getValue()));
 																										
 																												// Get session's URLs
 																												unordered_set<string> &sessionsUrls = urls->at(clients->at(connection).getSessionId());
@@ -1965,44 +3158,38 @@ int main(int argc, char *argv[]) {
 																												
 																													// Delete URL
 																													sessionsUrls.erase(url);
+																													
+																													// Stop accounting for the URL's memory
+																													Memory::subtract(Memory::Category::URLS, sizeof(url) + url.length());
 																												
-																													// Set response
-																													response = Json(Json::Object{
-																														{"Index", make_unique<Json>(index)},
-																														{"Response", make_unique<Json>(true)}
-																													}).encode();
+																													// Fill response
+																													INDEX_RESPONSE_TEMPLATE.fill(response, index, true);
 																												}
 																												
 																												// Otherwise
 																												else {
 																												
-																													// Set response
-																													response = Json(Json::Object{
-																														{"Index", make_unique<Json>(index)},
-																														{"Error", make_unique<Json>("URL doesn't exist or it isn't owned by your session ID")}
-																													}).encode();
+																													// Fill response
+																													INDEX_ERROR_RESPONSE_TEMPLATE.fill(response, index, "URL doesn't exist or it isn't owned by your session ID");
 																												}
 																											}
 																										}
 																										
 																										// Otherwise check if message request is to check if they own a URL
-																										else if(jsonRequest == "Own URL") {
+																										else if(controlRequest == ControlRequest::OWN_URL) {
 																										
 																											// Check if URL isn't provided or is invalid
-																											if(!jsonMessage.getObjectValue().count("URL") || jsonMessage.getObjectValue().at("URL")->getType() != Json::Type::STRING) {
+																											if(controlMessage.url.state != Schema::State::VALID) {
 																											
-																												// Set response
-																												response = Json(Json::Object{
-																													{"Index", make_unique<Json>(index)},
-																													{"Error", make_unique<Json>(jsonMessage.getObjectValue().count("URL") ? "Invalid URL parameter" : "Missing URL parameter")}
-																												}).encode();
+																												// Fill response
+																												INDEX_ERROR_RESPONSE_TEMPLATE.fill(response, index, (controlMessage.url.state == Schema::State::INVALID) ? "Invalid URL parameter" : "Missing URL parameter");
 																											}
 																											
 																											// Otherwise
 																											else {
 																											
 																												// Get URL
-																												const Json::String url = Common::toLowerCase(jsonMessage.getObjectValue().at("URL")->getStringValue());
+																												const Json::String url = Common::toLowerCase(string(controlMessage.url.getValue()));
 																												
 																												// Get session's URLs
 																												const unordered_set<string> &sessionsUrls = urls->at(clients->at(connection).getSessionId());
@@ -2010,21 +3197,15 @@ int main(int argc, char *argv[]) {
 																												// Check if session owns the URL
 																												if(sessionsUrls.count(url)) {
 																												
-																													// Set response
-																													response = Json(Json::Object{
-																														{"Index", make_unique<Json>(index)},
-																														{"Response", make_unique<Json>(true)}
-																													}).encode();
+																													// Fill response
+																													INDEX_RESPONSE_TEMPLATE.fill(response, index, true);
 																												}
 																												
 																												// Otherwise
 																												else {
 																												
-																													// Set response
-																													response = Json(Json::Object{
-																														{"Index", make_unique<Json>(index)},
-																														{"Response", make_unique<Json>(false)}
-																													}).encode();
+																													// Fill response
+																													INDEX_RESPONSE_TEMPLATE.fill(response, index, false);
 																												}
 																											}
 																										}
@@ -2032,95 +3213,129 @@ int main(int argc, char *argv[]) {
 																										// Otherwise
 																										else {
 																										
-																											// Set response
-																											response = Json(Json::Object{
-																												{"Index", make_unique<Json>(index)},
-																												{"Error", make_unique<Json>("Unknown request")}
-																											}).encode();
+																											// Fill response
+																											INDEX_ERROR_RESPONSE_TEMPLATE.fill(response, index, "Unknown request");
 																										}
 																									}
 																									
 																									// Otherwise
 																									else {
 																									
-																										// Set response
-																										response = Json(Json::Object{
-																											{"Index", make_unique<Json>(index)},
-																											{"Error", make_unique<Json>(jsonMessage.getObjectValue().count("Request") ? "Invalid request parameter" : "Missing request parameter")}
-																										}).encode();
+																										// Fill response
+																										INDEX_ERROR_RESPONSE_TEMPLATE.fill(response, index, (controlMessage.request.state == Schema::State::INVALID) ? "Invalid request parameter" : "Missing request parameter");
 																									}
 																								}
 																								
 																								// Otherwise
 																								else {
 																								
-																									// Set response
-																									response = Json(Json::Object{
-																										{"Error", make_unique<Json>("Invalid index parameter")}
-																									}).encode();
+																									// Fill response
+																									ERROR_RESPONSE_TEMPLATE.fill(response, "Invalid index parameter");
 																								}
 																							}
 																							
 																							// Otherwise check if message contains a interaction
-																							else if(jsonMessage.getObjectValue().count("Interaction")) {
+																							else if(interactionMessage.interaction.state != Schema::State::MISSING) {
 																							
 																								// Check if interaction is valid
-																								Json::Number integerComponent;
-																								if(jsonMessage.getObjectValue().at("Interaction")->getType() == Json::Type::NUMBER && jsonMessage.getObjectValue().at("Interaction")->getNumberValue() >= 0 && jsonMessage.getObjectValue().at("Interaction")->getNumberValue() <= MAXIMUM_SAFE_INTEGER && modf(jsonMessage.getObjectValue().at("Interaction")->getNumberValue(), &integerComponent) == 0) {
+																								if(interactionMessage.interaction.state == Schema::State::VALID) {
 																								
 																									// Get interaction index
-																									const Json::Number &interactionIndex = jsonMessage.getObjectValue().at("Interaction")->getNumberValue();
+																									const Json::Number &interactionIndex = interactionMessage.interaction.value;
 																									
 																									// Check if interaction currently exists
 																									evhttp_request *request = clients->at(connection).getInteraction(interactionIndex);
 																									if(request) {
 																									
+																										// Profile the reply's allocations
+																										PROFILE_ALLOCATIONS(REPLY);
+																									
+																										// Get interaction's trace
+																										Trace trace = *clients->at(connection).getInteractionTrace(interactionIndex);
+																										
+																										// Mark interaction's trace reply parsed
+																										trace.mark(Trace::Stage::REPLY_PARSED);
+																										
 																										// Remove interaction from client
 																										clients->at(connection).removeInteraction(interactionIndex);
 																									
 																										// Check if message contains valid data
-																										if(jsonMessage.getObjectValue().count("Data") && jsonMessage.getObjectValue().at("Data")->getType() == Json::Type::STRING) {
+																										if(interactionMessage.data.state == Schema::State::VALID) {
 																										
 																											// Get data
-																											const Json::String &data = jsonMessage.getObjectValue().at("Data")->getStringValue();
+																											const string_view data = interactionMessage.data.getValue();
 																											
-																											// Try
-																											bool invalidData = false;
-																											vector<uint8_t> decodedData;
-																											try {
+																											// Get decoded data's length
+																											const size_t decodedDataLength = Base64::getDecodedLength(data.data(), data.length());
 																											
-																												// Decode data
-																												decodedData = data.empty() ? URL_DOESNT_EXIST : Json::base64Decode(data);
-																											}
+																											// Get request's buffer
+																											bufferevent *requestsBuffer = evhttp_connection_get_bufferevent(evhttp_request_get_connection(request));
+																											
+																											// Set type to provided type otherwise HTML if not provided
+																											const string type = (interactionMessage.type.state == Schema::State::VALID) ? string(interactionMessage.type.getValue()) : "text/html";
 																											
-																											// Catch errors
-																											catch(...) {
+																											// Initialize compress
+																											bool compress = false;
 																											
-																												// Set invalid data
-																												invalidData = true;
+																											// Check if decoded data is large enough to compress
+																											if(decodedDataLength >= MINIMUM_COMPRESSION_LENGTH) {
+																											
+																												// Check if request contains an accept encoding header
+																												const char *acceptEncoding = evhttp_find_header(evhttp_request_get_input_headers(request), "Accept-Encoding");
+																												if(acceptEncoding) {
+																												
+																													// Get encodings
+																													const string encodings = acceptEncoding;
+																													
+																													// Go through all encodings
+																													for(string::size_type startOfEncodings = 0, endOfEncodings = encodings.find(',', startOfEncodings);; startOfEncodings = endOfEncodings + sizeof(','), endOfEncodings = encodings.find(',', startOfEncodings)) {
+																													
+																														// Get encoding
+																														const string encoding = Common::trim(encodings.substr(startOfEncodings, (endOfEncodings != string::npos) ? endOfEncodings - startOfEncodings : string::npos));
+																														
+																														// Check if encoding is gzip
+																														if(encoding == "gzip") {
+																														
+																															// Set compress
+																															compress = true;
+																															
+																															// Break
+																															break;
+																														}
+																														
+																														// Check if at the last encodings
+																														if(endOfEncodings == string::npos) {
+																														
+																															// Break
+																															break;
+																														}
+																													}
+																												}
 																											}
 																											
-																											// Check if data is invalid
-																											if(invalidData) {
+																											// Check if creating request's buffer callbacks argument failed
+																											unique_ptr<tuple<evhttp_connection *, unordered_map<evhttp_connection *, Client> *, const Json::Number, Trace>> requestsBufferCallbacksArgument = make_unique<tuple<evhttp_connection *, unordered_map<evhttp_connection *, Client> *, const Json::Number, Trace>>(connection, clients, interactionIndex, trace);
+																											if(!requestsBufferCallbacksArgument) {
 																											
-																												// Set response
-																												response = Json(Json::Object{
-																													{"Interaction", make_unique<Json>(interactionIndex)},
-																													{"Error", make_unique<Json>("Invalid data parameter")}
-																												}).encode();
+																												// Reply with internal server error to request
+																												evhttp_send_reply(request, HTTP_INTERNAL, nullptr, nullptr);
+																												
+																												// Remove request's buffer callbacks
+																												bufferevent_setcb(requestsBuffer, nullptr, nullptr, nullptr, nullptr);
+																												
+																												// Fill response
+																												INTERACTION_FAILED_RESPONSE_TEMPLATE.fill(response, interactionIndex);
 																											}
 																											
 																											// Otherwise
 																											else {
 																											
-																												// Get request's buffer
-																												bufferevent *requestsBuffer = evhttp_connection_get_bufferevent(evhttp_request_get_connection(request));
-																											
-																												// Set type to provided type otherwise HTML if not provided
-																												const string type = (jsonMessage.getObjectValue().count("Type") && jsonMessage.getObjectValue().at("Type")->getType() == Json::Type::STRING) ? jsonMessage.getObjectValue().at("Type")->getStringValue() : "text/html";
+																												// Get cache key for the data if compressing
+																												const string cacheKey = compress ? Cache::getKey(data, "gzip") : string();
 																												
-																												// Check if setting request's content type failed
-																												if(!decodedData.empty() && evhttp_add_header(evhttp_request_get_output_headers(request), "Content-Type", type.c_str())) {
+																												// Check if creating buffer failed
+																												unique_ptr<evbuffer, decltype(&evbuffer_free)> buffer(evbuffer_new(), evbuffer_free);
+																												if(!buffer) {
 																												
 																													// Reply with internal server error to request
 																													evhttp_send_reply(request, HTTP_INTERNAL, nullptr, nullptr);
@@ -2128,19 +3343,43 @@ int main(int argc, char *argv[]) {
 																													// Remove request's buffer callbacks
 																													bufferevent_setcb(requestsBuffer, nullptr, nullptr, nullptr, nullptr);
 																													
-																													// Set response
-																													response = Json(Json::Object{
-																														{"Interaction", make_unique<Json>(interactionIndex)},
-																														{"Status", make_unique<Json>("Failed")}
-																													}).encode();
+																													// Fill response
+																													INTERACTION_FAILED_RESPONSE_TEMPLATE.fill(response, interactionIndex);
+																												}
+																												
+																												// Otherwise check if data isn't empty, it isn't already cached compressed, and decoding it, and compressing and caching it if compressing, directly into the buffer failed
+																												else if(!data.empty() && !(compress && cache->reference(buffer.get(), cacheKey)) && !decodeInteractionData(buffer.get(), data, compress, cache, cacheKey)) {
+																												
+																													// Check if data is invalid
+																													if(!Base64::isValid(data.data(), data.length())) {
+																													
+																														// Fill response
+																														INTERACTION_ERROR_RESPONSE_TEMPLATE.fill(response, interactionIndex, "Invalid data parameter");
+																													}
+																													
+																													// Otherwise
+																													else {
+																													
+																														// Reply with internal server error to request
+																														evhttp_send_reply(request, HTTP_INTERNAL, nullptr, nullptr);
+																														
+																														// Remove request's buffer callbacks
+																														bufferevent_setcb(requestsBuffer, nullptr, nullptr, nullptr, nullptr);
+																														
+																														// Fill response
+																														INTERACTION_FAILED_RESPONSE_TEMPLATE.fill(response, interactionIndex);
+																													}
 																												}
 																												
 																												// Otherwise
 																												else {
 																												
-																													// Check if creating request's buffer callbacks argument failed
-																													unique_ptr<tuple<evhttp_connection *, unordered_map<evhttp_connection *, Client> *, const Json::Number>> requestsBufferCallbacksArgument = make_unique<tuple<evhttp_connection *, unordered_map<evhttp_connection *, Client> *, const Json::Number>>(connection, clients, interactionIndex);
-																													if(!requestsBufferCallbacksArgument) {
+																													// Reserve memory for the decoded data in the buffer
+																													Memory::Reservation decodedDataReservation(Memory::Category::CODEC);
+																													decodedDataReservation.set(evbuffer_get_length(buffer.get()));
+																												
+																													// Check if data isn't empty and setting request's content type failed
+																													if(!data.empty() && evhttp_add_header(evhttp_request_get_output_headers(request), "Content-Type", type.c_str())) {
 																													
 																														// Reply with internal server error to request
 																														evhttp_send_reply(request, HTTP_INTERNAL, nullptr, nullptr);
@@ -2148,320 +3387,226 @@ int main(int argc, char *argv[]) {
 																														// Remove request's buffer callbacks
 																														bufferevent_setcb(requestsBuffer, nullptr, nullptr, nullptr, nullptr);
 																														
-																														// Set response
-																														response = Json(Json::Object{
-																															{"Interaction", make_unique<Json>(interactionIndex)},
-																															{"Status", make_unique<Json>("Failed")}
-																														}).encode();
+																														// Fill response
+																														INTERACTION_FAILED_RESPONSE_TEMPLATE.fill(response, interactionIndex);
 																													}
 																													
-																													// Otherwise
-																													else {
+																													// Otherwise check if compressing and setting request's content encoding or vary failed
+																													else if(compress && (evhttp_add_header(evhttp_request_get_output_headers(request), "Content-Encoding", "gzip") || evhttp_add_header(evhttp_request_get_output_headers(request), "Vary", "Accept-Encoding"))) {
 																													
-																														// Check if creating buffer failed
-																														unique_ptr<evbuffer, decltype(&evbuffer_free)> buffer(evbuffer_new(), evbuffer_free);
-																														if(!buffer) {
+																														// Reply with internal server error to request
+																														evhttp_send_reply(request, HTTP_INTERNAL, nullptr, nullptr);
 																														
-																															// Reply with internal server error to request
-																															evhttp_send_reply(request, HTTP_INTERNAL, nullptr, nullptr);
-																															
-																															// Remove request's buffer callbacks
-																															bufferevent_setcb(requestsBuffer, nullptr, nullptr, nullptr, nullptr);
-																															
-																															// Set response
-																															response = Json(Json::Object{
-																																{"Interaction", make_unique<Json>(interactionIndex)},
-																																{"Status", make_unique<Json>("Failed")}
-																															}).encode();
-																														}
+																														// Remove request's buffer callbacks
+																														bufferevent_setcb(requestsBuffer, nullptr, nullptr, nullptr, nullptr);
+																														
+																														// Fill response
+																														INTERACTION_FAILED_RESPONSE_TEMPLATE.fill(response, interactionIndex);
+																													}
+																													
+																													// Check if response wasn't set
+																													if(response.empty()) {
+																													
+																														// Set status to provided status otherwise ok if not provided
+																														const int status = (interactionMessage.status.state == Schema::State::VALID) ? interactionMessage.status.value : HTTP_OK;
 																														
-																														// Otherwise
-																														else {
+																														// Update HTTP bytes sent metric
+																														Metrics::httpBytesSent.increment(evbuffer_get_length(buffer.get()));
 																														
-																															// Initialize compress
-																															bool compress = false;
+																														// Mark interaction's trace encoded
+																														trace.mark(Trace::Stage::ENCODED);
+																														
+																														// Reply with status to request
+																														evhttp_send_reply(request, status, nullptr, buffer.get());
+																														
+																														// Mark interaction's trace replied
+																														trace.mark(Trace::Stage::REPLIED);
+																														
+																														// Update interaction latency metric
+																														Metrics::interactionLatency.recordDuration(trace.getDuration(Trace::Stage::RECEIVED, Trace::Stage::REPLIED));
+																														
+																														// Probe interaction replied
+																														PROBE(interaction_replied, clients->at(connection).getId(), static_cast<uint64_t>(interactionIndex), status, static_cast<int64_t>(chrono::duration_cast<chrono::nanoseconds>(trace.getDuration(Trace::Stage::RECEIVED, Trace::Stage::REPLIED)).count()));
+																														
+																														// Set request's buffer callbacks argument's trace
+																														get<3>(*requestsBufferCallbacksArgument) = trace;
+																														
+																														// Set request's buffer callbacks
+																														bufferevent_setcb(requestsBuffer, nullptr, ([](bufferevent *requestsBuffer, void *argument) {
+																														
+																															// Get request's buffer callbacks argument from argument
+																															unique_ptr<tuple<evhttp_connection *, unordered_map<evhttp_connection *, Client> *, const Json::Number, Trace>> requestsBufferCallbacksArgument(reinterpret_cast<tuple<evhttp_connection *, unordered_map<evhttp_connection *, Client> *, const Json::Number, Trace> *>(argument));
+																															
+																															// Get connection from request's buffer callbacks argument
+																															evhttp_connection *connection = get<0>(*requestsBufferCallbacksArgument);
 																															
-																															// Check if decoded data is large enough to compress
-																															if(decodedData.size() >= MINIMUM_COMPRESSION_LENGTH) {
+																															// Get clients from request's buffer callbacks argument
+																															unordered_map<evhttp_connection *, Client> *clients = get<1>(*requestsBufferCallbacksArgument);
+																															
+																															// Get interaction index from request's buffer callbacks argument
+																															const Json::Number interactionIndex = get<2>(*requestsBufferCallbacksArgument);
+																															
+																															// Get interaction's trace from request's buffer callbacks argument
+																															Trace &trace = get<3>(*requestsBufferCallbacksArgument);
+																															
+																															// Mark interaction's trace written
+																															trace.mark(Trace::Stage::WRITTEN);
+																															
+																															// Finish interaction's trace
+																															trace.finish(interactionIndex);
 																														
-																																// Check if request contains an accept encoding header
-																																const char *acceptEncoding = evhttp_find_header(evhttp_request_get_input_headers(request), "Accept-Encoding");
-																																if(acceptEncoding) {
-																																
-																																	// Get encodings
-																																	const string encodings = acceptEncoding;
-																																
-																																	// Go through all encodings
-																																	for(string::size_type startOfEncodings = 0, endOfEncodings = encodings.find(',', startOfEncodings);; startOfEncodings = endOfEncodings + sizeof(','), endOfEncodings = encodings.find(',', startOfEncodings)) {
-																																	
-																																		// Get encoding
-																																		const string encoding = Common::trim(encodings.substr(startOfEncodings, (endOfEncodings != string::npos) ? endOfEncodings - startOfEncodings : string::npos));
-																																		
-																																		// Check if encoding is gzip
-																																		if(encoding == "gzip") {
-																																		
-																																			// Set compress
-																																			compress = true;
-																																			
-																																			// Break
-																																			break;
-																																		}
-																																		
-																																		// Check if at the last encodings
-																																		if(endOfEncodings == string::npos) {
-																																		
-																																			// Break
-																																			break;
-																																		}
-																																	}
-																																}
-																															}
+																															// Remove request's buffer callbacks
+																															bufferevent_setcb(requestsBuffer, nullptr, nullptr, nullptr, nullptr);
 																															
-																															// Check if compressing
-																															if(compress) {
+																															// Check if connection still exists
+																															if(clients->count(connection)) {
 																															
-																																// Check if setting request's content encoding or vary failed
-																																if(evhttp_add_header(evhttp_request_get_output_headers(request), "Content-Encoding", "gzip") || evhttp_add_header(evhttp_request_get_output_headers(request), "Vary", "Accept-Encoding")) {
+																																// Check if getting connection's buffer failed
+																																bufferevent *connectionsBuffer = evhttp_connection_get_bufferevent(connection);
+																																if(!connectionsBuffer) {
 																																
-																																	// Reply with internal server error to request
-																																	evhttp_send_reply(request, HTTP_INTERNAL, nullptr, nullptr);
+																																	// Close connection
+																																	evhttp_connection_free(connection);
 																																	
-																																	// Remove request's buffer callbacks
-																																	bufferevent_setcb(requestsBuffer, nullptr, nullptr, nullptr, nullptr);
+																																	// Cancel all client's interactions
+																																	clients->at(connection).cancelAllInteractions();
 																																	
-																																	// Set response
-																																	response = Json(Json::Object{
-																																		{"Interaction", make_unique<Json>(interactionIndex)},
-																																		{"Status", make_unique<Json>("Failed")}
-																																	}).encode();
+																																	// Probe client disconnected
+																																	PROBE(client_disconnected, clients->at(connection).getId(), "buffer_unavailable");
+																																	
+																																	// Log client disconnected
+																																	Logger::log(Logger::Level::WARNING, "Client disconnected", clients->at(connection).getId(), "buffer_unavailable");
+																																	
+																																	// Remove connection from list of clients
+																																	clients->erase(connection);
 																																}
 																																
 																																// Otherwise
 																																else {
-																															
-																																	// Check if compressing decoded data failed
-																																	vector<uint8_t> compressedData;
-																																	if(!Common::gzip(compressedData, decodedData)) {
+																																
+																																	// Set response
+																																	const string response = INTERACTION_SUCCEEDED_RESPONSE_TEMPLATE.fill(interactionIndex);
+																																
+																																	// Get response message
+																																	const vector<uint8_t> responseMessage = createWebSocketResponse(response, WebSocket::Opcode::TEXT, clients->at(connection));
 																																	
-																																		// Remove request's content encoding and vary headers
-																																		evhttp_remove_header(evhttp_request_get_output_headers(request), "Content-Encoding");
-																																		evhttp_remove_header(evhttp_request_get_output_headers(request), "Vary");
+																																	// Check if sending response message to client failed
+																																	if(bufferevent_write(connectionsBuffer, responseMessage.data(), responseMessage.size())) {
 																																	
-																																		// Reply with internal server error to request
-																																		evhttp_send_reply(request, HTTP_INTERNAL, nullptr, nullptr);
+																																		// Check if getting connection's buffer input was successful
+																																		evbuffer *input = bufferevent_get_input(connectionsBuffer);
+																																		if(input) {
 																																		
-																																		// Remove request's buffer callbacks
-																																		bufferevent_setcb(requestsBuffer, nullptr, nullptr, nullptr, nullptr);
+																																			// Remove data from input
+																																			evbuffer_drain(input, evbuffer_get_length(input));
+																																		}
 																																		
-																																		// Set response
-																																		response = Json(Json::Object{
-																																			{"Interaction", make_unique<Json>(interactionIndex)},
-																																			{"Status", make_unique<Json>("Failed")}
-																																		}).encode();
-																																	}
-																																	
-																																	// Otherwise check if adding compressed data to buffer failed
-																																	else if(evbuffer_add(buffer.get(), compressedData.data(), compressedData.size())) {
-																																	
-																																		// Remove request's content encoding and vary headers
-																																		evhttp_remove_header(evhttp_request_get_output_headers(request), "Content-Encoding");
-																																		evhttp_remove_header(evhttp_request_get_output_headers(request), "Vary");
-																																	
-																																		// Reply with internal server error to request
-																																		evhttp_send_reply(request, HTTP_INTERNAL, nullptr, nullptr);
+																																		// Remove connection's buffer callbacks
+																																		bufferevent_setcb(connectionsBuffer, nullptr, nullptr, nullptr, nullptr);
+																																		
+																																		// Close connection
+																																		evhttp_connection_free(connection);
+																																		
+																																		// Cancel all client's interactions
+																																		clients->at(connection).cancelAllInteractions();
 																																		
-																																		// Remove request's buffer callbacks
-																																		bufferevent_setcb(requestsBuffer, nullptr, nullptr, nullptr, nullptr);
+																																		// Probe client disconnected
+																																		PROBE(client_disconnected, clients->at(connection).getId(), "write_failed");
 																																		
-																																		// Set response
-																																		response = Json(Json::Object{
-																																			{"Interaction", make_unique<Json>(interactionIndex)},
-																																			{"Status", make_unique<Json>("Failed")}
-																																		}).encode();
+																																		// Log client disconnected
+																																		Logger::log(Logger::Level::WARNING, "Client disconnected", clients->at(connection).getId(), "write_failed");
+																																		
+																																		// Remove connection from list of clients
+																																		clients->erase(connection);
 																																	}
 																																}
 																															}
 																															
-																															// Otherwise
-																															else {
-																													
-																																// Check if adding decoded data to buffer failed
-																																if(evbuffer_add(buffer.get(), decodedData.data(), decodedData.size())) {
-																																
-																																	// Reply with internal server error to request
-																																	evhttp_send_reply(request, HTTP_INTERNAL, nullptr, nullptr);
-																																	
-																																	// Remove request's buffer callbacks
-																																	bufferevent_setcb(requestsBuffer, nullptr, nullptr, nullptr, nullptr);
-																																	
-																																	// Set response
-																																	response = Json(Json::Object{
-																																		{"Interaction", make_unique<Json>(interactionIndex)},
-																																		{"Status", make_unique<Json>("Failed")}
-																																	}).encode();
-																																}
-																															}
+																														}), ([](bufferevent *requestsBuffer, short event, void *argument) {
+																														
+																															// Get request's buffer callbacks argument from argument
+																															unique_ptr<tuple<evhttp_connection *, unordered_map<evhttp_connection *, Client> *, const Json::Number, Trace>> requestsBufferCallbacksArgument(reinterpret_cast<tuple<evhttp_connection *, unordered_map<evhttp_connection *, Client> *, const Json::Number, Trace> *>(argument));
 																															
-																															// Check if response wasn't set
-																															if(response.empty()) {
+																															// Get connection from request's buffer callbacks argument
+																															evhttp_connection *connection = get<0>(*requestsBufferCallbacksArgument);
 																															
-																																// Set status to provided status otherwise ok if not provided
-																																const int status = (jsonMessage.getObjectValue().count("Status") && jsonMessage.getObjectValue().at("Status")->getType() == Json::Type::NUMBER && jsonMessage.getObjectValue().at("Status")->getNumberValue() >= 0 && jsonMessage.getObjectValue().at("Status")->getNumberValue() <= INT_MAX && modf(jsonMessage.getObjectValue().at("Status")->getNumberValue(), &integerComponent) == 0) ? jsonMessage.getObjectValue().at("Status")->getNumberValue() : HTTP_OK;
-																																
-																																// Reply with status to request
-																																evhttp_send_reply(request, status, nullptr, buffer.get());
-																																
-																																// Set request's buffer callbacks
-																																bufferevent_setcb(requestsBuffer, nullptr, ([](bufferevent *requestsBuffer, void *argument) {
+																															// Get clients from request's buffer callbacks argument
+																															unordered_map<evhttp_connection *, Client> *clients = get<1>(*requestsBufferCallbacksArgument);
+																															
+																															// Get interaction index from request's buffer callbacks argument
+																															const Json::Number interactionIndex = get<2>(*requestsBufferCallbacksArgument);
+																														
+																															// Remove request's buffer callbacks
+																															bufferevent_setcb(requestsBuffer, nullptr, nullptr, nullptr, nullptr);
+																															
+																															// Check if connection still exists
+																															if(clients->count(connection)) {
+																															
+																																// Check if getting connection's buffer failed
+																																bufferevent *connectionsBuffer = evhttp_connection_get_bufferevent(connection);
+																																if(!connectionsBuffer) {
 																																
-																																	// Get request's buffer callbacks argument from argument
-																																	unique_ptr<tuple<evhttp_connection *, unordered_map<evhttp_connection *, Client> *, const Json::Number>> requestsBufferCallbacksArgument(reinterpret_cast<tuple<evhttp_connection *, unordered_map<evhttp_connection *, Client> *, const Json::Number> *>(argument));
+																																	// Close connection
+																																	evhttp_connection_free(connection);
+																																	
+																																	// Cancel all client's interactions
+																																	clients->at(connection).cancelAllInteractions();
 																																	
-																																	// Get connection from request's buffer callbacks argument
-																																	evhttp_connection *connection = get<0>(*requestsBufferCallbacksArgument);
+																																	// Probe client disconnected
+																																	PROBE(client_disconnected, clients->at(connection).getId(), "buffer_unavailable");
 																																	
-																																	// Get clients from request's buffer callbacks argument
-																																	unordered_map<evhttp_connection *, Client> *clients = get<1>(*requestsBufferCallbacksArgument);
+																																	// Log client disconnected
+																																	Logger::log(Logger::Level::WARNING, "Client disconnected", clients->at(connection).getId(), "buffer_unavailable");
 																																	
-																																	// Get interaction index from request's buffer callbacks argument
-																																	const Json::Number interactionIndex = get<2>(*requestsBufferCallbacksArgument);
+																																	// Remove connection from list of clients
+																																	clients->erase(connection);
+																																}
+																																
+																																// Otherwise
+																																else {
+																																
+																																	// Set response
+																																	const string response = INTERACTION_FAILED_RESPONSE_TEMPLATE.fill(interactionIndex);
 																																
-																																	// Remove request's buffer callbacks
-																																	bufferevent_setcb(requestsBuffer, nullptr, nullptr, nullptr, nullptr);
+																																	// Get response message
+																																	const vector<uint8_t> responseMessage = createWebSocketResponse(response, WebSocket::Opcode::TEXT, clients->at(connection));
 																																	
-																																	// Check if connection still exists
-																																	if(clients->count(connection)) {
+																																	// Check if sending response message to client failed
+																																	if(bufferevent_write(connectionsBuffer, responseMessage.data(), responseMessage.size())) {
 																																	
-																																		// Check if getting connection's buffer failed
-																																		bufferevent *connectionsBuffer = evhttp_connection_get_bufferevent(connection);
-																																		if(!connectionsBuffer) {
+																																		// Check if getting connection's buffer input was successful
+																																		evbuffer *input = bufferevent_get_input(connectionsBuffer);
+																																		if(input) {
 																																		
-																																			// Close connection
-																																			evhttp_connection_free(connection);
-																																			
-																																			// Cancel all client's interactions
-																																			clients->at(connection).cancelAllInteractions();
-																																			
-																																			// Remove connection from list of clients
-																																			clients->erase(connection);
+																																			// Remove data from input
+																																			evbuffer_drain(input, evbuffer_get_length(input));
 																																		}
 																																		
-																																		// Otherwise
-																																		else {
+																																		// Remove connection's buffer callbacks
+																																		bufferevent_setcb(connectionsBuffer, nullptr, nullptr, nullptr, nullptr);
 																																		
-																																			// Set response
-																																			const string response = Json(Json::Object{
-																																				{"Interaction", make_unique<Json>(interactionIndex)},
-																																				{"Status", make_unique<Json>("Succeeded")}
-																																			}).encode();
+																																		// Close connection
+																																		evhttp_connection_free(connection);
 																																		
-																																			// Get response message
-																																			const vector<uint8_t> responseMessage = createWebSocketResponse(response, WebSocketOpcode::TEXT, clients->at(connection).getSupportsCompression());
-																																			
-																																			// Check if sending response message to client failed
-																																			if(bufferevent_write(connectionsBuffer, responseMessage.data(), responseMessage.size())) {
-																																			
-																																				// Check if getting connection's buffer input was successful
-																																				evbuffer *input = bufferevent_get_input(connectionsBuffer);
-																																				if(input) {
-																																				
-																																					// Remove data from input
-																																					evbuffer_drain(input, evbuffer_get_length(input));
-																																				}
-																																				
-																																				// Remove connection's buffer callbacks
-																																				bufferevent_setcb(connectionsBuffer, nullptr, nullptr, nullptr, nullptr);
-																																				
-																																				// Close connection
-																																				evhttp_connection_free(connection);
-																																				
-																																				// Cancel all client's interactions
-																																				clients->at(connection).cancelAllInteractions();
-																																				
-																																				// Remove connection from list of clients
-																																				clients->erase(connection);
-																																			}
-																																		}
-																																	}
-																																	
-																																}), ([](bufferevent *requestsBuffer, short event, void *argument) {
-																																
-																																	// Get request's buffer callbacks argument from argument
-																																	unique_ptr<tuple<evhttp_connection *, unordered_map<evhttp_connection *, Client> *, const Json::Number>> requestsBufferCallbacksArgument(reinterpret_cast<tuple<evhttp_connection *, unordered_map<evhttp_connection *, Client> *, const Json::Number> *>(argument));
-																																	
-																																	// Get connection from request's buffer callbacks argument
-																																	evhttp_connection *connection = get<0>(*requestsBufferCallbacksArgument);
-																																	
-																																	// Get clients from request's buffer callbacks argument
-																																	unordered_map<evhttp_connection *, Client> *clients = get<1>(*requestsBufferCallbacksArgument);
-																																	
-																																	// Get interaction index from request's buffer callbacks argument
-																																	const Json::Number interactionIndex = get<2>(*requestsBufferCallbacksArgument);
-																																
-																																	// Remove request's buffer callbacks
-																																	bufferevent_setcb(requestsBuffer, nullptr, nullptr, nullptr, nullptr);
-																																	
-																																	// Check if connection still exists
-																																	if(clients->count(connection)) {
-																																	
-																																		// Check if getting connection's buffer failed
-																																		bufferevent *connectionsBuffer = evhttp_connection_get_bufferevent(connection);
-																																		if(!connectionsBuffer) {
-																																		
-																																			// Close connection
-																																			evhttp_connection_free(connection);
-																																			
-																																			// Cancel all client's interactions
-																																			clients->at(connection).cancelAllInteractions();
-																																			
-																																			// Remove connection from list of clients
-																																			clients->erase(connection);
-																																		}
+																																		// Cancel all client's interactions
+																																		clients->at(connection).cancelAllInteractions();
 																																		
-																																		// Otherwise
-																																		else {
+																																		// Probe client disconnected
+																																		PROBE(client_disconnected, clients->at(connection).getId(), "write_failed");
 																																		
-																																			// Set response
-																																			const string response = Json(Json::Object{
-																																				{"Interaction", make_unique<Json>(interactionIndex)},
-																																				{"Status", make_unique<Json>("Failed")}
-																																			}).encode();
+																																		// Log client disconnected
+																																		Logger::log(Logger::Level::WARNING, "Client disconnected", clients->at(connection).getId(), "write_failed");
 																																		
-																																			// Get response message
-																																			const vector<uint8_t> responseMessage = createWebSocketResponse(response, WebSocketOpcode::TEXT, clients->at(connection).getSupportsCompression());
-																																			
-																																			// Check if sending response message to client failed
-																																			if(bufferevent_write(connectionsBuffer, responseMessage.data(), responseMessage.size())) {
-																																			
-																																				// Check if getting connection's buffer input was successful
-																																				evbuffer *input = bufferevent_get_input(connectionsBuffer);
-																																				if(input) {
-																																				
-																																					// Remove data from input
-																																					evbuffer_drain(input, evbuffer_get_length(input));
-																																				}
-																																				
-																																				// Remove connection's buffer callbacks
-																																				bufferevent_setcb(connectionsBuffer, nullptr, nullptr, nullptr, nullptr);
-																																				
-																																				// Close connection
-																																				evhttp_connection_free(connection);
-																																				
-																																				// Cancel all client's interactions
-																																				clients->at(connection).cancelAllInteractions();
-																																				
-																																				// Remove connection from list of clients
-																																				clients->erase(connection);
-																																			}
-																																		}
+																																		// Remove connection from list of clients
+																																		clients->erase(connection);
 																																	}
-																																	
-																																}), requestsBufferCallbacksArgument.get());
-																																
-																																// Release request's callback argument
-																																requestsBufferCallbacksArgument.release();
+																																}
 																															}
-																														}
+																															
+																														}), requestsBufferCallbacksArgument.get());
+																														
+																														// Release request's callback argument
+																														requestsBufferCallbacksArgument.release();
 																													}
 																												}
 																											}
@@ -2470,52 +3615,40 @@ int main(int argc, char *argv[]) {
 																										// Otherwise
 																										else {
 																										
-																											// Set response
-																											response = Json(Json::Object{
-																												{"Interaction", make_unique<Json>(interactionIndex)},
-																												{"Error", make_unique<Json>((jsonMessage.getObjectValue().count("Data") && jsonMessage.getObjectValue().at("Data")->getType() != Json::Type::STRING) ? "Invalid data parameter" : "Missing data parameter")}
-																											}).encode();
+																											// Fill response
+																											INTERACTION_ERROR_RESPONSE_TEMPLATE.fill(response, interactionIndex, (interactionMessage.data.state == Schema::State::INVALID) ? "Invalid data parameter" : "Missing data parameter");
 																										}
 																									}
 																									
 																									// Otherwise
 																									else {
 																									
-																										// Set response
-																										response = Json(Json::Object{
-																											{"Interaction", make_unique<Json>(interactionIndex)},
-																											{"Error", make_unique<Json>("Interaction doesn't exist or it was already processed")}
-																										}).encode();
+																										// Fill response
+																										INTERACTION_ERROR_RESPONSE_TEMPLATE.fill(response, interactionIndex, "Interaction doesn't exist or it was already processed");
 																									}
 																								}
 																								
 																								// Otherwise
 																								else {
 																								
-																									// Set response
-																									response = Json(Json::Object{
-																										{"Error", make_unique<Json>("Invalid interaction parameter")}
-																									}).encode();
+																									// Fill response
+																									ERROR_RESPONSE_TEMPLATE.fill(response, "Invalid interaction parameter");
 																								}
 																							}
 																							
 																							// Otherwise
 																							else {
 																							
-																								// Set response
-																								response = Json(Json::Object{
-																									{"Error", make_unique<Json>("Unknown message type")}
-																								}).encode();
+																								// Fill response
+																								ERROR_RESPONSE_TEMPLATE.fill(response, "Unknown message type");
 																							}
 																						}
 																						
 																						// Otherwise
 																						else {
 																						
-																							// Set response
-																							response = Json(Json::Object{
-																								{"Error", make_unique<Json>("Message is not JSON")}
-																							}).encode();
+																							// Fill response
+																							ERROR_RESPONSE_TEMPLATE.fill(response, "Message is not JSON");
 																						}
 																						
 																						// Check if response exists
@@ -2526,7 +3659,7 @@ int main(int argc, char *argv[]) {
 																							try {
 																						
 																								// Get response message
-																								responseMessage = createWebSocketResponse(response, WebSocketOpcode::TEXT, clients->at(connection).getSupportsCompression());
+																								responseMessage = createWebSocketResponse(response, WebSocket::Opcode::TEXT, clients->at(connection));
 																							}
 																							
 																							// Catch errors
@@ -2544,6 +3677,12 @@ int main(int argc, char *argv[]) {
 																								// Cancel all client's interactions
 																								clients->at(connection).cancelAllInteractions();
 																								
+																								// Probe client disconnected
+																								PROBE(client_disconnected, clients->at(connection).getId(), "response_failed");
+																								
+																								// Log client disconnected
+																								Logger::log(Logger::Level::WARNING, "Client disconnected", clients->at(connection).getId(), "response_failed");
+																								
 																								// Remove connection from list of clients
 																								clients->erase(connection);
 																								
@@ -2566,6 +3705,12 @@ int main(int argc, char *argv[]) {
 																								// Cancel all client's interactions
 																								clients->at(connection).cancelAllInteractions();
 																								
+																								// Probe client disconnected
+																								PROBE(client_disconnected, clients->at(connection).getId(), "write_failed");
+																								
+																								// Log client disconnected
+																								Logger::log(Logger::Level::WARNING, "Client disconnected", clients->at(connection).getId(), "write_failed");
+																								
 																								// Remove connection from list of clients
 																								clients->erase(connection);
 																								
@@ -2579,11 +3724,11 @@ int main(int argc, char *argv[]) {
 																					break;
 																				
 																				// Ping
-																				case WebSocketOpcode::PING:
+																				case WebSocket::Opcode::PING:
 																				
 																					{
 																						// Get pong message
-																						const vector<uint8_t> pongMessage = createWebSocketResponse(*message, WebSocketOpcode::PONG, clients->at(connection).getSupportsCompression());
+																						const vector<uint8_t> pongMessage = createWebSocketResponse(*message, WebSocket::Opcode::PONG, clients->at(connection));
 																						
 																						// Check if sending pong message to client failed
 																						if(bufferevent_write(connectionsBuffer, pongMessage.data(), pongMessage.size())) {
@@ -2600,6 +3745,12 @@ int main(int argc, char *argv[]) {
 																							// Cancel all client's interactions
 																							clients->at(connection).cancelAllInteractions();
 																							
+																							// Probe client disconnected
+																							PROBE(client_disconnected, clients->at(connection).getId(), "write_failed");
+																							
+																							// Log client disconnected
+																							Logger::log(Logger::Level::WARNING, "Client disconnected", clients->at(connection).getId(), "write_failed");
+																							
 																							// Remove connection from list of clients
 																							clients->erase(connection);
 																							
@@ -2611,8 +3762,51 @@ int main(int argc, char *argv[]) {
 																					// Break
 																					break;
 																				
-																				// Pong or default
-																				case WebSocketOpcode::PONG:
+																				// Pong
+																				case WebSocket::Opcode::PONG:
+																				
+																					// Probe pong received
+																					PROBE(pong_received, clients->at(connection).getId(), message->size());
+																					
+																					// Check if message is a ping's send time
+																					if(Common::isNumeric(*message)) {
+																					
+																						// Initialize error occurred
+																						bool errorOccurred = false;
+																						
+																						// Try
+																						unsigned long long sendTimeMicroseconds;
+																						try {
+																						
+																							// Get ping's send time from message
+																							sendTimeMicroseconds = stoull(*message);
+																						}
+																						
+																						// Catch errors
+																						catch(...) {
+																						
+																							// Set error occurred
+																							errorOccurred = true;
+																						}
+																						
+																						// Check if an error didn't occur
+																						if(!errorOccurred) {
+																						
+																							// Check if ping's send time isn't in the future
+																							const chrono::microseconds sendTime(sendTimeMicroseconds);
+																							const chrono::microseconds currentTime = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now().time_since_epoch());
+																							if(sendTime <= currentTime) {
+																							
+																								// Update ping round trip time metric
+																								Metrics::pingRoundTripTime.recordDuration(currentTime - sendTime);
+																							}
+																						}
+																					}
+																					
+																					// Break
+																					break;
+																				
+																				// Default
 																				default:
 																				
 																					// Break
@@ -2624,6 +3818,9 @@ int main(int argc, char *argv[]) {
 																			
 																			// Clear message compressed
 																			*messageCompressed = false;
+																			
+																			// Reset client's message validator
+																			clients->at(connection).getMessageValidator().reset();
 																		}
 																	}
 																	
@@ -2664,10 +3861,28 @@ int main(int argc, char *argv[]) {
 											}
 										}
 									
-									}), nullptr, ([](bufferevent *connectionsBuffer, short event, void *argument) {
+									}), ([](bufferevent *connectionsBuffer, void *argument) {
+									
+										// Get connection's buffer callbacks argument from argument
+										const tuple<evhttp_connection *, string *, const string *, unordered_map<evhttp_connection *, Client> *, unordered_map<string, unordered_set<string>> *, bool *, Cache *> *connectionsBufferCallbacksArgument = reinterpret_cast<const tuple<evhttp_connection *, string *, const string *, unordered_map<evhttp_connection *, Client> *, unordered_map<string, unordered_set<string>> *, bool *, Cache *> *>(argument);
+										
+										// Get connection from connection's buffer callbacks argument
+										evhttp_connection *connection = get<0>(*connectionsBufferCallbacksArgument);
+										
+										// Get clients from connection's buffer callbacks argument
+										unordered_map<evhttp_connection *, Client> *clients = get<3>(*connectionsBufferCallbacksArgument);
+										
+										// Check if connection still exists
+										if(clients->count(connection)) {
+										
+											// Mark client's interactions flushed since the connection's output was written to the socket
+											clients->at(connection).markInteractionsFlushed();
+										}
+									
+									}), ([](bufferevent *connectionsBuffer, short event, void *argument) {
 									
 										// Get connection's buffer callbacks argument from argument
-										unique_ptr<tuple<evhttp_connection *, string *, const string *, unordered_map<evhttp_connection *, Client> *, unordered_map<string, unordered_set<string>> *, bool *>> connectionsBufferCallbacksArgument(reinterpret_cast<tuple<evhttp_connection *, string *, const string *, unordered_map<evhttp_connection *, Client> *, unordered_map<string, unordered_set<string>> *, bool *> *>(argument));
+										unique_ptr<tuple<evhttp_connection *, string *, const string *, unordered_map<evhttp_connection *, Client> *, unordered_map<string, unordered_set<string>> *, bool *, Cache *>> connectionsBufferCallbacksArgument(reinterpret_cast<tuple<evhttp_connection *, string *, const string *, unordered_map<evhttp_connection *, Client> *, unordered_map<string, unordered_set<string>> *, bool *, Cache *> *>(argument));
 										
 										// Get connection from connection's buffer callbacks argument
 										evhttp_connection *connection = get<0>(*connectionsBufferCallbacksArgument);
@@ -2701,6 +3916,12 @@ int main(int argc, char *argv[]) {
 											// Cancel all client's interactions
 											clients->at(connection).cancelAllInteractions();
 											
+											// Probe client disconnected
+											PROBE(client_disconnected, clients->at(connection).getId(), "connection_closed");
+											
+											// Log client disconnected
+											Logger::log(Logger::Level::DEBUG, "Client disconnected", clients->at(connection).getId(), "connection_closed");
+											
 											// Remove connection from list of clients
 											clients->erase(connection);
 										}
@@ -2732,6 +3953,144 @@ int main(int argc, char *argv[]) {
 		
 	}), &httpServerRequestCallbackArgument);
 	
+	// Check if creating metrics server failed
+	unique_ptr<evhttp, decltype(&evhttp_free)> metricsServer(evhttp_new(eventBase.get()), evhttp_free);
+	if(!metricsServer) {
+	
+		// Log message
+		Logger::log(Logger::Level::FAILURE, "Creating metrics server failed");
+	
+		// Return failure
+		return EXIT_FAILURE;
+	}
+	
+	// Set metrics server's maximum header size
+	evhttp_set_max_headers_size(metricsServer.get(), MAXIMUM_HEADERS_SIZE);
+	
+	// Set metrics server's maximum body size
+	evhttp_set_max_body_size(metricsServer.get(), 0);
+	
+	// Set metrics server to only allow GET requests
+	evhttp_set_allowed_methods(metricsServer.get(), EVHTTP_REQ_GET);
+	
+	// Set metrics server metrics request callback
+	evhttp_set_cb(metricsServer.get(), "/metrics", ([](evhttp_request *request, void *argument) {
+	
+		// Get HTTP server request callback argument from argument
+		const tuple<const string *, unordered_map<evhttp_connection *, Client> *, unordered_map<string, unordered_set<string>> *, const size_t *, Cache *> *httpServerRequestCallbackArgument = reinterpret_cast<const tuple<const string *, unordered_map<evhttp_connection *, Client> *, unordered_map<string, unordered_set<string>> *, const size_t *, Cache *> *>(argument);
+		
+		// Get clients from HTTP server request callback argument
+		const unordered_map<evhttp_connection *, Client> *clients = get<1>(*httpServerRequestCallbackArgument);
+		
+		// Get URLs from HTTP server request callback argument
+		const unordered_map<string, unordered_set<string>> *urls = get<2>(*httpServerRequestCallbackArgument);
+		
+		// Get cache from HTTP server request callback argument
+		const Cache *cache = get<4>(*httpServerRequestCallbackArgument);
+		
+		// Check if setting request's cache control header failed
+		if(evhttp_add_header(evhttp_request_get_output_headers(request), "Cache-Control", "no-store, no-transform")) {
+		
+			// Reply with internal server error to request
+			evhttp_send_reply(request, HTTP_INTERNAL, nullptr, nullptr);
+		}
+		
+		// Otherwise
+		else {
+		
+			// Set connected clients and sessions metrics
+			Metrics::connectedClients.set(clients->size());
+			Metrics::sessions.set(urls->size());
+			
+			// Go through all sessions
+			size_t numberOfUrls = 0;
+			for(unordered_map<string, unordered_set<string>>::const_iterator i = urls->cbegin(); i != urls->cend(); ++i) {
+			
+				// Add session's number of URLs to the number of URLs
+				numberOfUrls += i->second.size();
+			}
+			
+			// Set URLs metric
+			Metrics::urls.set(numberOfUrls);
+			
+			// Go through all clients
+			size_t numberOfInteractions = 0;
+			size_t largestConnectionMemory = 0;
+			uint64_t compressionSavedBytes = 0;
+			uint64_t largestConnectionCompressionSavedBytes = 0;
+			for(unordered_map<evhttp_connection *, Client>::const_iterator i = clients->cbegin(); i != clients->cend(); ++i) {
+			
+				// Add client's number of interactions to the number of interactions
+				numberOfInteractions += i->second.getNumberOfInteractions();
+				
+				// Update largest connection memory with the client's memory
+				largestConnectionMemory = max(largestConnectionMemory, i->second.getMemoryAccount().getTotal());
+				
+				// Check if client supports compression
+				const WebSocket::CompressionPolicy *compressionPolicy = i->second.getCompressionPolicy();
+				if(compressionPolicy) {
+				
+					// Add client's compression saved bytes to the compression saved bytes and update largest connection compression saved bytes with them
+					const uint64_t savedBytes = compressionPolicy->getUncompressedBytes() - compressionPolicy->getCompressedBytes();
+					compressionSavedBytes += savedBytes;
+					largestConnectionCompressionSavedBytes = max(largestConnectionCompressionSavedBytes, savedBytes);
+				}
+			}
+			
+			// Set in-flight interactions metric
+			Metrics::inFlightInteractions.set(numberOfInteractions);
+			
+			// Set memory metrics
+			Memory::updateMetrics();
+			Metrics::memoryLargestConnection.set(largestConnectionMemory);
+			
+			// Set compression saved bytes metrics
+			Metrics::compressionConnectedSavedBytes.set(compressionSavedBytes);
+			Metrics::compressionLargestConnectionSavedBytes.set(largestConnectionCompressionSavedBytes);
+			
+			// Set cache metrics
+			Metrics::cacheHits.set(cache->getHits());
+			Metrics::cacheMisses.set(cache->getMisses());
+			Metrics::cacheSize.set(cache->getSize());
+			Metrics::cacheMaximumSize.set(cache->getMaximumSize());
+			
+			// Check if creating buffer failed
+			unique_ptr<evbuffer, decltype(&evbuffer_free)> buffer(evbuffer_new(), evbuffer_free);
+			if(!buffer) {
+			
+				// Reply with internal server error to request
+				evhttp_send_reply(request, HTTP_INTERNAL, nullptr, nullptr);
+			}
+			
+			// Otherwise check if setting request's content type failed
+			else if(evhttp_add_header(evhttp_request_get_output_headers(request), "Content-Type", "text/plain; version=0.0.4; charset=utf-8")) {
+			
+				// Reply with internal server error to request
+				evhttp_send_reply(request, HTTP_INTERNAL, nullptr, nullptr);
+			}
+			
+			// Otherwise
+			else {
+			
+				// Check if appending metrics to the buffer failed
+				const string metrics = Metrics::encode();
+				if(evbuffer_add(buffer.get(), metrics.data(), metrics.size())) {
+				
+					// Reply with internal server error to request
+					evhttp_send_reply(request, HTTP_INTERNAL, nullptr, nullptr);
+				}
+				
+				// Otherwise
+				else {
+				
+					// Reply with ok to request
+					evhttp_send_reply(request, HTTP_OK, nullptr, buffer.get());
+				}
+			}
+		}
+		
+	}), &httpServerRequestCallbackArgument);
+	
 	// Set HTTP server request callback
 	evhttp_set_gencb(httpServer.get(), ([](evhttp_request *request, void *argument) {
 	
@@ -2780,8 +4139,8 @@ int main(int argc, char *argv[]) {
 	unique_ptr<evhttp, decltype(&evhttp_free)> torServer(evhttp_new(eventBase.get()), evhttp_free);
 	if(!torServer) {
 	
-		// Display message
-		cout << "Creating Tor server failed" << endl;
+		// Log message
+		Logger::log(Logger::Level::FAILURE, "Creating Tor server failed");
 	
 		// Return failure
 		return EXIT_FAILURE;
@@ -2814,6 +4173,20 @@ int main(int argc, char *argv[]) {
 		// Get URLs from Tor server request callback argument
 		const unordered_map<string, unordered_set<string>> *urls = get<2>(*torServerRequestCallbackArgument);
 		
+		// Start request's trace
+		Trace trace;
+		
+		// Start callback's monitor with the request's body's length as its payload size
+		Monitor monitor(Monitor::Callback::TOR_SERVER_REQUEST);
+		monitor.setPayloadSize(evbuffer_get_length(evhttp_request_get_input_buffer(request)));
+		
+		// Check if recording and request is a POST request
+		if(Recorder::isRecording() && evhttp_request_get_command(request) == EVHTTP_REQ_POST) {
+		
+			// Record request
+			Recorder::recordPostRequest(evhttp_request_get_uri(request), evhttp_find_header(evhttp_request_get_input_headers(request), "Content-Type"), evhttp_find_header(evhttp_request_get_input_headers(request), "Accept-Encoding"), evhttp_request_get_input_buffer(request));
+		}
+		
 		// Check if setting request's cache control header or CORS header failed
 		if(evhttp_add_header(evhttp_request_get_output_headers(request), "Cache-Control", "no-store, no-transform") || evhttp_add_header(evhttp_request_get_output_headers(request), "Access-Control-Allow-Origin", "*")) {
 		
@@ -2846,9 +4219,25 @@ int main(int argc, char *argv[]) {
 			}
 		}
 		
+		// Otherwise check if memory would be over budget with the request's body
+		else if(Memory::isOverBudget(evbuffer_get_length(evhttp_request_get_input_buffer(request)))) {
+		
+			// Update memory budget rejections metric
+			Metrics::memoryBudgetRejections.increment();
+			
+			// Log rejection
+			Logger::log(Logger::Level::WARNING, "Rejected POST request since memory is over budget", Logger::NO_CONNECTION, to_string(Memory::getTotal()));
+		
+			// Reply with service unavailable error to request
+			evhttp_send_reply(request, HTTP_SERVUNAVAIL, nullptr, nullptr);
+		}
+		
 		// Otherwise
 		else {
 		
+			// Profile the dispatch's allocations
+			PROFILE_ALLOCATIONS(POST_DISPATCH);
+		
 			// Check if parsing request's URI failed
 			unique_ptr<evhttp_uri, decltype(&evhttp_uri_free)> uri(evhttp_uri_parse(evhttp_request_get_uri(request)), evhttp_uri_free);
 			if(!uri) {
@@ -2875,7 +4264,7 @@ int main(int argc, char *argv[]) {
 				else {
 				
 					// Set URL
-					const string url = "http://" + *onionServiceAddress + ".onion" + Common::toLowerCase(path.substr(0, urlDelimiter));
+					const string url = "http://" + *onionServiceAddress + Common::toLowerCase(path.substr(0, urlDelimiter));
 					
 					// Set API
 					const string api = path.substr(urlDelimiter);
@@ -2940,6 +4329,12 @@ int main(int argc, char *argv[]) {
 							// Cancel all client's interactions
 							clients->at(connection).cancelAllInteractions();
 							
+							// Probe client disconnected
+							PROBE(client_disconnected, clients->at(connection).getId(), "buffer_unavailable");
+							
+							// Log client disconnected
+							Logger::log(Logger::Level::WARNING, "Client disconnected", clients->at(connection).getId(), "buffer_unavailable");
+							
 							// Remove connection from list of clients
 							clients->erase(connection);
 						}
@@ -2982,6 +4377,9 @@ int main(int argc, char *argv[]) {
 							// Initialize data
 							string data;
 							
+							// Initialize request body's memory reservation
+							Memory::Reservation requestBodyReservation(Memory::Category::REQUEST_BODIES);
+							
 							// Check if getting request's input was succesful
 							evbuffer *input = evhttp_request_get_input_buffer(request);
 							if(input) {
@@ -2989,8 +4387,12 @@ int main(int argc, char *argv[]) {
 								// Get input's length
 								const size_t length = evbuffer_get_length(input);
 								
+								// Update HTTP bytes received metric
+								Metrics::httpBytesReceived.increment(length);
+								
 								// Check if getting data from input failed
 								vector<uint8_t> buffer(length);
+								requestBodyReservation.set(length);
 								if(evbuffer_copyout(input, buffer.data(), length) == -1) {
 								
 									// Remove data from input
@@ -3017,7 +4419,14 @@ int main(int argc, char *argv[]) {
 								try {
 								
 									// Set data to buffer
+									const chrono::steady_clock::time_point encodeStartTime = chrono::steady_clock::now();
 									data = Json::base64Encode(buffer);
+									
+									// Update base64 encode duration metric
+									Metrics::base64EncodeDuration.recordDuration(chrono::steady_clock::now() - encodeStartTime);
+									
+									// Reserve memory for the buffer and its encoded data
+									requestBodyReservation.set(length + data.capacity());
 								}
 								
 								// Catch errors
@@ -3032,20 +4441,14 @@ int main(int argc, char *argv[]) {
 							}
 						
 							// Set response
-							const string response = Json(Json::Object{
-								{"Interaction", make_unique<Json>(interactionIndex)},
-								{"URL", make_unique<Json>(url)},
-								{"API", make_unique<Json>(api)},
-								{"Type", make_unique<Json>(contentType)},
-								{"Data", make_unique<Json>(data)}
-							}).encode();
+							const string response = INTERACTION_REQUEST_TEMPLATE.fill(interactionIndex, url, api, contentType, data);
 							
 							// Try
 							vector<uint8_t> responseMessage;
 							try {
 						
 								// Get response message
-								responseMessage = createWebSocketResponse(response, WebSocketOpcode::TEXT, clients->at(connection).getSupportsCompression());
+								responseMessage = createWebSocketResponse(response, WebSocket::Opcode::TEXT, clients->at(connection));
 							}
 							
 							// Catch errors
@@ -3058,6 +4461,10 @@ int main(int argc, char *argv[]) {
 								return;
 							}
 							
+							// Reserve memory for the response message
+							Memory::Reservation responseMessageReservation(Memory::Category::CODEC);
+							responseMessageReservation.set(responseMessage.capacity());
+							
 							// Check if sending response message to client failed
 							if(bufferevent_write(connectionsBuffer, responseMessage.data(), responseMessage.size())) {
 							
@@ -3081,6 +4488,12 @@ int main(int argc, char *argv[]) {
 								// Cancel all client's interactions
 								clients->at(connection).cancelAllInteractions();
 								
+								// Probe client disconnected
+								PROBE(client_disconnected, clients->at(connection).getId(), "write_failed");
+								
+								// Log client disconnected
+								Logger::log(Logger::Level::WARNING, "Client disconnected", clients->at(connection).getId(), "write_failed");
+								
 								// Remove connection from list of clients
 								clients->erase(connection);
 							}
@@ -3088,20 +4501,23 @@ int main(int argc, char *argv[]) {
 							// Otherwise
 							else {
 							
+								// Mark request's trace queued
+								trace.mark(Trace::Stage::QUEUED);
+							
+								// Probe interaction dispatched
+								PROBE(interaction_dispatched, clients->at(connection).getId(), static_cast<uint64_t>(interactionIndex), url.c_str(), data.length());
+								
 								// Check if adding interaction to client failed
-								if(!clients->at(connection).addInteraction(interactionIndex, request)) {
+								if(!clients->at(connection).addInteraction(interactionIndex, request, trace)) {
 								
 									// Reply with internal server error to request
 									evhttp_send_reply(request, HTTP_INTERNAL, nullptr, nullptr);
 									
 									// Set response
-									const string response = Json(Json::Object{
-										{"Interaction", make_unique<Json>(interactionIndex)},
-										{"Status", make_unique<Json>("Failed")}
-									}).encode();
+									const string response = INTERACTION_FAILED_RESPONSE_TEMPLATE.fill(interactionIndex);
 								
 									// Get response message
-									const vector<uint8_t> responseMessage = createWebSocketResponse(response, WebSocketOpcode::TEXT, clients->at(connection).getSupportsCompression());
+									const vector<uint8_t> responseMessage = createWebSocketResponse(response, WebSocket::Opcode::TEXT, clients->at(connection));
 									
 									// Check if sending response message to client failed
 									if(bufferevent_write(connectionsBuffer, responseMessage.data(), responseMessage.size())) {
@@ -3123,6 +4539,12 @@ int main(int argc, char *argv[]) {
 										// Cancel all client's interactions
 										clients->at(connection).cancelAllInteractions();
 										
+										// Probe client disconnected
+										PROBE(client_disconnected, clients->at(connection).getId(), "write_failed");
+										
+										// Log client disconnected
+										Logger::log(Logger::Level::WARNING, "Client disconnected", clients->at(connection).getId(), "write_failed");
+										
 										// Remove connection from list of clients
 										clients->erase(connection);
 									}
@@ -3142,13 +4564,10 @@ int main(int argc, char *argv[]) {
 										clients->at(connection).removeInteraction(interactionIndex);
 										
 										// Set response
-										const string response = Json(Json::Object{
-											{"Interaction", make_unique<Json>(interactionIndex)},
-											{"Status", make_unique<Json>("Failed")}
-										}).encode();
+										const string response = INTERACTION_FAILED_RESPONSE_TEMPLATE.fill(interactionIndex);
 									
 										// Get response message
-										const vector<uint8_t> responseMessage = createWebSocketResponse(response, WebSocketOpcode::TEXT, clients->at(connection).getSupportsCompression());
+										const vector<uint8_t> responseMessage = createWebSocketResponse(response, WebSocket::Opcode::TEXT, clients->at(connection));
 										
 										// Check if sending response message to client failed
 										if(bufferevent_write(connectionsBuffer, responseMessage.data(), responseMessage.size())) {
@@ -3170,6 +4589,12 @@ int main(int argc, char *argv[]) {
 											// Cancel all client's interactions
 											clients->at(connection).cancelAllInteractions();
 											
+											// Probe client disconnected
+											PROBE(client_disconnected, clients->at(connection).getId(), "write_failed");
+											
+											// Log client disconnected
+											Logger::log(Logger::Level::WARNING, "Client disconnected", clients->at(connection).getId(), "write_failed");
+											
 											// Remove connection from list of clients
 											clients->erase(connection);
 										}
@@ -3218,6 +4643,12 @@ int main(int argc, char *argv[]) {
 														// Cancel all client's interactions
 														clients->at(connection).cancelAllInteractions();
 														
+														// Probe client disconnected
+														PROBE(client_disconnected, clients->at(connection).getId(), "buffer_unavailable");
+														
+														// Log client disconnected
+														Logger::log(Logger::Level::WARNING, "Client disconnected", clients->at(connection).getId(), "buffer_unavailable");
+														
 														// Remove connection from list of clients
 														clients->erase(connection);
 													}
@@ -3226,13 +4657,10 @@ int main(int argc, char *argv[]) {
 													else {
 													
 														// Set response
-														const string response = Json(Json::Object{
-															{"Interaction", make_unique<Json>(interactionIndex)},
-															{"Status", make_unique<Json>("Failed")}
-														}).encode();
+														const string response = INTERACTION_FAILED_RESPONSE_TEMPLATE.fill(interactionIndex);
 													
 														// Get response message
-														const vector<uint8_t> responseMessage = createWebSocketResponse(response, WebSocketOpcode::TEXT, clients->at(connection).getSupportsCompression());
+														const vector<uint8_t> responseMessage = createWebSocketResponse(response, WebSocket::Opcode::TEXT, clients->at(connection));
 														
 														// Check if sending response message to client failed
 														if(bufferevent_write(connectionsBuffer, responseMessage.data(), responseMessage.size())) {
@@ -3254,6 +4682,12 @@ int main(int argc, char *argv[]) {
 															// Cancel all client's interactions
 															clients->at(connection).cancelAllInteractions();
 															
+															// Probe client disconnected
+															PROBE(client_disconnected, clients->at(connection).getId(), "write_failed");
+															
+															// Log client disconnected
+															Logger::log(Logger::Level::WARNING, "Client disconnected", clients->at(connection).getId(), "write_failed");
+															
 															// Remove connection from list of clients
 															clients->erase(connection);
 														}
@@ -3276,13 +4710,10 @@ int main(int argc, char *argv[]) {
 											clients->at(connection).removeInteraction(interactionIndex);
 											
 											// Set response
-											const string response = Json(Json::Object{
-												{"Interaction", make_unique<Json>(interactionIndex)},
-												{"Status", make_unique<Json>("Failed")}
-											}).encode();
+											const string response = INTERACTION_FAILED_RESPONSE_TEMPLATE.fill(interactionIndex);
 										
 											// Get response message
-											const vector<uint8_t> responseMessage = createWebSocketResponse(response, WebSocketOpcode::TEXT, clients->at(connection).getSupportsCompression());
+											const vector<uint8_t> responseMessage = createWebSocketResponse(response, WebSocket::Opcode::TEXT, clients->at(connection));
 											
 											// Check if sending response message to client failed
 											if(bufferevent_write(connectionsBuffer, responseMessage.data(), responseMessage.size())) {
@@ -3304,6 +4735,12 @@ int main(int argc, char *argv[]) {
 												// Cancel all client's interactions
 												clients->at(connection).cancelAllInteractions();
 												
+												// Probe client disconnected
+												PROBE(client_disconnected, clients->at(connection).getId(), "write_failed");
+												
+												// Log client disconnected
+												Logger::log(Logger::Level::WARNING, "Client disconnected", clients->at(connection).getId(), "write_failed");
+												
 												// Remove connection from list of clients
 												clients->erase(connection);
 											}
@@ -3326,34 +4763,197 @@ int main(int argc, char *argv[]) {
 	
 	}), &torServerRequestCallbackArgument);
 	
-	// Check if creating Tor configuration failed
-	shared_ptr<tor_main_configuration_t> torConfiguration(tor_main_configuration_new(), tor_main_configuration_free);
-	if(!torConfiguration) {
+	// Initialize interrupt signal event
+	unique_ptr<event, decltype(&event_free)> interruptSignalEvent(nullptr, event_free);
 	
-		// Display message
-		cout << "Creating Tor configuration failed" << endl;
+	// Initialize terminate signal event
+	unique_ptr<event, decltype(&event_free)> terminateSignalEvent(nullptr, event_free);
+	
+	// Check if not using Tor or using mock Tor
+	if(noTor || mockTor) {
+	
+		// Check if creating interrupt signal event failed
+		interruptSignalEvent.reset(evsignal_new(eventBase.get(), SIGINT, ([](evutil_socket_t signal, short events, void *argument) {
+		
+			// Break out of event dispatch loop
+			event_base_loopbreak(reinterpret_cast<event_base *>(argument));
+			
+		}), eventBase.get()));
+		if(!interruptSignalEvent) {
+		
+			// Log message
+			Logger::log(Logger::Level::FAILURE, "Creating interrupt signal event failed");
+		
+			// Return failure
+			return EXIT_FAILURE;
+		}
+		
+		// Check if creating terminate signal event failed
+		terminateSignalEvent.reset(evsignal_new(eventBase.get(), SIGTERM, ([](evutil_socket_t signal, short events, void *argument) {
+		
+			// Break out of event dispatch loop
+			event_base_loopbreak(reinterpret_cast<event_base *>(argument));
+			
+		}), eventBase.get()));
+		if(!terminateSignalEvent) {
+		
+			// Log message
+			Logger::log(Logger::Level::FAILURE, "Creating terminate signal event failed");
+		
+			// Return failure
+			return EXIT_FAILURE;
+		}
+		
+		// Check if adding interrupt signal event or terminate signal event failed
+		if(evsignal_add(interruptSignalEvent.get(), nullptr) || evsignal_add(terminateSignalEvent.get(), nullptr)) {
+		
+			// Log message
+			Logger::log(Logger::Level::FAILURE, "Adding signal events failed");
+		
+			// Return failure
+			return EXIT_FAILURE;
+		}
+		
+		// Check if not Windows
+		#ifndef _WIN32
+		
+			// Check if allowing interrupt and terminate signals failed since Tor isn't handling them
+			sigset_t signalMask;
+			if(sigemptyset(&signalMask) || sigaddset(&signalMask, SIGINT) || sigaddset(&signalMask, SIGTERM) || pthread_sigmask(SIG_UNBLOCK, &signalMask, nullptr)) {
+			
+				// Log message
+				Logger::log(Logger::Level::FAILURE, "Allowing signals failed");
+			
+				// Return failure
+				return EXIT_FAILURE;
+			}
+			
+			// Check if ignoring broken pipe signals failed since Tor isn't ignoring them
+			if(signal(SIGPIPE, SIG_IGN) == SIG_ERR) {
+			
+				// Log message
+				Logger::log(Logger::Level::FAILURE, "Ignoring broken pipe signals failed");
+			
+				// Return failure
+				return EXIT_FAILURE;
+			}
+		#endif
+	}
+	
+	// Check if binding metrics server to the metrics address and metrics port failed
+	if(evhttp_bind_socket(metricsServer.get(), metricsAddress.c_str(), metricsPort)) {
+	
+		// Log message
+		Logger::log(Logger::Level::FAILURE, "Binding metrics server to " + metricsAddress + ':' + to_string(metricsPort) + " failed");
 	
 		// Return failure
 		return EXIT_FAILURE;
 	}
 	
-	// Check if getting Tor control socket failed
-	tor_control_socket_t torControlSocket = tor_main_configuration_setup_control_socket(torConfiguration.get());
-	if(torControlSocket == INVALID_TOR_CONTROL_SOCKET) {
+	// Log message
+	Logger::log(Logger::Level::INFO, "Serving metrics at http://" + metricsAddress + ':' + to_string(metricsPort) + "/metrics");
 	
-		// Display message
-		cout << "Getting Tor control socket failed" << endl;
+	// Check if not using Tor
+	if(noTor) {
+	
+		// Check if binding Tor server to direct address and direct port failed
+		if(evhttp_bind_socket(torServer.get(), directAddress.c_str(), directPort)) {
+		
+			// Log message
+			Logger::log(Logger::Level::FAILURE, "Binding Tor server to " + directAddress + ':' + to_string(directPort) + " failed");
+		
+			// Return failure
+			return EXIT_FAILURE;
+		}
+		
+		// Check if direct hostname isn't provided
+		if(directHostname.empty()) {
+		
+			// Check if direct address is an IPv6 address
+			char temp[sizeof(in6_addr)];
+			if(inet_pton(AF_INET6, directAddress.c_str(), temp) == 1) {
+			
+				// Set direct hostname to the direct address
+				directHostname = '[' + Common::toLowerCase(directAddress) + ']';
+			}
+			
+			// Otherwise
+			else {
+			
+				// Set direct hostname to the direct address
+				directHostname = Common::toLowerCase(directAddress);
+			}
+			
+			// Check if direct port doesn't match the default server port
+			if(directPort != HTTP_PORT) {
+			
+				// Append direct port to the direct hostname
+				directHostname += ':' + to_string(directPort);
+			}
+		}
+		
+		// Set Onion Service address to the direct hostname
+		onionServiceAddress = directHostname;
+		
+		// Check if starting server at the listen address and listen port failed
+		if(!startServer(httpServer.get(), listenAddress, listenPort, usingTlsServer)) {
+		
+			// Return failure
+			return EXIT_FAILURE;
+		}
+		
+		// Log message
+		Logger::log(Logger::Level::INFO, "Serving interactions at http://" + onionServiceAddress);
+		
+		// Check if running event dispatch loop failed
+		if(event_base_dispatch(eventBase.get()) == -1) {
+		
+			// Log message
+			Logger::log(Logger::Level::FAILURE, "Running event dispatch loop failed");
+		
+			// Return failure
+			return EXIT_FAILURE;
+		}
+		
+		// Return success
+		return EXIT_SUCCESS;
+	}
+	
+	// Try
+	unique_ptr<Controller> controller;
+	try {
+	
+		// Check if using mock Tor
+		if(mockTor) {
+		
+			// Create mock controller with the mock Tor settings
+			controller = make_unique<MockController>(mockTorSettings);
+		}
+		
+		// Otherwise
+		else {
+		
+			// Create embedded Tor controller
+			controller = make_unique<EmbeddedTorController>();
+		}
+	}
+	
+	// Catch errors
+	catch(const runtime_error &error) {
+	
+		// Log message
+		Logger::log(Logger::Level::FAILURE, error.what());
 	
 		// Return failure
 		return EXIT_FAILURE;
 	}
 	
 	// Check if creating Tor connection from Tor control socket failed
-	unique_ptr<bufferevent, decltype(&bufferevent_free)> torConnection(bufferevent_socket_new(eventBase.get(), torControlSocket, BEV_OPT_DEFER_CALLBACKS | BEV_OPT_THREADSAFE), bufferevent_free);
+	unique_ptr<bufferevent, decltype(&bufferevent_free)> torConnection(bufferevent_socket_new(eventBase.get(), controller->getControlSocket(), BEV_OPT_DEFER_CALLBACKS | BEV_OPT_THREADSAFE), bufferevent_free);
 	if(!torConnection) {
 	
-		// Display message
-		cout << "Creating Tor connection from Tor control socket failed" << endl;
+		// Log message
+		Logger::log(Logger::Level::FAILURE, "Creating Tor connection from Tor control socket failed");
 	
 		// Return failure
 		return EXIT_FAILURE;
@@ -3368,6 +4968,9 @@ int main(int argc, char *argv[]) {
 	// Set Tor connection callbacks
 	bufferevent_setcb(torConnection.get(), ([](bufferevent *torConnection, void *argument) {
 	
+		// Start callback's monitor
+		Monitor monitor(Monitor::Callback::TOR_CONTROL);
+		
 		// Get Tor connection callbacks argument from argument
 		tuple<const string *, const uint16_t *, const bool *, evhttp *, string *, evhttp *, bool *> *torConnectionCallbacksArgument = reinterpret_cast<tuple<const string *, const uint16_t *, const bool *, evhttp *, string *, evhttp *, bool *> *>(argument);
 		
@@ -3396,8 +4999,8 @@ int main(int argc, char *argv[]) {
 		evbuffer *input = bufferevent_get_input(torConnection);
 		if(!input) {
 		
-			// Display message
-			cout << "Getting input from the Tor connection failed" << endl;
+			// Log message
+			Logger::log(Logger::Level::FAILURE, "Getting input from the Tor connection failed");
 			
 			// Remove Tor connection callbacks
 			bufferevent_setcb(torConnection, nullptr, nullptr, nullptr, nullptr);
@@ -3409,62 +5012,57 @@ int main(int argc, char *argv[]) {
 		// Otherwise
 		else {
 		
-			// Get input's length
-			const size_t length = evbuffer_get_length(input);
-			
-			// Check if getting data from input failed
-			uint8_t data[length];
-			if(evbuffer_copyout(input, data, length) == -1) {
+			// Set callback's monitor's payload size to the input's length
+			monitor.setPayloadSize(evbuffer_get_length(input));
+		
+			// Go through all lines in the input
+			size_t length;
+			for(unique_ptr<char, decltype(&free)> line(evbuffer_readln(input, &length, EVBUFFER_EOL_CRLF), free); line; line.reset(evbuffer_readln(input, &length, EVBUFFER_EOL_CRLF))) {
 			
-				// Display message
-				cout << "Getting data from input failed" << endl;
+				// Check if Onion Service address is already known
+				if(!onionServiceAddress->empty()) {
 				
-				// Remove data from input
-				evbuffer_drain(input, length);
+					// Continue
+					continue;
+				}
 				
-				// Remove Tor connection callbacks
-				bufferevent_setcb(torConnection, nullptr, nullptr, nullptr, nullptr);
-			
-				// Exit failure
-				quick_exit(EXIT_FAILURE);
-			}
-			
-			// Otherwise check if removing data from input failed
-			else if(evbuffer_drain(input, length)) {
-			
-				// Display message
-				cout << "Removing data from input failed" << endl;
+				// Check if line is an error reply
+				if(length > TOR_REPLY_CODE_LENGTH && (line.get()[0] == TOR_TEMPORARY_ERROR_REPLY_CODE || line.get()[0] == TOR_PERMANENT_ERROR_REPLY_CODE)) {
 				
-				// Remove Tor connection callbacks
-				bufferevent_setcb(torConnection, nullptr, nullptr, nullptr, nullptr);
-			
-				// Exit failure
-				quick_exit(EXIT_FAILURE);
-			}
-			
-			// Otherwise
-			else {
-			
-				// Check if Tor isn't connected
-				if(!*torConnected) {
+					// Probe Tor state changed
+					PROBE(tor_state_changed, "failed");
 					
-					// Check if Tor is connected
-					const char connectedMessage[] = "250-status/circuit-established=1";
+					// Log message
+					Logger::log(Logger::Level::FAILURE, *torConnected ? "Getting Onion Service information failed" : "Connecting to the Tor network failed", Logger::NO_CONNECTION, line.get());
 					
-					if(length >= sizeof(connectedMessage) - sizeof('\0') && !memcmp(data, connectedMessage, sizeof(connectedMessage) - sizeof('\0'))) {
+					// Remove Tor connection callbacks
+					bufferevent_setcb(torConnection, nullptr, nullptr, nullptr, nullptr);
+					
+					// Exit failure
+					quick_exit(EXIT_FAILURE);
+				}
+				
+				// Otherwise check if Tor isn't connected
+				else if(!*torConnected) {
+				
+					// Check if Tor is connected
+					if(!strcmp(line.get(), "250-status/circuit-established=1")) {
 					
 						// Set Tor connected
 						*torConnected = true;
 						
-						// Display message
-						cout << "Connected to the Tor network" << endl;
+						// Probe Tor state changed
+						PROBE(tor_state_changed, "connected");
+						
+						// Log message
+						Logger::log(Logger::Level::INFO, "Connected to the Tor network");
 						
 						// Check if binding Tor server to random port failed
 						evhttp_bound_socket *torServerSocket = evhttp_bind_socket_with_handle(torServer, "localhost", 0);
 						if(!torServerSocket) {
 						
-							// Display message
-							cout << "Binding Tor server to random port failed" << endl;
+							// Log message
+							Logger::log(Logger::Level::FAILURE, "Binding Tor server to random port failed");
 							
 							// Remove Tor connection callbacks
 							bufferevent_setcb(torConnection, nullptr, nullptr, nullptr, nullptr);
@@ -3481,8 +5079,8 @@ int main(int argc, char *argv[]) {
 							socklen_t length = sizeof(socketDetails);
 							if(getsockname(evhttp_bound_socket_get_fd(torServerSocket), reinterpret_cast<sockaddr *>(&socketDetails), &length)) {
 							
-								// Display message
-								cout << "Getting Tor server socket details failed" << endl;
+								// Log message
+								Logger::log(Logger::Level::FAILURE, "Getting Tor server socket details failed");
 								
 								// Remove Tor connection callbacks
 								bufferevent_setcb(torConnection, nullptr, nullptr, nullptr, nullptr);
@@ -3500,8 +5098,8 @@ int main(int argc, char *argv[]) {
 								// Check if creating Onion Service with the Tor connection failed
 								if(bufferevent_write(torConnection, createOnionServiceCommand.c_str(), createOnionServiceCommand.length())) {
 								
-									// Display message
-									cout << "Creating Onion Service with the Tor connection failed" << endl;
+									// Log message
+									Logger::log(Logger::Level::FAILURE, "Creating Onion Service with the Tor connection failed");
 									
 									// Remove Tor connection callbacks
 									bufferevent_setcb(torConnection, nullptr, nullptr, nullptr, nullptr);
@@ -3513,15 +5111,15 @@ int main(int argc, char *argv[]) {
 						}
 					}
 					
-					// Otherwise
-					else {
+					// Otherwise check if line is the end of a reply
+					else if(length > TOR_REPLY_CODE_LENGTH && line.get()[TOR_REPLY_CODE_LENGTH] == ' ') {
 					
 						// Check if creating timer event failed
 						unique_ptr<event> timerEvent = make_unique<event>();
 						if(!timerEvent) {
 						
-							// Display message
-							cout << "Creating timer event failed" << endl;
+							// Log message
+							Logger::log(Logger::Level::FAILURE, "Creating timer event failed");
 							
 							// Remove Tor connection callbacks
 							bufferevent_setcb(torConnection, nullptr, nullptr, nullptr, nullptr);
@@ -3537,8 +5135,8 @@ int main(int argc, char *argv[]) {
 							unique_ptr<tuple<bufferevent *, event *>> timerCallbackArgument = make_unique<tuple<bufferevent *, event *>>(torConnection, timerEvent.get());
 							if(!timerCallbackArgument) {
 							
-								// Display message
-								cout << "Creating timer callback argument failed" << endl;
+								// Log message
+								Logger::log(Logger::Level::FAILURE, "Creating timer callback argument failed");
 								
 								// Remove Tor connection callbacks
 								bufferevent_setcb(torConnection, nullptr, nullptr, nullptr, nullptr);
@@ -3565,8 +5163,8 @@ int main(int argc, char *argv[]) {
 									// Check if getting status from the Tor connection failed
 									if(bufferevent_write(torConnection, "getinfo status/circuit-established\n", sizeof("getinfo status/circuit-established\n") - sizeof('\0'))) {
 									
-										// Display message
-										cout << "Getting status from the Tor connection failed" << endl;
+										// Log message
+										Logger::log(Logger::Level::FAILURE, "Getting status from the Tor connection failed");
 									
 										// Remove Tor connection callbacks
 										bufferevent_setcb(torConnection, nullptr, nullptr, nullptr, nullptr);
@@ -3577,8 +5175,8 @@ int main(int argc, char *argv[]) {
 								
 								}), timerCallbackArgument.get())) {
 								
-									// Display message
-									cout << "Setting timer callback failed" << endl;
+									// Log message
+									Logger::log(Logger::Level::FAILURE, "Setting timer callback failed");
 									
 									// Remove Tor connection callbacks
 									bufferevent_setcb(torConnection, nullptr, nullptr, nullptr, nullptr);
@@ -3600,8 +5198,8 @@ int main(int argc, char *argv[]) {
 									// Check if adding timer event to the dispatched events failed
 									if(evtimer_add(timerEvent.get(), &timer)) {
 									
-										// Display message
-										cout << "Adding timer event to the dispatched events failed" << endl;
+										// Log message
+										Logger::log(Logger::Level::FAILURE, "Adding timer event to the dispatched events failed");
 										
 										// Remove Tor connection callbacks
 										bufferevent_setcb(torConnection, nullptr, nullptr, nullptr, nullptr);
@@ -3630,16 +5228,27 @@ int main(int argc, char *argv[]) {
 				
 					// Check if got Onion Service information
 					const char onionServiceInformationMessage[] = "250-ServiceID=";
+					if(length >= sizeof(onionServiceInformationMessage) - sizeof('\0') && !memcmp(line.get(), onionServiceInformationMessage, sizeof(onionServiceInformationMessage) - sizeof('\0'))) {
 					
-					if(length >= sizeof(onionServiceInformationMessage) - sizeof('\0') && !memcmp(data, onionServiceInformationMessage, sizeof(onionServiceInformationMessage) - sizeof('\0'))) {
-					
-						// Check if getting Onion Service address delimiter failed
-						const uint8_t *addressDelimiter = reinterpret_cast<uint8_t *>(memchr(&data[sizeof(onionServiceInformationMessage) - sizeof('\0')], '\r', length - (sizeof(onionServiceInformationMessage) - sizeof('\0'))));
-						if(!addressDelimiter) {
+						// Get Onion Service address
+						const string address(&line.get()[sizeof(onionServiceInformationMessage) - sizeof('\0')], length - (sizeof(onionServiceInformationMessage) - sizeof('\0')));
+						
+						// Check if Onion Service address is invalid
+						if(address.empty()) {
 						
-							// Display message
-							cout << "Getting Onion Service address delimiter failed" << endl;
+							// Log message
+							Logger::log(Logger::Level::FAILURE, "Onion Service address is invalid");
 							
+							// Remove Tor connection callbacks
+							bufferevent_setcb(torConnection, nullptr, nullptr, nullptr, nullptr);
+							
+							// Exit failure
+							quick_exit(EXIT_FAILURE);
+						}
+						
+						// Otherwise check if starting server at the listen address and listen port failed
+						else if(!startServer(httpServer, *listenAddress, *listenPort, *usingTlsServer)) {
+						
 							// Remove Tor connection callbacks
 							bufferevent_setcb(torConnection, nullptr, nullptr, nullptr, nullptr);
 						
@@ -3650,78 +5259,13 @@ int main(int argc, char *argv[]) {
 						// Otherwise
 						else {
 						
-							// Get Onion Service address
-							string address(reinterpret_cast<char *>(&data[sizeof(onionServiceInformationMessage) - sizeof('\0')]), addressDelimiter - &data[sizeof(onionServiceInformationMessage) - sizeof('\0')]);
-							
-							// Check if Onion Service address is invalid
-							if(address.empty()) {
-							
-								// Display message
-								cout << "Onion Service address is invalid" << endl;
-								
-								// Remove Tor connection callbacks
-								bufferevent_setcb(torConnection, nullptr, nullptr, nullptr, nullptr);
-							
-								// Exit failure
-								quick_exit(EXIT_FAILURE);
-							}
+							// Probe Tor state changed
+							PROBE(tor_state_changed, "onion_service_created");
 							
-							// Otherwise
-							else {
-											
-								// Check if binding server to listen address and listen port failed
-								if(evhttp_bind_socket(httpServer, listenAddress->c_str(), *listenPort)) {
-								
-									// Display message
-									cout << "Binding server to " << *listenAddress << ':' << to_string(*listenPort) << " failed" << endl;
-									
-									// Remove Tor connection callbacks
-									bufferevent_setcb(torConnection, nullptr, nullptr, nullptr, nullptr);
-								
-									// Exit failure
-									quick_exit(EXIT_FAILURE);
-								}
-								
-								// Otherwise
-								else {
-								
-									// Set Onion Service address to address
-									*onionServiceAddress = address;
-									
-									// Set display port to if the listen port doesn't match the default server port
-									const bool displayPort = (!*usingTlsServer && *listenPort != HTTP_PORT) || (*usingTlsServer && *listenPort != HTTPS_PORT);
-									
-									// Check if listen address is an IPv6 address
-									char temp[sizeof(in6_addr)];
-									if(inet_pton(AF_INET6, listenAddress->c_str(), temp) == 1) {
-									
-										// Display message
-										cout << "Listening at " << (*usingTlsServer ? "https" : "http") << "://[" << *listenAddress << ']' << (displayPort ? ':' + to_string(*listenPort) : "") << endl;
-									}
-									
-									// Otherwise
-									else {
-									
-										// Display message
-										cout << "Listening at " << (*usingTlsServer ? "https" : "http") << "://" << *listenAddress << (displayPort ? ':' + to_string(*listenPort) : "") << endl;
-									}
-								}
-							}
+							// Set Onion Service address to address
+							*onionServiceAddress = address + ".onion";
 						}
 					}
-					
-					// Otherwise
-					else {
-					
-						// Display message
-						cout << "Getting Onion Service information failed" << endl;
-						
-						// Remove Tor connection callbacks
-						bufferevent_setcb(torConnection, nullptr, nullptr, nullptr, nullptr);
-					
-						// Exit failure
-						quick_exit(EXIT_FAILURE);
-					}
 				}
 			}
 		}
@@ -3731,21 +5275,24 @@ int main(int argc, char *argv[]) {
 	// Check if enabling reading with the Tor buffer failed
 	if(bufferevent_enable(torConnection.get(), EV_READ)) {
 	
-		// Display message
-		cout << "Enabling reading with the Tor buffer failed" << endl;
+		// Log message
+		Logger::log(Logger::Level::FAILURE, "Enabling reading with the Tor buffer failed");
 	
 		// Return failure
 		return EXIT_FAILURE;
 	}
 	
-	// Display message
-	cout << "Connecting to the Tor network" << endl;
+	// Log message
+	Logger::log(Logger::Level::INFO, "Connecting to the Tor network");
+	
+	// Probe Tor state changed
+	PROBE(tor_state_changed, "authenticating");
 	
 	// Check if sending authentication message to Tor connection failed
 	if(bufferevent_write(torConnection.get(), "authenticate \"\"\n", sizeof("authenticate \"\"\n") - sizeof('\0'))) {
 	
-		// Display message
-		cout << "sending authentication message to Tor connection failed" << endl;
+		// Log message
+		Logger::log(Logger::Level::FAILURE, "sending authentication message to Tor connection failed");
 	
 		// Return failure
 		return EXIT_FAILURE;
@@ -3817,11 +5364,11 @@ int main(int argc, char *argv[]) {
 		nullptr
 	};
 	
-	// Check if configuring Tor configuration with the Tor arguments failed
-	if(tor_main_configuration_set_command_line(torConfiguration.get(), sizeof(torArguments) / sizeof(torArguments[0]) - 1, const_cast<char **>(torArguments))) {
+	// Check if configuring controller with the Tor arguments failed
+	if(!controller->configure(sizeof(torArguments) / sizeof(torArguments[0]) - 1, const_cast<char **>(torArguments))) {
 	
-		// Display message
-		cout << "Configuring Tor configuration with the Tor arguments failed" << endl;
+		// Log message
+		Logger::log(Logger::Level::FAILURE, "Configuring controller with the Tor arguments failed");
 		
 		// Remove temporary directory
 		filesystem::remove_all(temporaryDirectory);
@@ -3834,16 +5381,16 @@ int main(int argc, char *argv[]) {
 	atomic_bool threadError(false);
 	
 	// Create Tor thread
-	thread torThread(([&eventBase, &torConfiguration, &temporaryDirectory, &threadError]() {
+	thread torThread(([&eventBase, &controller, &temporaryDirectory, &threadError]() {
 	
 		// Check if Windows
 		#ifdef _WIN32
 		
-			// Check if running Tor failed
-			if(tor_run_main(torConfiguration.get()) != EXIT_SUCCESS) {
+			// Check if running controller failed
+			if(!controller->run()) {
 			
-				// Display message
-				cout << "Running Tor failed" << endl;
+				// Log message
+				Logger::log(Logger::Level::FAILURE, "Running Tor failed");
 			
 				// Set thread error
 				threadError.store(true);
@@ -3856,11 +5403,11 @@ int main(int argc, char *argv[]) {
 			sigset_t signalMask;
 			if(!sigemptyset(&signalMask) && !pthread_sigmask(SIG_SETMASK, &signalMask, nullptr)) {
 				
-				// Check if running Tor failed
-				if(tor_run_main(torConfiguration.get()) != EXIT_SUCCESS) {
+				// Check if running controller failed
+				if(!controller->run()) {
 				
-					// Display message
-					cout << "Running Tor failed" << endl;
+					// Log message
+					Logger::log(Logger::Level::FAILURE, "Running Tor failed");
 					
 					// Set thread error
 					threadError.store(true);
@@ -3870,8 +5417,8 @@ int main(int argc, char *argv[]) {
 			// Otherwise
 			else {
 			
-				// Display message
-				cout << "Allowing all signals failed" << endl;
+				// Log message
+				Logger::log(Logger::Level::FAILURE, "Allowing all signals failed");
 			
 				// Set thread error
 				threadError.store(true);
@@ -3881,8 +5428,8 @@ int main(int argc, char *argv[]) {
 		// Check if breaking out of event dispatch loop failed
 		if(event_base_loopbreak(eventBase.get())) {
 		
-			// Display message
-			cout << "Breaking out of event dispatch loop failed" << endl;
+			// Log message
+			Logger::log(Logger::Level::FAILURE, "Breaking out of event dispatch loop failed");
 			
 			// Remove temporary directory
 			filesystem::remove_all(temporaryDirectory);
@@ -3895,8 +5442,8 @@ int main(int argc, char *argv[]) {
 	// Check if running event dispatch loop failed
 	if(event_base_dispatch(eventBase.get()) == -1) {
 	
-		// Display message
-		cout << "Running event dispatch loop failed" << endl;
+		// Log message
+		Logger::log(Logger::Level::FAILURE, "Running event dispatch loop failed");
 		
 		// Remove temporary directory
 		filesystem::remove_all(temporaryDirectory);
@@ -3911,6 +5458,9 @@ int main(int argc, char *argv[]) {
 		// Initialize error occurred
 		bool errorOccurred = false;
 	
+		// Stop controller
+		controller->stop();
+		
 		// Check if Tor thread is joinable
 		if(torThread.joinable()) {
 		
@@ -3924,8 +5474,8 @@ int main(int argc, char *argv[]) {
 			// Catch errors
 			catch(...) {
 			
-				// Display message
-				cout << "Joining Tor thread failed" << endl;
+				// Log message
+				Logger::log(Logger::Level::FAILURE, "Joining Tor thread failed");
 			
 				// Set error occurred
 				errorOccurred = true;
@@ -3980,109 +5530,30 @@ void displayOptionsHelp() {
 	cout << "\t-p, --port\t\tSets port to listen on (default: " << DEFAULT_LISTEN_PORT << ')' << endl;
 	cout << "\t-c, --cert\t\tSets the TLS certificate file" << endl;
 	cout << "\t-k, --key\t\tSets the TLS private key file" << endl;
+	cout << "\t-t, --compression-threshold\tSets the minimum WebSocket message size to compress (default: " << MINIMUM_COMPRESSION_LENGTH << ')' << endl;
+	cout << "\t-s, --cache-size\tSets the compressed response cache size in megabytes (default: " << DEFAULT_CACHE_SIZE / Common::KILOBYTE_IN_A_MEGABYTE / Common::BYTES_IN_A_KILOBYTE << ')' << endl;
+	cout << "\t-r, --trace-file\tSets the file to append sampled interaction traces to" << endl;
+	cout << "\t-R, --trace-sample-interval\tSets how many interactions there are per traced interaction (default: " << DEFAULT_TRACE_SAMPLE_INTERVAL << ')' << endl;
+	cout << "\t-f, --record-file\tSets the file to record POST requests and WebSocket messages to for replaying" << endl;
+	cout << "\t-n, --no-tor\t\tServes interactions directly instead of through an Onion Service" << endl;
+	cout << "\t-A, --direct-address\tSets address to serve interactions on when not using Tor (default: " << DEFAULT_LISTEN_ADDRESS << ')' << endl;
+	cout << "\t-P, --direct-port\tSets port to serve interactions on when not using Tor (default: " << DEFAULT_DIRECT_PORT << ')' << endl;
+	cout << "\t-H, --direct-hostname\tSets hostname used in URLs when not using Tor (default: direct address and port)" << endl;
+	cout << "\t-M, --metrics-address\tSets address to serve metrics on (default: " << DEFAULT_LISTEN_ADDRESS << ')' << endl;
+	cout << "\t-O, --metrics-port\tSets port to serve metrics on (default: " << DEFAULT_METRICS_PORT << ')' << endl;
+	cout << "\t-m, --mock-tor[=settings]\tUses a scripted stand-in for Tor's control port with optional delay, polls, split, fail, and id settings (example: --mock-tor=delay=50,polls=3,split=5)" << endl;
+	cout << "\t-W, --slow-callback-threshold\tSets the milliseconds a callback or event loop lag must take to be logged as slow (default: " << DEFAULT_SLOW_CALLBACK_THRESHOLD_MILLISECONDS << ')' << endl;
+	cout << "\t-B, --memory-budget\tSets the megabytes of accounted memory over which new POST requests and WebSocket upgrades are rejected, or 0 for unlimited (default: 0)" << endl;
+	cout << "\t-l, --log-level\t\tSets the minimum level of messages to log as debug, info, warning, or error (default: info)" << endl;
+	cout << "\t-L, --log-format\tSets the format of logged messages as text or json (default: text)" << endl;
 	cout << "\t-h, --help\t\tDisplays help information" << endl;
 }
 
 // Create WebSocket response
-const vector<uint8_t> createWebSocketResponse(const string &message, WebSocketOpcode opcode, bool supportsCompression) {
+const vector<uint8_t> createWebSocketResponse(const string &message, WebSocket::Opcode opcode, Client &client) {
 
-	// Initialize response
-	vector<uint8_t> response;
-	
-	// Initialize compressed message
-	vector<uint8_t> compressedMessage(message.begin(), message.end());
-	
-	// Initialize compress
-	bool compress = false;
-	
-	// Check if supports compression and message is large enough to compress
-	if(supportsCompression && message.size() >= MINIMUM_COMPRESSION_LENGTH) {
-	
-		// Check if opcode is text
-		if(opcode == WebSocketOpcode::TEXT) {
-		
-			// Check if deflating the message failed
-			compressedMessage.clear();
-			if(!Common::deflate(compressedMessage, vector<uint8_t>(message.begin(), message.end()))) {
-				
-				// Throw exception
-				throw runtime_error("Deflating the message failed");
-			}
-			
-			// Append BFINAL flag to compressed message
-			compressedMessage.push_back(Common::DEFLATE_BFINAL_FLAG);
-			
-			// Set compress
-			compress = true;
-		}
-	}
-	
-	// Go through all WebSocket response frames
-	for(string::size_type i = 0;;) {
-	
-		// Get if response is final frame
-		const bool isFinalFrame = compressedMessage.size() - i <= INT64_MAX;
-		
-		// Get frame length
-		const string::size_type frameLength = isFinalFrame ? compressedMessage.size() - i : INT64_MAX;
-		
-		// Append opcode, is final frame, and is compressed to the response
-		response.push_back(static_cast<uint8_t>(opcode) | (isFinalFrame ? WEBSOCKET_FINAL_FRAME_BYTE_MASK : 0) | ((opcode == WebSocketOpcode::TEXT && compress) ? WEBSOCKET_COMPRESSED_EXTENSION_BYTE_MASK : 0));
-		
-		// Check if frame's length requires sixty-three to express
-		if(frameLength > UINT16_MAX) {
-		
-			// Append length to the response
-			response.push_back(WEBSOCKET_SIXTY_THREE_BITS_LENGTH);
-			
-			// Go through all length bytes
-			for(size_t j = 0; j < sizeof(uint64_t); ++j) {
-			
-				// Append length byte to the response
-				response.push_back(frameLength >> (Common::BITS_IN_A_BYTE * (sizeof(uint64_t) - sizeof(uint8_t) - j)));
-			}
-		}
-		
-		// Otherwise check if frame's length requires sixteen bits to express
-		else if(frameLength >= WEBSOCKET_SIXTEEN_BITS_LENGTH) {
-		
-			// Append length to the response
-			response.push_back(WEBSOCKET_SIXTEEN_BITS_LENGTH);
-			
-			// Go through all length bytes
-			for(size_t j = 0; j < sizeof(uint16_t); ++j) {
-			
-				// Append length byte to the response
-				response.push_back(frameLength >> (Common::BITS_IN_A_BYTE * (sizeof(uint16_t) - sizeof(uint8_t) - j)));
-			}
-		}
-		
-		// Otherwise
-		else {
-		
-			// Append length to the response
-			response.push_back(frameLength);
-		}
-		
-		// Append message to the response
-		response.insert(response.end(), compressedMessage.begin() + i, compressedMessage.begin() + i + frameLength);
-		
-		// Check if is final frame
-		if(isFinalFrame) {
-		
-			// Break
-			break;
-		}
-		
-		// Update offset to next frame
-		i += frameLength;
-		
-		// Set opcode to continuation
-		opcode = WebSocketOpcode::CONTINUATION;
-	}
-	
-	// Return response
-	return response;
+	// Return WebSocket response compressed with the client's compression policy
+	return WebSocket::createResponse(message, opcode, client.getCompressionPolicy(), client.getId());
 }
 
 // Get cookies
@@ -4187,7 +5658,7 @@ const string getRandomUrl(const string &onionServiceAddress) {
 	urlLength = urlLength % (URL_MAXIMUM_LENGTH - URL_MINIMUM_LENGTH + 1) + URL_MINIMUM_LENGTH;
 	
 	// Initialize URL
-	string url = "http://" + onionServiceAddress + ".onion/";
+	string url = "http://" + onionServiceAddress + '/';
 	
 	// Go through all characters in the URL
 	for(size_t i = 0; i < urlLength; ++i) {
@@ -4199,3 +5670,68 @@ const string getRandomUrl(const string &onionServiceAddress) {
 	// Return URL
 	return url;
 }
+
+// Start server
+bool startServer(evhttp *httpServer, const string &listenAddress, uint16_t listenPort, bool usingTlsServer) {
+
+	// Check if binding server to listen address and listen port failed
+	if(evhttp_bind_socket(httpServer, listenAddress.c_str(), listenPort)) {
+	
+		// Log message
+		Logger::log(Logger::Level::FAILURE, "Binding server to " + listenAddress + ':' + to_string(listenPort) + " failed");
+		
+		// Return false
+		return false;
+	}
+	
+	// Set display port to if the listen port doesn't match the default server port
+	const bool displayPort = (!usingTlsServer && listenPort != HTTP_PORT) || (usingTlsServer && listenPort != HTTPS_PORT);
+	
+	// Check if listen address is an IPv6 address
+	char temp[sizeof(in6_addr)];
+	if(inet_pton(AF_INET6, listenAddress.c_str(), temp) == 1) {
+	
+		// Log message
+		Logger::log(Logger::Level::INFO, string("Listening at ") + (usingTlsServer ? "https" : "http") + "://[" + listenAddress + ']' + (displayPort ? ':' + to_string(listenPort) : ""));
+	}
+	
+	// Otherwise
+	else {
+	
+		// Log message
+		Logger::log(Logger::Level::INFO, string("Listening at ") + (usingTlsServer ? "https" : "http") + "://" + listenAddress + (displayPort ? ':' + to_string(listenPort) : ""));
+	}
+	
+	// Return true
+	return true;
+}
+
+// Decode interaction data
+bool decodeInteractionData(evbuffer *output, const string_view &data, bool compress, Cache *cache, const string &cacheKey) {
+
+	// Get start time
+	const chrono::steady_clock::time_point startTime = chrono::steady_clock::now();
+	
+	// Check if compressing
+	if(compress) {
+	
+		// Probe gzip start
+		PROBE(gzip_start, data.length());
+	}
+	
+	// Decode data, and compress and cache it if compressing, directly into the output
+	const bool result = compress ? Common::base64DecodeAndGzip(output, data) && cache->add(cacheKey, output) : Common::base64Decode(output, data);
+	
+	// Check if compressing
+	if(compress) {
+	
+		// Probe gzip end
+		PROBE(gzip_end, evbuffer_get_length(output), result);
+	}
+	
+	// Update base64 decode duration metric
+	Metrics::base64DecodeDuration.recordDuration(chrono::steady_clock::now() - startTime);
+	
+	// Return result
+	return result;
+}
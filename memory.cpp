@@ -0,0 +1,326 @@
+// Header files
+#include <algorithm>
+#include "memory.h"
+
+using namespace std;
+
+
+// Constants
+
+// Unlimited budget
+const size_t Memory::UNLIMITED_BUDGET = 0;
+
+// Category gauges
+Metrics::Gauge *const Memory::CATEGORY_GAUGES[] = {
+
+	// Connection input
+	&Metrics::memoryConnectionInput,
+
+	// Connection output
+	&Metrics::memoryConnectionOutput,
+
+	// Messages
+	&Metrics::memoryMessages,
+
+	// Request bodies
+	&Metrics::memoryRequestBodies,
+
+	// Codec
+	&Metrics::memoryCodec,
+
+	// URLs
+	&Metrics::memoryUrls
+};
+
+// Category peak gauges
+Metrics::Gauge *const Memory::CATEGORY_PEAK_GAUGES[] = {
+
+	// Connection input
+	&Metrics::memoryConnectionInputPeak,
+
+	// Connection output
+	&Metrics::memoryConnectionOutputPeak,
+
+	// Messages
+	&Metrics::memoryMessagesPeak,
+
+	// Request bodies
+	&Metrics::memoryRequestBodiesPeak,
+
+	// Codec
+	&Metrics::memoryCodecPeak,
+
+	// URLs
+	&Metrics::memoryUrlsPeak
+};
+
+
+// Global variables
+
+// Budget
+size_t Memory::budget = Memory::UNLIMITED_BUDGET;
+
+// Bytes (only accessed from the event loop's thread so not atomic)
+size_t Memory::bytes[static_cast<size_t>(Memory::Category::NUMBER_OF_CATEGORIES)];
+
+// Peaks
+size_t Memory::peaks[static_cast<size_t>(Memory::Category::NUMBER_OF_CATEGORIES)];
+
+// Total
+size_t Memory::total = 0;
+
+// Account watched accounts (buffers' callbacks look their account up here since a buffer can outlive its account)
+unordered_map<const bufferevent *, Memory::Account *> Memory::Account::watchedAccounts;
+
+
+// Supporting function implementation
+
+// Set budget
+void Memory::setBudget(size_t budget) {
+
+	// Set budget
+	Memory::budget = budget;
+
+	// Set memory budget metric
+	Metrics::memoryBudget.set(budget);
+}
+
+// Is over budget
+bool Memory::isOverBudget(size_t additionalBytes) {
+
+	// Return if budget is limited and the total with the additional bytes exceeds it
+	return budget != UNLIMITED_BUDGET && (additionalBytes > budget || total > budget - additionalBytes);
+}
+
+// Add
+void Memory::add(Category category, size_t bytes) {
+
+	// Add bytes to the category and total
+	Memory::bytes[static_cast<size_t>(category)] += bytes;
+	total += bytes;
+
+	// Update category's peak
+	peaks[static_cast<size_t>(category)] = max(peaks[static_cast<size_t>(category)], Memory::bytes[static_cast<size_t>(category)]);
+}
+
+// Subtract
+void Memory::subtract(Category category, size_t bytes) {
+
+	// Subtract bytes from the category and total
+	Memory::bytes[static_cast<size_t>(category)] -= bytes;
+	total -= bytes;
+}
+
+// Get total
+size_t Memory::getTotal() {
+
+	// Return total
+	return total;
+}
+
+// Update metrics
+void Memory::updateMetrics() {
+
+	// Go through all categories
+	for(size_t i = 0; i < static_cast<size_t>(Category::NUMBER_OF_CATEGORIES); ++i) {
+
+		// Set category's metrics
+		CATEGORY_GAUGES[i]->set(bytes[i]);
+		CATEGORY_PEAK_GAUGES[i]->set(peaks[i]);
+	}
+}
+
+// Account constructor
+Memory::Account::Account() :
+
+	// Set bytes
+	bytes(),
+
+	// Set watched buffer
+	watchedBuffer(nullptr)
+{
+}
+
+// Account move constructor
+Memory::Account::Account(Account &&other) :
+
+	// Set watched buffer
+	watchedBuffer(other.watchedBuffer)
+{
+
+	// Take other's bytes so that they're only subtracted once
+	copy(begin(other.bytes), end(other.bytes), begin(bytes));
+	fill(begin(other.bytes), end(other.bytes), 0);
+
+	// Check if other is watching a buffer
+	if(other.watchedBuffer) {
+
+		// Take other's watched buffer
+		watchedAccounts[watchedBuffer] = this;
+		other.watchedBuffer = nullptr;
+	}
+}
+
+// Account destructor
+Memory::Account::~Account() {
+
+	// Check if watching a buffer
+	if(watchedBuffer) {
+
+		// Stop watching buffer
+		watchedAccounts.erase(watchedBuffer);
+	}
+
+	// Go through all categories
+	for(size_t i = 0; i < static_cast<size_t>(Category::NUMBER_OF_CATEGORIES); ++i) {
+
+		// Subtract category's bytes from the global bytes
+		subtract(static_cast<Category>(i), bytes[i]);
+	}
+}
+
+// Account set
+void Memory::Account::set(Category category, size_t bytes) {
+
+	// Check if bytes increased
+	size_t &currentBytes = this->bytes[static_cast<size_t>(category)];
+	if(bytes > currentBytes) {
+
+		// Add increase to the global bytes
+		add(category, bytes - currentBytes);
+	}
+
+	// Otherwise
+	else {
+
+		// Subtract decrease from the global bytes
+		subtract(category, currentBytes - bytes);
+	}
+
+	// Set current bytes
+	currentBytes = bytes;
+}
+
+// Account get
+size_t Memory::Account::get(Category category) const {
+
+	// Return category's bytes
+	return bytes[static_cast<size_t>(category)];
+}
+
+// Account get total
+size_t Memory::Account::getTotal() const {
+
+	// Go through all categories
+	size_t total = 0;
+	for(size_t i = 0; i < static_cast<size_t>(Category::NUMBER_OF_CATEGORIES); ++i) {
+
+		// Add category's bytes to the total
+		total += bytes[i];
+	}
+
+	// Return total
+	return total;
+}
+
+// Account watch
+bool Memory::Account::watch(bufferevent *buffer) {
+
+	// Check if already watching a buffer or adding callbacks to the buffer's input and output failed
+	evbuffer *input = bufferevent_get_input(buffer);
+	evbuffer *output = bufferevent_get_output(buffer);
+	if(watchedBuffer || !input || !output || !evbuffer_add_cb(input, inputChanged, buffer) || !evbuffer_add_cb(output, outputChanged, buffer)) {
+
+		// Return false
+		return false;
+	}
+
+	// Set watched buffer
+	watchedBuffer = buffer;
+	watchedAccounts[watchedBuffer] = this;
+
+	// Set input and output's current lengths
+	set(Category::CONNECTION_INPUT, evbuffer_get_length(input));
+	set(Category::CONNECTION_OUTPUT, evbuffer_get_length(output));
+
+	// Return true
+	return true;
+}
+
+// Account input changed
+void Memory::Account::inputChanged(evbuffer *buffer, const evbuffer_cb_info *information, void *argument) {
+
+	// Check if buffer's account still exists
+	Account *account = getWatchedAccount(argument);
+	if(account) {
+
+		// Set account's input to the buffer's length
+		account->set(Category::CONNECTION_INPUT, evbuffer_get_length(buffer));
+	}
+}
+
+// Account output changed
+void Memory::Account::outputChanged(evbuffer *buffer, const evbuffer_cb_info *information, void *argument) {
+
+	// Check if buffer's account still exists
+	Account *account = getWatchedAccount(argument);
+	if(account) {
+
+		// Set account's output to the buffer's length
+		account->set(Category::CONNECTION_OUTPUT, evbuffer_get_length(buffer));
+	}
+}
+
+// Account get watched account
+Memory::Account *Memory::Account::getWatchedAccount(void *argument) {
+
+	// Check if buffer is watched
+	const unordered_map<const bufferevent *, Account *>::const_iterator account = watchedAccounts.find(reinterpret_cast<const bufferevent *>(argument));
+	if(account != watchedAccounts.cend()) {
+
+		// Return account
+		return account->second;
+	}
+
+	// Return null
+	return nullptr;
+}
+
+// Reservation constructor
+Memory::Reservation::Reservation(Category category) :
+
+	// Set category
+	category(category),
+
+	// Set bytes
+	bytes(0)
+{
+}
+
+// Reservation destructor
+Memory::Reservation::~Reservation() {
+
+	// Subtract bytes from the global bytes
+	subtract(category, bytes);
+}
+
+// Reservation set
+void Memory::Reservation::set(size_t bytes) {
+
+	// Check if bytes increased
+	if(bytes > this->bytes) {
+
+		// Add increase to the global bytes
+		add(category, bytes - this->bytes);
+	}
+
+	// Otherwise
+	else {
+
+		// Subtract decrease from the global bytes
+		subtract(category, this->bytes - bytes);
+	}
+
+	// Set bytes
+	this->bytes = bytes;
+}
@@ -0,0 +1,182 @@
+// Header guard
+#ifndef MEMORY_H
+#define MEMORY_H
+
+
+// Header files
+#include <cstddef>
+#include <unordered_map>
+#include "event2/buffer.h"
+#include "event2/bufferevent.h"
+#include "metrics.h"
+
+using namespace std;
+
+
+// Classes
+
+// Memory class
+class Memory final {
+
+	// Public
+	public:
+
+		// Constructor
+		Memory() = delete;
+
+		// Category
+		enum class Category {
+
+			// Connection input
+			CONNECTION_INPUT,
+
+			// Connection output
+			CONNECTION_OUTPUT,
+
+			// Messages
+			MESSAGES,
+
+			// Request bodies
+			REQUEST_BODIES,
+
+			// Codec
+			CODEC,
+
+			// URLs
+			URLS,
+
+			// Number of categories
+			NUMBER_OF_CATEGORIES
+		};
+
+		// Account class
+		class Account final {
+
+			// Public
+			public:
+
+				// Constructor
+				Account();
+
+				// Copy constructor
+				Account(const Account &other) = delete;
+
+				// Move constructor
+				Account(Account &&other);
+
+				// Destructor
+				~Account();
+
+				// Copy assignment operator
+				Account &operator=(const Account &other) = delete;
+
+				// Set
+				void set(Category category, size_t bytes);
+
+				// Get
+				size_t get(Category category) const;
+
+				// Get total
+				size_t getTotal() const;
+
+				// Watch
+				bool watch(bufferevent *buffer);
+
+			// Private
+			private:
+
+				// Input changed
+				static void inputChanged(evbuffer *buffer, const evbuffer_cb_info *information, void *argument);
+
+				// Output changed
+				static void outputChanged(evbuffer *buffer, const evbuffer_cb_info *information, void *argument);
+
+				// Get watched account
+				static Account *getWatchedAccount(void *argument);
+
+				// Watched accounts
+				static unordered_map<const bufferevent *, Account *> watchedAccounts;
+
+				// Bytes
+				size_t bytes[static_cast<size_t>(Category::NUMBER_OF_CATEGORIES)];
+
+				// Watched buffer
+				const bufferevent *watchedBuffer;
+		};
+
+		// Reservation class
+		class Reservation final {
+
+			// Public
+			public:
+
+				// Constructor
+				explicit Reservation(Category category);
+
+				// Copy constructor
+				Reservation(const Reservation &other) = delete;
+
+				// Destructor
+				~Reservation();
+
+				// Copy assignment operator
+				Reservation &operator=(const Reservation &other) = delete;
+
+				// Set
+				void set(size_t bytes);
+
+			// Private
+			private:
+
+				// Category
+				Category category;
+
+				// Bytes
+				size_t bytes;
+		};
+
+		// Unlimited budget
+		static const size_t UNLIMITED_BUDGET;
+
+		// Set budget
+		static void setBudget(size_t budget);
+
+		// Is over budget
+		static bool isOverBudget(size_t additionalBytes = 0);
+
+		// Add
+		static void add(Category category, size_t bytes);
+
+		// Subtract
+		static void subtract(Category category, size_t bytes);
+
+		// Get total
+		static size_t getTotal();
+
+		// Update metrics
+		static void updateMetrics();
+
+	// Private
+	private:
+
+		// Category gauges
+		static Metrics::Gauge *const CATEGORY_GAUGES[];
+
+		// Category peak gauges
+		static Metrics::Gauge *const CATEGORY_PEAK_GAUGES[];
+
+		// Budget
+		static size_t budget;
+
+		// Bytes
+		static size_t bytes[static_cast<size_t>(Category::NUMBER_OF_CATEGORIES)];
+
+		// Peaks
+		static size_t peaks[static_cast<size_t>(Category::NUMBER_OF_CATEGORIES)];
+
+		// Total
+		static size_t total;
+};
+
+
+#endif
@@ -0,0 +1,72 @@
+// Header guard
+#ifndef MESSAGES_H
+#define MESSAGES_H
+
+
+// Header files
+#include <climits>
+#include <cstdint>
+#include "schema.h"
+
+using namespace std;
+
+
+// Constants
+
+// Maximum safe integer
+static const uint64_t MAXIMUM_SAFE_INTEGER = (static_cast<uint64_t>(1) << 53) - 1;
+
+
+// Classes
+
+// Control message class
+class ControlMessage final {
+
+	// Public
+	public:
+
+		// Index
+		Schema::Integer index;
+
+		// Request
+		Schema::String request;
+
+		// URL
+		Schema::String url;
+};
+
+// Interaction message class
+class InteractionMessage final {
+
+	// Public
+	public:
+
+		// Interaction
+		Schema::Integer interaction;
+
+		// Data
+		Schema::String data;
+
+		// Type
+		Schema::String type;
+
+		// Status
+		Schema::Integer status;
+};
+
+
+// Schemas
+
+// Client message decoder
+static constexpr Schema::Decoder CLIENT_MESSAGE_DECODER(
+	Schema::Field("Index", &ControlMessage::index, MAXIMUM_SAFE_INTEGER),
+	Schema::Field("Request", &ControlMessage::request),
+	Schema::Field("URL", &ControlMessage::url),
+	Schema::Field("Interaction", &InteractionMessage::interaction, MAXIMUM_SAFE_INTEGER),
+	Schema::Field("Data", &InteractionMessage::data),
+	Schema::Field("Type", &InteractionMessage::type),
+	Schema::Field("Status", &InteractionMessage::status, INT_MAX)
+);
+
+
+#endif
@@ -0,0 +1,493 @@
+// Header files
+#include <algorithm>
+#include <climits>
+#include "metrics.h"
+
+using namespace std;
+
+
+// Constants
+
+// Histogram sub-bucket bits
+const int Metrics::Histogram::SUB_BUCKET_BITS = 2;
+
+// Histogram number of sub-buckets
+const size_t Metrics::Histogram::NUMBER_OF_SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+
+// Histogram number of buckets
+const size_t Metrics::Histogram::NUMBER_OF_BUCKETS;
+
+
+// Global variables
+
+// Connected clients
+Metrics::Gauge Metrics::connectedClients("websocket_listener_connected_clients", "Number of connected WebSocket clients");
+
+// Sessions
+Metrics::Gauge Metrics::sessions("websocket_listener_sessions", "Number of sessions with URLs");
+
+// URLs
+Metrics::Gauge Metrics::urls("websocket_listener_urls", "Number of URLs across all sessions");
+
+// In-flight interactions
+Metrics::Gauge Metrics::inFlightInteractions("websocket_listener_in_flight_interactions", "Number of interactions waiting for a reply");
+
+// WebSocket bytes received
+Metrics::Counter Metrics::webSocketBytesReceived("websocket_listener_websocket_received_bytes_total", "Bytes of WebSocket frames received from clients");
+
+// WebSocket bytes sent
+Metrics::Counter Metrics::webSocketBytesSent("websocket_listener_websocket_sent_bytes_total", "Bytes of WebSocket frames sent to clients");
+
+// HTTP bytes received
+Metrics::Counter Metrics::httpBytesReceived("websocket_listener_http_received_bytes_total", "Bytes of interaction request bodies received");
+
+// HTTP bytes sent
+Metrics::Counter Metrics::httpBytesSent("websocket_listener_http_sent_bytes_total", "Bytes of interaction reply bodies sent");
+
+// WebSocket frames parsed
+Metrics::Counter Metrics::webSocketFramesParsed("websocket_listener_websocket_frames_parsed_total", "Number of WebSocket frames parsed");
+
+// Compression input bytes
+Metrics::Counter Metrics::compressionInputBytes("websocket_listener_compression_input_bytes_total", "Bytes of WebSocket messages sent compressed before compression");
+
+// Compression output bytes
+Metrics::Counter Metrics::compressionOutputBytes("websocket_listener_compression_output_bytes_total", "Bytes of WebSocket messages sent compressed after compression");
+
+// Compression ratio
+Metrics::Histogram Metrics::compressionRatio("websocket_listener_compression_ratio_percent", "Compressed size of WebSocket messages as a percentage of their original size");
+
+// Compression connected saved bytes
+Metrics::Gauge Metrics::compressionConnectedSavedBytes("websocket_listener_compression_connected_saved_bytes", "Bytes saved by compressing WebSocket messages sent to the connected clients");
+
+// Compression largest connection saved bytes
+Metrics::Gauge Metrics::compressionLargestConnectionSavedBytes("websocket_listener_compression_largest_connection_saved_bytes", "Bytes saved by compressing WebSocket messages sent to the connected client that compression saved the most for");
+
+// Compression duration
+Metrics::Histogram Metrics::compressionDuration("websocket_listener_compression_duration_microseconds", "Time spent compressing WebSocket messages and reply bodies");
+
+// Base64 encode duration
+Metrics::Histogram Metrics::base64EncodeDuration("websocket_listener_base64_encode_duration_microseconds", "Time spent base64 encoding interaction request bodies");
+
+// Base64 decode duration
+Metrics::Histogram Metrics::base64DecodeDuration("websocket_listener_base64_decode_duration_microseconds", "Time spent base64 decoding, and gzipping if compressing, interaction reply bodies");
+
+// JSON decode duration
+Metrics::Histogram Metrics::jsonDecodeDuration("websocket_listener_json_decode_duration_microseconds", "Time spent decoding JSON messages from clients");
+
+// Ping round trip time
+Metrics::Histogram Metrics::pingRoundTripTime("websocket_listener_ping_round_trip_time_microseconds", "Time between sending a ping and receiving its pong");
+
+// Interaction latency
+Metrics::Histogram Metrics::interactionLatency("websocket_listener_interaction_latency_microseconds", "Time between receiving an interaction request and replying to it");
+
+// Interaction queue duration
+Metrics::Histogram Metrics::interactionQueueDuration("websocket_listener_interaction_queue_duration_microseconds", "Time between receiving an interaction request and queuing it to the WebSocket client");
+
+// Interaction flush duration
+Metrics::Histogram Metrics::interactionFlushDuration("websocket_listener_interaction_flush_duration_microseconds", "Time between queuing an interaction to the WebSocket client and flushing it to the socket");
+
+// Interaction responder duration
+Metrics::Histogram Metrics::interactionResponderDuration("websocket_listener_interaction_responder_duration_microseconds", "Time between flushing an interaction to the socket and parsing the WebSocket client's reply");
+
+// Interaction decode duration
+Metrics::Histogram Metrics::interactionDecodeDuration("websocket_listener_interaction_decode_duration_microseconds", "Time between parsing an interaction's reply and having its body decoded, and gzipped if compressing");
+
+// Interaction reply duration
+Metrics::Histogram Metrics::interactionReplyDuration("websocket_listener_interaction_reply_duration_microseconds", "Time between having an interaction's body decoded and sending its reply");
+
+// Interaction write duration
+Metrics::Histogram Metrics::interactionWriteDuration("websocket_listener_interaction_write_duration_microseconds", "Time between sending an interaction's reply and it being written to the socket");
+
+// Cache hits
+Metrics::Counter Metrics::cacheHits("websocket_listener_cache_hits_total", "Number of reply bodies served from the compressed body cache");
+
+// Cache misses
+Metrics::Counter Metrics::cacheMisses("websocket_listener_cache_misses_total", "Number of reply bodies not found in the compressed body cache");
+
+// Cache size
+Metrics::Gauge Metrics::cacheSize("websocket_listener_cache_size_bytes", "Bytes held by the compressed body cache");
+
+// Cache maximum size
+Metrics::Gauge Metrics::cacheMaximumSize("websocket_listener_cache_maximum_size_bytes", "Byte budget of the compressed body cache");
+
+// Log records dropped
+Metrics::Counter Metrics::logRecordsDropped("websocket_listener_log_records_dropped_total", "Number of log records dropped because their thread's ring was full");
+
+// Event loop lag
+Metrics::Histogram Metrics::eventLoopLag("websocket_listener_event_loop_lag_microseconds", "Time the event loop's lag probe timer fired after it was due");
+
+// WebSocket read callback duration
+Metrics::Histogram Metrics::webSocketReadCallbackDuration("websocket_listener_websocket_read_callback_duration_microseconds", "Time spent in the WebSocket read callback");
+
+// Tor server request callback duration
+Metrics::Histogram Metrics::torServerRequestCallbackDuration("websocket_listener_tor_server_request_callback_duration_microseconds", "Time spent in the Tor-side server's request callback");
+
+// Ping callback duration
+Metrics::Histogram Metrics::pingCallbackDuration("websocket_listener_ping_callback_duration_microseconds", "Time spent in the ping callback");
+
+// Tor control callback duration
+Metrics::Histogram Metrics::torControlCallbackDuration("websocket_listener_tor_control_callback_duration_microseconds", "Time spent in the Tor control connection's read callback");
+
+// Slow callbacks
+Metrics::Counter Metrics::slowCallbacks("websocket_listener_slow_callbacks_total", "Number of callbacks that took at least the slow callback threshold");
+
+// Memory connection input
+Metrics::Gauge Metrics::memoryConnectionInput("websocket_listener_memory_connection_input_bytes", "Bytes in the WebSocket connections' input buffers");
+
+// Memory connection output
+Metrics::Gauge Metrics::memoryConnectionOutput("websocket_listener_memory_connection_output_bytes", "Bytes in the WebSocket connections' output buffers");
+
+// Memory messages
+Metrics::Gauge Metrics::memoryMessages("websocket_listener_memory_messages_bytes", "Bytes reserved by the WebSocket connections' reassembled messages");
+
+// Memory request bodies
+Metrics::Gauge Metrics::memoryRequestBodies("websocket_listener_memory_request_bodies_bytes", "Bytes held by POST request bodies being forwarded to clients");
+
+// Memory codec
+Metrics::Gauge Metrics::memoryCodec("websocket_listener_memory_codec_bytes", "Bytes held by decoded and compressed interaction replies");
+
+// Memory URLs
+Metrics::Gauge Metrics::memoryUrls("websocket_listener_memory_urls_bytes", "Bytes held by the sessions' URLs");
+
+// Memory connection input peak
+Metrics::Gauge Metrics::memoryConnectionInputPeak("websocket_listener_memory_connection_input_peak_bytes", "Most bytes ever in the WebSocket connections' input buffers");
+
+// Memory connection output peak
+Metrics::Gauge Metrics::memoryConnectionOutputPeak("websocket_listener_memory_connection_output_peak_bytes", "Most bytes ever in the WebSocket connections' output buffers");
+
+// Memory messages peak
+Metrics::Gauge Metrics::memoryMessagesPeak("websocket_listener_memory_messages_peak_bytes", "Most bytes ever reserved by the WebSocket connections' reassembled messages");
+
+// Memory request bodies peak
+Metrics::Gauge Metrics::memoryRequestBodiesPeak("websocket_listener_memory_request_bodies_peak_bytes", "Most bytes ever held by POST request bodies being forwarded to clients");
+
+// Memory codec peak
+Metrics::Gauge Metrics::memoryCodecPeak("websocket_listener_memory_codec_peak_bytes", "Most bytes ever held by decoded and compressed interaction replies");
+
+// Memory URLs peak
+Metrics::Gauge Metrics::memoryUrlsPeak("websocket_listener_memory_urls_peak_bytes", "Most bytes ever held by the sessions' URLs");
+
+// Memory largest connection
+Metrics::Gauge Metrics::memoryLargestConnection("websocket_listener_memory_largest_connection_bytes", "Bytes accounted to the WebSocket connection using the most memory");
+
+// Memory budget
+Metrics::Gauge Metrics::memoryBudget("websocket_listener_memory_budget_bytes", "Byte budget that new POST requests and WebSocket upgrades are rejected over, or zero if unlimited");
+
+// Memory budget rejections
+Metrics::Counter Metrics::memoryBudgetRejections("websocket_listener_memory_budget_rejections_total", "Number of POST requests and WebSocket upgrades rejected because memory was over budget");
+
+// Check if using allocation profiler
+#ifdef ALLOCATION_PROFILER
+
+	// WebSocket message allocations
+	Metrics::Histogram Metrics::webSocketMessageAllocations("websocket_listener_websocket_message_allocations", "Heap allocations made while handling a WebSocket message excluding its interaction reply");
+
+	// WebSocket message allocated bytes
+	Metrics::Histogram Metrics::webSocketMessageAllocatedBytes("websocket_listener_websocket_message_allocated_bytes", "Heap bytes allocated while handling a WebSocket message excluding its interaction reply");
+
+	// POST dispatch allocations
+	Metrics::Histogram Metrics::postDispatchAllocations("websocket_listener_post_dispatch_allocations", "Heap allocations made while dispatching a POST request to a client");
+
+	// POST dispatch allocated bytes
+	Metrics::Histogram Metrics::postDispatchAllocatedBytes("websocket_listener_post_dispatch_allocated_bytes", "Heap bytes allocated while dispatching a POST request to a client");
+
+	// Reply allocations
+	Metrics::Histogram Metrics::replyAllocations("websocket_listener_reply_allocations", "Heap allocations made while replying to a POST request with a client's interaction reply");
+
+	// Reply allocated bytes
+	Metrics::Histogram Metrics::replyAllocatedBytes("websocket_listener_reply_allocated_bytes", "Heap bytes allocated while replying to a POST request with a client's interaction reply");
+#endif
+
+// Metrics
+const Metrics::Metric *const Metrics::METRICS[] = {
+	&connectedClients,
+	&sessions,
+	&urls,
+	&inFlightInteractions,
+	&webSocketBytesReceived,
+	&webSocketBytesSent,
+	&httpBytesReceived,
+	&httpBytesSent,
+	&webSocketFramesParsed,
+	&compressionInputBytes,
+	&compressionOutputBytes,
+	&compressionRatio,
+	&compressionConnectedSavedBytes,
+	&compressionLargestConnectionSavedBytes,
+	&compressionDuration,
+	&base64EncodeDuration,
+	&base64DecodeDuration,
+	&jsonDecodeDuration,
+	&pingRoundTripTime,
+	&interactionLatency,
+	&interactionQueueDuration,
+	&interactionFlushDuration,
+	&interactionResponderDuration,
+	&interactionDecodeDuration,
+	&interactionReplyDuration,
+	&interactionWriteDuration,
+	&cacheHits,
+	&cacheMisses,
+	&cacheSize,
+	&cacheMaximumSize,
+	&logRecordsDropped,
+	&eventLoopLag,
+	&webSocketReadCallbackDuration,
+	&torServerRequestCallbackDuration,
+	&pingCallbackDuration,
+	&torControlCallbackDuration,
+	&slowCallbacks,
+	&memoryConnectionInput,
+	&memoryConnectionOutput,
+	&memoryMessages,
+	&memoryRequestBodies,
+	&memoryCodec,
+	&memoryUrls,
+	&memoryConnectionInputPeak,
+	&memoryConnectionOutputPeak,
+	&memoryMessagesPeak,
+	&memoryRequestBodiesPeak,
+	&memoryCodecPeak,
+	&memoryUrlsPeak,
+	&memoryLargestConnection,
+	&memoryBudget,
+	&memoryBudgetRejections,
+
+	// Check if using allocation profiler
+	#ifdef ALLOCATION_PROFILER
+		&webSocketMessageAllocations,
+		&webSocketMessageAllocatedBytes,
+		&postDispatchAllocations,
+		&postDispatchAllocatedBytes,
+		&replyAllocations,
+		&replyAllocatedBytes
+	#endif
+};
+
+
+// Supporting function implementation
+
+// Encode
+string Metrics::encode() {
+
+	// Initialize output
+	string output;
+
+	// Go through all metrics
+	for(const Metric *metric : METRICS) {
+
+		// Append metric to the output
+		metric->encode(output);
+	}
+
+	// Return output
+	return output;
+}
+
+// Metric constructor
+Metrics::Metric::Metric(const char *name, const char *help, const char *type) :
+
+	// Set name
+	name(name),
+
+	// Set help
+	help(help),
+
+	// Set type
+	type(type)
+{
+}
+
+// Metric append header
+void Metrics::Metric::appendHeader(string &output) const {
+
+	// Append help and type to the output
+	output += string("# HELP ") + name + ' ' + help + '\n';
+	output += string("# TYPE ") + name + ' ' + type + '\n';
+}
+
+// Counter constructor
+Metrics::Counter::Counter(const char *name, const char *help) :
+
+	// Delegate constructor
+	Metric(name, help, "counter"),
+
+	// Set value
+	value(0)
+{
+}
+
+// Counter increment
+void Metrics::Counter::increment(uint64_t amount) {
+
+	// Add amount to value
+	value.fetch_add(amount, memory_order_relaxed);
+}
+
+// Counter set
+void Metrics::Counter::set(uint64_t total) {
+
+	// Set value to total
+	value.store(total, memory_order_relaxed);
+}
+
+// Counter get
+uint64_t Metrics::Counter::get() const {
+
+	// Return value
+	return value.load(memory_order_relaxed);
+}
+
+// Counter encode
+void Metrics::Counter::encode(string &output) const {
+
+	// Append header to the output
+	appendHeader(output);
+
+	// Append value to the output
+	output += string(name) + ' ' + to_string(get()) + '\n';
+}
+
+// Gauge constructor
+Metrics::Gauge::Gauge(const char *name, const char *help) :
+
+	// Delegate constructor
+	Metric(name, help, "gauge"),
+
+	// Set value
+	value(0)
+{
+}
+
+// Gauge add
+void Metrics::Gauge::add(int64_t amount) {
+
+	// Add amount to value
+	value.fetch_add(amount, memory_order_relaxed);
+}
+
+// Gauge set
+void Metrics::Gauge::set(int64_t total) {
+
+	// Set value to total
+	value.store(total, memory_order_relaxed);
+}
+
+// Gauge get
+int64_t Metrics::Gauge::get() const {
+
+	// Return value
+	return value.load(memory_order_relaxed);
+}
+
+// Gauge encode
+void Metrics::Gauge::encode(string &output) const {
+
+	// Append header to the output
+	appendHeader(output);
+
+	// Append value to the output
+	output += string(name) + ' ' + to_string(get()) + '\n';
+}
+
+// Histogram constructor
+Metrics::Histogram::Histogram(const char *name, const char *help) :
+
+	// Delegate constructor
+	Metric(name, help, "histogram"),
+
+	// Set buckets
+	buckets(),
+
+	// Set count
+	count(0),
+
+	// Set sum
+	sum(0)
+{
+}
+
+// Histogram record
+void Metrics::Histogram::record(uint64_t value) {
+
+	// Check if value is in a bucket
+	const size_t index = getBucketIndex(value);
+	if(index < NUMBER_OF_BUCKETS) {
+
+		// Increment value's bucket
+		buckets[index].fetch_add(1, memory_order_relaxed);
+	}
+
+	// Increment count
+	count.fetch_add(1, memory_order_relaxed);
+
+	// Add value to sum
+	sum.fetch_add(value, memory_order_relaxed);
+}
+
+// Histogram record duration
+void Metrics::Histogram::recordDuration(chrono::steady_clock::duration duration) {
+
+	// Record duration in microseconds
+	record(max(chrono::duration_cast<chrono::microseconds>(duration).count(), static_cast<chrono::microseconds::rep>(0)));
+}
+
+// Histogram encode
+void Metrics::Histogram::encode(string &output) const {
+
+	// Append header to the output
+	appendHeader(output);
+
+	// Go through all buckets
+	uint64_t cumulativeCount = 0;
+	for(size_t i = 0; i < NUMBER_OF_BUCKETS; ++i) {
+
+		// Add bucket's count to the cumulative count
+		cumulativeCount += buckets[i].load(memory_order_relaxed);
+
+		// Append bucket to the output
+		output += string(name) + "_bucket{le=\"" + to_string(getBucketUpperBound(i)) + "\"} " + to_string(cumulativeCount) + '\n';
+	}
+
+	// Append infinite bucket, sum, and count to the output
+	const uint64_t totalCount = count.load(memory_order_relaxed);
+	output += string(name) + "_bucket{le=\"+Inf\"} " + to_string(max(totalCount, cumulativeCount)) + '\n';
+	output += string(name) + "_sum " + to_string(sum.load(memory_order_relaxed)) + '\n';
+	output += string(name) + "_count " + to_string(max(totalCount, cumulativeCount)) + '\n';
+}
+
+// Histogram get bucket index
+size_t Metrics::Histogram::getBucketIndex(uint64_t value) {
+
+	// Check if value is small enough to have its own bucket
+	if(value < NUMBER_OF_SUB_BUCKETS) {
+
+		// Return value
+		return value;
+	}
+
+	// Get value's most significant bit and the sub-bucket bits after it
+	const int exponent = sizeof(unsigned long long) * CHAR_BIT - 1 - __builtin_clzll(value);
+	const size_t subBucket = (value >> (exponent - SUB_BUCKET_BITS)) & (NUMBER_OF_SUB_BUCKETS - 1);
+
+	// Return bucket index or the number of buckets if the value is larger than all buckets
+	return min(NUMBER_OF_SUB_BUCKETS + (exponent - SUB_BUCKET_BITS) * NUMBER_OF_SUB_BUCKETS + subBucket, NUMBER_OF_BUCKETS);
+}
+
+// Histogram get bucket upper bound
+uint64_t Metrics::Histogram::getBucketUpperBound(size_t index) {
+
+	// Check if bucket holds a single value
+	if(index < NUMBER_OF_SUB_BUCKETS) {
+
+		// Return index
+		return index;
+	}
+
+	// Get bucket's exponent and sub-bucket
+	const int shift = (index - NUMBER_OF_SUB_BUCKETS) / NUMBER_OF_SUB_BUCKETS;
+	const uint64_t subBucket = (index - NUMBER_OF_SUB_BUCKETS) % NUMBER_OF_SUB_BUCKETS;
+
+	// Return the largest value in the bucket
+	return ((NUMBER_OF_SUB_BUCKETS + subBucket + 1) << shift) - 1;
+}
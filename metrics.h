@@ -0,0 +1,348 @@
+// Header guard
+#ifndef METRICS_H
+#define METRICS_H
+
+
+// Header files
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+using namespace std;
+
+
+// Classes
+
+// Metrics class
+class Metrics final {
+
+	// Public
+	public:
+
+		// Constructor
+		Metrics() = delete;
+
+		// Metric class
+		class Metric {
+
+			// Public
+			public:
+
+				// Constructor
+				Metric(const char *name, const char *help, const char *type);
+
+				// Destructor
+				virtual ~Metric() = default;
+
+				// Encode
+				virtual void encode(string &output) const = 0;
+
+			// Protected
+			protected:
+
+				// Append header
+				void appendHeader(string &output) const;
+
+				// Name
+				const char *name;
+
+				// Help
+				const char *help;
+
+				// Type
+				const char *type;
+		};
+
+		// Counter class
+		class Counter final : public Metric {
+
+			// Public
+			public:
+
+				// Constructor
+				Counter(const char *name, const char *help);
+
+				// Increment
+				void increment(uint64_t amount = 1);
+
+				// Set
+				void set(uint64_t total);
+
+				// Get
+				uint64_t get() const;
+
+				// Encode
+				void encode(string &output) const override;
+
+			// Private
+			private:
+
+				// Value
+				atomic_uint64_t value;
+		};
+
+		// Gauge class
+		class Gauge final : public Metric {
+
+			// Public
+			public:
+
+				// Constructor
+				Gauge(const char *name, const char *help);
+
+				// Add
+				void add(int64_t amount);
+
+				// Set
+				void set(int64_t total);
+
+				// Get
+				int64_t get() const;
+
+				// Encode
+				void encode(string &output) const override;
+
+			// Private
+			private:
+
+				// Value
+				atomic_int64_t value;
+		};
+
+		// Histogram class
+		class Histogram final : public Metric {
+
+			// Public
+			public:
+
+				// Constructor
+				Histogram(const char *name, const char *help);
+
+				// Record
+				void record(uint64_t value);
+
+				// Record duration
+				void recordDuration(chrono::steady_clock::duration duration);
+
+				// Encode
+				void encode(string &output) const override;
+
+			// Private
+			private:
+
+				// Get bucket index
+				static size_t getBucketIndex(uint64_t value);
+
+				// Get bucket upper bound
+				static uint64_t getBucketUpperBound(size_t index);
+
+				// Sub-bucket bits
+				static const int SUB_BUCKET_BITS;
+
+				// Number of sub-buckets
+				static const size_t NUMBER_OF_SUB_BUCKETS;
+
+				// Number of buckets
+				static const size_t NUMBER_OF_BUCKETS = 128;
+
+				// Buckets
+				atomic_uint64_t buckets[NUMBER_OF_BUCKETS];
+
+				// Count
+				atomic_uint64_t count;
+
+				// Sum
+				atomic_uint64_t sum;
+		};
+
+		// Encode
+		static string encode();
+
+		// Connected clients
+		static Gauge connectedClients;
+
+		// Sessions
+		static Gauge sessions;
+
+		// URLs
+		static Gauge urls;
+
+		// In-flight interactions
+		static Gauge inFlightInteractions;
+
+		// WebSocket bytes received
+		static Counter webSocketBytesReceived;
+
+		// WebSocket bytes sent
+		static Counter webSocketBytesSent;
+
+		// HTTP bytes received
+		static Counter httpBytesReceived;
+
+		// HTTP bytes sent
+		static Counter httpBytesSent;
+
+		// WebSocket frames parsed
+		static Counter webSocketFramesParsed;
+
+		// Compression input bytes
+		static Counter compressionInputBytes;
+
+		// Compression output bytes
+		static Counter compressionOutputBytes;
+
+		// Compression ratio
+		static Histogram compressionRatio;
+
+		// Compression connected saved bytes
+		static Gauge compressionConnectedSavedBytes;
+
+		// Compression largest connection saved bytes
+		static Gauge compressionLargestConnectionSavedBytes;
+
+		// Compression duration
+		static Histogram compressionDuration;
+
+		// Base64 encode duration
+		static Histogram base64EncodeDuration;
+
+		// Base64 decode duration
+		static Histogram base64DecodeDuration;
+
+		// JSON decode duration
+		static Histogram jsonDecodeDuration;
+
+		// Ping round trip time
+		static Histogram pingRoundTripTime;
+
+		// Interaction latency
+		static Histogram interactionLatency;
+
+		// Interaction queue duration
+		static Histogram interactionQueueDuration;
+
+		// Interaction flush duration
+		static Histogram interactionFlushDuration;
+
+		// Interaction responder duration
+		static Histogram interactionResponderDuration;
+
+		// Interaction decode duration
+		static Histogram interactionDecodeDuration;
+
+		// Interaction reply duration
+		static Histogram interactionReplyDuration;
+
+		// Interaction write duration
+		static Histogram interactionWriteDuration;
+
+		// Cache hits
+		static Counter cacheHits;
+
+		// Cache misses
+		static Counter cacheMisses;
+
+		// Cache size
+		static Gauge cacheSize;
+
+		// Cache maximum size
+		static Gauge cacheMaximumSize;
+
+		// Log records dropped
+		static Counter logRecordsDropped;
+
+		// Event loop lag
+		static Histogram eventLoopLag;
+
+		// WebSocket read callback duration
+		static Histogram webSocketReadCallbackDuration;
+
+		// Tor server request callback duration
+		static Histogram torServerRequestCallbackDuration;
+
+		// Ping callback duration
+		static Histogram pingCallbackDuration;
+
+		// Tor control callback duration
+		static Histogram torControlCallbackDuration;
+
+		// Slow callbacks
+		static Counter slowCallbacks;
+
+		// Memory connection input
+		static Gauge memoryConnectionInput;
+
+		// Memory connection output
+		static Gauge memoryConnectionOutput;
+
+		// Memory messages
+		static Gauge memoryMessages;
+
+		// Memory request bodies
+		static Gauge memoryRequestBodies;
+
+		// Memory codec
+		static Gauge memoryCodec;
+
+		// Memory URLs
+		static Gauge memoryUrls;
+
+		// Memory connection input peak
+		static Gauge memoryConnectionInputPeak;
+
+		// Memory connection output peak
+		static Gauge memoryConnectionOutputPeak;
+
+		// Memory messages peak
+		static Gauge memoryMessagesPeak;
+
+		// Memory request bodies peak
+		static Gauge memoryRequestBodiesPeak;
+
+		// Memory codec peak
+		static Gauge memoryCodecPeak;
+
+		// Memory URLs peak
+		static Gauge memoryUrlsPeak;
+
+		// Memory largest connection
+		static Gauge memoryLargestConnection;
+
+		// Memory budget
+		static Gauge memoryBudget;
+
+		// Memory budget rejections
+		static Counter memoryBudgetRejections;
+
+		// Check if using allocation profiler
+		#ifdef ALLOCATION_PROFILER
+
+			// WebSocket message allocations
+			static Histogram webSocketMessageAllocations;
+
+			// WebSocket message allocated bytes
+			static Histogram webSocketMessageAllocatedBytes;
+
+			// POST dispatch allocations
+			static Histogram postDispatchAllocations;
+
+			// POST dispatch allocated bytes
+			static Histogram postDispatchAllocatedBytes;
+
+			// Reply allocations
+			static Histogram replyAllocations;
+
+			// Reply allocated bytes
+			static Histogram replyAllocatedBytes;
+		#endif
+
+	// Private
+	private:
+
+		// Metrics
+		static const Metric *const METRICS[];
+};
+
+
+#endif
@@ -0,0 +1,121 @@
+// Header files
+#include <string>
+#include "logger.h"
+#include "monitor.h"
+#include "probes.h"
+
+using namespace std;
+
+
+// Constants
+
+// Callback names
+const char *Monitor::CALLBACK_NAMES[] = {
+
+	// WebSocket read
+	"websocket_read",
+
+	// Tor server request
+	"tor_server_request",
+
+	// Ping
+	"ping",
+
+	// Tor control
+	"tor_control"
+};
+
+// Callback histograms
+Metrics::Histogram *const Monitor::CALLBACK_HISTOGRAMS[] = {
+
+	// WebSocket read
+	&Metrics::webSocketReadCallbackDuration,
+
+	// Tor server request
+	&Metrics::torServerRequestCallbackDuration,
+
+	// Ping
+	&Metrics::pingCallbackDuration,
+
+	// Tor control
+	&Metrics::torControlCallbackDuration
+};
+
+
+// Global variables
+
+// Slow threshold
+chrono::steady_clock::duration Monitor::slowThreshold = chrono::milliseconds(50);
+
+
+// Supporting function implementation
+
+// Constructor
+Monitor::Monitor(Callback callback) :
+
+	// Set callback
+	callback(callback),
+
+	// Set payload size
+	payloadSize(0),
+
+	// Set start time
+	startTime(chrono::steady_clock::now())
+{
+}
+
+// Destructor
+Monitor::~Monitor() {
+
+	// Get callback's duration
+	const chrono::steady_clock::duration duration = chrono::steady_clock::now() - startTime;
+
+	// Update callback's duration metric
+	CALLBACK_HISTOGRAMS[static_cast<size_t>(callback)]->recordDuration(duration);
+
+	// Check if callback was slow
+	if(duration >= slowThreshold) {
+
+		// Update slow callbacks metric
+		Metrics::slowCallbacks.increment();
+
+		// Probe slow callback
+		const long long microseconds = chrono::duration_cast<chrono::microseconds>(duration).count();
+		PROBE(slow_callback, CALLBACK_NAMES[static_cast<size_t>(callback)], microseconds, payloadSize);
+
+		// Log slow callback
+		Logger::log(Logger::Level::WARNING, "Slow callback", Logger::NO_CONNECTION, string(CALLBACK_NAMES[static_cast<size_t>(callback)]) + " took " + to_string(microseconds) + " us with a payload size of " + to_string(payloadSize));
+	}
+}
+
+// Set payload size
+void Monitor::setPayloadSize(size_t payloadSize) {
+
+	// Set payload size
+	this->payloadSize = payloadSize;
+}
+
+// Set slow threshold
+void Monitor::setSlowThreshold(chrono::steady_clock::duration slowThreshold) {
+
+	// Set slow threshold
+	Monitor::slowThreshold = slowThreshold;
+}
+
+// Record lag
+void Monitor::recordLag(chrono::steady_clock::duration lag) {
+
+	// Update event loop lag metric
+	Metrics::eventLoopLag.recordDuration(lag);
+
+	// Check if lag is over the slow threshold
+	if(lag >= slowThreshold) {
+
+		// Probe event loop lagged
+		const long long microseconds = chrono::duration_cast<chrono::microseconds>(lag).count();
+		PROBE(event_loop_lagged, microseconds);
+
+		// Log event loop lagged
+		Logger::log(Logger::Level::WARNING, "Event loop lagged", Logger::NO_CONNECTION, to_string(microseconds) + " us");
+	}
+}
@@ -0,0 +1,85 @@
+// Header guard
+#ifndef MONITOR_H
+#define MONITOR_H
+
+
+// Header files
+#include <chrono>
+#include <cstddef>
+#include "metrics.h"
+
+using namespace std;
+
+
+// Classes
+
+// Monitor class
+class Monitor final {
+
+	// Public
+	public:
+
+		// Callback
+		enum class Callback {
+
+			// WebSocket read
+			WEBSOCKET_READ,
+
+			// Tor server request
+			TOR_SERVER_REQUEST,
+
+			// Ping
+			PING,
+
+			// Tor control
+			TOR_CONTROL,
+
+			// Number of callbacks
+			NUMBER_OF_CALLBACKS
+		};
+
+		// Constructor
+		explicit Monitor(Callback callback);
+
+		// Copy constructor
+		Monitor(const Monitor &other) = delete;
+
+		// Destructor
+		~Monitor();
+
+		// Copy assignment operator
+		Monitor &operator=(const Monitor &other) = delete;
+
+		// Set payload size
+		void setPayloadSize(size_t payloadSize);
+
+		// Set slow threshold
+		static void setSlowThreshold(chrono::steady_clock::duration slowThreshold);
+
+		// Record lag
+		static void recordLag(chrono::steady_clock::duration lag);
+
+	// Private
+	private:
+
+		// Callback names
+		static const char *CALLBACK_NAMES[];
+
+		// Callback histograms
+		static Metrics::Histogram *const CALLBACK_HISTOGRAMS[];
+
+		// Slow threshold
+		static chrono::steady_clock::duration slowThreshold;
+
+		// Callback
+		Callback callback;
+
+		// Payload size
+		size_t payloadSize;
+
+		// Start time
+		chrono::steady_clock::time_point startTime;
+};
+
+
+#endif
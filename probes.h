@@ -0,0 +1,28 @@
+// Header guard
+#ifndef PROBES_H
+#define PROBES_H
+
+
+// Header files
+#ifdef USDT_PROBES
+	#include <sys/sdt.h>
+#endif
+
+
+// Definitions
+
+// Check if using USDT probes
+#ifdef USDT_PROBES
+
+	// Probe (compiles to a single no-op instruction and an ELF note that tracers like bpftrace and perf can attach to)
+	#define PROBE(name, ...) STAP_PROBEV(websocket_listener, name, ##__VA_ARGS__)
+
+// Otherwise
+#else
+
+	// Probe (compiles to nothing and doesn't evaluate its arguments)
+	#define PROBE(name, ...) static_cast<void>(0)
+#endif
+
+
+#endif
@@ -0,0 +1,145 @@
+// Header files
+#include "profiler.h"
+
+// Check if using allocation profiler
+#ifdef ALLOCATION_PROFILER
+
+	// Header files
+	#include <cstdlib>
+	#include <new>
+
+	using namespace std;
+
+
+	// Constants
+
+	// Allocations histograms
+	Metrics::Histogram *const Profiler::ALLOCATIONS_HISTOGRAMS[] = {
+
+		// WebSocket message
+		&Metrics::webSocketMessageAllocations,
+
+		// POST dispatch
+		&Metrics::postDispatchAllocations,
+
+		// Reply
+		&Metrics::replyAllocations
+	};
+
+	// Bytes histograms
+	Metrics::Histogram *const Profiler::BYTES_HISTOGRAMS[] = {
+
+		// WebSocket message
+		&Metrics::webSocketMessageAllocatedBytes,
+
+		// POST dispatch
+		&Metrics::postDispatchAllocatedBytes,
+
+		// Reply
+		&Metrics::replyAllocatedBytes
+	};
+
+
+	// Global variables
+
+	// Scope current scope
+	thread_local Profiler::Scope *Profiler::Scope::currentScope = nullptr;
+
+
+	// Supporting function implementation
+
+	// Scope constructor
+	Profiler::Scope::Scope(Operation operation) :
+
+		// Set operation
+		operation(operation),
+
+		// Set number of allocations
+		numberOfAllocations(0),
+
+		// Set number of bytes
+		numberOfBytes(0),
+
+		// Set parent
+		parent(currentScope)
+	{
+
+		// Set current scope to this so that nested scopes' allocations aren't counted by their parent
+		currentScope = this;
+	}
+
+	// Scope destructor
+	Profiler::Scope::~Scope() {
+
+		// Restore parent as the current scope
+		currentScope = parent;
+
+		// Update operation's allocations and bytes metrics
+		ALLOCATIONS_HISTOGRAMS[static_cast<size_t>(operation)]->record(numberOfAllocations);
+		BYTES_HISTOGRAMS[static_cast<size_t>(operation)]->record(numberOfBytes);
+	}
+
+	// Scope record allocation
+	void Profiler::Scope::recordAllocation(size_t size) {
+
+		// Check if the thread is in a scope
+		if(currentScope) {
+
+			// Add allocation to the scope
+			++currentScope->numberOfAllocations;
+			currentScope->numberOfBytes += size;
+		}
+	}
+
+
+	// Allocation counting
+
+	// New operator
+	void *operator new(size_t size) {
+
+		// Record allocation
+		Profiler::Scope::recordAllocation(size);
+
+		// Check if allocating memory was successful
+		void *memory = malloc(size ? size : 1);
+		if(memory) {
+
+			// Return memory
+			return memory;
+		}
+
+		// Throw exception
+		throw bad_alloc();
+	}
+
+	// No throw new operator
+	void *operator new(size_t size, const nothrow_t &) noexcept {
+
+		// Record allocation
+		Profiler::Scope::recordAllocation(size);
+
+		// Return allocated memory
+		return malloc(size ? size : 1);
+	}
+
+	// Delete operator
+	void operator delete(void *memory) noexcept {
+
+		// Free memory
+		free(memory);
+	}
+
+	// Sized delete operator
+	void operator delete(void *memory, size_t size) noexcept {
+
+		// Free memory
+		free(memory);
+	}
+
+	// No throw delete operator
+	void operator delete(void *memory, const nothrow_t &) noexcept {
+
+		// Free memory
+		free(memory);
+	}
+#endif
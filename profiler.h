@@ -0,0 +1,112 @@
+// Header guard
+#ifndef PROFILER_H
+#define PROFILER_H
+
+
+// Header files
+#include <cstddef>
+#include <cstdint>
+#include "metrics.h"
+
+using namespace std;
+
+
+// Definitions
+
+// Check if using allocation profiler
+#ifdef ALLOCATION_PROFILER
+
+	// Profile allocations (attributes the heap allocations made by the current thread until the end of the enclosing block to the operation)
+	#define PROFILE_ALLOCATIONS(operation) const Profiler::Scope allocationProfilerScope(Profiler::Operation::operation)
+
+// Otherwise
+#else
+
+	// Profile allocations (compiles to nothing)
+	#define PROFILE_ALLOCATIONS(operation) static_cast<void>(0)
+#endif
+
+
+// Check if using allocation profiler
+#ifdef ALLOCATION_PROFILER
+
+	// Classes
+
+	// Profiler class
+	class Profiler final {
+
+		// Public
+		public:
+
+			// Constructor
+			Profiler() = delete;
+
+			// Operation
+			enum class Operation {
+
+				// WebSocket message
+				WEBSOCKET_MESSAGE,
+
+				// POST dispatch
+				POST_DISPATCH,
+
+				// Reply
+				REPLY,
+
+				// Number of operations
+				NUMBER_OF_OPERATIONS
+			};
+
+			// Scope class
+			class Scope final {
+
+				// Public
+				public:
+
+					// Constructor
+					explicit Scope(Operation operation);
+
+					// Copy constructor
+					Scope(const Scope &other) = delete;
+
+					// Destructor
+					~Scope();
+
+					// Copy assignment operator
+					Scope &operator=(const Scope &other) = delete;
+
+					// Record allocation
+					static void recordAllocation(size_t size);
+
+				// Private
+				private:
+
+					// Current scope
+					static thread_local Scope *currentScope;
+
+					// Operation
+					Operation operation;
+
+					// Number of allocations
+					uint64_t numberOfAllocations;
+
+					// Number of bytes
+					uint64_t numberOfBytes;
+
+					// Parent
+					Scope *parent;
+			};
+
+		// Private
+		private:
+
+			// Allocations histograms
+			static Metrics::Histogram *const ALLOCATIONS_HISTOGRAMS[];
+
+			// Bytes histograms
+			static Metrics::Histogram *const BYTES_HISTOGRAMS[];
+	};
+#endif
+
+
+#endif
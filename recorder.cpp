@@ -0,0 +1,504 @@
+// Header files
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include "recorder.h"
+
+// Check if not Windows
+#ifndef _WIN32
+
+	// Header files
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+using namespace std;
+
+
+// Constants
+
+// Magic
+const char Recorder::MAGIC[] = {'W', 'S', 'L', 'R', 'E', 'C', '0', '1'};
+
+// File header length
+const size_t Recorder::FILE_HEADER_LENGTH = sizeof(MAGIC) + sizeof(uint64_t);
+
+// Record header length
+const size_t Recorder::RECORD_HEADER_LENGTH = sizeof(uint64_t) + sizeof(uint64_t) + sizeof(uint8_t) + sizeof(uint8_t) + sizeof(uint16_t) + sizeof(uint32_t);
+
+// Initial capacity
+const size_t Recorder::INITIAL_CAPACITY = 16 * 1024 * 1024;
+
+// Metadata separator
+const char Recorder::METADATA_SEPARATOR = '\n';
+
+
+// Global variables
+
+// Mapping
+Recorder::Mapping Recorder::mapping;
+
+// Number of connection IDs
+uint64_t Recorder::numberOfConnectionIds = 0;
+
+
+// Supporting function implementation
+
+// Reader constructor
+Recorder::Reader::Reader(const char *path) :
+
+	// Set data
+	data(nullptr),
+
+	// Set mapped length
+	mappedLength(0),
+
+	// Set length
+	length(0),
+
+	// Set offset
+	offset(FILE_HEADER_LENGTH)
+{
+
+	// Check if Windows
+	#ifdef _WIN32
+
+		// Throw exception
+		throw runtime_error("Reading recordings isn't supported on Windows");
+
+	// Otherwise
+	#else
+
+		// Check if opening file failed
+		const int fileDescriptor = open(path, O_RDONLY);
+		if(fileDescriptor == -1) {
+
+			// Throw exception
+			throw runtime_error("Opening recording failed");
+		}
+
+		// Check if getting file's size failed or it's too small to be a recording
+		struct stat fileStatus;
+		if(fstat(fileDescriptor, &fileStatus) || static_cast<size_t>(fileStatus.st_size) < FILE_HEADER_LENGTH) {
+
+			// Close file
+			::close(fileDescriptor);
+
+			// Throw exception
+			throw runtime_error("Invalid recording");
+		}
+
+		// Check if mapping file failed
+		void *memory = mmap(nullptr, fileStatus.st_size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+		::close(fileDescriptor);
+		if(memory == MAP_FAILED) {
+
+			// Throw exception
+			throw runtime_error("Mapping recording failed");
+		}
+
+		// Set data, mapped length, and length
+		data = reinterpret_cast<uint8_t *>(memory);
+		mappedLength = fileStatus.st_size;
+		length = mappedLength;
+
+		// Check if file doesn't start with the magic
+		if(memcmp(data, MAGIC, sizeof(MAGIC))) {
+
+			// Unmap file
+			munmap(data, mappedLength);
+
+			// Throw exception
+			throw runtime_error("Invalid recording");
+		}
+
+		// Set length to the committed length since a recording that wasn't closed is longer than its records
+		uint64_t committedLength;
+		memcpy(&committedLength, &data[sizeof(MAGIC)], sizeof(committedLength));
+		length = FILE_HEADER_LENGTH + min(committedLength, static_cast<uint64_t>(length - FILE_HEADER_LENGTH));
+	#endif
+}
+
+// Reader destructor
+Recorder::Reader::~Reader() {
+
+	// Check if not Windows
+	#ifndef _WIN32
+
+		// Unmap file
+		munmap(data, mappedLength);
+	#endif
+}
+
+// Reader read
+bool Recorder::Reader::read(Record &record) {
+
+	// Check if a record header doesn't remain
+	if(length - offset < RECORD_HEADER_LENGTH) {
+
+		// Return false
+		return false;
+	}
+
+	// Get record's header
+	const uint8_t *header = &data[offset];
+	uint64_t time;
+	memcpy(&time, header, sizeof(time));
+	memcpy(&record.connectionId, &header[sizeof(uint64_t)], sizeof(record.connectionId));
+	const uint8_t type = header[sizeof(uint64_t) + sizeof(uint64_t)];
+	const uint8_t flags = header[sizeof(uint64_t) + sizeof(uint64_t) + sizeof(uint8_t)];
+	uint16_t metadataLength;
+	memcpy(&metadataLength, &header[sizeof(uint64_t) + sizeof(uint64_t) + sizeof(uint8_t) + sizeof(uint8_t)], sizeof(metadataLength));
+	uint32_t payloadLength;
+	memcpy(&payloadLength, &header[sizeof(uint64_t) + sizeof(uint64_t) + sizeof(uint8_t) + sizeof(uint8_t) + sizeof(uint16_t)], sizeof(payloadLength));
+
+	// Check if record is invalid or truncated
+	if(type >= static_cast<uint8_t>(Type::NUMBER_OF_TYPES) || length - offset - RECORD_HEADER_LENGTH < static_cast<size_t>(metadataLength) + payloadLength) {
+
+		// Return false
+		return false;
+	}
+
+	// Set record's values
+	record.type = static_cast<Type>(type);
+	record.time = chrono::nanoseconds(time);
+	record.compressed = flags;
+	record.metadata = string_view(reinterpret_cast<const char *>(&header[RECORD_HEADER_LENGTH]), metadataLength);
+	record.payload = string_view(reinterpret_cast<const char *>(&header[RECORD_HEADER_LENGTH + metadataLength]), payloadLength);
+
+	// Update offset to the next record
+	offset += RECORD_HEADER_LENGTH + metadataLength + payloadLength;
+
+	// Return true
+	return true;
+}
+
+// Reader rewind
+void Recorder::Reader::rewind() {
+
+	// Set offset to the first record
+	offset = FILE_HEADER_LENGTH;
+}
+
+// Open file
+bool Recorder::openFile(const char *path) {
+
+	// Check if Windows
+	#ifdef _WIN32
+
+		// Return false
+		return false;
+
+	// Otherwise
+	#else
+
+		// Check if opening file failed
+		mapping.fileDescriptor = open(path, O_RDWR | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+		if(mapping.fileDescriptor == -1) {
+
+			// Return false
+			return false;
+		}
+
+		// Check if reserving space for the file header failed
+		if(!reserve(FILE_HEADER_LENGTH)) {
+
+			// Close mapping
+			mapping.close();
+
+			// Return false
+			return false;
+		}
+
+		// Write file header
+		memcpy(mapping.data, MAGIC, sizeof(MAGIC));
+		memset(&mapping.data[sizeof(MAGIC)], 0, sizeof(uint64_t));
+		mapping.length = FILE_HEADER_LENGTH;
+
+		// Set start time
+		mapping.startTime = chrono::steady_clock::now();
+
+		// Return true
+		return true;
+	#endif
+}
+
+// Is recording
+bool Recorder::isRecording() {
+
+	// Return if mapping exists
+	return mapping.data;
+}
+
+// Get new connection ID
+uint64_t Recorder::getNewConnectionId() {
+
+	// Return incremented number of connection IDs
+	return ++numberOfConnectionIds;
+}
+
+// Record POST request
+void Recorder::recordPostRequest(const char *uri, const char *contentType, const char *acceptEncoding, evbuffer *body) {
+
+	// Check if not recording
+	if(!isRecording()) {
+
+		// Return
+		return;
+	}
+
+	// Get metadata
+	const string metadata = string(uri ? uri : "") + METADATA_SEPARATOR + (contentType ? contentType : "") + METADATA_SEPARATOR + (acceptEncoding ? acceptEncoding : "");
+
+	// Check if beginning record failed
+	const size_t bodyLength = evbuffer_get_length(body);
+	uint8_t *payload = beginRecord(Type::POST_REQUEST, 0, false, metadata, bodyLength);
+	if(!payload) {
+
+		// Return
+		return;
+	}
+
+	// Copy body into the record
+	evbuffer_copyout(body, payload, bodyLength);
+
+	// End record
+	endRecord(RECORD_HEADER_LENGTH + metadata.size() + bodyLength);
+}
+
+// Record client message
+void Recorder::recordClientMessage(uint64_t connectionId, bool compressed, const string_view &message) {
+
+	// Check if not recording
+	if(!isRecording()) {
+
+		// Return
+		return;
+	}
+
+	// Check if beginning record failed
+	uint8_t *payload = beginRecord(Type::CLIENT_MESSAGE, connectionId, compressed, string_view(), message.size());
+	if(!payload) {
+
+		// Return
+		return;
+	}
+
+	// Copy message into the record
+	memcpy(payload, message.data(), message.size());
+
+	// End record
+	endRecord(RECORD_HEADER_LENGTH + message.size());
+}
+
+// Record server message
+void Recorder::recordServerMessage(uint64_t connectionId, bool compressed, const string_view &message) {
+
+	// Check if not recording
+	if(!isRecording()) {
+
+		// Return
+		return;
+	}
+
+	// Check if beginning record failed
+	uint8_t *payload = beginRecord(Type::SERVER_MESSAGE, connectionId, compressed, string_view(), message.size());
+	if(!payload) {
+
+		// Return
+		return;
+	}
+
+	// Copy message into the record
+	memcpy(payload, message.data(), message.size());
+
+	// End record
+	endRecord(RECORD_HEADER_LENGTH + message.size());
+}
+
+// Get POST request field
+string_view Recorder::getPostRequestField(const Record &record, PostRequestField field) {
+
+	// Go through all fields before the field
+	string_view::size_type startOfField = 0;
+	for(size_t i = 0; i < static_cast<size_t>(field); ++i) {
+
+		// Check if metadata doesn't contain the next field
+		const string_view::size_type endOfField = record.metadata.find(METADATA_SEPARATOR, startOfField);
+		if(endOfField == string_view::npos) {
+
+			// Return nothing
+			return string_view();
+		}
+
+		// Set start of field to the next field
+		startOfField = endOfField + sizeof(METADATA_SEPARATOR);
+	}
+
+	// Return field
+	return record.metadata.substr(startOfField, record.metadata.find(METADATA_SEPARATOR, startOfField) - startOfField);
+}
+
+// Mapping constructor
+Recorder::Mapping::Mapping() :
+
+	// Set file descriptor
+	fileDescriptor(-1),
+
+	// Set data
+	data(nullptr),
+
+	// Set capacity
+	capacity(0),
+
+	// Set length
+	length(0)
+{
+}
+
+// Mapping destructor
+Recorder::Mapping::~Mapping() {
+
+	// Close
+	close();
+}
+
+// Mapping close
+void Recorder::Mapping::close() {
+
+	// Check if not Windows
+	#ifndef _WIN32
+
+		// Check if data exists
+		if(data) {
+
+			// Unmap data
+			munmap(data, capacity);
+			data = nullptr;
+		}
+
+		// Check if file is open
+		if(fileDescriptor != -1) {
+
+			// Check if truncating file to its records failed
+			if(ftruncate(fileDescriptor, length)) {
+
+				// Leave file's length since its header's committed length still marks the end of its records
+			}
+
+			// Close file
+			::close(fileDescriptor);
+			fileDescriptor = -1;
+		}
+	#endif
+}
+
+// Begin record
+uint8_t *Recorder::beginRecord(Type type, uint64_t connectionId, bool compressed, const string_view &metadata, size_t payloadLength) {
+
+	// Check if metadata or payload is too long to record or reserving space for the record failed
+	if(metadata.size() > UINT16_MAX || payloadLength > UINT32_MAX || !reserve(mapping.length + RECORD_HEADER_LENGTH + metadata.size() + payloadLength)) {
+
+		// Return null
+		return nullptr;
+	}
+
+	// Get record's values
+	const uint64_t time = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - mapping.startTime).count();
+	const uint8_t typeValue = static_cast<uint8_t>(type);
+	const uint8_t flags = compressed;
+	const uint16_t metadataLength = metadata.size();
+	const uint32_t recordPayloadLength = payloadLength;
+
+	// Write record's header and metadata
+	uint8_t *header = &mapping.data[mapping.length];
+	memcpy(header, &time, sizeof(time));
+	memcpy(&header[sizeof(uint64_t)], &connectionId, sizeof(connectionId));
+	header[sizeof(uint64_t) + sizeof(uint64_t)] = typeValue;
+	header[sizeof(uint64_t) + sizeof(uint64_t) + sizeof(uint8_t)] = flags;
+	memcpy(&header[sizeof(uint64_t) + sizeof(uint64_t) + sizeof(uint8_t) + sizeof(uint8_t)], &metadataLength, sizeof(metadataLength));
+	memcpy(&header[sizeof(uint64_t) + sizeof(uint64_t) + sizeof(uint8_t) + sizeof(uint8_t) + sizeof(uint16_t)], &recordPayloadLength, sizeof(recordPayloadLength));
+	memcpy(&header[RECORD_HEADER_LENGTH], metadata.data(), metadata.size());
+
+	// Return record's payload
+	return &header[RECORD_HEADER_LENGTH + metadata.size()];
+}
+
+// End record
+void Recorder::endRecord(size_t recordLength) {
+
+	// Update length
+	mapping.length += recordLength;
+
+	// Commit the record by updating the file header's length so that readers never see a partial record
+	const uint64_t committedLength = mapping.length - FILE_HEADER_LENGTH;
+	memcpy(&mapping.data[sizeof(MAGIC)], &committedLength, sizeof(committedLength));
+}
+
+// Reserve
+bool Recorder::reserve(size_t length) {
+
+	// Check if capacity is large enough
+	if(length <= mapping.capacity) {
+
+		// Return true
+		return true;
+	}
+
+	// Check if Windows
+	#ifdef _WIN32
+
+		// Return false
+		return false;
+
+	// Otherwise
+	#else
+
+		// Get new capacity by doubling the current capacity until the length fits
+		size_t newCapacity = max(mapping.capacity, INITIAL_CAPACITY);
+		while(newCapacity < length) {
+
+			// Double new capacity
+			newCapacity *= 2;
+		}
+
+		// Check if growing file failed
+		if(ftruncate(mapping.fileDescriptor, newCapacity)) {
+
+			// Stop recording
+			mapping.close();
+
+			// Return false
+			return false;
+		}
+
+		// Check if data exists
+		if(mapping.data) {
+
+			// Unmap data
+			munmap(mapping.data, mapping.capacity);
+			mapping.data = nullptr;
+		}
+
+		// Check if mapping file failed
+		void *memory = mmap(nullptr, newCapacity, PROT_READ | PROT_WRITE, MAP_SHARED, mapping.fileDescriptor, 0);
+		if(memory == MAP_FAILED) {
+
+			// Stop recording
+			mapping.close();
+
+			// Return false
+			return false;
+		}
+
+		// Set data and capacity
+		mapping.data = reinterpret_cast<uint8_t *>(memory);
+		mapping.capacity = newCapacity;
+
+		// Return true
+		return true;
+	#endif
+}
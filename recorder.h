@@ -0,0 +1,204 @@
+// Header guard
+#ifndef RECORDER_H
+#define RECORDER_H
+
+
+// Header files
+#include <chrono>
+#include <cstdint>
+#include <string_view>
+#include "event2/buffer.h"
+
+using namespace std;
+
+
+// Classes
+
+// Recorder class
+class Recorder final {
+
+	// Public
+	public:
+
+		// Constructor
+		Recorder() = delete;
+
+		// Type
+		enum class Type {
+
+			// POST request
+			POST_REQUEST,
+
+			// Client message
+			CLIENT_MESSAGE,
+
+			// Server message
+			SERVER_MESSAGE,
+
+			// Number of types
+			NUMBER_OF_TYPES
+		};
+
+		// POST request field
+		enum class PostRequestField {
+
+			// URI
+			URI,
+
+			// Content type
+			CONTENT_TYPE,
+
+			// Accept encoding
+			ACCEPT_ENCODING
+		};
+
+		// Record structure
+		struct Record {
+
+			// Type
+			Type type;
+
+			// Time since the recording started
+			chrono::nanoseconds time;
+
+			// Connection ID
+			uint64_t connectionId;
+
+			// Compressed
+			bool compressed;
+
+			// Metadata
+			string_view metadata;
+
+			// Payload
+			string_view payload;
+		};
+
+		// Reader class
+		class Reader final {
+
+			// Public
+			public:
+
+				// Constructor
+				explicit Reader(const char *path);
+
+				// Copy constructor
+				Reader(const Reader &other) = delete;
+
+				// Destructor
+				~Reader();
+
+				// Copy assignment operator
+				Reader &operator=(const Reader &other) = delete;
+
+				// Read
+				bool read(Record &record);
+
+				// Rewind
+				void rewind();
+
+			// Private
+			private:
+
+				// Data
+				uint8_t *data;
+
+				// Mapped length
+				size_t mappedLength;
+
+				// Length
+				size_t length;
+
+				// Offset
+				size_t offset;
+		};
+
+		// Open file
+		static bool openFile(const char *path);
+
+		// Is recording
+		static bool isRecording();
+
+		// Get new connection ID
+		static uint64_t getNewConnectionId();
+
+		// Record POST request
+		static void recordPostRequest(const char *uri, const char *contentType, const char *acceptEncoding, evbuffer *body);
+
+		// Record client message
+		static void recordClientMessage(uint64_t connectionId, bool compressed, const string_view &message);
+
+		// Record server message
+		static void recordServerMessage(uint64_t connectionId, bool compressed, const string_view &message);
+
+		// Get POST request field
+		static string_view getPostRequestField(const Record &record, PostRequestField field);
+
+	// Private
+	private:
+
+		// Mapping class
+		class Mapping final {
+
+			// Public
+			public:
+
+				// Constructor
+				Mapping();
+
+				// Destructor
+				~Mapping();
+
+				// Close
+				void close();
+
+				// File descriptor
+				int fileDescriptor;
+
+				// Data
+				uint8_t *data;
+
+				// Capacity
+				size_t capacity;
+
+				// Length
+				size_t length;
+
+				// Start time
+				chrono::steady_clock::time_point startTime;
+		};
+
+		// Begin record
+		static uint8_t *beginRecord(Type type, uint64_t connectionId, bool compressed, const string_view &metadata, size_t payloadLength);
+
+		// End record
+		static void endRecord(size_t recordLength);
+
+		// Reserve
+		static bool reserve(size_t length);
+
+		// Magic
+		static const char MAGIC[];
+
+		// File header length
+		static const size_t FILE_HEADER_LENGTH;
+
+		// Record header length
+		static const size_t RECORD_HEADER_LENGTH;
+
+		// Initial capacity
+		static const size_t INITIAL_CAPACITY;
+
+		// Metadata separator
+		static const char METADATA_SEPARATOR;
+
+		// Mapping
+		static Mapping mapping;
+
+		// Number of connection IDs
+		static uint64_t numberOfConnectionIds;
+};
+
+
+#endif
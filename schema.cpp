@@ -0,0 +1,529 @@
+// Header files
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include "schema.h"
+
+using namespace std;
+
+
+// Constants
+
+// Maximum depth
+const size_t Schema::MAXIMUM_DEPTH = sizeof(uint64_t) * 8;
+
+
+// Supporting function implementation
+
+bool Schema::parseValue(Integer &field, uint64_t maximum, const string_view &text, string_view::size_type &index) {
+
+	// Check if value isn't a number
+	if(text[index] != '-' && (text[index] < '0' || text[index] > '9')) {
+
+		// Set field's state to invalid
+		field.state = State::INVALID;
+
+		// Return skipping the value
+		return skipValue(text, index);
+	}
+
+	// Check if parsing number failed
+	Json::Number value;
+	if(!parseNumber(text, index, &value))
+
+		// Return false
+		return false;
+
+	// Check if value is a non-negative integer that isn't greater than the maximum
+	Json::Number integerComponent;
+	if(value >= 0 && value <= maximum && modf(value, &integerComponent) == 0) {
+
+		// Set field's value
+		field.value = value;
+
+		// Set field's state to valid
+		field.state = State::VALID;
+	}
+
+	// Otherwise
+	else
+
+		// Set field's state to invalid
+		field.state = State::INVALID;
+
+	// Return true
+	return true;
+}
+
+bool Schema::parseValue(String &field, uint64_t maximum, const string_view &text, string_view::size_type &index) {
+
+	// Check if value isn't a string
+	if(text[index] != '"') {
+
+		// Set field's state to invalid
+		field.state = State::INVALID;
+
+		// Return skipping the value
+		return skipValue(text, index);
+	}
+
+	// Check if parsing string failed
+	if(!parseString(text, index, field.value, field.escaped))
+
+		// Return false
+		return false;
+
+	// Check if value contains escape sequences
+	if(field.escaped) {
+
+		// Try
+		try {
+
+			// Unescape value into the field's unescaped value
+			Json::unescape(field.value, field.unescapedValue);
+		}
+
+		// Catch errors
+		catch(...) {
+
+			// Return false
+			return false;
+		}
+	}
+
+	// Set field's state to valid
+	field.state = State::VALID;
+
+	// Return true
+	return true;
+}
+
+bool Schema::parseString(const string_view &text, string_view::size_type &index, string_view &value, bool &escaped) {
+
+	// Skip start of string
+	const string_view::size_type start = index + sizeof('"');
+
+	// Clear escaped
+	escaped = false;
+
+	// Go through all characters in the string
+	for(string_view::size_type i = start; i < text.length();) {
+
+		// Get next quote or backslash
+		while(i < text.length() && text[i] != '"' && text[i] != '\\')
+
+			// Increment index
+			++i;
+
+		// Check if at the end of the text
+		if(i == text.length())
+
+			// Break
+			break;
+
+		// Check if at the end of the string
+		if(text[i] == '"') {
+
+			// Set value
+			value = text.substr(start, i - start);
+
+			// Set index to after the string
+			index = i + sizeof('"');
+
+			// Return true
+			return true;
+		}
+
+		// Set escaped
+		escaped = true;
+
+		// Check if escape sequence is at the end of the text
+		if(++i == text.length())
+
+			// Break
+			break;
+
+		// Check if escaped character isn't an escaped code point
+		if(text[i] != 'u') {
+
+			// Check if escaped character isn't ASCII
+			if(static_cast<uint8_t>(text[i]) > 0x7F)
+
+				// Return false
+				return false;
+
+			// Increment index
+			++i;
+
+			// Continue
+			continue;
+		}
+
+		// Go through both potential surrogate pair values
+		for(uint8_t j = 0; j < 2; ++j) {
+
+			// Check if the escaped code point has an invalid length
+			if(text.length() - (i + sizeof('u')) < sizeof("FFFF") - 1)
+
+				// Return false
+				return false;
+
+			// Go through all characters in the escaped code point
+			char16_t utf16Character = 0;
+			for(string_view::size_type k = i + sizeof('u'); k < i + sizeof('u') + sizeof("FFFF") - 1; ++k) {
+
+				// Check if character isn't a hexadecimal character
+				if(!isxdigit(text[k]))
+
+					// Return false
+					return false;
+
+				// Include character in the UTF-16 code point
+				utf16Character = (utf16Character << 4) | (isdigit(text[k]) ? text[k] - '0' : tolower(text[k]) - 'a' + 10);
+			}
+
+			// Increment index
+			i += sizeof('u') + sizeof("FFFF") - 1;
+
+			// Check if UTF-16 code point is a single unpaired low surrogate or the previous code point was an unpaired high surrogate
+			if((j == 0 && utf16Character >= Unicode::UTF16_LOW_SURROGATE_RANGE_BEGIN && utf16Character <= Unicode::UTF16_LOW_SURROGATE_RANGE_END) || (j == 1 && (utf16Character < Unicode::UTF16_LOW_SURROGATE_RANGE_BEGIN || utf16Character > Unicode::UTF16_LOW_SURROGATE_RANGE_END)))
+
+				// Return false
+				return false;
+
+			// Check if UTF-16 code point isn't a high surrogate
+			if(j == 1 || utf16Character < Unicode::UTF16_HIGH_SURROGATE_RANGE_BEGIN || utf16Character > Unicode::UTF16_HIGH_SURROGATE_RANGE_END)
+
+				// Break
+				break;
+
+			// Check if high surrogate isn't followed by another escaped code point
+			if(text.length() - i < sizeof("\\u") - 1 || text[i] != '\\' || text[i + 1] != 'u')
+
+				// Return false
+				return false;
+
+			// Increment index
+			i += sizeof('\\');
+		}
+	}
+
+	// Return false
+	return false;
+}
+
+bool Schema::parseNumber(const string_view &text, string_view::size_type &index, Json::Number *value) {
+
+	// Initialize end of number
+	string_view::size_type end = index;
+
+	// Check if number is negative
+	if(end < text.length() && text[end] == '-')
+
+		// Increment end of number
+		++end;
+
+	// Check if number doesn't have an integer component
+	if(end == text.length() || text[end] < '0' || text[end] > '9')
+
+		// Return false
+		return false;
+
+	// Check if integer component is zero
+	if(text[end] == '0')
+
+		// Increment end of number
+		++end;
+
+	// Otherwise
+	else {
+
+		// Go through all digits in the integer component
+		while(end < text.length() && text[end] >= '0' && text[end] <= '9')
+
+			// Increment end of number
+			++end;
+	}
+
+	// Check if number has a fraction component
+	if(end < text.length() && text[end] == '.') {
+
+		// Check if fraction component doesn't have any digits
+		if(++end == text.length() || text[end] < '0' || text[end] > '9')
+
+			// Return false
+			return false;
+
+		// Go through all digits in the fraction component
+		while(end < text.length() && text[end] >= '0' && text[end] <= '9')
+
+			// Increment end of number
+			++end;
+	}
+
+	// Check if number has an exponent component
+	if(end < text.length() && (text[end] == 'e' || text[end] == 'E')) {
+
+		// Check if exponent component has a sign
+		if(++end < text.length() && (text[end] == '+' || text[end] == '-'))
+
+			// Increment end of number
+			++end;
+
+		// Check if exponent component doesn't have any digits
+		if(end == text.length() || text[end] < '0' || text[end] > '9')
+
+			// Return false
+			return false;
+
+		// Go through all digits in the exponent component
+		while(end < text.length() && text[end] >= '0' && text[end] <= '9')
+
+			// Increment end of number
+			++end;
+	}
+
+	// Check if getting number's value
+	if(value) {
+
+		// Check if converting number failed
+		char *endOfNumber;
+		*value = strtold(text.data() + index, &endOfNumber);
+		if(endOfNumber != text.data() + end)
+
+			// Return false
+			return false;
+	}
+
+	// Set index to after the number
+	index = end;
+
+	// Return true
+	return true;
+}
+
+bool Schema::skipValue(const string_view &text, string_view::size_type &index) {
+
+	// Initialize containers with each bit set if the container at that depth is an object
+	uint64_t containers = 0;
+	size_t depth = 0;
+
+	// Loop through all values
+	while(true) {
+
+		// Check if at the end of the text
+		index = skipWhitespace(text, index);
+		if(index == text.length())
+
+			// Return false
+			return false;
+
+		// Check value's first character
+		switch(text[index]) {
+
+			// Start of object or array
+			case '{':
+			case '[':
+
+				// Check if at the maximum depth
+				if(depth == MAXIMUM_DEPTH)
+
+					// Return false
+					return false;
+
+				// Include container in the containers
+				containers = (containers << 1) | (text[index] == '{');
+				++depth;
+
+				// Check if container is empty
+				index = skipWhitespace(text, index + sizeof('{'));
+				if(index < text.length() && text[index] == ((containers & 1) ? '}' : ']')) {
+
+					// Remove container from the containers
+					containers >>= 1;
+					--depth;
+
+					// Skip end of container
+					++index;
+
+					// Break
+					break;
+				}
+
+				// Check if container is an object
+				if(containers & 1) {
+
+					// Check if object's key isn't a string
+					string_view key;
+					bool escaped;
+					if(index == text.length() || text[index] != '"' || !parseString(text, index, key, escaped))
+
+						// Return false
+						return false;
+
+					// Check if key isn't followed by a name separator
+					index = skipWhitespace(text, index);
+					if(index == text.length() || text[index] != ':')
+
+						// Return false
+						return false;
+
+					// Skip name separator
+					++index;
+				}
+
+				// Continue
+				continue;
+
+			// String
+			case '"':
+
+				{
+					// Check if parsing string failed
+					string_view value;
+					bool escaped;
+					if(!parseString(text, index, value, escaped))
+
+						// Return false
+						return false;
+				}
+
+				// Break
+				break;
+
+			// True
+			case 't':
+
+				// Check if value isn't true
+				if(text.compare(index, sizeof("true") - 1, "true"))
+
+					// Return false
+					return false;
+
+				// Skip value
+				index += sizeof("true") - 1;
+
+				// Break
+				break;
+
+			// False
+			case 'f':
+
+				// Check if value isn't false
+				if(text.compare(index, sizeof("false") - 1, "false"))
+
+					// Return false
+					return false;
+
+				// Skip value
+				index += sizeof("false") - 1;
+
+				// Break
+				break;
+
+			// Null
+			case 'n':
+
+				// Check if value isn't null
+				if(text.compare(index, sizeof("null") - 1, "null"))
+
+					// Return false
+					return false;
+
+				// Skip value
+				index += sizeof("null") - 1;
+
+				// Break
+				break;
+
+			// Default
+			default:
+
+				// Check if parsing number failed
+				if(!parseNumber(text, index, nullptr))
+
+					// Return false
+					return false;
+
+				// Break
+				break;
+		}
+
+		// Loop while inside a container
+		while(depth) {
+
+			// Check if at the end of the text
+			index = skipWhitespace(text, index);
+			if(index == text.length())
+
+				// Return false
+				return false;
+
+			// Check if at the end of the container
+			if(text[index] == ((containers & 1) ? '}' : ']')) {
+
+				// Remove container from the containers
+				containers >>= 1;
+				--depth;
+
+				// Skip end of container
+				++index;
+
+				// Continue
+				continue;
+			}
+
+			// Check if value isn't followed by a value separator
+			if(text[index] != ',')
+
+				// Return false
+				return false;
+
+			// Skip value separator
+			index = skipWhitespace(text, index + sizeof(','));
+
+			// Check if container is an object
+			if(containers & 1) {
+
+				// Check if object's key isn't a string
+				string_view key;
+				bool escaped;
+				if(index == text.length() || text[index] != '"' || !parseString(text, index, key, escaped))
+
+					// Return false
+					return false;
+
+				// Check if key isn't followed by a name separator
+				index = skipWhitespace(text, index);
+				if(index == text.length() || text[index] != ':')
+
+					// Return false
+					return false;
+
+				// Skip name separator
+				++index;
+			}
+
+			// Break
+			break;
+		}
+
+		// Check if not inside a container
+		if(!depth)
+
+			// Return true
+			return true;
+	}
+}
+
+string_view::size_type Schema::skipWhitespace(const string_view &text, string_view::size_type index) {
+
+	// Go through all whitespace characters
+	while(index < text.length() && (text[index] == ' ' || text[index] == '\t' || text[index] == '\n' || text[index] == '\r'))
+
+		// Increment index
+		++index;
+
+	// Return index
+	return index;
+}
@@ -0,0 +1,426 @@
+// Header guard
+#ifndef SCHEMA_H
+#define SCHEMA_H
+
+
+// Header files
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include "json.h"
+#include "unicode.h"
+
+using namespace std;
+
+
+// Classes
+
+// Schema class
+class Schema final {
+
+	// Public
+	public:
+
+		// Constructor
+		Schema() = delete;
+
+		// State
+		enum class State {
+			MISSING,
+			INVALID,
+			VALID
+		};
+
+		// Integer class
+		class Integer final {
+
+			// Public
+			public:
+
+				// State
+				State state = State::MISSING;
+
+				// Value
+				Json::Number value = 0;
+		};
+
+		// String class
+		class String final {
+
+			// Public
+			public:
+
+				// Get value
+				string_view getValue() const {
+
+					// Return unescaped value if value contained escape sequences otherwise the value
+					return escaped ? string_view(unescapedValue) : value;
+				}
+
+				// State
+				State state = State::MISSING;
+
+				// Value
+				string_view value;
+
+				// Escaped
+				bool escaped = false;
+
+				// Unescaped value
+				string unescapedValue;
+		};
+
+		// Field class
+		template<typename Message, typename Type> class Field final {
+
+			// Public
+			public:
+
+				// Constructor
+				constexpr Field(const string_view &name, Type Message::*member, uint64_t maximum = 0) :
+
+					// Set name
+					name(name),
+
+					// Set member
+					member(member),
+
+					// Set maximum
+					maximum(maximum)
+				{
+				}
+
+				// Name
+				const string_view name;
+
+				// Member
+				Type Message::*const member;
+
+				// Maximum
+				const uint64_t maximum;
+		};
+
+		// Perfect hash class
+		template<size_t numberOfKeys> class PerfectHash final {
+
+			// Public
+			public:
+
+				// Constructor
+				constexpr PerfectHash(const array<string_view, numberOfKeys> &keys) :
+
+					// Set keys
+					keys(keys),
+
+					// Set seed
+					seed(0),
+
+					// Set table
+					table()
+				{
+
+					// Loop until a seed that maps every key to a different slot is found
+					for(;; ++seed) {
+
+						// Go through all slots
+						for(size_t i = 0; i < TABLE_SIZE; ++i) {
+
+							// Clear slot
+							table[i] = numberOfKeys;
+						}
+
+						// Initialize collision
+						bool collision = false;
+
+						// Go through all keys or until a collision occurs
+						for(size_t i = 0; i < numberOfKeys && !collision; ++i) {
+
+							// Get key's slot
+							size_t &slot = table[hash(keys[i], seed) & (TABLE_SIZE - 1)];
+
+							// Set collision if slot is already used otherwise set slot to the key's index
+							collision = slot != numberOfKeys;
+							slot = collision ? slot : i;
+						}
+
+						// Check if no collision occurred
+						if(!collision) {
+
+							// Break
+							break;
+						}
+					}
+				}
+
+				// Find
+				constexpr size_t find(const string_view &key) const {
+
+					// Get index at the key's slot
+					const size_t index = table[hash(key, seed) & (TABLE_SIZE - 1)];
+
+					// Return index if it's the key otherwise the number of keys
+					return (index != numberOfKeys && keys[index] == key) ? index : numberOfKeys;
+				}
+
+			// Private
+			private:
+
+				// Hash
+				static constexpr uint32_t hash(const string_view &key, uint32_t seed) {
+
+					// Initialize result
+					uint32_t result = FNV_OFFSET_BASIS ^ (seed * FNV_PRIME);
+
+					// Go through all characters in the key
+					for(const char character : key) {
+
+						// Include character in the result
+						result = (result ^ static_cast<uint8_t>(character)) * FNV_PRIME;
+					}
+
+					// Return result with its high bits mixed into its low bits
+					return result ^ (result >> 16);
+				}
+
+				// Get table size
+				static constexpr size_t getTableSize() {
+
+					// Initialize table size
+					size_t tableSize = 1;
+
+					// Loop while the table size isn't at least twice the number of keys
+					while(tableSize < numberOfKeys * 2) {
+
+						// Double table size
+						tableSize *= 2;
+					}
+
+					// Return table size
+					return tableSize;
+				}
+
+				// FNV offset basis
+				static constexpr uint32_t FNV_OFFSET_BASIS = 0x811C9DC5;
+
+				// FNV prime
+				static constexpr uint32_t FNV_PRIME = 0x01000193;
+
+				// Table size
+				static constexpr size_t TABLE_SIZE = getTableSize();
+
+				// Keys
+				array<string_view, numberOfKeys> keys;
+
+				// Seed
+				uint32_t seed;
+
+				// Table
+				array<size_t, TABLE_SIZE> table;
+		};
+
+		// Decoder class
+		template<typename... Fields> class Decoder final {
+
+			// Public
+			public:
+
+				// Constructor
+				constexpr Decoder(const Fields &... fields) :
+
+					// Set fields
+					fields(fields...),
+
+					// Set names
+					names(array<string_view, sizeof...(Fields)>{fields.name...})
+				{
+				}
+
+				// Decode
+				template<typename... Messages> bool decode(const string &text, Messages &... messages) const {
+
+					// Check if text isn't a valid UTF-8 string
+					if(!Unicode::isValidUtf8(text)) {
+
+						// Reset messages
+						((messages = Messages()), ...);
+
+						// Return false
+						return false;
+					}
+
+					// Return decoding valid UTF-8 text
+					return decodeValidUtf8(text, messages...);
+				}
+
+				// Decode valid UTF-8
+				template<typename... Messages> bool decodeValidUtf8(const string_view &text, Messages &... messages) const {
+
+					// Reset messages
+					((messages = Messages()), ...);
+
+					// Get messages
+					tuple<Messages &...> messagesTuple(messages...);
+
+					// Check if text doesn't start with an object
+					string_view::size_type index = skipWhitespace(text, 0);
+					if(index == text.length() || text[index] != '{') {
+
+						// Return false
+						return false;
+					}
+
+					// Skip start of object
+					index = skipWhitespace(text, index + sizeof('{'));
+
+					// Check if object isn't empty
+					if(index == text.length() || text[index] != '}') {
+
+						// Loop through all of the object's members
+						while(true) {
+
+							// Check if parsing key failed
+							string_view key;
+							bool keyEscaped;
+							if(index == text.length() || text[index] != '"' || !parseString(text, index, key, keyEscaped)) {
+
+								// Return false
+								return false;
+							}
+
+							// Check if key contains escape sequences
+							string unescapedKey;
+							if(keyEscaped) {
+
+								// Try
+								try {
+
+									// Unescape key
+									key = Json::unescape(key, unescapedKey);
+								}
+
+								// Catch errors
+								catch(...) {
+
+									// Return false
+									return false;
+								}
+							}
+
+							// Check if key isn't followed by a name separator
+							index = skipWhitespace(text, index);
+							if(index == text.length() || text[index] != ':') {
+
+								// Return false
+								return false;
+							}
+
+							// Skip name separator
+							index = skipWhitespace(text, index + sizeof(':'));
+
+							// Check if parsing value into its field or skipping value if it's an unknown field failed
+							if(!parseField<0>(names.find(key), text, index, messagesTuple)) {
+
+								// Return false
+								return false;
+							}
+
+							// Check if at the end of the text
+							index = skipWhitespace(text, index);
+							if(index == text.length()) {
+
+								// Return false
+								return false;
+							}
+
+							// Check if at the end of the object
+							if(text[index] == '}') {
+
+								// Break
+								break;
+							}
+
+							// Check if value isn't followed by a value separator
+							if(text[index] != ',') {
+
+								// Return false
+								return false;
+							}
+
+							// Skip value separator
+							index = skipWhitespace(text, index + sizeof(','));
+						}
+					}
+
+					// Return if nothing follows the object
+					return skipWhitespace(text, index + sizeof('}')) == text.length();
+				}
+
+			// Private
+			private:
+
+				// Parse field
+				template<size_t fieldIndex, typename... Messages> bool parseField(size_t index, const string_view &text, string_view::size_type &textIndex, tuple<Messages &...> &messages) const {
+
+					// Check if field exists
+					if constexpr(fieldIndex < sizeof...(Fields)) {
+
+						// Check if index is for this field
+						if(index == fieldIndex) {
+
+							// Get field
+							const auto &field = get<fieldIndex>(fields);
+
+							// Return parsing value into the field's member
+							return parseValue(get<typename remove_reference<decltype(getMessage(field))>::type &>(messages).*(field.member), field.maximum, text, textIndex);
+						}
+
+						// Return parsing the next field
+						return parseField<fieldIndex + 1>(index, text, textIndex, messages);
+					}
+
+					// Otherwise
+					else {
+
+						// Return skipping the value since it's an unknown field
+						return skipValue(text, textIndex);
+					}
+				}
+
+				// Get message
+				template<typename Message, typename Type> static Message &getMessage(const Field<Message, Type> &field);
+
+				// Fields
+				tuple<Fields...> fields;
+
+				// Names
+				PerfectHash<sizeof...(Fields)> names;
+		};
+
+	// Private
+	private:
+
+		// Parse value
+		static bool parseValue(Integer &field, uint64_t maximum, const string_view &text, string_view::size_type &index);
+		static bool parseValue(String &field, uint64_t maximum, const string_view &text, string_view::size_type &index);
+
+		// Parse string
+		static bool parseString(const string_view &text, string_view::size_type &index, string_view &value, bool &escaped);
+
+		// Parse number
+		static bool parseNumber(const string_view &text, string_view::size_type &index, Json::Number *value);
+
+		// Skip value
+		static bool skipValue(const string_view &text, string_view::size_type &index);
+
+		// Skip whitespace
+		static string_view::size_type skipWhitespace(const string_view &text, string_view::size_type index);
+
+		// Maximum depth
+		static const size_t MAXIMUM_DEPTH;
+};
+
+
+#endif
@@ -0,0 +1,390 @@
+// Header files
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+#include "common.h"
+#include "unicode.h"
+
+// Check if x86-64
+#if defined __x86_64__ || defined _M_X64
+
+	// Header files
+	#include <immintrin.h>
+#endif
+
+using namespace std;
+
+
+// Constants
+
+// Maximum sequence length
+static const size_t MAXIMUM_SEQUENCE_LENGTH = 4;
+
+// AVX2 text length
+static const size_t AVX2_TEXT_LENGTH = 64;
+
+// AVX2 block boundary offset index
+static const size_t AVX2_BLOCK_BOUNDARY_OFFSET_INDEX = 1;
+
+// Maximum number of displayed failures
+static const uint64_t MAXIMUM_NUMBER_OF_DISPLAYED_FAILURES = 10;
+
+
+// Classes
+
+// Match
+enum class Match {
+
+	// Accepted
+	ACCEPTED,
+
+	// Incomplete
+	INCOMPLETE,
+
+	// Rejected
+	REJECTED
+};
+
+// Unicode test class
+class UnicodeTest final {
+
+	// Public
+	public:
+
+		// Constructor
+		UnicodeTest() = delete;
+
+		// Check sequences
+		static void checkSequences(size_t length, unsigned int firstThread, unsigned int numberOfThreads);
+
+		// Get number of failures
+		static uint64_t getNumberOfFailures();
+
+	// Private
+	private:
+
+		// Record failure
+		static void recordFailure(const char *validator, const uint8_t *sequence, size_t length, size_t offset);
+
+		// Number of failures
+		static atomic_uint64_t numberOfFailures;
+
+		// Display lock
+		static mutex displayLock;
+};
+
+
+// Global variables
+
+// Unicode test number of failures
+atomic_uint64_t UnicodeTest::numberOfFailures(0);
+
+// Unicode test display lock
+mutex UnicodeTest::displayLock;
+
+
+// Function prototypes
+
+// Match UTF-8 language
+static Match matchUtf8Language(const uint8_t *text, size_t length);
+
+
+// Main function
+int main() {
+
+	// Display message
+	cout << TOSTRING(PROGRAM_NAME) << " Test v" << TOSTRING(PROGRAM_VERSION) << endl;
+
+	// Check if AVX2 isn't supported
+	if(!Common::isAvx2Supported()) {
+
+		// Display message
+		cout << "AVX2 isn't supported so its UTF-8 validator won't be tested" << endl;
+	}
+
+	// Get number of threads
+	const unsigned int numberOfThreads = max(thread::hardware_concurrency(), 1U);
+
+	// Go through all sequence lengths
+	for(size_t length = 1; length <= MAXIMUM_SEQUENCE_LENGTH; ++length) {
+
+		// Go through all threads
+		vector<thread> threads;
+		for(unsigned int i = 0; i < numberOfThreads; ++i) {
+
+			// Check the thread's share of sequences of the length
+			threads.emplace_back(UnicodeTest::checkSequences, length, i, numberOfThreads);
+		}
+
+		// Go through all threads
+		for(thread &thread : threads) {
+
+			// Wait for thread to finish
+			thread.join();
+		}
+
+		// Display message
+		cout << "Checked all " << length << " byte sequences" << endl;
+	}
+
+	// Check if any checks failed
+	if(UnicodeTest::getNumberOfFailures()) {
+
+		// Display message
+		cout << UnicodeTest::getNumberOfFailures() << " checks failed" << endl;
+
+		// Return failure
+		return EXIT_FAILURE;
+	}
+
+	// Display message
+	cout << "All checks passed" << endl;
+
+	// Return success
+	return EXIT_SUCCESS;
+}
+
+
+// Supporting function implementation
+
+// Match UTF-8 language (printable ASCII, tab, newline, carriage return, and the well-formed byte sequences from table 3-7 of the Unicode standard)
+Match matchUtf8Language(const uint8_t *text, size_t length) {
+
+	// Go through all characters in the text
+	for(size_t i = 0; i < length;) {
+
+		// Check if character is printable ASCII, tab, newline, or carriage return
+		const uint8_t byte = text[i];
+		if((byte >= ' ' && byte <= '~') || byte == '\t' || byte == '\n' || byte == '\r') {
+
+			// Go to next character
+			++i;
+
+			// Continue
+			continue;
+		}
+
+		// Check if character is C2-DF 80-BF
+		size_t characterLength;
+		uint8_t secondByteMinimum = 0x80;
+		uint8_t secondByteMaximum = 0xBF;
+		if(byte >= 0xC2 && byte <= 0xDF) {
+
+			// Set character length
+			characterLength = 2;
+		}
+
+		// Otherwise check if character is E0 A0-BF 80-BF
+		else if(byte == 0xE0) {
+
+			// Set character length and second byte's minimum
+			characterLength = 3;
+			secondByteMinimum = 0xA0;
+		}
+
+		// Otherwise check if character is E1-EC 80-BF 80-BF or EE-EF 80-BF 80-BF
+		else if((byte >= 0xE1 && byte <= 0xEC) || byte == 0xEE || byte == 0xEF) {
+
+			// Set character length
+			characterLength = 3;
+		}
+
+		// Otherwise check if character is ED 80-9F 80-BF
+		else if(byte == 0xED) {
+
+			// Set character length and second byte's maximum
+			characterLength = 3;
+			secondByteMaximum = 0x9F;
+		}
+
+		// Otherwise check if character is F0 90-BF 80-BF 80-BF
+		else if(byte == 0xF0) {
+
+			// Set character length and second byte's minimum
+			characterLength = 4;
+			secondByteMinimum = 0x90;
+		}
+
+		// Otherwise check if character is F1-F3 80-BF 80-BF 80-BF
+		else if(byte >= 0xF1 && byte <= 0xF3) {
+
+			// Set character length
+			characterLength = 4;
+		}
+
+		// Otherwise check if character is F4 80-8F 80-BF 80-BF
+		else if(byte == 0xF4) {
+
+			// Set character length and second byte's maximum
+			characterLength = 4;
+			secondByteMaximum = 0x8F;
+		}
+
+		// Otherwise
+		else {
+
+			// Return rejected
+			return Match::REJECTED;
+		}
+
+		// Go through all of the character's continuation bytes
+		for(size_t j = 1; j < characterLength; ++j) {
+
+			// Check if text ends before the continuation byte
+			if(i + j == length) {
+
+				// Return incomplete
+				return Match::INCOMPLETE;
+			}
+
+			// Check if continuation byte is outside of its range
+			if(text[i + j] < ((j == 1) ? secondByteMinimum : 0x80) || text[i + j] > ((j == 1) ? secondByteMaximum : 0xBF)) {
+
+				// Return rejected
+				return Match::REJECTED;
+			}
+		}
+
+		// Go to next character
+		i += characterLength;
+	}
+
+	// Return accepted
+	return Match::ACCEPTED;
+}
+
+// Unicode test check sequences
+void UnicodeTest::checkSequences(size_t length, unsigned int firstThread, unsigned int numberOfThreads) {
+
+	// Get AVX2 offsets at the start of the text, across the first block boundary, and at the end of the text
+	#if defined __x86_64__ || defined _M_X64
+		const size_t avx2Offsets[] = {0, sizeof(__m256i) - 2, AVX2_TEXT_LENGTH - length};
+	#endif
+
+	// Go through the thread's share of the sequences' prefixes (all but their last byte)
+	const uint32_t numberOfPrefixes = UINT32_C(1) << (8 * (length - 1));
+	for(uint32_t prefix = firstThread; prefix < numberOfPrefixes; prefix += numberOfThreads) {
+
+		// Go through all bytes in the prefix
+		uint8_t sequence[MAXIMUM_SEQUENCE_LENGTH];
+		const char *text = reinterpret_cast<const char *>(sequence);
+		Unicode::Utf8Validator prefixValidator;
+		for(size_t i = 0; i < length - 1; ++i) {
+
+			// Set byte in the sequence
+			sequence[i] = prefix >> (8 * (length - 2 - i));
+
+			// Update prefix validator one byte at a time (its results for the prefix were checked with the shorter sequences)
+			prefixValidator.update(&text[i], 1);
+		}
+
+		// Check if x86-64
+		#if defined __x86_64__ || defined _M_X64
+
+			// Go through all AVX2 offsets
+			char avx2Texts[size(avx2Offsets)][AVX2_TEXT_LENGTH];
+			for(size_t i = 0; i < size(avx2Offsets); ++i) {
+
+				// Surround prefix with printable ASCII
+				memset(avx2Texts[i], 'a', sizeof(avx2Texts[i]));
+				memcpy(&avx2Texts[i][avx2Offsets[i]], sequence, length - 1);
+			}
+		#endif
+
+		// Go through all last bytes
+		for(unsigned int lastByte = 0; lastByte <= UINT8_MAX; ++lastByte) {
+
+			// Set last byte in the sequence
+			sequence[length - 1] = lastByte;
+
+			// Get expected match
+			const Match match = matchUtf8Language(sequence, length);
+
+			// Check if DFA's result is wrong (sequences shorter than an AVX2 block are only checked by the DFA)
+			if(Unicode::isValidUtf8(text, length) != (match == Match::ACCEPTED)) {
+
+				// Record failure
+				recordFailure("DFA", sequence, length, 0);
+			}
+
+			// Check if streaming validator's result after the last byte or its completeness is wrong
+			Unicode::Utf8Validator validator = prefixValidator;
+			if(validator.update(&text[length - 1], 1) != (match != Match::REJECTED) || validator.isComplete() != (match == Match::ACCEPTED)) {
+
+				// Record failure
+				recordFailure("Streaming", sequence, length, length - 1);
+			}
+
+			// Check if streaming validator's result for the whole sequence at once is wrong
+			validator.reset();
+			if(validator.update(text, length) != (match != Match::REJECTED)) {
+
+				// Record failure
+				recordFailure("Streaming", sequence, length, 0);
+			}
+
+			// Check if x86-64
+			#if defined __x86_64__ || defined _M_X64
+
+				// Check if AVX2 is supported
+				if(Common::isAvx2Supported()) {
+
+					// Go through all AVX2 offsets
+					for(size_t i = 0; i < size(avx2Offsets); ++i) {
+
+						// Set last byte in the text
+						avx2Texts[i][avx2Offsets[i] + length - 1] = lastByte;
+
+						// Check if AVX2 validator validated past the text, past a character boundary that isn't valid, or didn't validate a valid text
+						const size_t validLength = Unicode::getValidUtf8LengthAvx2(avx2Texts[i], sizeof(avx2Texts[i]));
+						if(validLength > sizeof(avx2Texts[i]) || (validLength > avx2Offsets[i] && matchUtf8Language(sequence, min(validLength - avx2Offsets[i], length)) != Match::ACCEPTED) || (match == Match::ACCEPTED && validLength != sizeof(avx2Texts[i]))) {
+
+							// Record failure
+							recordFailure("AVX2", sequence, length, avx2Offsets[i]);
+						}
+					}
+
+					// Check if AVX2 and DFA's combined result is wrong when the DFA continues from the middle of the sequence across the block boundary
+					if(Unicode::isValidUtf8(avx2Texts[AVX2_BLOCK_BOUNDARY_OFFSET_INDEX], sizeof(avx2Texts[AVX2_BLOCK_BOUNDARY_OFFSET_INDEX])) != (match == Match::ACCEPTED)) {
+
+						// Record failure
+						recordFailure("AVX2 and DFA", sequence, length, avx2Offsets[AVX2_BLOCK_BOUNDARY_OFFSET_INDEX]);
+					}
+				}
+			#endif
+		}
+	}
+}
+
+// Unicode test get number of failures
+uint64_t UnicodeTest::getNumberOfFailures() {
+
+	// Return number of failures
+	return numberOfFailures.load();
+}
+
+// Unicode test record failure
+void UnicodeTest::recordFailure(const char *validator, const uint8_t *sequence, size_t length, size_t offset) {
+
+	// Check if failure should be displayed
+	if(numberOfFailures.fetch_add(1) < MAXIMUM_NUMBER_OF_DISPLAYED_FAILURES) {
+
+		// Get sequence as hexadecimal
+		stringstream hexadecimalSequence;
+		for(size_t i = 0; i < length; ++i) {
+			hexadecimalSequence << ((i) ? " " : "") << hex << uppercase << setw(2) << setfill('0') << static_cast<unsigned int>(sequence[i]);
+		}
+
+		// Display failure
+		lock_guard<mutex> lock(displayLock);
+		cout << validator << " UTF-8 validator is wrong for " << hexadecimalSequence.str() << " at " << offset << endl;
+	}
+}
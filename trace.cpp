@@ -0,0 +1,175 @@
+// Header files
+#include "trace.h"
+
+using namespace std;
+
+
+// Constants
+
+// Stage names
+const char *Trace::STAGE_NAMES[] = {
+
+	// Received
+	"received",
+
+	// Queued
+	"queued",
+
+	// Flushed
+	"flushed",
+
+	// Reply parsed
+	"reply_parsed",
+
+	// Encoded
+	"encoded",
+
+	// Replied
+	"replied",
+
+	// Written
+	"written"
+};
+
+// Stage histograms
+Metrics::Histogram *const Trace::STAGE_HISTOGRAMS[] = {
+
+	// Received
+	nullptr,
+
+	// Queued
+	&Metrics::interactionQueueDuration,
+
+	// Flushed
+	&Metrics::interactionFlushDuration,
+
+	// Reply parsed
+	&Metrics::interactionResponderDuration,
+
+	// Encoded
+	&Metrics::interactionDecodeDuration,
+
+	// Replied
+	&Metrics::interactionReplyDuration,
+
+	// Written
+	&Metrics::interactionWriteDuration
+};
+
+
+// Global variables
+
+// File
+ofstream Trace::file;
+
+// Sample interval
+uint64_t Trace::sampleInterval = 1;
+
+// Number of finished traces
+uint64_t Trace::numberOfFinishedTraces = 0;
+
+
+// Supporting function implementation
+
+// Constructor
+Trace::Trace() :
+
+	// Set times
+	times(),
+
+	// Set marked stages
+	markedStages(0)
+{
+
+	// Mark received
+	mark(Stage::RECEIVED);
+}
+
+// Mark
+void Trace::mark(Stage stage) {
+
+	// Set stage's time to now
+	times[static_cast<size_t>(stage)] = chrono::steady_clock::now();
+
+	// Set stage as marked
+	markedStages |= 1 << static_cast<size_t>(stage);
+}
+
+// Is marked
+bool Trace::isMarked(Stage stage) const {
+
+	// Return if stage is marked
+	return markedStages & (1 << static_cast<size_t>(stage));
+}
+
+// Get duration
+chrono::steady_clock::duration Trace::getDuration(Stage start, Stage end) const {
+
+	// Return time between the stages
+	return times[static_cast<size_t>(end)] - times[static_cast<size_t>(start)];
+}
+
+// Finish
+void Trace::finish(Json::Number interactionIndex) const {
+
+	// Go through all stages after received
+	size_t previousStage = static_cast<size_t>(Stage::RECEIVED);
+	for(size_t i = previousStage + 1; i < static_cast<size_t>(Stage::NUMBER_OF_STAGES); ++i) {
+
+		// Check if stage is marked
+		if(isMarked(static_cast<Stage>(i))) {
+
+			// Update stage's histogram with the time since the previous marked stage
+			STAGE_HISTOGRAMS[i]->recordDuration(times[i] - times[previousStage]);
+
+			// Set previous stage to the stage
+			previousStage = i;
+		}
+	}
+
+	// Check if trace is sampled
+	if(file.is_open() && !(numberOfFinishedTraces++ % sampleInterval)) {
+
+		// Write span to file
+		writeSpan(interactionIndex);
+	}
+}
+
+// Open file
+bool Trace::openFile(const char *path, uint64_t sampleInterval) {
+
+	// Check if opening file failed
+	file.open(path, ios::out | ios::app);
+	if(!file.is_open()) {
+
+		// Return false
+		return false;
+	}
+
+	// Set sample interval
+	Trace::sampleInterval = sampleInterval;
+
+	// Return true
+	return true;
+}
+
+// Write span
+void Trace::writeSpan(Json::Number interactionIndex) const {
+
+	// Initialize span with the interaction index and received time
+	string span = "{\"interaction\":" + to_string(static_cast<uint64_t>(interactionIndex)) + ",\"received\":" + to_string(chrono::duration_cast<chrono::microseconds>(times[static_cast<size_t>(Stage::RECEIVED)].time_since_epoch()).count());
+
+	// Go through all stages after received
+	for(size_t i = static_cast<size_t>(Stage::RECEIVED) + 1; i < static_cast<size_t>(Stage::NUMBER_OF_STAGES); ++i) {
+
+		// Check if stage is marked
+		if(isMarked(static_cast<Stage>(i))) {
+
+			// Append stage's microseconds since received to the span
+			span += string(",\"") + STAGE_NAMES[i] + "\":" + to_string(chrono::duration_cast<chrono::microseconds>(getDuration(Stage::RECEIVED, static_cast<Stage>(i))).count());
+		}
+	}
+
+	// Write span to file
+	file << span << "}\n";
+}
@@ -0,0 +1,99 @@
+// Header guard
+#ifndef TRACE_H
+#define TRACE_H
+
+
+// Header files
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include "json.h"
+#include "metrics.h"
+
+using namespace std;
+
+
+// Classes
+
+// Trace class
+class Trace final {
+
+	// Public
+	public:
+
+		// Stage
+		enum class Stage {
+
+			// Received
+			RECEIVED,
+
+			// Queued
+			QUEUED,
+
+			// Flushed
+			FLUSHED,
+
+			// Reply parsed
+			REPLY_PARSED,
+
+			// Encoded
+			ENCODED,
+
+			// Replied
+			REPLIED,
+
+			// Written
+			WRITTEN,
+
+			// Number of stages
+			NUMBER_OF_STAGES
+		};
+
+		// Constructor
+		Trace();
+
+		// Mark
+		void mark(Stage stage);
+
+		// Is marked
+		bool isMarked(Stage stage) const;
+
+		// Get duration
+		chrono::steady_clock::duration getDuration(Stage start, Stage end) const;
+
+		// Finish
+		void finish(Json::Number interactionIndex) const;
+
+		// Open file
+		static bool openFile(const char *path, uint64_t sampleInterval);
+
+	// Private
+	private:
+
+		// Write span
+		void writeSpan(Json::Number interactionIndex) const;
+
+		// Stage names
+		static const char *STAGE_NAMES[];
+
+		// Stage histograms
+		static Metrics::Histogram *const STAGE_HISTOGRAMS[];
+
+		// File
+		static ofstream file;
+
+		// Sample interval
+		static uint64_t sampleInterval;
+
+		// Number of finished traces
+		static uint64_t numberOfFinishedTraces;
+
+		// Times
+		chrono::steady_clock::time_point times[static_cast<size_t>(Stage::NUMBER_OF_STAGES)];
+
+		// Marked stages
+		uint8_t markedStages;
+};
+
+
+#endif
@@ -1,8 +1,16 @@
 // Header files
-#include <codecvt>
-#include <locale>
+#include <algorithm>
+#include <stdexcept>
+#include "common.h"
 #include "unicode.h"
 
+// Check if x86-64
+#if defined __x86_64__ || defined _M_X64
+
+	// Header files
+	#include <immintrin.h>
+#endif
+
 using namespace std;
 
 
@@ -20,18 +28,128 @@ const uint16_t Unicode::UTF16_CODE_PAGE = 1200;
 // UTF-32 max code point
 const char32_t Unicode::UTF32_MAX_CODE_POINT = 0x10FFFF;
 
-// Use alternative methods
-const bool Unicode::USE_ALTERNATIVE_METHODS = true;
-
-// UTF-8 code points pattern
-const regex Unicode::UTF8_CODE_POINTS_PATTERN("(?:[\x09\x0A\x0D\x20-\x7E]|[\xC2-\xDF][\x80-\xBF]|\xE0[\xA0-\xBF][\x80-\xBF]|[\xE1-\xEC\xEE\xEF][\x80-\xBF]{2}|\xED[\x80-\x9F][\x80-\xBF]|\xF0[\x90-\xBF][\x80-\xBF]{2}|[\xF1-\xF3][\x80-\xBF]{3}|\xF4[\x80-\x8F][\x80-\xBF]{2})*", regex_constants::ECMAScript);
+// UTF-8 accept state
+const uint8_t Unicode::UTF8_ACCEPT_STATE = 0;
+
+// UTF-8 reject state
+const uint8_t Unicode::UTF8_REJECT_STATE = 1;
+
+// UTF-8 number of character classes
+const uint8_t Unicode::UTF8_NUMBER_OF_CHARACTER_CLASSES = 12;
+
+// UTF-8 character classes (0 printable ASCII, 1 80-8F, 2 90-9F, 3 A0-BF, 4 C2-DF, 5 E0, 6 E1-EC and EE-EF, 7 ED, 8 F0, 9 F1-F3, 10 F4, 11 invalid)
+const uint8_t Unicode::UTF8_CHARACTER_CLASSES[] = {
+	11, 11, 11, 11, 11, 11, 11, 11, 11, 0, 0, 11, 11, 0, 11, 11,
+	11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 11,
+	1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+	2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+	3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+	3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+	11, 11, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+	4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+	5, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 7, 6, 6,
+	8, 9, 9, 9, 10, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11
+};
+
+// UTF-8 transitions (0 accept, 1 reject, 2 one continuation left, 3 two continuations left, 4 after E0, 5 after ED, 6 three continuations left, 7 after F0, 8 after F4)
+const uint8_t Unicode::UTF8_TRANSITIONS[] = {
+	0, 1, 1, 1, 2, 4, 3, 5, 7, 6, 8, 1,
+	1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+	1, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1,
+	1, 2, 2, 2, 1, 1, 1, 1, 1, 1, 1, 1,
+	1, 1, 1, 2, 1, 1, 1, 1, 1, 1, 1, 1,
+	1, 2, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+	1, 3, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1,
+	1, 1, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1,
+	1, 3, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1
+};
 
 
 // Supporting function implementation
+Unicode::Utf8Validator::Utf8Validator() :
+
+	// Set state
+	state(UTF8_ACCEPT_STATE)
+{
+}
+
+bool Unicode::Utf8Validator::update(const char *text, size_t length) {
+
+	// Update state with the text
+	state = updateUtf8State(state, text, length);
+	
+	// Return if text so far is valid
+	return state != UTF8_REJECT_STATE;
+}
+
+bool Unicode::Utf8Validator::isComplete() const {
+
+	// Return if text so far doesn't end in the middle of a character
+	return state == UTF8_ACCEPT_STATE;
+}
+
+void Unicode::Utf8Validator::reset() {
+
+	// Reset state
+	state = UTF8_ACCEPT_STATE;
+}
+
+size_t Unicode::utf8ToUtf32(char32_t *output, const char *text, size_t length) {
+
+	// Go through all bytes in the text
+	const char32_t *start = output;
+	for(size_t i = 0; i < length;) {
+	
+		// Check if x86-64
+		#if defined __x86_64__ || defined _M_X64
+		
+			// Check if the next block is all ASCII
+			if(length - i >= sizeof(__m128i) && !_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(&text[i])))) {
+			
+				// Append block's bytes widened to code points to the output
+				const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&text[i]));
+				const __m128i zero = _mm_setzero_si128();
+				const __m128i low = _mm_unpacklo_epi8(block, zero);
+				const __m128i high = _mm_unpackhi_epi8(block, zero);
+				_mm_storeu_si128(reinterpret_cast<__m128i *>(output), _mm_unpacklo_epi16(low, zero));
+				_mm_storeu_si128(reinterpret_cast<__m128i *>(output + 4), _mm_unpackhi_epi16(low, zero));
+				_mm_storeu_si128(reinterpret_cast<__m128i *>(output + 8), _mm_unpacklo_epi16(high, zero));
+				_mm_storeu_si128(reinterpret_cast<__m128i *>(output + 12), _mm_unpackhi_epi16(high, zero));
+				
+				// Skip block
+				i += sizeof(__m128i);
+				output += sizeof(__m128i);
+				
+				// Continue
+				continue;
+			}
+		#endif
+		
+		// Append next code point to the output
+		*output++ = decodeUtf8(text, length, i);
+	}
+	
+	// Return number of code points
+	return output - start;
+}
+
 u32string Unicode::utf8ToUtf32(const char *text) {
 
+	// Get text's length
+	const size_t length = char_traits<char>::length(text);
+	
+	// Convert text into a string large enough for every byte to be a code point
+	u32string result(length, U'\0');
+	result.resize(utf8ToUtf32(result.data(), text, length));
+	
 	// Return UTF-32 string
-	return wstring_convert<codecvt_utf8<char32_t>, char32_t>{}.from_bytes(text);
+	return result;
 }
 
 u32string Unicode::utf8ToUtf32(const string &text) {
@@ -46,10 +164,64 @@ char32_t Unicode::utf8ToUtf32(char character) {
 	return utf8ToUtf32(string(1, character))[0];
 }
 
+size_t Unicode::utf32ToUtf8(char *output, const char32_t *text, size_t length) {
+
+	// Go through all code points in the text
+	const char *start = output;
+	for(size_t i = 0; i < length;) {
+	
+		// Check if x86-64
+		#if defined __x86_64__ || defined _M_X64
+		
+			// Check if the next eight code points are all ASCII
+			if(length - i >= 8) {
+			
+				// Get blocks
+				const __m128i firstBlock = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&text[i]));
+				const __m128i secondBlock = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&text[i + 4]));
+				
+				if(_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(_mm_or_si128(firstBlock, secondBlock), _mm_set1_epi32(~0x7F)), _mm_setzero_si128())) == 0xFFFF) {
+				
+					// Append blocks' code points narrowed to bytes to the output
+					const __m128i words = _mm_packs_epi32(firstBlock, secondBlock);
+					_mm_storel_epi64(reinterpret_cast<__m128i *>(output), _mm_packus_epi16(words, words));
+					
+					// Skip blocks
+					i += 8;
+					output += 8;
+					
+					// Continue
+					continue;
+				}
+			}
+		#endif
+		
+		// Check if code point is a surrogate or is too large
+		const char32_t codePoint = text[i++];
+		if((codePoint >= UTF16_HIGH_SURROGATE_RANGE_BEGIN && codePoint <= UTF16_LOW_SURROGATE_RANGE_END) || codePoint > UTF32_MAX_CODE_POINT)
+		
+			// Throw exception
+			throw range_error("Invalid UTF-32 string");
+		
+		// Append code point to the output
+		output += encodeUtf8(output, codePoint);
+	}
+	
+	// Return number of bytes
+	return output - start;
+}
+
 string Unicode::utf32ToUtf8(const char32_t *text) {
 
+	// Get text's length
+	const size_t length = char_traits<char32_t>::length(text);
+	
+	// Convert text into a string large enough for every code point to be four bytes
+	string result(length * 4, '\0');
+	result.resize(utf32ToUtf8(result.data(), text, length));
+	
 	// Return UTF-8 string
-	return wstring_convert<codecvt_utf8<char32_t>, char32_t>{}.to_bytes(text);
+	return result;
 }
 
 string Unicode::utf32ToUtf8(const u32string &text) {
@@ -64,10 +236,64 @@ string Unicode::utf32ToUtf8(char32_t character) {
 	return utf32ToUtf8(u32string(1, character));
 }
 
+size_t Unicode::utf8ToUtf16(char16_t *output, const char *text, size_t length) {
+
+	// Go through all bytes in the text
+	const char16_t *start = output;
+	for(size_t i = 0; i < length;) {
+	
+		// Check if x86-64
+		#if defined __x86_64__ || defined _M_X64
+		
+			// Check if the next block is all ASCII
+			if(length - i >= sizeof(__m128i) && !_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(&text[i])))) {
+			
+				// Append block's bytes widened to code units to the output
+				const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&text[i]));
+				const __m128i zero = _mm_setzero_si128();
+				_mm_storeu_si128(reinterpret_cast<__m128i *>(output), _mm_unpacklo_epi8(block, zero));
+				_mm_storeu_si128(reinterpret_cast<__m128i *>(output + 8), _mm_unpackhi_epi8(block, zero));
+				
+				// Skip block
+				i += sizeof(__m128i);
+				output += sizeof(__m128i);
+				
+				// Continue
+				continue;
+			}
+		#endif
+		
+		// Check if next code point is in the basic multilingual plane
+		const char32_t codePoint = decodeUtf8(text, length, i);
+		if(codePoint <= 0xFFFF)
+		
+			// Append code point to the output
+			*output++ = codePoint;
+		
+		// Otherwise
+		else {
+		
+			// Append code point as a surrogate pair to the output
+			*output++ = UTF16_HIGH_SURROGATE_RANGE_BEGIN + ((codePoint - 0x10000) >> 10);
+			*output++ = UTF16_LOW_SURROGATE_RANGE_BEGIN + ((codePoint - 0x10000) & 0x3FF);
+		}
+	}
+	
+	// Return number of code units
+	return output - start;
+}
+
 u16string Unicode::utf8ToUtf16(const char *text) {
 
+	// Get text's length
+	const size_t length = char_traits<char>::length(text);
+	
+	// Convert text into a string large enough for every byte to be a code unit
+	u16string result(length, u'\0');
+	result.resize(utf8ToUtf16(result.data(), text, length));
+	
 	// Return UTF-16 string
-	return wstring_convert<codecvt_utf8_utf16<char16_t>, char16_t>{}.from_bytes(text);
+	return result;
 }
 
 u16string Unicode::utf8ToUtf16(const string &text) {
@@ -82,10 +308,72 @@ char16_t Unicode::utf8ToUtf16(char character) {
 	return utf8ToUtf16(string(1, character))[0];
 }
 
+size_t Unicode::utf16ToUtf8(char *output, const char16_t *text, size_t length) {
+
+	// Go through all code units in the text
+	const char *start = output;
+	for(size_t i = 0; i < length;) {
+	
+		// Check if x86-64
+		#if defined __x86_64__ || defined _M_X64
+		
+			// Check if the next block is all ASCII
+			if(length - i >= sizeof(__m128i) / sizeof(char16_t)) {
+			
+				// Get block
+				const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&text[i]));
+				
+				if(_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(block, _mm_set1_epi16(~0x7F)), _mm_setzero_si128())) == 0xFFFF) {
+				
+					// Append block's code units narrowed to bytes to the output
+					_mm_storel_epi64(reinterpret_cast<__m128i *>(output), _mm_packus_epi16(block, block));
+					
+					// Skip block
+					i += sizeof(__m128i) / sizeof(char16_t);
+					output += sizeof(__m128i) / sizeof(char16_t);
+					
+					// Continue
+					continue;
+				}
+			}
+		#endif
+		
+		// Check if code unit isn't a surrogate
+		const char16_t codeUnit = text[i++];
+		if(codeUnit < UTF16_HIGH_SURROGATE_RANGE_BEGIN || codeUnit > UTF16_LOW_SURROGATE_RANGE_END)
+		
+			// Append code unit to the output
+			output += encodeUtf8(output, codeUnit);
+		
+		// Otherwise check if code unit is a high surrogate followed by a low surrogate
+		else if(codeUnit <= UTF16_HIGH_SURROGATE_RANGE_END && i < length && text[i] >= UTF16_LOW_SURROGATE_RANGE_BEGIN && text[i] <= UTF16_LOW_SURROGATE_RANGE_END) {
+		
+			// Append surrogate pair's code point to the output
+			output += encodeUtf8(output, 0x10000 + ((codeUnit - UTF16_HIGH_SURROGATE_RANGE_BEGIN) << 10) + (text[i++] - UTF16_LOW_SURROGATE_RANGE_BEGIN));
+		}
+		
+		// Otherwise
+		else
+		
+			// Throw exception
+			throw range_error("Invalid UTF-16 string");
+	}
+	
+	// Return number of bytes
+	return output - start;
+}
+
 string Unicode::utf16ToUtf8(const char16_t *text) {
 
+	// Get text's length
+	const size_t length = char_traits<char16_t>::length(text);
+	
+	// Convert text into a string large enough for every code unit to be three bytes
+	string result(length * 3, '\0');
+	result.resize(utf16ToUtf8(result.data(), text, length));
+	
 	// Return UTF-8 string
-	return wstring_convert<codecvt_utf8_utf16<char16_t>, char16_t>{}.to_bytes(text);
+	return result;
 }
 
 string Unicode::utf16ToUtf8(const u16string &text) {
@@ -100,98 +388,22 @@ string Unicode::utf16ToUtf8(char16_t character) {
 	return utf16ToUtf8(u16string(1, character));
 }
 
+bool Unicode::isValidUtf8(const char *text, size_t length) {
+
+	// Return if the text doesn't end in the middle of a character or contain invalid characters
+	return updateUtf8State(UTF8_ACCEPT_STATE, text, length) == UTF8_ACCEPT_STATE;
+}
+
 bool Unicode::isValidUtf8(const string &text) {
 
-	// Check if using alternative methods
-	if(USE_ALTERNATIVE_METHODS) {
-	
-		// Go through all code points in the text
-		for(string::size_type i = 0; i < text.length(); ++i) {
-		
-			// Initialize code point
-			const char &codePoint = text[i];
-			
-			// Initialize character
-			string character;
-			
-			// Check if code point represents an ASCII character
-			if((codePoint & 0b10000000) == 0b00000000)
-			
-				// Append code point to character
-				character += codePoint;
-			
-			// Otherwise code point starts the represention of a non-ASCII character
-			else if((codePoint & 0b11000000) == 0b11000000) {
-			
-				// Set length
-				uint8_t length;
-				if((codePoint & 0b11100000) == 0b11000000)
-					length = 2;
-				else if((codePoint & 0b11110000) == 0b11100000)
-					length = 3;
-				else if((codePoint & 0b11111000) == 0b11110000)
-					length = 4;
-				
-				// Otherwise assume length is invalid
-				else
-				
-					// Return false
-					return false;
-				
-				// Go through all bytes in the code point
-				for(uint8_t j = 0; j < length && i < text.length(); ++j, ++i) {
-				
-					// Initialize byte
-					const char &byte = text[i];
-					
-					// Check if byte is invalid
-					if(j != 0 && (byte & 0b11000000) != 0b10000000)
-						
-						// Return false
-						return false;
-				
-					// Append byte to character
-					character += byte;
-				}
-				
-				// Decrement index
-				--i;
-				
-				// Check if code point doesn't have its expected size
-				if(character.length() != length)
-				
-					// Return false
-					return false;
-			}
-			
-			// Otherwise
-			else
-			
-				// Return false
-				return false;
-			
-			// Check if character isn't a valid UTF-8 character
-			if(!regex_match(character, UTF8_CODE_POINTS_PATTERN, regex_constants::format_default | regex_constants::match_default))
-			
-				// Return false
-				return false;
-		}
-		
-		// Return true
-		return true;
-	}
-	
-	// Otherwise
-	else
-	
-		// Return if text is a valid UTF-8 string
-		return regex_match(text, UTF8_CODE_POINTS_PATTERN, regex_constants::format_default | regex_constants::match_default);
+	// Return if text is a valid UTF-8 string
+	return isValidUtf8(text.data(), text.length());
 }
 
 bool Unicode::isValidUtf8(const vector<uint8_t> &data) {
 
 	// Return if data is a valid UTF-8 string
-	return isValidUtf8(string(data.begin(), data.end()));
+	return isValidUtf8(reinterpret_cast<const char *>(data.data()), data.size());
 }
 
 bool Unicode::isValidUtf16(const u16string &text) {
@@ -256,95 +468,92 @@ bool Unicode::isValidUtf32(const vector<uint32_t> &data) {
 	return isValidUtf32(u32string(data.begin(), data.end()));
 }
 
-string Unicode::removeInvalidUtf8(const string &text) {
+size_t Unicode::removeInvalidUtf8(char *output, const char *text, size_t length) {
 
-	// Initialize return value
-	string returnValue;
+	// Go through all bytes in the text
+	const char *start = output;
+	for(size_t i = 0; i < length;) {
 	
-	// Check if using alternative methods
-	if(USE_ALTERNATIVE_METHODS) {
-
-		// Go through all code points in the text
-		for(string::size_type i = 0; i < text.length(); ++i) {
+		// Check if x86-64
+		#if defined __x86_64__ || defined _M_X64
 		
-			// Initialize code point
-			const char &codePoint = text[i];
-			
-			// Initialize character
-			string character;
-			
-			// Check if code point represents an ASCII character
-			if((codePoint & 0b10000000) == 0b00000000)
-			
-				// Append code point to character
-				character += codePoint;
-			
-			// Otherwise code point starts the represention of a non-ASCII character
-			else if((codePoint & 0b11000000) == 0b11000000) {
+			// Check if the next block is all printable ASCII
+			if(length - i >= sizeof(__m128i) && isPrintableAsciiBlock(&text[i])) {
 			
-				// Set length
-				uint8_t length;
-				if((codePoint & 0b11100000) == 0b11000000)
-					length = 2;
-				else if((codePoint & 0b11110000) == 0b11100000)
-					length = 3;
-				else if((codePoint & 0b11111000) == 0b11110000)
-					length = 4;
-				
-				// Otherwise assume length is invalid
-				else
-				
-					// Go to the next code point
-					continue;
-				
-				// Go through all bytes in the code point
-				for(uint8_t j = 0; j < length && i < text.length(); ++j, ++i) {
+				// Append block to the output
+				_mm_storeu_si128(reinterpret_cast<__m128i *>(output), _mm_loadu_si128(reinterpret_cast<const __m128i *>(&text[i])));
 				
-					// Initialize byte
-					const char &byte = text[i];
-					
-					// Check if byte is invalid
-					if(j != 0 && (byte & 0b11000000) != 0b10000000)
-						
-						// Stop going through bytes
-						break;
-				
-					// Append byte to character
-					character += byte;
-				}
-				
-				// Decrement index
-				--i;
-				
-				// Check if code point doesn't have its expected size
-				if(character.length() != length)
+				// Skip block
+				i += sizeof(__m128i);
+				output += sizeof(__m128i);
 				
-					// Go to the next code point
-					continue;
+				// Continue
+				continue;
 			}
+		#endif
+		
+		// Set character's length from its first byte
+		const uint8_t byte = text[i];
+		size_t characterLength;
+		if((byte & 0b10000000) == 0b00000000)
+			characterLength = 1;
+		else if((byte & 0b11100000) == 0b11000000)
+			characterLength = 2;
+		else if((byte & 0b11110000) == 0b11100000)
+			characterLength = 3;
+		else if((byte & 0b11111000) == 0b11110000)
+			characterLength = 4;
+		
+		// Otherwise byte doesn't start a character
+		else {
+		
+			// Skip byte
+			++i;
 			
-			// Otherwise
-			else
+			// Continue
+			continue;
+		}
+		
+		// Go through all of the character's continuation bytes
+		size_t end = i + 1;
+		while(end < length && end - i < characterLength && (text[end] & 0b11000000) == 0b10000000)
+		
+			// Increment end
+			++end;
+		
+		// Check if character has its expected size
+		if(end - i == characterLength) {
+		
+			// Go through all bytes in the character
+			uint8_t state = UTF8_ACCEPT_STATE;
+			for(size_t j = i; j < end; ++j)
 			
-				// Go to the next code point
-				continue;
+				// Transition to the next state
+				state = UTF8_TRANSITIONS[state * UTF8_NUMBER_OF_CHARACTER_CLASSES + UTF8_CHARACTER_CLASSES[static_cast<uint8_t>(text[j])]];
 			
 			// Check if character is a valid UTF-8 character
-			if(isValidUtf8(character))
+			if(state == UTF8_ACCEPT_STATE)
 			
-				// Append character to return value
-				returnValue.append(character);
+				// Go through all bytes in the character
+				for(size_t j = i; j < end; ++j)
+				
+					// Append byte to the output
+					*output++ = text[j];
 		}
+		
+		// Skip character
+		i = end;
 	}
 	
-	// Otherwise
-	else
-	
-		// Go through all valid UTF-8 code points in the text
-		for(sregex_iterator i(text.begin(), text.end(), UTF8_CODE_POINTS_PATTERN, regex_constants::format_default | regex_constants::match_default), end; i != end; ++i)
-			
-			// Append code point's character to return value
-			returnValue.append(i->str());
+	// Return number of bytes
+	return output - start;
+}
+
+string Unicode::removeInvalidUtf8(const string &text) {
+
+	// Remove invalid parts from text into a string large enough for all of it
+	string returnValue(text.length(), '\0');
+	returnValue.resize(removeInvalidUtf8(returnValue.data(), text.data(), text.length()));
 	
 	// Return return value
 	return returnValue;
@@ -352,28 +561,58 @@ string Unicode::removeInvalidUtf8(const string &text) {
 
 string Unicode::removeInvalidUtf8(const vector<uint8_t> &data) {
 
+	// Remove invalid parts from data into a string large enough for all of it
+	string returnValue(data.size(), '\0');
+	returnValue.resize(removeInvalidUtf8(returnValue.data(), reinterpret_cast<const char *>(data.data()), data.size()));
+	
 	// Return data with only valid UTF-8 parts
-	return removeInvalidUtf8(string(data.begin(), data.end()));
+	return returnValue;
 }
 
-u16string Unicode::removeInvalidUtf16(const u16string &text) {
-
-	// Initialize return value
-	u16string returnValue;
+size_t Unicode::removeInvalidUtf16(char16_t *output, const char16_t *text, size_t length) {
 
 	// Go through all code points in the text
+	const char16_t *start = output;
 	bool inSurrogatePair = false;
 	char16_t previousCodePoint = u'\0';
-	for(char16_t codePoint : text) {
+	for(size_t i = 0; i < length;) {
+	
+		// Check if x86-64
+		#if defined __x86_64__ || defined _M_X64
+		
+			// Check if the next block doesn't contain any surrogates
+			if(length - i >= sizeof(__m128i) / sizeof(char16_t)) {
+			
+				// Get block
+				const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&text[i]));
+				
+				if(!_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(block, _mm_set1_epi16(0xF800)), _mm_set1_epi16(UTF16_HIGH_SURROGATE_RANGE_BEGIN)))) {
+				
+					// Clear in surrogate pair
+					inSurrogatePair = false;
+					
+					// Append block to the output
+					_mm_storeu_si128(reinterpret_cast<__m128i *>(output), block);
+					
+					// Skip block
+					i += sizeof(__m128i) / sizeof(char16_t);
+					output += sizeof(__m128i) / sizeof(char16_t);
+					
+					// Continue
+					continue;
+				}
+			}
+		#endif
 		
 		// Check if code point isn't part of a surrogate pair
+		const char16_t codePoint = text[i++];
 		if(codePoint < UTF16_HIGH_SURROGATE_RANGE_BEGIN || codePoint > UTF16_LOW_SURROGATE_RANGE_END) {
 		
 			// Clear in surrogate pair
 			inSurrogatePair = false;
 		
-			// Append code point to return value
-			returnValue.push_back(codePoint);
+			// Append code point to the output
+			*output++ = codePoint;
 		}
 		
 		// Otherwise check if code point finishes a surrogate pair
@@ -382,9 +621,9 @@ u16string Unicode::removeInvalidUtf16(const u16string &text) {
 			// Clear in surrogate pair
 			inSurrogatePair = false;
 		
-			// Append code points to return value
-			returnValue.push_back(previousCodePoint);
-			returnValue.push_back(codePoint);
+			// Append code points to the output
+			*output++ = previousCodePoint;
+			*output++ = codePoint;
 		}
 		
 		// Otherwise check if code point starts a surrogate pair
@@ -398,36 +637,325 @@ u16string Unicode::removeInvalidUtf16(const u16string &text) {
 		}
 	}
 	
+	// Return number of code points
+	return output - start;
+}
+
+u16string Unicode::removeInvalidUtf16(const u16string &text) {
+
+	// Remove invalid parts from text into a string large enough for all of it
+	u16string returnValue(text.length(), u'\0');
+	returnValue.resize(removeInvalidUtf16(returnValue.data(), text.data(), text.length()));
+	
 	// Return return value
 	return returnValue;
 }
 
 u16string Unicode::removeInvalidUtf16(const vector<uint16_t> &data) {
 
+	// Remove invalid parts from data into a string large enough for all of it
+	u16string returnValue(data.size(), u'\0');
+	returnValue.resize(removeInvalidUtf16(returnValue.data(), reinterpret_cast<const char16_t *>(data.data()), data.size()));
+	
 	// Return data with only valid UTF-16 parts
-	return removeInvalidUtf16(u16string(data.begin(), data.end()));
+	return returnValue;
 }
 
-u32string Unicode::removeInvalidUtf32(const u32string &text) {
-
-	// Initialize return value
-	u32string returnValue;
+size_t Unicode::removeInvalidUtf32(char32_t *output, const char32_t *text, size_t length) {
 
 	// Go through all code points in the text
-	for(char32_t codePoint : text)
+	const char32_t *start = output;
+	for(size_t i = 0; i < length;) {
 	
+		// Check if x86-64
+		#if defined __x86_64__ || defined _M_X64
+		
+			// Check if the next block doesn't contain any code points that are too large
+			if(length - i >= sizeof(__m128i) / sizeof(char32_t)) {
+			
+				// Get block
+				const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&text[i]));
+				
+				if(!_mm_movemask_epi8(_mm_cmpgt_epi32(_mm_xor_si128(block, _mm_set1_epi32(INT32_MIN)), _mm_set1_epi32(UTF32_MAX_CODE_POINT ^ INT32_MIN)))) {
+				
+					// Append block to the output
+					_mm_storeu_si128(reinterpret_cast<__m128i *>(output), block);
+					
+					// Skip block
+					i += sizeof(__m128i) / sizeof(char32_t);
+					output += sizeof(__m128i) / sizeof(char32_t);
+					
+					// Continue
+					continue;
+				}
+			}
+		#endif
+		
 		// Check if code point is valid
+		const char32_t codePoint = text[i++];
 		if(codePoint <= UTF32_MAX_CODE_POINT)
 		
-			// Append code point to return value
-			returnValue.push_back(codePoint);
+			// Append code point to the output
+			*output++ = codePoint;
+	}
+	
+	// Return number of code points
+	return output - start;
+}
+
+u32string Unicode::removeInvalidUtf32(const u32string &text) {
 
+	// Remove invalid parts from text into a string large enough for all of it
+	u32string returnValue(text.length(), U'\0');
+	returnValue.resize(removeInvalidUtf32(returnValue.data(), text.data(), text.length()));
+	
 	// Return return value
 	return returnValue;
 }
 
 u32string Unicode::removeInvalidUtf32(const vector<uint32_t> &data) {
 
+	// Remove invalid parts from data into a string large enough for all of it
+	u32string returnValue(data.size(), U'\0');
+	returnValue.resize(removeInvalidUtf32(returnValue.data(), reinterpret_cast<const char32_t *>(data.data()), data.size()));
+	
 	// Return data with only valid UTF-32 parts
-	return removeInvalidUtf32(u32string(data.begin(), data.end()));
+	return returnValue;
+}
+
+uint8_t Unicode::updateUtf8State(uint8_t state, const char *text, size_t length) {
+
+	// Initialize index
+	size_t i = 0;
+	
+	// Check if x86-64
+	#if defined __x86_64__ || defined _M_X64
+	
+		// Check if at the start of a character and AVX2 is supported
+		if(state == UTF8_ACCEPT_STATE && Common::isAvx2Supported())
+		
+			// Validate full blocks with AVX2
+			i = getValidUtf8LengthAvx2(text, length);
+	#endif
+	
+	// Go through all remaining bytes in the text
+	while(i < length) {
+	
+		// Check if x86-64
+		#if defined __x86_64__ || defined _M_X64
+		
+			// Check if at the start of a character and the next block is all printable ASCII
+			if(state == UTF8_ACCEPT_STATE && length - i >= sizeof(__m128i) && isPrintableAsciiBlock(&text[i])) {
+			
+				// Skip block
+				i += sizeof(__m128i);
+				
+				// Continue
+				continue;
+			}
+		#endif
+		
+		// Go through the next sixteen bytes
+		for(const size_t end = min(i + 16, length); i < end; ++i)
+		
+			// Transition to the next state
+			state = UTF8_TRANSITIONS[state * UTF8_NUMBER_OF_CHARACTER_CLASSES + UTF8_CHARACTER_CLASSES[static_cast<uint8_t>(text[i])]];
+		
+		// Check if text is invalid
+		if(state == UTF8_REJECT_STATE)
+		
+			// Return state
+			return state;
+	}
+	
+	// Return state
+	return state;
+}
+
+char32_t Unicode::decodeUtf8(const char *text, size_t length, size_t &index) {
+
+	// Check if first byte is ASCII
+	const uint8_t byte = text[index++];
+	if(byte < 0b10000000)
+	
+		// Return byte
+		return byte;
+	
+	// Get code point's bits from the first byte
+	char32_t codePoint = byte & ((byte >= 0b11110000) ? 0b00000111 : ((byte >= 0b11100000) ? 0b00001111 : 0b00011111));
+	uint8_t state = UTF8_TRANSITIONS[UTF8_ACCEPT_STATE * UTF8_NUMBER_OF_CHARACTER_CLASSES + UTF8_CHARACTER_CLASSES[byte]];
+	
+	// Go through all continuation bytes
+	while(state != UTF8_ACCEPT_STATE && state != UTF8_REJECT_STATE && index < length) {
+	
+		// Include continuation byte's bits in the code point
+		const uint8_t continuation = text[index++];
+		codePoint = (codePoint << 6) | (continuation & 0b00111111);
+		
+		// Transition to the next state
+		state = UTF8_TRANSITIONS[state * UTF8_NUMBER_OF_CHARACTER_CLASSES + UTF8_CHARACTER_CLASSES[continuation]];
+	}
+	
+	// Check if code point is invalid
+	if(state != UTF8_ACCEPT_STATE)
+	
+		// Throw exception
+		throw range_error("Invalid UTF-8 string");
+	
+	// Return code point
+	return codePoint;
+}
+
+size_t Unicode::encodeUtf8(char *output, char32_t codePoint) {
+
+	// Check if code point is ASCII
+	if(codePoint < 0x80) {
+	
+		// Append code point to the output
+		output[0] = codePoint;
+		
+		// Return one byte
+		return 1;
+	}
+	
+	// Check if code point fits in two bytes
+	if(codePoint < 0x800) {
+	
+		// Append code point to the output
+		output[0] = 0b11000000 | (codePoint >> 6);
+		output[1] = 0b10000000 | (codePoint & 0b00111111);
+		
+		// Return two bytes
+		return 2;
+	}
+	
+	// Check if code point fits in three bytes
+	if(codePoint < 0x10000) {
+	
+		// Append code point to the output
+		output[0] = 0b11100000 | (codePoint >> 12);
+		output[1] = 0b10000000 | ((codePoint >> 6) & 0b00111111);
+		output[2] = 0b10000000 | (codePoint & 0b00111111);
+		
+		// Return three bytes
+		return 3;
+	}
+	
+	// Append code point to the output
+	output[0] = 0b11110000 | (codePoint >> 18);
+	output[1] = 0b10000000 | ((codePoint >> 12) & 0b00111111);
+	output[2] = 0b10000000 | ((codePoint >> 6) & 0b00111111);
+	output[3] = 0b10000000 | (codePoint & 0b00111111);
+	
+	// Return four bytes
+	return 4;
 }
+
+// Check if x86-64
+#if defined __x86_64__ || defined _M_X64
+
+	bool Unicode::isPrintableAsciiBlock(const char *text) {
+	
+		// Get block
+		const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(text));
+		
+		// Return if block doesn't contain any bytes outside of space to tilde, tab, newline, or carriage return
+		return _mm_movemask_epi8(_mm_or_si128(_mm_and_si128(_mm_cmpgt_epi8(block, _mm_set1_epi8(' ' - 1)), _mm_cmplt_epi8(block, _mm_set1_epi8(0x7F))), _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(block, _mm_set1_epi8('\t')), _mm_cmpeq_epi8(block, _mm_set1_epi8('\n'))), _mm_cmpeq_epi8(block, _mm_set1_epi8('\r'))))) == 0xFFFF;
+	}
+
+	size_t Unicode::getValidUtf8LengthAvx2(const char *text, size_t length) {
+	
+		// Initialize constants (lookup tables from Keiser and Lemire's "Validating UTF-8 In Less Than One Instruction Per Byte" where bit 0 is too short, 1 is too long, 2 is overlong 3, 3 is too large, 4 is surrogate, 5 is overlong 2, 6 is too large 1000 or overlong 4, and 7 is two continuations)
+		const __m256i nibbleMask = _mm256_set1_epi8(0x0F);
+		const __m256i firstByteHighNibbleErrors = _mm256_setr_epi8(0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x80, 0x80, 0x80, 0x80, 0x21, 0x01, 0x15, 0x49, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x80, 0x80, 0x80, 0x80, 0x21, 0x01, 0x15, 0x49);
+		const __m256i firstByteLowNibbleErrors = _mm256_setr_epi8(0xE7, 0xA3, 0x83, 0x83, 0x8B, 0xCB, 0xCB, 0xCB, 0xCB, 0xCB, 0xCB, 0xCB, 0xCB, 0xDB, 0xCB, 0xCB, 0xE7, 0xA3, 0x83, 0x83, 0x8B, 0xCB, 0xCB, 0xCB, 0xCB, 0xCB, 0xCB, 0xCB, 0xCB, 0xDB, 0xCB, 0xCB);
+		const __m256i secondByteHighNibbleErrors = _mm256_setr_epi8(0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0xE6, 0xAE, 0xBA, 0xBA, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0xE6, 0xAE, 0xBA, 0xBA, 0x01, 0x01, 0x01, 0x01);
+		const __m256i continuationFlag = _mm256_set1_epi8(0x80);
+		const __m256i thirdByteOffset = _mm256_set1_epi8(0xE0 - 0x80);
+		const __m256i fourthByteOffset = _mm256_set1_epi8(0xF0 - 0x80);
+		const __m256i incompleteMaximums = _mm256_setr_epi8(0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xF0 - 1, 0xE0 - 1, 0xC0 - 1);
+		const __m256i firstControlCharacter = _mm256_set1_epi8(-1);
+		const __m256i space = _mm256_set1_epi8(' ');
+		const __m256i tab = _mm256_set1_epi8('\t');
+		const __m256i newline = _mm256_set1_epi8('\n');
+		const __m256i carriageReturn = _mm256_set1_epi8('\r');
+		const __m256i deleteCharacter = _mm256_set1_epi8(0x7F);
+		
+		// Go through all blocks until an invalid block is found
+		__m256i previousBlock = _mm256_setzero_si256();
+		__m256i previousIncomplete = _mm256_setzero_si256();
+		size_t i = 0;
+		for(; length - i >= sizeof(__m256i); i += sizeof(__m256i)) {
+		
+			// Get block
+			const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(&text[i]));
+			
+			// Get block's control characters other than tab, newline, and carriage return
+			__m256i errors = _mm256_or_si256(_mm256_andnot_si256(_mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(block, tab), _mm256_cmpeq_epi8(block, newline)), _mm256_cmpeq_epi8(block, carriageReturn)), _mm256_and_si256(_mm256_cmpgt_epi8(block, firstControlCharacter), _mm256_cmpgt_epi8(space, block))), _mm256_cmpeq_epi8(block, deleteCharacter));
+			
+			// Check if block is all ASCII
+			if(!_mm256_movemask_epi8(block)) {
+			
+				// Include previous block ending in the middle of a character in the errors
+				errors = _mm256_or_si256(errors, previousIncomplete);
+				
+				// Clear previous incomplete
+				previousIncomplete = _mm256_setzero_si256();
+			}
+			
+			// Otherwise
+			else {
+			
+				// Get previous one, two, and three bytes for each byte in the block
+				const __m256i previousBlocks = _mm256_permute2x128_si256(previousBlock, block, 0x21);
+				const __m256i previousOne = _mm256_alignr_epi8(block, previousBlocks, sizeof(__m128i) - 1);
+				const __m256i previousTwo = _mm256_alignr_epi8(block, previousBlocks, sizeof(__m128i) - 2);
+				const __m256i previousThree = _mm256_alignr_epi8(block, previousBlocks, sizeof(__m128i) - 3);
+				
+				// Get errors for each pair of bytes
+				const __m256i specialCases = _mm256_and_si256(_mm256_and_si256(_mm256_shuffle_epi8(firstByteHighNibbleErrors, _mm256_and_si256(_mm256_srli_epi16(previousOne, 4), nibbleMask)), _mm256_shuffle_epi8(firstByteLowNibbleErrors, _mm256_and_si256(previousOne, nibbleMask))), _mm256_shuffle_epi8(secondByteHighNibbleErrors, _mm256_and_si256(_mm256_srli_epi16(block, 4), nibbleMask)));
+				
+				// Get bytes that must be the third or fourth byte of a character
+				const __m256i mustBeContinuations = _mm256_and_si256(_mm256_or_si256(_mm256_subs_epu8(previousTwo, thirdByteOffset), _mm256_subs_epu8(previousThree, fourthByteOffset)), continuationFlag);
+				
+				// Include special cases that don't match the expected continuations in the errors
+				errors = _mm256_or_si256(errors, _mm256_xor_si256(mustBeContinuations, specialCases));
+				
+				// Set previous incomplete to if block ends in the middle of a character
+				previousIncomplete = _mm256_subs_epu8(block, incompleteMaximums);
+			}
+			
+			// Check if block is invalid
+			if(!_mm256_testz_si256(errors, errors)) {
+			
+				// Break
+				break;
+			}
+			
+			// Update previous block
+			previousBlock = block;
+		}
+		
+		// Go through the last three bytes
+		for(size_t j = 1; j <= 3 && j <= i; ++j) {
+		
+			// Check if byte isn't a continuation byte
+			const uint8_t byte = text[i - j];
+			if((byte & 0b11000000) != 0b10000000) {
+			
+				// Check if byte starts a character that continues past the validated bytes
+				if(byte >= 0b11000000 && ((byte >= 0b11110000) ? 4 : (byte >= 0b11100000) ? 3 : 2) > j) {
+				
+					// Return number of bytes before the character
+					return i - j;
+				}
+				
+				// Break
+				break;
+			}
+		}
+		
+		// Return number of bytes validated
+		return i;
+	}
+#endif
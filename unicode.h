@@ -4,8 +4,9 @@
 
 
 // Header files
+#include <cstddef>
 #include <cstdint>
-#include <regex>
+#include <string>
 #include <vector>
 
 using namespace std;
@@ -21,28 +22,58 @@ class Unicode final {
 	
 		// Constructor
 		Unicode() = delete;
+		
+		// UTF-8 validator class
+		class Utf8Validator final {
+		
+			// Public
+			public:
+			
+				// Constructor
+				Utf8Validator();
+				
+				// Update
+				bool update(const char *text, size_t length);
+				
+				// Is complete
+				bool isComplete() const;
+				
+				// Reset
+				void reset();
+			
+			// Private
+			private:
+			
+				// State
+				uint8_t state;
+		};
 	
-		// UTF-8 to UTF-32
+		// UTF-8 to UTF-32 (output must have space for length code points)
+		static size_t utf8ToUtf32(char32_t *output, const char *text, size_t length);
 		static u32string utf8ToUtf32(const char *text);
 		static u32string utf8ToUtf32(const string &text);
 		static char32_t utf8ToUtf32(char character);
 
-		// UTF-32 to UTF-8
+		// UTF-32 to UTF-8 (output must have space for four times length bytes)
+		static size_t utf32ToUtf8(char *output, const char32_t *text, size_t length);
 		static string utf32ToUtf8(const char32_t *text);
 		static string utf32ToUtf8(const u32string &text);
 		static string utf32ToUtf8(char32_t character);
 
-		// UTF-8 to UTF-16
+		// UTF-8 to UTF-16 (output must have space for length code units)
+		static size_t utf8ToUtf16(char16_t *output, const char *text, size_t length);
 		static u16string utf8ToUtf16(const char *text);
 		static u16string utf8ToUtf16(const string &text);
 		static char16_t utf8ToUtf16(char character);
 
-		// UTF-16 to UTF-8
+		// UTF-16 to UTF-8 (output must have space for three times length bytes)
+		static size_t utf16ToUtf8(char *output, const char16_t *text, size_t length);
 		static string utf16ToUtf8(const char16_t *text);
 		static string utf16ToUtf8(const u16string &text);
 		static string utf16ToUtf8(char16_t character);
 
 		// Is valid UTF-8
+		static bool isValidUtf8(const char *text, size_t length);
 		static bool isValidUtf8(const string &text);
 		static bool isValidUtf8(const vector<uint8_t> &data);
 
@@ -54,15 +85,18 @@ class Unicode final {
 		static bool isValidUtf32(const u32string &text);
 		static bool isValidUtf32(const vector<uint32_t> &data);
 
-		// Remove invalid UTF-8
+		// Remove invalid UTF-8 (output must have space for length bytes and can be the text)
+		static size_t removeInvalidUtf8(char *output, const char *text, size_t length);
 		static string removeInvalidUtf8(const string &text);
 		static string removeInvalidUtf8(const vector<uint8_t> &data);
 
-		// Remove invalid UTF-16
+		// Remove invalid UTF-16 (output must have space for length code points and can be the text)
+		static size_t removeInvalidUtf16(char16_t *output, const char16_t *text, size_t length);
 		static u16string removeInvalidUtf16(const u16string &text);
 		static u16string removeInvalidUtf16(const vector<uint16_t> &data);
 
-		// Remove invalid UTF-32
+		// Remove invalid UTF-32 (output must have space for length code points and can be the text)
+		static size_t removeInvalidUtf32(char32_t *output, const char32_t *text, size_t length);
 		static u32string removeInvalidUtf32(const u32string &text);
 		static u32string removeInvalidUtf32(const vector<uint32_t> &data);
 		
@@ -81,11 +115,42 @@ class Unicode final {
 	// Private
 	private:
 	
-		// Use alternative methods
-		static const bool USE_ALTERNATIVE_METHODS;
-
-		// UTF-8 code points pattern
-		static const regex UTF8_CODE_POINTS_PATTERN;
+		// Unicode test (checks the private validators directly)
+		friend class UnicodeTest;
+		
+		// Update UTF-8 state
+		static uint8_t updateUtf8State(uint8_t state, const char *text, size_t length);
+		
+		// Decode UTF-8
+		static char32_t decodeUtf8(const char *text, size_t length, size_t &index);
+		
+		// Encode UTF-8
+		static size_t encodeUtf8(char *output, char32_t codePoint);
+		
+		// Check if x86-64
+		#if defined __x86_64__ || defined _M_X64
+		
+			// Is printable ASCII block
+			static bool isPrintableAsciiBlock(const char *text);
+			
+			// Get valid UTF-8 length AVX2
+			__attribute__((target("avx2"))) static size_t getValidUtf8LengthAvx2(const char *text, size_t length);
+		#endif
+		
+		// UTF-8 accept state
+		static const uint8_t UTF8_ACCEPT_STATE;
+		
+		// UTF-8 reject state
+		static const uint8_t UTF8_REJECT_STATE;
+		
+		// UTF-8 number of character classes
+		static const uint8_t UTF8_NUMBER_OF_CHARACTER_CLASSES;
+		
+		// UTF-8 character classes
+		static const uint8_t UTF8_CHARACTER_CLASSES[];
+		
+		// UTF-8 transitions
+		static const uint8_t UTF8_TRANSITIONS[];
 };
 
 
@@ -0,0 +1,437 @@
+// Header files
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include "event2/buffer.h"
+#include "base64.h"
+#include "common.h"
+#include "metrics.h"
+#include "recorder.h"
+#include "websocket.h"
+
+using namespace std;
+
+
+// Constants
+
+// Opcode byte offset
+const size_t WebSocket::OPCODE_BYTE_OFFSET = 0;
+
+// Opcode byte mask
+const uint8_t WebSocket::OPCODE_BYTE_MASK = 0x0F;
+
+// Final frame byte offset
+const size_t WebSocket::FINAL_FRAME_BYTE_OFFSET = WebSocket::OPCODE_BYTE_OFFSET;
+
+// Final frame byte mask
+const uint8_t WebSocket::FINAL_FRAME_BYTE_MASK = 0x80;
+
+// Extension byte offset
+const size_t WebSocket::EXTENSION_BYTE_OFFSET = 0;
+
+// Extension byte mask
+const uint8_t WebSocket::EXTENSION_BYTE_MASK = 0x70;
+
+// Compressed extension byte mask
+const uint8_t WebSocket::COMPRESSED_EXTENSION_BYTE_MASK = 0x40;
+
+// Mask byte offset
+const size_t WebSocket::MASK_BYTE_OFFSET = 1;
+
+// Mask byte mask
+const uint8_t WebSocket::MASK_BYTE_MASK = 0x80;
+
+// Length byte offset
+const size_t WebSocket::LENGTH_BYTE_OFFSET = 1;
+
+// Length byte mask
+const uint8_t WebSocket::LENGTH_BYTE_MASK = 0x7F;
+
+// Sixteen bits length
+const uint8_t WebSocket::SIXTEEN_BITS_LENGTH = 0x7E;
+
+// Sixty-three bits length
+const uint8_t WebSocket::SIXTY_THREE_BITS_LENGTH = 0x7F;
+
+// Mask length
+const size_t WebSocket::MASK_LENGTH = 4;
+
+// Compressed message tail
+const vector<uint8_t> WebSocket::COMPRESSED_MESSAGE_TAIL = {0x00, 0x00, 0xFF, 0xFF};
+
+// Magic key value
+const char *WebSocket::MAGIC_KEY_VALUE = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+
+// Unmask block size
+const size_t WebSocket::UNMASK_BLOCK_SIZE = 4 * Common::BYTES_IN_A_KILOBYTE;
+
+// Compression policy poor compression ratio
+const double WebSocket::CompressionPolicy::POOR_COMPRESSION_RATIO = 0.9;
+
+// Compression policy compression ratio weight
+const double WebSocket::CompressionPolicy::COMPRESSION_RATIO_WEIGHT = 0.25;
+
+// Compression policy compression probe interval
+const int WebSocket::CompressionPolicy::COMPRESSION_PROBE_INTERVAL = 16;
+
+// Compression policy compression time budget microseconds per kilobyte
+const double WebSocket::CompressionPolicy::COMPRESSION_TIME_BUDGET_MICROSECONDS_PER_KILOBYTE = 20;
+
+
+// Supporting function implementation
+
+// Get accept key
+string WebSocket::getAcceptKey(const string &key) {
+
+	// Get hash of the key appended the magic key value to it
+	const string value = key + MAGIC_KEY_VALUE;
+	const vector<uint8_t> hash = Common::sha1Hash(vector<uint8_t>(value.begin(), value.end()));
+
+	// Encode hash
+	string acceptKey(Base64::getEncodedLength(hash.size()), '\0');
+	Base64::encode(acceptKey.data(), hash.data(), hash.size());
+
+	// Return accept key
+	return acceptKey;
+}
+
+// Append frame header
+void WebSocket::appendFrameHeader(vector<uint8_t> &output, Opcode opcode, bool isFinalFrame, bool isCompressed, uint64_t length, const uint8_t *mask) {
+
+	// Append opcode, is final frame, and is compressed to the output
+	output.push_back(static_cast<uint8_t>(opcode) | (isFinalFrame ? FINAL_FRAME_BYTE_MASK : 0) | (isCompressed ? COMPRESSED_EXTENSION_BYTE_MASK : 0));
+
+	// Get has mask
+	const uint8_t hasMask = mask ? MASK_BYTE_MASK : 0;
+
+	// Check if length requires sixty-three bits to express
+	if(length > UINT16_MAX) {
+
+		// Append length and has mask to the output
+		output.push_back(SIXTY_THREE_BITS_LENGTH | hasMask);
+
+		// Go through all length bytes
+		for(size_t i = 0; i < sizeof(uint64_t); ++i) {
+
+			// Append length byte to the output
+			output.push_back(length >> (Common::BITS_IN_A_BYTE * (sizeof(uint64_t) - sizeof(uint8_t) - i)));
+		}
+	}
+
+	// Otherwise check if length requires sixteen bits to express
+	else if(length >= SIXTEEN_BITS_LENGTH) {
+
+		// Append length and has mask to the output
+		output.push_back(SIXTEEN_BITS_LENGTH | hasMask);
+
+		// Go through all length bytes
+		for(size_t i = 0; i < sizeof(uint16_t); ++i) {
+
+			// Append length byte to the output
+			output.push_back(length >> (Common::BITS_IN_A_BYTE * (sizeof(uint16_t) - sizeof(uint8_t) - i)));
+		}
+	}
+
+	// Otherwise
+	else {
+
+		// Append length and has mask to the output
+		output.push_back(length | hasMask);
+	}
+
+	// Check if mask exists
+	if(mask) {
+
+		// Append mask to the output
+		output.insert(output.end(), mask, mask + MASK_LENGTH);
+	}
+}
+
+// Unmask
+bool WebSocket::unmask(uint8_t *output, const uint8_t *input, size_t length, const uint8_t *mask, Unicode::Utf8Validator *validator) {
+
+	// Get mask as a word
+	uint32_t maskWord;
+	memcpy(&maskWord, mask, sizeof(maskWord));
+
+	// Go through all blocks in the data
+	for(size_t i = 0; i < length; i += UNMASK_BLOCK_SIZE) {
+
+		// Get block's end
+		const size_t blockEnd = min(length, i + UNMASK_BLOCK_SIZE);
+
+		// Go through all words in the block
+		size_t j = i;
+		for(; j + sizeof(maskWord) <= blockEnd; j += sizeof(maskWord)) {
+
+			// Unmask word
+			uint32_t word;
+			memcpy(&word, &input[j], sizeof(word));
+			word ^= maskWord;
+			memcpy(&output[j], &word, sizeof(word));
+		}
+
+		// Go through all remaining bytes in the block
+		for(; j < blockEnd; ++j) {
+
+			// Unmask byte
+			output[j] = input[j] ^ mask[j % MASK_LENGTH];
+		}
+
+		// Check if validating the unmasked block failed
+		if(validator && !validator->update(reinterpret_cast<const char *>(&output[i]), blockEnd - i)) {
+
+			// Return false
+			return false;
+		}
+	}
+
+	// Return true
+	return true;
+}
+
+// Create response
+vector<uint8_t> WebSocket::createResponse(const string &message, Opcode opcode, CompressionPolicy *compressionPolicy, uint64_t connectionId) {
+
+	// Initialize response
+	vector<uint8_t> response;
+
+	// Initialize payload
+	const uint8_t *payload = reinterpret_cast<const uint8_t *>(message.data());
+	size_t payloadLength = message.size();
+
+	// Initialize compressed message
+	unique_ptr<evbuffer, decltype(&evbuffer_free)> compressedMessage(nullptr, evbuffer_free);
+
+	// Initialize compress
+	bool compress = false;
+
+	// Check if supports compression and opcode is text
+	if(compressionPolicy && opcode == Opcode::TEXT) {
+
+		// Check if compression policy allows compressing the message
+		if(compressionPolicy->shouldCompress(message.size())) {
+
+			// Get start time
+			const chrono::steady_clock::time_point startTime = chrono::steady_clock::now();
+
+			// Check if creating compressed message failed
+			compressedMessage.reset(evbuffer_new());
+			if(!compressedMessage) {
+
+				// Throw exception
+				throw runtime_error("Creating compressed message failed");
+			}
+
+			// Check if deflating the message at the compression policy's level failed
+			if(!Common::deflate(compressedMessage.get(), payload, payloadLength, compressionPolicy->getLevel())) {
+
+				// Throw exception
+				throw runtime_error("Deflating the message failed");
+			}
+
+			// Check if appending BFINAL flag to compressed message failed
+			if(evbuffer_add(compressedMessage.get(), &Common::DEFLATE_BFINAL_FLAG, sizeof(Common::DEFLATE_BFINAL_FLAG))) {
+
+				// Throw exception
+				throw runtime_error("Appending BFINAL flag to compressed message failed");
+			}
+
+			// Update compression policy with the message's ratio and time
+			const size_t compressedMessageLength = evbuffer_get_length(compressedMessage.get());
+			const chrono::steady_clock::duration duration = chrono::steady_clock::now() - startTime;
+			compressionPolicy->update(message.size(), compressedMessageLength, duration);
+
+			// Update compression duration and ratio metrics
+			Metrics::compressionDuration.recordDuration(duration);
+			Metrics::compressionRatio.record(compressedMessageLength * 100 / max(message.size(), static_cast<size_t>(1)));
+
+			// Check if compressed message is smaller than the message
+			if(compressedMessageLength < message.size()) {
+
+				// Update compression input and output bytes metrics
+				Metrics::compressionInputBytes.increment(message.size());
+				Metrics::compressionOutputBytes.increment(compressedMessageLength);
+
+				// Check if making compressed message contiguous failed
+				payloadLength = compressedMessageLength;
+				payload = evbuffer_pullup(compressedMessage.get(), payloadLength);
+				if(!payload) {
+
+					// Throw exception
+					throw runtime_error("Making compressed message contiguous failed");
+				}
+
+				// Set compress
+				compress = true;
+			}
+		}
+	}
+
+	// Check if opcode is text
+	if(opcode == Opcode::TEXT) {
+
+		// Record message sent to the connection
+		Recorder::recordServerMessage(connectionId, compress, message);
+	}
+
+	// Reserve space for the payload and a frame header in the response
+	response.reserve(payloadLength + sizeof(uint8_t) + sizeof(uint8_t) + sizeof(uint64_t));
+
+	// Go through all WebSocket response frames
+	for(string::size_type i = 0;;) {
+
+		// Get if response is final frame
+		const bool isFinalFrame = payloadLength - i <= INT64_MAX;
+
+		// Get frame length
+		const string::size_type frameLength = isFinalFrame ? payloadLength - i : INT64_MAX;
+
+		// Append frame's header to the response
+		appendFrameHeader(response, opcode, isFinalFrame, opcode == Opcode::TEXT && compress, frameLength);
+
+		// Append message to the response
+		response.insert(response.end(), payload + i, payload + i + frameLength);
+
+		// Check if is final frame
+		if(isFinalFrame) {
+
+			// Break
+			break;
+		}
+
+		// Update offset to next frame
+		i += frameLength;
+
+		// Set opcode to continuation
+		opcode = Opcode::CONTINUATION;
+	}
+
+	// Update WebSocket bytes sent metric
+	Metrics::webSocketBytesSent.increment(response.size());
+
+	// Return response
+	return response;
+}
+
+// Compression policy constructor
+WebSocket::CompressionPolicy::CompressionPolicy(size_t minimumCompressionLength) :
+
+	// Set minimum compression length
+	minimumCompressionLength(minimumCompressionLength),
+
+	// Set level
+	level(Z_BEST_COMPRESSION),
+
+	// Set average ratio
+	averageRatio(0),
+
+	// Set messages since probe
+	messagesSinceProbe(0),
+
+	// Set uncompressed bytes
+	uncompressedBytes(0),
+
+	// Set compressed bytes
+	compressedBytes(0)
+{
+}
+
+// Compression policy should compress
+bool WebSocket::CompressionPolicy::shouldCompress(size_t length) {
+
+	// Check if length is too small to compress
+	if(length < minimumCompressionLength) {
+
+		// Return false
+		return false;
+	}
+
+	// Check if recent messages compressed poorly and it's not time to probe again
+	if(averageRatio > POOR_COMPRESSION_RATIO && ++messagesSinceProbe < COMPRESSION_PROBE_INTERVAL) {
+
+		// Return false
+		return false;
+	}
+
+	// Reset messages since probe
+	messagesSinceProbe = 0;
+
+	// Return true
+	return true;
+}
+
+// Compression policy get level
+int WebSocket::CompressionPolicy::getLevel() const {
+
+	// Return level
+	return level;
+}
+
+// Compression policy update
+void WebSocket::CompressionPolicy::update(size_t length, size_t compressedLength, chrono::steady_clock::duration duration) {
+
+	// Check if length is zero
+	if(!length) {
+
+		// Return since an empty message has no ratio or time per kilobyte
+		return;
+	}
+
+	// Get ratio
+	const double ratio = static_cast<double>(compressedLength) / length;
+
+	// Check if no ratio has been recorded
+	if(!averageRatio) {
+
+		// Set average ratio to the ratio
+		averageRatio = ratio;
+	}
+
+	// Otherwise
+	else {
+
+		// Add ratio to the average ratio
+		averageRatio += (ratio - averageRatio) * COMPRESSION_RATIO_WEIGHT;
+	}
+
+	// Check if compressed message will be sent
+	if(compressedLength < length) {
+
+		// Update uncompressed and compressed bytes
+		uncompressedBytes += length;
+		compressedBytes += compressedLength;
+	}
+
+	// Get time spent per kilobyte
+	const double time = chrono::duration<double, micro>(duration).count() * Common::BYTES_IN_A_KILOBYTE / length;
+
+	// Check if time is over budget and level can be decreased
+	if(time > COMPRESSION_TIME_BUDGET_MICROSECONDS_PER_KILOBYTE && level > Z_BEST_SPEED) {
+
+		// Decrease level
+		--level;
+	}
+
+	// Otherwise check if time is well under budget and level can be increased
+	else if(time < COMPRESSION_TIME_BUDGET_MICROSECONDS_PER_KILOBYTE / 2 && level < Z_BEST_COMPRESSION) {
+
+		// Increase level
+		++level;
+	}
+}
+
+// Compression policy get uncompressed bytes
+uint64_t WebSocket::CompressionPolicy::getUncompressedBytes() const {
+
+	// Return uncompressed bytes
+	return uncompressedBytes;
+}
+
+// Compression policy get compressed bytes
+uint64_t WebSocket::CompressionPolicy::getCompressedBytes() const {
+
+	// Return compressed bytes
+	return compressedBytes;
+}
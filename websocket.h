@@ -0,0 +1,170 @@
+// Header guard
+#ifndef WEBSOCKET_H
+#define WEBSOCKET_H
+
+
+// Header files
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "unicode.h"
+
+using namespace std;
+
+
+// Classes
+
+// WebSocket class
+class WebSocket final {
+
+	// Public
+	public:
+
+		// Constructor
+		WebSocket() = delete;
+
+		// Opcode
+		enum class Opcode {
+
+			// Continuation
+			CONTINUATION = 0x00,
+
+			// Text
+			TEXT = 0x01,
+
+			// Ping
+			PING = 0x09,
+
+			// Pong
+			PONG = 0x0A
+		};
+
+		// Compression policy class
+		class CompressionPolicy final {
+
+			// Public
+			public:
+
+				// Constructor
+				explicit CompressionPolicy(size_t minimumCompressionLength);
+
+				// Should compress
+				bool shouldCompress(size_t length);
+
+				// Get level
+				int getLevel() const;
+
+				// Update
+				void update(size_t length, size_t compressedLength, chrono::steady_clock::duration duration);
+
+				// Get uncompressed bytes
+				uint64_t getUncompressedBytes() const;
+
+				// Get compressed bytes
+				uint64_t getCompressedBytes() const;
+
+			// Private
+			private:
+
+				// Poor compression ratio
+				static const double POOR_COMPRESSION_RATIO;
+
+				// Compression ratio weight
+				static const double COMPRESSION_RATIO_WEIGHT;
+
+				// Compression probe interval
+				static const int COMPRESSION_PROBE_INTERVAL;
+
+				// Compression time budget microseconds per kilobyte
+				static const double COMPRESSION_TIME_BUDGET_MICROSECONDS_PER_KILOBYTE;
+
+				// Minimum compression length
+				size_t minimumCompressionLength;
+
+				// Level
+				int level;
+
+				// Average ratio
+				double averageRatio;
+
+				// Messages since probe
+				int messagesSinceProbe;
+
+				// Uncompressed bytes
+				uint64_t uncompressedBytes;
+
+				// Compressed bytes
+				uint64_t compressedBytes;
+		};
+
+		// Get accept key
+		static string getAcceptKey(const string &key);
+
+		// Append frame header
+		static void appendFrameHeader(vector<uint8_t> &output, Opcode opcode, bool isFinalFrame, bool isCompressed, uint64_t length, const uint8_t *mask = nullptr);
+
+		// Unmask
+		static bool unmask(uint8_t *output, const uint8_t *input, size_t length, const uint8_t *mask, Unicode::Utf8Validator *validator);
+
+		// Create response (compresses text messages when there's a compression policy that allows it and records them for the connection)
+		static vector<uint8_t> createResponse(const string &message, Opcode opcode, CompressionPolicy *compressionPolicy, uint64_t connectionId);
+
+		// Opcode byte offset
+		static const size_t OPCODE_BYTE_OFFSET;
+
+		// Opcode byte mask
+		static const uint8_t OPCODE_BYTE_MASK;
+
+		// Final frame byte offset
+		static const size_t FINAL_FRAME_BYTE_OFFSET;
+
+		// Final frame byte mask
+		static const uint8_t FINAL_FRAME_BYTE_MASK;
+
+		// Extension byte offset
+		static const size_t EXTENSION_BYTE_OFFSET;
+
+		// Extension byte mask
+		static const uint8_t EXTENSION_BYTE_MASK;
+
+		// Compressed extension byte mask
+		static const uint8_t COMPRESSED_EXTENSION_BYTE_MASK;
+
+		// Mask byte offset
+		static const size_t MASK_BYTE_OFFSET;
+
+		// Mask byte mask
+		static const uint8_t MASK_BYTE_MASK;
+
+		// Length byte offset
+		static const size_t LENGTH_BYTE_OFFSET;
+
+		// Length byte mask
+		static const uint8_t LENGTH_BYTE_MASK;
+
+		// Sixteen bits length
+		static const uint8_t SIXTEEN_BITS_LENGTH;
+
+		// Sixty-three bits length
+		static const uint8_t SIXTY_THREE_BITS_LENGTH;
+
+		// Mask length
+		static const size_t MASK_LENGTH;
+
+		// Compressed message tail
+		static const vector<uint8_t> COMPRESSED_MESSAGE_TAIL;
+
+	// Private
+	private:
+
+		// Magic key value
+		static const char *MAGIC_KEY_VALUE;
+
+		// Unmask block size
+		static const size_t UNMASK_BLOCK_SIZE;
+};
+
+
+#endif